@@ -314,6 +314,11 @@ CopyContext::ReadTextureTask::SharedPtr CopyContext::ReadTextureTask::create(
     return pThis;
 }
 
+bool CopyContext::ReadTextureTask::isDataReady() const
+{
+    return mpFence->getGpuValue() >= mpFence->getCpuValue() - 1;
+}
+
 std::vector<uint8_t> CopyContext::ReadTextureTask::getData()
 {
     mpFence->syncCpu();
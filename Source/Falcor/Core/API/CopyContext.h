@@ -50,6 +50,10 @@ public:
         using SharedPtr = std::shared_ptr<ReadTextureTask>;
         static SharedPtr create(CopyContext* pCtx, const Texture* pTexture, uint32_t subresourceIndex);
         std::vector<uint8_t> getData();
+        /**
+         * Returns true if the GPU has finished the readback and getData() will not block.
+         */
+        bool isDataReady() const;
 
     private:
         ReadTextureTask() = default;
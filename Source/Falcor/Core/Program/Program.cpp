@@ -31,6 +31,7 @@
 #include "Core/Platform/OS.h"
 #include "Core/API/Device.h"
 #include "Core/API/ParameterBlock.h"
+#include "Utils/CryptoUtils.h"
 #include "Utils/StringUtils.h"
 #include "Utils/Logger.h"
 #include "Utils/Timing/CpuTimer.h"
@@ -203,7 +204,62 @@ void Program::validateEntryPoints() const
     }
 }
 
-Program::~Program() {}
+Program::~Program()
+{
+    cancelPrewarmVersions();
+}
+
+void Program::cancelPrewarmVersions() const
+{
+    // Background compilations reference the program without keeping it alive. Claim the versions that have not
+    // started compiling yet, so that their tasks are skipped, and wait for the ones in flight.
+    for (auto& [defineList, prewarmVersion] : mPrewarmVersions)
+    {
+        if (prewarmVersion.pStarted->exchange(true))
+            prewarmVersion.future.wait();
+    }
+    mPrewarmVersions.clear();
+}
+
+const std::string& Program::getPrewarmKey() const
+{
+    if (mPrewarmKey.empty())
+    {
+        // Hash everything in the description that affects compilation.
+        SHA1 sha1;
+        auto updateString = [&sha1](const std::string& str)
+        {
+            sha1.update(str.size());
+            sha1.update(std::string_view(str));
+        };
+
+        for (const auto& src : mDesc.mSources)
+        {
+            sha1.update((uint32_t)src.source.type);
+            sha1.update(src.source.createTranslationUnit);
+            updateString(src.source.filePath.generic_string());
+            updateString(src.source.str);
+            updateString(src.source.moduleName);
+            updateString(src.source.modulePath);
+        }
+        for (const auto& entryPoint : mDesc.mEntryPoints)
+        {
+            updateString(entryPoint.name);
+            updateString(entryPoint.exportName);
+            sha1.update((uint32_t)entryPoint.stage);
+            sha1.update(entryPoint.sourceIndex);
+            sha1.update(entryPoint.groupIndex);
+        }
+        sha1.update((uint32_t)mDesc.mShaderFlags);
+        for (const auto& arg : mDesc.mCompilerArguments)
+            updateString(arg);
+        updateString(mDesc.mShaderModel);
+        updateString(mDesc.mLanguagePrelude);
+
+        mPrewarmKey = SHA1::toString(sha1.finalize());
+    }
+    return mPrewarmKey;
+}
 
 std::string Program::getProgramDescString() const
 {
@@ -417,7 +473,7 @@ bool Program::link() const
     {
         // Create the program
         std::string log;
-        auto pVersion = mpDevice->getProgramManager()->createProgramVersion(*this, log);
+        auto pVersion = mpDevice->getProgramManager()->getProgramVersion(*this, log);
 
         if (pVersion == nullptr)
         {
@@ -446,6 +502,10 @@ void Program::reset()
     mProgramVersions.clear();
     mFileTimeMap.clear();
     mLinkRequired = true;
+
+    // Discard versions compiled in the background from the old sources and queue them again on next use.
+    cancelPrewarmVersions();
+    mPrewarmQueued = false;
 }
 
 FALCOR_SCRIPT_BINDING(Program)
@@ -30,7 +30,9 @@
 #include "Core/Macros.h"
 #include "Core/API/fwd.h"
 #include "Core/API/Shader.h"
+#include <atomic>
 #include <filesystem>
+#include <future>
 #include <memory>
 #include <string_view>
 #include <string>
@@ -396,6 +398,35 @@ protected:
 
     Program(std::shared_ptr<Device> pDevice, Desc const& desc, DefineList const& programDefines);
 
+    /**
+     * Result of compiling a program version.
+     */
+    struct CompiledVersion
+    {
+        ProgramVersion::SharedPtr pVersion;
+        std::string log;
+        std::vector<std::string> dependencies; ///< Files the version depends on.
+    };
+
+    /**
+     * Program version queued for compilation in the background.
+     */
+    struct PrewarmVersion
+    {
+        std::shared_future<CompiledVersion> future;
+        std::shared_ptr<std::atomic<bool>> pStarted; ///< Set by whoever starts the compilation first, the background task or the program.
+    };
+
+    /**
+     * Get a key identifying the program description across sessions, used for recording program versions for prewarming.
+     */
+    const std::string& getPrewarmKey() const;
+
+    /**
+     * Cancel the background compilations of this program that have not started yet and wait for the others.
+     */
+    void cancelPrewarmVersions() const;
+
     void validateEntryPoints() const;
     bool link() const;
 
@@ -413,6 +444,11 @@ protected:
     mutable ProgramVersion::SharedConstPtr mpActiveVersion;
     void markDirty() { mLinkRequired = true; }
 
+    // Program versions compiled in the background, see ProgramManager::enablePrewarming().
+    mutable std::string mPrewarmKey;
+    mutable bool mPrewarmQueued = false;
+    mutable std::map<DefineList, PrewarmVersion> mPrewarmVersions;
+
     std::string getProgramDescString() const;
 
     using string_time_map = std::unordered_map<std::string, time_t>;
@@ -28,9 +28,13 @@
 #include "ProgramManager.h"
 #include "Core/API/Device.h"
 #include "Core/Platform/OS.h"
+#include "Utils/Logger.h"
 #include "Utils/Timing/CpuTimer.h"
 
 #include <slang.h>
+#include <nlohmann/json.hpp>
+
+#include <fstream>
 
 namespace Falcor
 {
@@ -101,21 +105,262 @@ inline bool doSlangReflection(
 
 ProgramManager::ProgramManager(std::weak_ptr<Device> pDevice) : mpDevice(pDevice) {}
 
+ProgramManager::~ProgramManager()
+{
+    {
+        std::lock_guard<std::mutex> lock(mPrewarmMutex);
+        mPrewarmTerminate = true;
+        // Dropping the pending tasks breaks their promises, programs waiting on them compile synchronously instead.
+        mPrewarmTasks.clear();
+    }
+    mPrewarmCondition.notify_all();
+    for (auto& thread : mPrewarmThreads)
+        thread.join();
+
+    if (!mPrewarmPath.empty())
+        savePrewarmList();
+}
+
 ProgramVersion::SharedPtr ProgramManager::createProgramVersion(const Program& program, std::string& log) const
 {
+    auto pDevice = mpDevice.lock();
+    FALCOR_ASSERT(pDevice);
+
+    auto result = compileProgramVersion(program, program.getDefineList(), getCompileSettings(), pDevice->getSlangGlobalSession());
+    log += result.log;
+
+    // Extract list of files referenced, for dependency-tracking purposes.
+    program.mFileTimeMap.clear();
+    for (const auto& path : result.dependencies)
+        program.mFileTimeMap[path] = getFileModifiedTime(path);
+
+    return result.pVersion;
+}
+
+ProgramVersion::SharedPtr ProgramManager::getProgramVersion(const Program& program, std::string& log)
+{
+    if (!mPrewarmPath.empty() && !program.mPrewarmQueued)
+    {
+        program.mPrewarmQueued = true;
+        queuePrewarmVersions(program);
+    }
+
+    ProgramVersion::SharedPtr pVersion;
+
+    // Use the version compiled in the background if there is one, waiting for it if still in flight.
+    // If its compilation has not started yet, claim it and compile it here instead.
+    auto it = program.mPrewarmVersions.find(program.getDefineList());
+    if (it != program.mPrewarmVersions.end())
+    {
+        auto prewarmVersion = std::move(it->second);
+        program.mPrewarmVersions.erase(it);
+        if (prewarmVersion.pStarted->exchange(true))
+        {
+            try
+            {
+                const auto& result = prewarmVersion.future.get();
+                if (result.pVersion)
+                {
+                    pVersion = result.pVersion;
+                    log += result.log;
+                    program.mFileTimeMap.clear();
+                    for (const auto& path : result.dependencies)
+                        program.mFileTimeMap[path] = getFileModifiedTime(path);
+                }
+            }
+            catch (const std::exception&)
+            {
+                // The task was dropped when shutting down, or failed. Compile below, which reports any errors.
+            }
+        }
+    }
+
+    // Compile on the calling thread. This also reports errors if the background compilation failed.
+    if (!pVersion)
+        pVersion = createProgramVersion(program, log);
+
+    if (pVersion && !mPrewarmPath.empty())
+        mRecordedVersions[program.getPrewarmKey()].insert(program.getDefineList());
+
+    return pVersion;
+}
+
+void ProgramManager::enablePrewarming(const std::filesystem::path& path, uint32_t threadCount)
+{
+    mPrewarmPath = path;
+    mPrewarmThreadCount = threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+    mPrewarmList.clear();
+
+    if (!std::filesystem::exists(path))
+        return;
+
+    try
+    {
+        std::ifstream ifs(path);
+        nlohmann::json json = nlohmann::json::parse(ifs);
+        for (const auto& program : json.at("programs"))
+        {
+            auto& versions = mPrewarmList[program.at("key").get<std::string>()];
+            for (const auto& defines : program.at("versions"))
+            {
+                Program::DefineList defineList;
+                for (const auto& [name, value] : defines.items())
+                    defineList.add(name, value.get<std::string>());
+                versions.push_back(std::move(defineList));
+            }
+        }
+        logInfo("Loaded shader prewarm list with {} programs from '{}'.", mPrewarmList.size(), path);
+    }
+    catch (const std::exception& e)
+    {
+        logWarning("Failed to load shader prewarm list from '{}': {}", path, e.what());
+        mPrewarmList.clear();
+    }
+}
+
+void ProgramManager::savePrewarmList() const
+{
+    if (mPrewarmPath.empty())
+        return;
+
+    nlohmann::json programs = nlohmann::json::array();
+    for (const auto& [key, versions] : mRecordedVersions)
+    {
+        nlohmann::json jsonVersions = nlohmann::json::array();
+        for (const auto& defineList : versions)
+        {
+            nlohmann::json defines = nlohmann::json::object();
+            for (const auto& [name, value] : defineList)
+                defines[name] = value;
+            jsonVersions.push_back(std::move(defines));
+        }
+        programs.push_back({{"key", key}, {"versions", std::move(jsonVersions)}});
+    }
+
+    try
+    {
+        std::filesystem::create_directories(mPrewarmPath.parent_path());
+        std::ofstream ofs(mPrewarmPath);
+        ofs << nlohmann::json{{"programs", std::move(programs)}}.dump(1);
+    }
+    catch (const std::exception& e)
+    {
+        logWarning("Failed to write shader prewarm list to '{}': {}", mPrewarmPath, e.what());
+    }
+}
+
+ProgramManager::CompileSettings ProgramManager::getCompileSettings() const
+{
+    CompileSettings settings;
+    settings.globalDefineList = mGlobalDefineList;
+    settings.forcedCompilerFlags = mForcedCompilerFlags;
+    settings.generateDebugInfo = mGenerateDebugInfo;
+    return settings;
+}
+
+void ProgramManager::queuePrewarmVersions(const Program& program)
+{
+    auto listIt = mPrewarmList.find(program.getPrewarmKey());
+    if (listIt == mPrewarmList.end())
+        return;
+
+    // The tasks don't keep the program alive, as the program holds a reference to the device which owns this manager.
+    // Instead, a task only accesses the program after claiming its version, and the program cancels or waits for
+    // its queued versions when it is destroyed, see Program::cancelPrewarmVersions().
+    const Program* pProgram = &program;
+    auto settings = std::make_shared<CompileSettings>(getCompileSettings());
+
+    std::lock_guard<std::mutex> lock(mPrewarmMutex);
+    for (const auto& defineList : listIt->second)
+    {
+        // The current version is compiled on the calling thread right away.
+        if (defineList == program.getDefineList() || program.mProgramVersions.count(defineList) > 0 ||
+            program.mPrewarmVersions.count(defineList) > 0)
+            continue;
+
+        auto pPromise = std::make_shared<std::promise<Program::CompiledVersion>>();
+        auto pStarted = std::make_shared<std::atomic<bool>>(false);
+        program.mPrewarmVersions[defineList] = {pPromise->get_future().share(), pStarted};
+        mPrewarmTasks.push_back(
+            [this, pProgram, defineList, settings, pPromise, pStarted](
+                slang::IGlobalSession* pSlangGlobalSession, const std::shared_ptr<std::mutex>& pSlangMutex
+            )
+            {
+                // Skip versions the program has already started compiling itself, or that were cancelled.
+                if (pStarted->exchange(true))
+                {
+                    pPromise->set_value({});
+                    return;
+                }
+                try
+                {
+                    auto result = compileProgramVersion(*pProgram, defineList, *settings, pSlangGlobalSession);
+                    if (result.pVersion)
+                        result.pVersion->mpSlangMutex = pSlangMutex;
+                    pPromise->set_value(std::move(result));
+                }
+                catch (...)
+                {
+                    pPromise->set_exception(std::current_exception());
+                }
+            }
+        );
+    }
+
+    // Start the workers on first use.
+    while (mPrewarmThreads.size() < mPrewarmThreadCount && mPrewarmThreads.size() < mPrewarmTasks.size())
+        mPrewarmThreads.emplace_back(&ProgramManager::runPrewarmWorker, this);
+    mPrewarmCondition.notify_all();
+}
+
+void ProgramManager::runPrewarmWorker()
+{
+    // Slang global sessions must not be used from multiple threads concurrently, so each worker has its own.
+    // Versions compiled by this worker keep using its session when creating kernels, which is serialized by the mutex.
+    ComPtr<slang::IGlobalSession> pSlangGlobalSession;
+    slang::createGlobalSession(pSlangGlobalSession.writeRef());
+    auto pSlangMutex = std::make_shared<std::mutex>();
+
+    while (true)
+    {
+        PrewarmTask task;
+        {
+            std::unique_lock<std::mutex> lock(mPrewarmMutex);
+            mPrewarmCondition.wait(lock, [this]() { return mPrewarmTerminate || !mPrewarmTasks.empty(); });
+            if (mPrewarmTerminate)
+                break;
+            task = std::move(mPrewarmTasks.front());
+            mPrewarmTasks.pop_front();
+        }
+
+        std::lock_guard<std::mutex> lock(*pSlangMutex);
+        task(pSlangGlobalSession, pSlangMutex);
+    }
+}
+
+Program::CompiledVersion ProgramManager::compileProgramVersion(
+    const Program& program,
+    const Program::DefineList& defineList,
+    const CompileSettings& settings,
+    slang::IGlobalSession* pSlangGlobalSession
+) const
+{
+    Program::CompiledVersion result;
+    std::string& log = result.log;
+
     CpuTimer timer;
     timer.update();
 
-    auto pSlangRequest = createSlangCompileRequest(program);
+    auto pSlangRequest = createSlangCompileRequest(program, defineList, settings, pSlangGlobalSession, log);
     if (pSlangRequest == nullptr)
-        return nullptr;
+        return result;
 
     SlangResult slangResult = spCompile(pSlangRequest);
     log += spGetDiagnosticOutput(pSlangRequest);
     if (SLANG_FAILED(slangResult))
     {
         spDestroyCompileRequest(pSlangRequest);
-        return nullptr;
+        return result;
     }
 
     ComPtr<slang::IComponentType> pSlangGlobalScope;
@@ -153,7 +398,7 @@ ProgramVersion::SharedPtr ProgramManager::createProgramVersion(const Program& pr
     {
         std::string depFilePath = spGetDependencyFilePath(pSlangRequest, ii);
         if (std::filesystem::exists(depFilePath))
-            program.mFileTimeMap[depFilePath] = getFileModifiedTime(depFilePath);
+            result.dependencies.push_back(depFilePath);
     }
 
     // Note: the `ProgramReflection` needs to be able to refer back to the
@@ -185,20 +430,24 @@ ProgramVersion::SharedPtr ProgramManager::createProgramVersion(const Program& pr
     ProgramReflection::SharedPtr pReflector;
     if (!doSlangReflection(*pVersion, pSlangGlobalScope, pSlangEntryPoints, pReflector, log))
     {
-        return nullptr;
+        return result;
     }
 
     auto descStr = program.getProgramDescString();
-    pVersion->init(program.getDefineList(), pReflector, descStr, pSlangEntryPoints);
+    pVersion->init(defineList, pReflector, descStr, pSlangEntryPoints);
+    result.pVersion = pVersion;
 
     timer.update();
     double time = timer.delta();
-    mCompilationStats.programVersionCount++;
-    mCompilationStats.programVersionTotalTime += time;
-    mCompilationStats.programVersionMaxTime = std::max(mCompilationStats.programVersionMaxTime, time);
+    {
+        std::lock_guard<std::mutex> lock(mStatsMutex);
+        mCompilationStats.programVersionCount++;
+        mCompilationStats.programVersionTotalTime += time;
+        mCompilationStats.programVersionMaxTime = std::max(mCompilationStats.programVersionMaxTime, time);
+    }
     logDebug("Created program version in {:.3f} s: {}", timer.delta(), descStr);
 
-    return pVersion;
+    return result;
 }
 
 ProgramKernels::SharedPtr ProgramManager::createProgramKernels(
@@ -214,6 +463,11 @@ ProgramKernels::SharedPtr ProgramManager::createProgramKernels(
     CpuTimer timer;
     timer.update();
 
+    // Versions compiled in the background share the Slang global session of their worker thread.
+    std::unique_lock<std::mutex> slangLock;
+    if (programVersion.mpSlangMutex)
+        slangLock = std::unique_lock<std::mutex>(*programVersion.mpSlangMutex);
+
     auto pSlangGlobalScope = programVersion.getSlangGlobalScope();
     auto pSlangSession = pSlangGlobalScope->getSession();
 
@@ -479,9 +733,12 @@ ProgramKernels::SharedPtr ProgramManager::createProgramKernels(
 
     timer.update();
     double time = timer.delta();
-    mCompilationStats.programKernelsCount++;
-    mCompilationStats.programKernelsTotalTime += time;
-    mCompilationStats.programKernelsMaxTime = std::max(mCompilationStats.programKernelsMaxTime, time);
+    {
+        std::lock_guard<std::mutex> lock(mStatsMutex);
+        mCompilationStats.programKernelsCount++;
+        mCompilationStats.programKernelsTotalTime += time;
+        mCompilationStats.programKernelsMaxTime = std::max(mCompilationStats.programKernelsMaxTime, time);
+    }
     logDebug("Created program kernels in {:.3f} s: {}", time, descStr);
 
     return pProgramKernels;
@@ -627,12 +884,16 @@ ProgramManager::ForcedCompilerFlags ProgramManager::getForcedCompilerFlags()
     return mForcedCompilerFlags;
 }
 
-SlangCompileRequest* ProgramManager::createSlangCompileRequest(const Program& program) const
+SlangCompileRequest* ProgramManager::createSlangCompileRequest(
+    const Program& program,
+    const Program::DefineList& defineList,
+    const CompileSettings& settings,
+    slang::IGlobalSession* pSlangGlobalSession,
+    std::string& log
+) const
 {
     auto pDevice = mpDevice.lock();
     FALCOR_ASSERT(pDevice);
-
-    slang::IGlobalSession* pSlangGlobalSession = pDevice->getSlangGlobalSession();
     FALCOR_ASSERT(pSlangGlobalSession);
 
     slang::SessionDesc sessionDesc;
@@ -659,14 +920,14 @@ SlangCompileRequest* ProgramManager::createSlangCompileRequest(const Program& pr
 
     if (targetDesc.profile == SLANG_PROFILE_UNKNOWN)
     {
-        reportError("Can't find Slang profile for shader model " + program.mDesc.mShaderModel);
+        log += "Can't find Slang profile for shader model " + program.mDesc.mShaderModel + "\n";
         return nullptr;
     }
 
     // Get compiler flags and adjust with forced flags.
     Shader::CompilerFlags compilerFlags = program.mDesc.getCompilerFlags();
-    compilerFlags &= ~mForcedCompilerFlags.disabled;
-    compilerFlags |= mForcedCompilerFlags.enabled;
+    compilerFlags &= ~settings.forcedCompilerFlags.disabled;
+    compilerFlags |= settings.forcedCompilerFlags.enabled;
 
     // Set floating point mode. If no shader compiler flags for this were set, we use Slang's default mode.
     bool flagFast = is_set(compilerFlags, Shader::CompilerFlags::FloatingPointModeFast);
@@ -714,9 +975,9 @@ SlangCompileRequest* ProgramManager::createSlangCompileRequest(const Program& pr
     const auto addSlangDefine = [&slangDefines](const char* name, const char* value) { slangDefines.push_back({name, value}); };
 
     // Add global followed by program specific defines.
-    for (const auto& shaderDefine : mGlobalDefineList)
+    for (const auto& shaderDefine : settings.globalDefineList)
         addSlangDefine(shaderDefine.first.c_str(), shaderDefine.second.c_str());
-    for (const auto& shaderDefine : program.getDefineList())
+    for (const auto& shaderDefine : defineList)
         addSlangDefine(shaderDefine.first.c_str(), shaderDefine.second.c_str());
 
     // Add a `#define`s based on the target and shader model.
@@ -742,8 +1003,6 @@ SlangCompileRequest* ProgramManager::createSlangCompileRequest(const Program& pr
     pSlangGlobalSession->createSession(sessionDesc, pSlangSession.writeRef());
     FALCOR_ASSERT(pSlangSession);
 
-    program.mFileTimeMap.clear(); // TODO @skallweit
-
     if (!program.mDesc.mLanguagePrelude.empty())
     {
         if (targetDesc.format == SLANG_DXIL)
@@ -752,7 +1011,7 @@ SlangCompileRequest* ProgramManager::createSlangCompileRequest(const Program& pr
         }
         else
         {
-            reportError("Language prelude set for unsupported target " + std::string(targetMacroName));
+            log += "Language prelude set for unsupported target " + std::string(targetMacroName) + "\n";
             return nullptr;
         }
     }
@@ -769,7 +1028,7 @@ SlangCompileRequest* ProgramManager::createSlangCompileRequest(const Program& pr
     spSetDumpIntermediates(pSlangRequest, dumpIR);
 
     // Set debug level
-    if (mGenerateDebugInfo || is_set(program.mDesc.getCompilerFlags(), Shader::CompilerFlags::GenerateDebugInfo))
+    if (settings.generateDebugInfo || is_set(program.mDesc.getCompilerFlags(), Shader::CompilerFlags::GenerateDebugInfo))
         spSetDebugInfoLevel(pSlangRequest, SLANG_DEBUG_INFO_LEVEL_STANDARD);
 
     // Configure any flags for the Slang compilation step
@@ -830,7 +1089,7 @@ SlangCompileRequest* ProgramManager::createSlangCompileRequest(const Program& pr
             std::filesystem::path fullPath;
             if (!findFileInShaderDirectories(path, fullPath))
             {
-                reportError("Can't find file " + path.string());
+                log += "Can't find file " + path.string() + "\n";
                 spDestroyCompileRequest(pSlangRequest);
                 return nullptr;
             }
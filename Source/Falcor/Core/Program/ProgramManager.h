@@ -29,15 +29,26 @@
 #include "Program.h"
 #include "Core/API/fwd.h"
 
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace Falcor
 {
 
-class ProgramManager
+class FALCOR_API ProgramManager
 {
 public:
     ProgramManager(std::weak_ptr<Device> pDevice);
+    ~ProgramManager();
 
     /**
      * Defines flags that should be forcefully disabled or enabled on all shaders.
@@ -64,6 +75,35 @@ public:
 
     ProgramVersion::SharedPtr createProgramVersion(const Program& program, std::string& log) const;
 
+    /**
+     * Get a program version for the program's current defines.
+     * If the version is being compiled in the background, this waits for it instead of compiling it again.
+     * Otherwise the version is compiled on the calling thread. On first use of a program, the versions
+     * recorded for it in an earlier session are queued for background compilation.
+     * @param[in] program The program.
+     * @param[out] log Compiler diagnostics.
+     * @return The program version, or nullptr on failure.
+     */
+    ProgramVersion::SharedPtr getProgramVersion(const Program& program, std::string& log);
+
+    /**
+     * Enable recording and prewarming of program versions.
+     * Program versions created in this session are recorded and written to the given file by savePrewarmList().
+     * Versions recorded in an earlier session are compiled in parallel on background threads when their program
+     * is first used, so that switching to them later does not stall on shader compilation.
+     * Only the front-end compilation of the versions is done in the background. Kernels, which depend on the
+     * type conformances of the program vars, are still created on first use.
+     * @param[in] path File storing the recorded program versions.
+     * @param[in] threadCount Number of background compilation threads. If zero, the number of logical threads is used.
+     */
+    void enablePrewarming(const std::filesystem::path& path, uint32_t threadCount = 0);
+
+    /**
+     * Write the program versions recorded in this session to the prewarm file.
+     * This is called automatically when the program manager is destroyed.
+     */
+    void savePrewarmList() const;
+
     ProgramKernels::SharedPtr ProgramManager::createProgramKernels(
         const Program& program,
         const ProgramVersion& programVersion,
@@ -125,7 +165,38 @@ public:
     void resetCompilationStats() { mCompilationStats = {}; }
 
 private:
-    SlangCompileRequest* createSlangCompileRequest(const Program& program) const;
+    /**
+     * Global settings affecting program version compilation.
+     * These are captured when a compilation is started, as they may change while compiling in the background.
+     */
+    struct CompileSettings
+    {
+        Program::DefineList globalDefineList;
+        ForcedCompilerFlags forcedCompilerFlags;
+        bool generateDebugInfo = false;
+    };
+
+    using PrewarmTask = std::function<void(slang::IGlobalSession*, const std::shared_ptr<std::mutex>&)>;
+
+    CompileSettings getCompileSettings() const;
+
+    Program::CompiledVersion compileProgramVersion(
+        const Program& program,
+        const Program::DefineList& defineList,
+        const CompileSettings& settings,
+        slang::IGlobalSession* pSlangGlobalSession
+    ) const;
+
+    SlangCompileRequest* createSlangCompileRequest(
+        const Program& program,
+        const Program::DefineList& defineList,
+        const CompileSettings& settings,
+        slang::IGlobalSession* pSlangGlobalSession,
+        std::string& log
+    ) const;
+
+    void queuePrewarmVersions(const Program& program);
+    void runPrewarmWorker();
 
     std::weak_ptr<Device> mpDevice;
 
@@ -137,6 +208,18 @@ private:
     ForcedCompilerFlags mForcedCompilerFlags;
 
     mutable uint32_t mHitGroupID = 0;
+    mutable std::mutex mStatsMutex; ///< Protects the compilation stats, which are updated from background threads.
+
+    // Prewarming. The recorded versions are stored per program, keyed by Program::getPrewarmKey().
+    std::filesystem::path mPrewarmPath;
+    std::map<std::string, std::vector<Program::DefineList>> mPrewarmList;  ///< Versions recorded in an earlier session.
+    std::map<std::string, std::set<Program::DefineList>> mRecordedVersions; ///< Versions used in this session.
+    uint32_t mPrewarmThreadCount = 0;
+    std::vector<std::thread> mPrewarmThreads;
+    std::mutex mPrewarmMutex;
+    std::condition_variable mPrewarmCondition;
+    std::deque<PrewarmTask> mPrewarmTasks;
+    bool mPrewarmTerminate = false;
 };
 
 } // namespace Falcor
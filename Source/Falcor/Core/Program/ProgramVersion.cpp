@@ -168,7 +168,7 @@ const Shader* ProgramKernels::getShader(ShaderType type) const
 }
 
 ProgramVersion::ProgramVersion(Program* pProgram, slang::IComponentType* pSlangGlobalScope)
-    : mpProgram(pProgram->shared_from_this()), mpSlangGlobalScope(pSlangGlobalScope)
+    : mpProgram(pProgram->weak_from_this()), mpSlangGlobalScope(pSlangGlobalScope)
 {
     FALCOR_ASSERT(pProgram);
 }
@@ -32,6 +32,7 @@
 #include "Core/API/Shader.h"
 #include "Core/API/Handles.h"
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -229,6 +230,9 @@ protected:
     ComPtr<slang::IComponentType> mpSlangGlobalScope;
     std::vector<ComPtr<slang::IComponentType>> mpSlangEntryPoints;
 
+    // Lock for the Slang global session if the version was compiled on a background thread, see ProgramManager::enablePrewarming().
+    std::shared_ptr<std::mutex> mpSlangMutex;
+
     // Cached version of compiled kernels for this program version
     mutable std::unordered_map<std::string, ProgramKernels::SharedPtr> mpKernels;
 };
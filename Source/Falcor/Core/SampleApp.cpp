@@ -121,6 +121,11 @@ SampleApp::SampleApp(const SampleAppConfig& config)
             {Shader::CompilerFlags::FloatingPointModePrecise, Shader::CompilerFlags::FloatingPointModeFast}
         );
     }
+    if (config.prewarmShaders)
+    {
+        auto path = getAppDataDirectory() / "NVIDIA/Falcor/ShaderPrewarm" / (getExecutableName() + ".json");
+        mpDevice->getProgramManager()->enablePrewarming(path);
+    }
 
     // Init the UI
     initUI();
@@ -67,6 +67,7 @@ struct SampleAppConfig
 
     bool generateShaderDebugInfo = false;
     bool shaderPreciseFloat = false;
+    bool prewarmShaders = false; ///< Record program versions and compile them in the background on the next start.
 };
 
 /**
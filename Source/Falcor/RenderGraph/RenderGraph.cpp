@@ -95,6 +95,7 @@ namespace Falcor
         for (auto& it : mNodeData)
         {
             it.second.pPass->setScene(mpDevice->getRenderContext(), pScene);
+            mDirtyPasses.insert(it.second.pPass.get());
         }
         mRecompile = true;
     }
@@ -114,7 +115,7 @@ namespace Falcor
             mNameToIndex[passName] = passIndex;
         }
 
-        pPass->mPassChangedCB = [this]() { mRecompile = true; };
+        pPass->mPassChangedCB = [this, pPass = pPass.get()]() { mRecompile = true; mDirtyPasses.insert(pPass); };
         pPass->mName = passName;
 
         if (mpScene) pPass->setScene(mpDevice->getRenderContext(), mpScene);
@@ -181,7 +182,7 @@ namespace Falcor
         std::string passTypeName = pOldPass->getType();
         auto pPass = RenderPass::create(passTypeName, mpDevice, dict);
         pPassIt->second.pPass = pPass;
-        pPass->mPassChangedCB = [this]() { mRecompile = true; };
+        pPass->mPassChangedCB = [this, pPass = pPass.get()]() { mRecompile = true; mDirtyPasses.insert(pPass); };
         pPass->mName = pOldPass->getName();
 
         if (mpScene) pPass->setScene(mpDevice->getRenderContext(), mpScene);
@@ -422,12 +423,15 @@ namespace Falcor
     bool RenderGraph::compile(RenderContext* pRenderContext, std::string& log)
     {
         if (!mRecompile) return true;
-        mpExe = nullptr;
+
+        // Keep the previous state alive during compilation, so unchanged passes and resources can be reused.
+        auto pPreviousExe = std::move(mpExe);
 
         try
         {
-            mpExe = RenderGraphCompiler::compile(*this, pRenderContext, mCompilerDeps);
+            mpExe = RenderGraphCompiler::compile(*this, pRenderContext, mCompilerDeps, pPreviousExe.get());
             mRecompile = false;
+            mDirtyPasses.clear();
             return true;
         }
         catch (const std::exception& e)
@@ -676,6 +680,18 @@ namespace Falcor
             src.getSampleCount() == dst.getSampleCount();
     }
 
+    void RenderGraph::setResourceAliasingEnabled(bool enabled)
+    {
+        if (mCompilerDeps.defaultResourceProps.aliasResources == enabled) return;
+        mCompilerDeps.defaultResourceProps.aliasResources = enabled;
+        mRecompile = true;
+    }
+
+    ResourceCache::AliasingStats RenderGraph::getResourceAliasingStats() const
+    {
+        return mpExe ? mpExe->getResourceAliasingStats() : ResourceCache::AliasingStats();
+    }
+
     void RenderGraph::renderUI(RenderContext* pRenderContext, Gui::Widgets& widget)
     {
         if (mpExe) mpExe->renderUI(pRenderContext, widget);
@@ -731,6 +747,7 @@ namespace Falcor
         };
         renderGraph.def_static("createFromFile", createFromFile, "path"_a); // PYTHONDEPRECATED
         renderGraph.def_property("name", &RenderGraph::getName, &RenderGraph::setName);
+        renderGraph.def_property("resourceAliasing", &RenderGraph::isResourceAliasingEnabled, &RenderGraph::setResourceAliasingEnabled);
         renderGraph.def(RenderGraphIR::kAddPass, &RenderGraph::addPass, "pass_"_a, "name"_a);
         renderGraph.def(RenderGraphIR::kRemovePass, &RenderGraph::removePass, "name"_a);
         renderGraph.def(RenderGraphIR::kAddEdge, &RenderGraph::addEdge, "src"_a, "dst"_a);
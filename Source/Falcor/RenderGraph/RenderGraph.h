@@ -248,6 +248,19 @@ namespace Falcor
         */
         void setName(const std::string& name) { mName = name; }
 
+        /** Enable/disable sharing of allocations between graph-owned resources with disjoint lifetimes.
+            Changing the setting triggers a recompilation of the graph.
+        */
+        void setResourceAliasingEnabled(bool enabled);
+
+        /** Check if graph-owned resources with disjoint lifetimes share allocations.
+        */
+        bool isResourceAliasingEnabled() const { return mCompilerDeps.defaultResourceProps.aliasResources; }
+
+        /** Get statistics on the resource aliasing done during the last compilation.
+        */
+        ResourceCache::AliasingStats getResourceAliasingStats() const;
+
         /** Compile the graph.
         */
         bool compile(RenderContext* pRenderContext, std::string& log);
@@ -306,6 +319,7 @@ namespace Falcor
         RenderGraphExe::SharedPtr mpExe;                            ///< Helper for allocating resources and executing the graph.
         RenderGraphCompiler::Dependencies mCompilerDeps;            ///< Data needed by the graph compiler.
         bool mRecompile = false;                                    ///< Set to true to trigger a recompilation after any graph changes (topology/scene/size/passes/etc.)
+        std::unordered_set<const RenderPass*> mDirtyPasses;        ///< Passes that requested a recompile, or need one for other reasons than a change of their compilation data.
 
         friend class RenderGraphUI;
         friend class RenderGraphExporter;
@@ -41,15 +41,23 @@ namespace Falcor
         }
     }
 
-    RenderGraphCompiler::RenderGraphCompiler(RenderGraph& graph, const Dependencies& dependencies)
+    RenderGraphCompiler::RenderGraphCompiler(RenderGraph& graph, const Dependencies& dependencies, const RenderGraphExe* pPrevious)
         : mGraph(graph)
         , mpDevice(graph.getDevice())
         , mDependencies(dependencies)
+        , mpPrevious(pPrevious)
     {}
 
-    RenderGraphExe::SharedPtr RenderGraphCompiler::compile(RenderGraph& graph, RenderContext* pRenderContext, const Dependencies& dependencies)
+    bool RenderGraphCompiler::isCompileDataEqual(const RenderPass::CompileData& lhs, const RenderPass::CompileData& rhs)
     {
-        RenderGraphCompiler c = RenderGraphCompiler(graph, dependencies);
+        return lhs.defaultTexDims == rhs.defaultTexDims &&
+            lhs.defaultTexFormat == rhs.defaultTexFormat &&
+            lhs.connectedResources == rhs.connectedResources;
+    }
+
+    RenderGraphExe::SharedPtr RenderGraphCompiler::compile(RenderGraph& graph, RenderContext* pRenderContext, const Dependencies& dependencies, const RenderGraphExe* pPrevious)
+    {
+        RenderGraphCompiler c = RenderGraphCompiler(graph, dependencies, pPrevious);
 
         // Register the external resources
         auto pResourcesCache = ResourceCache::create();
@@ -70,6 +78,8 @@ namespace Falcor
         }
         c.restoreCompilationChanges();
         pExe->mpResourceCache = pResourcesCache;
+        pExe->mPassCompileData = std::move(c.mPassCompileData);
+        pExe->mCompiledPassCount = c.mCompiledPassCount;
         return pExe;
     }
 
@@ -244,13 +254,6 @@ namespace Falcor
 
     void RenderGraphCompiler::allocateResources(Device* pDevice, ResourceCache* pResourceCache)
     {
-        // Build list to look up execution order index from the pass
-        std::unordered_map<RenderPass*, uint32_t> passToIndex;
-        for (size_t i = 0; i < mExecutionList.size(); i++)
-        {
-            passToIndex.emplace(mExecutionList[i].pPass.get(), uint32_t(i));
-        }
-
         for (size_t i = 0; i < mExecutionList.size(); i++)
         {
             uint32_t nodeIndex = mExecutionList[i].index;
@@ -312,13 +315,13 @@ namespace Falcor
                 std::string srcFieldName = mGraph.mNodeData[pEdge->getSourceNode()].name + '.' + edgeData.srcField;
                 std::string dstFieldName = mGraph.mNodeData[nodeIndex].name + '.' + dstField.getName();
 
-                const auto& pSrcPass = mGraph.mNodeData[pEdge->getSourceNode()].pPass.get();
-                const auto& srcReflection = mExecutionList[passToIndex.at(pSrcPass)].reflector;
-                pResourceCache->registerField(dstFieldName, dstField, passToIndex[pSrcPass], srcFieldName);
+                // The resource lifetime is extended to the consuming pass
+                pResourceCache->registerField(dstFieldName, dstField, uint32_t(i), srcFieldName);
             }
         }
 
-        pResourceCache->allocateResources(pDevice, mDependencies.defaultResourceProps);
+        const ResourceCache* pPreviousCache = mpPrevious ? mpPrevious->mpResourceCache.get() : nullptr;
+        pResourceCache->allocateResources(pDevice, mDependencies.defaultResourceProps, pPreviousCache);
     }
 
 
@@ -405,6 +408,17 @@ namespace Falcor
         return compileData;
     }
 
+    bool RenderGraphCompiler::needsCompilation(const PassData& passData, const RenderPass::CompileData& compileData) const
+    {
+        const RenderPass* pPass = passData.pPass.get();
+        if (mpPrevious == nullptr || mGraph.mDirtyPasses.count(pPass) > 0) return true;
+
+        // The previous state holds references to its passes, so a pass found there is the same object and not a new one at a reused address.
+        auto it = mpPrevious->mPassCompileData.find(pPass);
+        if (it == mpPrevious->mPassCompileData.end()) return true;
+        return !isCompileDataEqual(it->second, compileData);
+    }
+
     void RenderGraphCompiler::compilePasses(RenderContext* pRenderContext)
     {
         while(1)
@@ -413,15 +427,22 @@ namespace Falcor
             bool success = true;
             for (auto& p : mExecutionList)
             {
-                try
-                {
-                    p.pPass->compile(pRenderContext, prepPassCompilationData(p));
-                }
-                catch (const std::exception& e)
+                auto compileData = prepPassCompilationData(p);
+                if (needsCompilation(p, compileData))
                 {
-                    log += std::string(e.what()) + "\n";
-                    success = false;
+                    try
+                    {
+                        p.pPass->compile(pRenderContext, compileData);
+                        mCompiledPassCount++;
+                    }
+                    catch (const std::exception& e)
+                    {
+                        log += std::string(e.what()) + "\n";
+                        success = false;
+                        continue;
+                    }
                 }
+                mPassCompileData[p.pPass.get()] = std::move(compileData);
             }
 
             if (success) return;
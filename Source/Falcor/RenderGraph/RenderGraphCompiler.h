@@ -32,6 +32,7 @@
 #include "RenderGraphExe.h"
 #include "Core/Macros.h"
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -47,14 +48,31 @@ namespace Falcor
             ResourceCache::DefaultProperties defaultResourceProps;
             ResourceCache::ResourcesMap externalResources;
         };
-        static RenderGraphExe::SharedPtr compile(RenderGraph& graph, RenderContext* pRenderContext, const Dependencies& dependencies);
+
+        /** Compile a render graph.
+            If the previously compiled state of the graph is given, the compilation is incremental: only passes whose compilation data
+            changed (or that requested a recompile) are recompiled, and resources whose description did not change are reused.
+            \param[in] graph The render graph.
+            \param[in] pRenderContext The render context.
+            \param[in] dependencies External dependencies of the graph.
+            \param[in] pPrevious Optional. The previously compiled state of the same graph.
+            \return The compiled graph.
+        */
+        static RenderGraphExe::SharedPtr compile(RenderGraph& graph, RenderContext* pRenderContext, const Dependencies& dependencies, const RenderGraphExe* pPrevious = nullptr);
+
+        /** Check if two sets of compilation data are equal. Passes compiled with equal data do not need to be recompiled.
+        */
+        static bool isCompileDataEqual(const RenderPass::CompileData& lhs, const RenderPass::CompileData& rhs);
 
     private:
-        RenderGraphCompiler(RenderGraph& graph, const Dependencies& dependencies);
+        RenderGraphCompiler(RenderGraph& graph, const Dependencies& dependencies, const RenderGraphExe* pPrevious);
 
         RenderGraph& mGraph;
         std::shared_ptr<Device> mpDevice;
         const Dependencies& mDependencies;
+        const RenderGraphExe* mpPrevious;
+        std::unordered_map<const RenderPass*, RenderPass::CompileData> mPassCompileData;
+        uint32_t mCompiledPassCount = 0;
 
         struct PassData
         {
@@ -79,5 +97,6 @@ namespace Falcor
         void validateGraph() const;
         void restoreCompilationChanges();
         RenderPass::CompileData prepPassCompilationData(const PassData& passData);
+        bool needsCompilation(const PassData& passData, const RenderPass::CompileData& compileData) const;
     };
 }
@@ -36,6 +36,7 @@
 #include "Utils/InternalDictionary.h"
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Falcor
@@ -89,6 +90,15 @@ namespace Falcor
         */
         void setInput(const std::string& name, const Resource::SharedPtr& pResource);
 
+        /** Get statistics on the resource aliasing done when allocating the graph resources.
+        */
+        const ResourceCache::AliasingStats& getResourceAliasingStats() const { return mpResourceCache->getAliasingStats(); }
+
+        /** Get the number of passes whose compile() function was called when this object was compiled.
+            Passes whose compilation data did not change since the previous compilation of the graph are not recompiled.
+        */
+        uint32_t getCompiledPassCount() const { return mCompiledPassCount; }
+
     private:
         friend class RenderGraphCompiler;
         static SharedPtr create() { return SharedPtr(new RenderGraphExe); }
@@ -107,5 +117,7 @@ namespace Falcor
 
         std::vector<Pass> mExecutionList;
         ResourceCache::SharedPtr mpResourceCache;
+        std::unordered_map<const RenderPass*, RenderPass::CompileData> mPassCompileData; ///< Data each pass was last compiled with. Used for incremental recompilation.
+        uint32_t mCompiledPassCount = 0;
     };
 }
@@ -150,6 +150,8 @@ namespace Falcor
         virtual RenderPassReflection reflect(const CompileData& compileData) = 0;
 
         /** Will be called during graph compilation. You should throw an exception in case the compilation failed
+            Graph recompilation is incremental: the function is only called again if the compilation data changed, the pass requested
+            a recompile, or a new scene was set.
         */
         virtual void compile(RenderContext* pRenderContext, const CompileData& compileData) {}
 
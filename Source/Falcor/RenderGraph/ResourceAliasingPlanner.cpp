@@ -0,0 +1,143 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "ResourceAliasingPlanner.h"
+#include "Core/API/Resource.h"
+#include "Core/Platform/OS.h"
+#include "Utils/Math/Common.h"
+#include <algorithm>
+#include <numeric>
+
+namespace Falcor
+{
+    bool ResourceAliasingPlanner::ResourceDesc::operator==(const ResourceDesc& other) const
+    {
+        return type == other.type &&
+            width == other.width &&
+            height == other.height &&
+            depth == other.depth &&
+            arraySize == other.arraySize &&
+            mipLevels == other.mipLevels &&
+            sampleCount == other.sampleCount &&
+            format == other.format &&
+            bindFlags == other.bindFlags;
+    }
+
+    uint64_t ResourceAliasingPlanner::ResourceDesc::getSizeInBytes() const
+    {
+        using Type = RenderPassReflection::Field::Type;
+
+        if (type == Type::RawBuffer) return width;
+        if (format == ResourceFormat::Unknown) return 0;
+
+        uint32_t w = std::max(width, 1u);
+        uint32_t h = (type == Type::Texture1D) ? 1 : std::max(height, 1u);
+        uint32_t d = (type == Type::Texture3D) ? std::max(depth, 1u) : 1;
+
+        uint32_t mipCount = mipLevels;
+        uint32_t fullMipCount = bitScanReverse(std::max({ w, h, d })) + 1;
+        if (mipCount == Resource::kMaxPossible || mipCount > fullMipCount) mipCount = fullMipCount;
+        mipCount = std::max(mipCount, 1u);
+
+        const uint32_t blockWidth = getFormatWidthCompressionRatio(format);
+        const uint32_t blockHeight = getFormatHeightCompressionRatio(format);
+        const uint64_t bytesPerBlock = getFormatBytesPerBlock(format);
+
+        uint64_t size = 0;
+        for (uint32_t mip = 0; mip < mipCount; mip++)
+        {
+            uint64_t mipWidth = div_round_up(std::max(w >> mip, 1u), blockWidth);
+            uint64_t mipHeight = div_round_up(std::max(h >> mip, 1u), blockHeight);
+            uint64_t mipDepth = std::max(d >> mip, 1u);
+            size += mipWidth * mipHeight * mipDepth * bytesPerBlock;
+        }
+
+        uint64_t layerCount = std::max(arraySize, 1u);
+        if (type == Type::TextureCube) layerCount *= 6;
+        return size * layerCount * std::max(sampleCount, 1u);
+    }
+
+    ResourceAliasingPlanner::Plan ResourceAliasingPlanner::plan(const std::vector<Request>& requests)
+    {
+        Plan plan;
+        plan.allocationIndices.resize(requests.size());
+
+        // Sweep over the requests in order of increasing start time.
+        std::vector<uint32_t> order(requests.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+        {
+            return requests[a].lifetime.first < requests[b].lifetime.first;
+        });
+
+        struct Allocation
+        {
+            uint32_t request;   // First request assigned to the allocation, holds the description.
+            uint32_t lastUse;   // Last time point at which the allocation is in use.
+            bool aliasable;
+        };
+        std::vector<Allocation> allocations;
+
+        for (uint32_t r : order)
+        {
+            const auto& request = requests[r];
+            plan.stats.requestedBytes += request.desc.getSizeInBytes();
+
+            // Find a compatible allocation that is free at the start of the request.
+            // If several are free, pick the one that became free last to keep the others available for longer.
+            uint32_t allocationIndex = uint32_t(-1);
+            if (request.aliasable)
+            {
+                for (uint32_t a = 0; a < (uint32_t)allocations.size(); a++)
+                {
+                    const auto& allocation = allocations[a];
+                    if (!allocation.aliasable || allocation.lastUse >= request.lifetime.first) continue;
+                    if (requests[allocation.request].desc != request.desc) continue;
+                    if (allocationIndex == uint32_t(-1) || allocation.lastUse > allocations[allocationIndex].lastUse) allocationIndex = a;
+                }
+            }
+
+            if (allocationIndex == uint32_t(-1))
+            {
+                allocationIndex = (uint32_t)allocations.size();
+                allocations.push_back({ r, request.lifetime.second, request.aliasable });
+                plan.allocationRequests.push_back(r);
+                plan.stats.allocatedBytes += request.desc.getSizeInBytes();
+            }
+            else
+            {
+                allocations[allocationIndex].lastUse = std::max(allocations[allocationIndex].lastUse, request.lifetime.second);
+            }
+
+            plan.allocationIndices[r] = allocationIndex;
+        }
+
+        plan.stats.resourceCount = (uint32_t)requests.size();
+        plan.stats.allocationCount = (uint32_t)allocations.size();
+        return plan;
+    }
+}
@@ -0,0 +1,102 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "RenderPassReflection.h"
+#include "Core/Macros.h"
+#include "Core/API/Formats.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Falcor
+{
+    /** Plans how graph-owned resources with disjoint lifetimes share allocations.
+
+        Each request describes a fully resolved resource and the range of execution order indices in which it is used.
+        Requests with identical descriptions whose lifetimes do not overlap are packed into the same allocation.
+        For each description this is an interval graph coloring, which is solved optimally by a greedy sweep over the
+        requests sorted by start time.
+
+        The planner does not create any resources and can be used without a device.
+    */
+    class FALCOR_API ResourceAliasingPlanner
+    {
+    public:
+        /** Fully resolved description of a resource. Two requests can only share an allocation if their descriptions are equal.
+        */
+        struct ResourceDesc
+        {
+            RenderPassReflection::Field::Type type = RenderPassReflection::Field::Type::Texture2D;
+            uint32_t width = 0;                                 ///< Width in texels, or size in bytes for raw buffers.
+            uint32_t height = 1;
+            uint32_t depth = 1;
+            uint32_t arraySize = 1;
+            uint32_t mipLevels = 1;                             ///< Mip count. Resource::kMaxPossible means the full mip chain.
+            uint32_t sampleCount = 1;
+            ResourceFormat format = ResourceFormat::Unknown;
+            ResourceBindFlags bindFlags = ResourceBindFlags::None;
+
+            bool operator==(const ResourceDesc& other) const;
+            bool operator!=(const ResourceDesc& other) const { return !(*this == other); }
+
+            /** Get an estimate of the memory footprint of the resource. Alignment and padding are ignored.
+            */
+            uint64_t getSizeInBytes() const;
+        };
+
+        struct Request
+        {
+            ResourceDesc desc;
+            std::pair<uint32_t, uint32_t> lifetime;             ///< Inclusive range of execution order indices in which the resource is used.
+            bool aliasable = true;                              ///< If false, the request is always assigned a dedicated allocation.
+        };
+
+        struct Stats
+        {
+            uint32_t resourceCount = 0;                         ///< Number of requested resources.
+            uint32_t allocationCount = 0;                       ///< Number of allocations after aliasing.
+            uint64_t requestedBytes = 0;                        ///< Total size of all requested resources.
+            uint64_t allocatedBytes = 0;                        ///< Total size of all allocations.
+
+            uint64_t getSavedBytes() const { return requestedBytes - allocatedBytes; }
+        };
+
+        struct Plan
+        {
+            std::vector<uint32_t> allocationIndices;            ///< Allocation index for each request.
+            std::vector<uint32_t> allocationRequests;           ///< Index of the first request assigned to each allocation.
+            Stats stats;
+        };
+
+        /** Compute an aliasing plan.
+            \param[in] requests List of resource requests.
+            \return The plan, with one allocation index per request.
+        */
+        static Plan plan(const std::vector<Request>& requests);
+    };
+}
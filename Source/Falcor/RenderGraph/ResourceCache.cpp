@@ -30,6 +30,7 @@
 #include "Core/API/Texture.h"
 #include "Core/API/Buffer.h"
 #include "Utils/Logger.h"
+#include <unordered_set>
 
 namespace Falcor
 {
@@ -42,6 +43,8 @@ namespace Falcor
     {
         mNameToIndex.clear();
         mResourceData.clear();
+        mAliasingStats = {};
+        mReusedResourceCount = 0;
     }
 
     const Resource::SharedPtr& ResourceCache::getResource(const std::string& name) const
@@ -88,6 +91,14 @@ namespace Falcor
         range.second = std::max(range.second, newTime);
     }
 
+    inline bool isAliasable(const RenderPassReflection::Field& field, uint32_t timePoint)
+    {
+        // Internal resources may carry data across frames (e.g. history buffers) and graph outputs are read after the graph executed.
+        if (is_set(field.getVisibility(), RenderPassReflection::Field::Visibility::Internal)) return false;
+        if (is_set(field.getFlags(), RenderPassReflection::Field::Flags::Persistent)) return false;
+        return timePoint != uint32_t(-1);
+    }
+
     void ResourceCache::registerField(const std::string& name, const RenderPassReflection::Field& field, uint32_t timePoint, const std::string& alias)
     {
         FALCOR_ASSERT(mNameToIndex.find(name) == mNameToIndex.end());
@@ -104,7 +115,7 @@ namespace Falcor
             FALCOR_ASSERT(mNameToIndex.count(name) == 0);
             mNameToIndex[name] = (uint32_t)mResourceData.size();
             bool resolveBindFlags = (field.getBindFlags() == ResourceBindFlags::None);
-            mResourceData.push_back({ field, {timePoint, timePoint}, nullptr, resolveBindFlags, name });
+            mResourceData.push_back({ field, {timePoint, timePoint}, nullptr, resolveBindFlags, name, isAliasable(field, timePoint), {} });
         }
         else // Add alias
         {
@@ -114,19 +125,22 @@ namespace Falcor
             mergeTimePoint(mResourceData[index].lifetime, timePoint);
             mResourceData[index].pResource = nullptr;
             mResourceData[index].resolveBindFlags = mResourceData[index].resolveBindFlags || (field.getBindFlags() == ResourceBindFlags::None);
+            mResourceData[index].aliasable = mResourceData[index].aliasable && isAliasable(field, timePoint);
         }
     }
 
-    inline Resource::SharedPtr createResourceForPass(Device* pDevice, const ResourceCache::DefaultProperties& params, const RenderPassReflection::Field& field, bool resolveBindFlags, const std::string& resourceName)
+    inline ResourceAliasingPlanner::ResourceDesc resolveResourceDesc(Device* pDevice, const ResourceCache::DefaultProperties& params, const RenderPassReflection::Field& field, bool resolveBindFlags)
     {
-        uint32_t width = field.getWidth() ? field.getWidth() : params.dims.x;
-        uint32_t height = field.getHeight() ? field.getHeight() : params.dims.y;
-        uint32_t depth = field.getDepth() ? field.getDepth() : 1;
-        uint32_t sampleCount = field.getSampleCount() ? field.getSampleCount() : 1;
-        auto bindFlags = field.getBindFlags();
-        auto arraySize = field.getArraySize();
-        auto mipLevels = field.getMipCount();
+        ResourceAliasingPlanner::ResourceDesc desc;
+        desc.type = field.getType();
+        desc.width = field.getWidth() ? field.getWidth() : params.dims.x;
+        desc.height = field.getHeight() ? field.getHeight() : params.dims.y;
+        desc.depth = field.getDepth() ? field.getDepth() : 1;
+        desc.sampleCount = field.getSampleCount() ? field.getSampleCount() : 1;
+        desc.arraySize = field.getArraySize();
+        desc.mipLevels = field.getMipCount();
 
+        auto bindFlags = field.getBindFlags();
         ResourceFormat format = ResourceFormat::Unknown;
 
         if (field.getType() != RenderPassReflection::Field::Type::RawBuffer)
@@ -147,31 +161,39 @@ namespace Falcor
         {
             if (resolveBindFlags) bindFlags = Resource::BindFlags::UnorderedAccess | Resource::BindFlags::ShaderResource;
         }
+
+        desc.format = format;
+        desc.bindFlags = bindFlags;
+        return desc;
+    }
+
+    inline Resource::SharedPtr createResource(Device* pDevice, const ResourceAliasingPlanner::ResourceDesc& desc, const std::string& resourceName)
+    {
         Resource::SharedPtr pResource;
 
-        switch (field.getType())
+        switch (desc.type)
         {
         case RenderPassReflection::Field::Type::RawBuffer:
-            pResource = Buffer::create(pDevice, width, bindFlags, Buffer::CpuAccess::None);
+            pResource = Buffer::create(pDevice, desc.width, desc.bindFlags, Buffer::CpuAccess::None);
             break;
         case RenderPassReflection::Field::Type::Texture1D:
-            pResource = Texture::create1D(pDevice, width, format, arraySize, mipLevels, nullptr, bindFlags);
+            pResource = Texture::create1D(pDevice, desc.width, desc.format, desc.arraySize, desc.mipLevels, nullptr, desc.bindFlags);
             break;
         case RenderPassReflection::Field::Type::Texture2D:
-            if (sampleCount > 1)
+            if (desc.sampleCount > 1)
             {
-                pResource = Texture::create2DMS(pDevice, width, height, format, sampleCount, arraySize, bindFlags);
+                pResource = Texture::create2DMS(pDevice, desc.width, desc.height, desc.format, desc.sampleCount, desc.arraySize, desc.bindFlags);
             }
             else
             {
-                pResource = Texture::create2D(pDevice, width, height, format, arraySize, mipLevels, nullptr, bindFlags);
+                pResource = Texture::create2D(pDevice, desc.width, desc.height, desc.format, desc.arraySize, desc.mipLevels, nullptr, desc.bindFlags);
             }
             break;
         case RenderPassReflection::Field::Type::Texture3D:
-            pResource = Texture::create3D(pDevice, width, height, depth, format, mipLevels, nullptr, bindFlags);
+            pResource = Texture::create3D(pDevice, desc.width, desc.height, desc.depth, desc.format, desc.mipLevels, nullptr, desc.bindFlags);
             break;
         case RenderPassReflection::Field::Type::TextureCube:
-            pResource = Texture::createCube(pDevice, width, height, format, arraySize, mipLevels, nullptr, bindFlags);
+            pResource = Texture::createCube(pDevice, desc.width, desc.height, desc.format, desc.arraySize, desc.mipLevels, nullptr, desc.bindFlags);
             break;
         default:
             FALCOR_UNREACHABLE();
@@ -181,14 +203,73 @@ namespace Falcor
         return pResource;
     }
 
-    void ResourceCache::allocateResources(Device* pDevice, const DefaultProperties& params)
+    void ResourceCache::allocateResources(Device* pDevice, const DefaultProperties& params, const ResourceCache* pPrevious)
     {
-        for (auto& data : mResourceData)
+        // Collect the resources that need to be created and plan which of them can share an allocation.
+        std::vector<uint32_t> pending;
+        std::vector<ResourceAliasingPlanner::Request> requests;
+        for (uint32_t i = 0; i < (uint32_t)mResourceData.size(); i++)
         {
+            auto& data = mResourceData[i];
             if ((data.pResource == nullptr) && (data.field.isValid()))
             {
-                data.pResource = createResourceForPass(pDevice, params, data.field, data.resolveBindFlags, data.name);
+                data.desc = resolveResourceDesc(pDevice, params, data.field, data.resolveBindFlags);
+                pending.push_back(i);
+                requests.push_back({ data.desc, data.lifetime, params.aliasResources && data.aliasable });
             }
         }
+
+        mReusedResourceCount = 0;
+        if (pending.empty()) return;
+
+        auto plan = ResourceAliasingPlanner::plan(requests);
+
+        std::vector<std::vector<uint32_t>> allocationMembers(plan.allocationRequests.size());
+        for (uint32_t r = 0; r < (uint32_t)pending.size(); r++) allocationMembers[plan.allocationIndices[r]].push_back(r);
+
+        // Take over a resource from the previous cache if one of the members of the allocation was created with the same description.
+        // Each previous resource is reused at most once, as it may have been shared by resources that no longer share an allocation.
+        std::unordered_set<const Resource*> reusedResources;
+        auto findPreviousResource = [&](const ResourceData& data) -> Resource::SharedPtr
+        {
+            if (!pPrevious) return nullptr;
+            auto it = pPrevious->mNameToIndex.find(data.name);
+            if (it == pPrevious->mNameToIndex.end()) return nullptr;
+            const auto& prevData = pPrevious->mResourceData[it->second];
+            if (!prevData.pResource || prevData.desc != data.desc || reusedResources.count(prevData.pResource.get())) return nullptr;
+            return prevData.pResource;
+        };
+
+        std::vector<Resource::SharedPtr> allocations(plan.allocationRequests.size());
+        for (size_t a = 0; a < allocations.size(); a++)
+        {
+            for (uint32_t r : allocationMembers[a])
+            {
+                if ((allocations[a] = findPreviousResource(mResourceData[pending[r]]))) break;
+            }
+
+            if (allocations[a])
+            {
+                reusedResources.insert(allocations[a].get());
+                mReusedResourceCount++;
+            }
+            else
+            {
+                uint32_t r = plan.allocationRequests[a];
+                allocations[a] = createResource(pDevice, requests[r].desc, mResourceData[pending[r]].name);
+            }
+        }
+
+        for (size_t r = 0; r < pending.size(); r++)
+        {
+            mResourceData[pending[r]].pResource = allocations[plan.allocationIndices[r]];
+        }
+
+        mAliasingStats = plan.stats;
+        if (mAliasingStats.allocationCount < mAliasingStats.resourceCount)
+        {
+            logDebug("ResourceCache: {} resources share {} allocations, saving {:.1f} MB.",
+                mAliasingStats.resourceCount, mAliasingStats.allocationCount, mAliasingStats.getSavedBytes() / (1024.0 * 1024.0));
+        }
     }
 }
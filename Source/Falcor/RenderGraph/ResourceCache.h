@@ -27,6 +27,7 @@
  **************************************************************************/
 #pragma once
 #include "RenderPassReflection.h"
+#include "ResourceAliasingPlanner.h"
 #include "Core/Macros.h"
 #include "Core/API/fwd.h"
 #include "Core/API/Resource.h"
@@ -54,8 +55,11 @@ namespace Falcor
         {
             uint2 dims;                                         ///< Width, height of the swap chain
             ResourceFormat format = ResourceFormat::Unknown;    ///< Format to use for texture creation
+            bool aliasResources = true;                         ///< Share allocations between graph-owned resources with disjoint lifetimes
         };
 
+        using AliasingStats = ResourceAliasingPlanner::Stats;
+
         /** Add/Remove reference to a graph input resource not owned by the cache
             \param[in] name The resource's name
             \param[in] pResource The resource to register. If this is null, will unregister the resource
@@ -81,8 +85,22 @@ namespace Falcor
 
         /** Allocate all resources that need to be created/updated.
             This includes new resources, resources whose properties have been updated since last allocation call.
+            If resource aliasing is enabled, resources with compatible descriptions and disjoint lifetimes share the same allocation.
+            Internal, persistent and graph output resources are never shared.
+            \param[in] pDevice GPU device.
+            \param[in] params Default resource properties.
+            \param[in] pPrevious Optional. Cache of a previous compilation of the graph. Resources registered under the same name with an
+                unchanged description are taken from it instead of being created again.
+        */
+        void allocateResources(Device* pDevice, const DefaultProperties& params, const ResourceCache* pPrevious = nullptr);
+
+        /** Get statistics of the last call to allocateResources().
         */
-        void allocateResources(Device* pDevice, const DefaultProperties& params);
+        const AliasingStats& getAliasingStats() const { return mAliasingStats; }
+
+        /** Get the number of resources taken over from the previous cache in the last call to allocateResources().
+        */
+        uint32_t getReusedResourceCount() const { return mReusedResourceCount; }
 
         /** Clears all registered field/resource properties and allocated resources.
         */
@@ -98,6 +116,8 @@ namespace Falcor
             Resource::SharedPtr pResource;          // The resource
             bool resolveBindFlags;                  // Whether or not we should resolve the field's bind-flags before creating the resource
             std::string name;                       // Full name of the resource, including the pass name
+            bool aliasable;                         // Whether or not the resource can share its allocation with other resources
+            ResourceAliasingPlanner::ResourceDesc desc; // Resolved description the resource was created with
         };
 
         // Resources and properties for fields within (and therefore owned by) a render graph
@@ -106,6 +126,9 @@ namespace Falcor
 
         // References to output resources not to be allocated by the render graph
         ResourcesMap mExternalResources;
+
+        AliasingStats mAliasingStats;
+        uint32_t mReusedResourceCount = 0;
     };
 
 }
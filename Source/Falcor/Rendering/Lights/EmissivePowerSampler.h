@@ -30,7 +30,6 @@
 #include "Core/Macros.h"
 #include "Scene/Lights/LightCollection.h"
 #include <memory>
-#include <random>
 #include <vector>
 
 namespace Falcor
@@ -86,7 +85,6 @@ namespace Falcor
 
         LightCollection::SharedConstPtr mpLightCollection;
 
-        std::mt19937                    mAliasTableRng;
         AliasTable                      mTriangleTable;
     };
 }
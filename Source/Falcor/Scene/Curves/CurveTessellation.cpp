@@ -27,12 +27,17 @@
  **************************************************************************/
 #include "CurveTessellation.h"
 #include "Core/Assert.h"
+#include "Core/Errors.h"
 #include "Utils/Math/Common.h"
 #include "Utils/Math/MathHelpers.h"
 #include "Utils/Math/CubicSpline.h"
 #include "Utils/Math/Matrix/Matrix.h"
+#include "Utils/NumericRange.h"
 #include <glm/gtx/quaternion.hpp>
+#include <algorithm>
 #include <cmath>
+#include <execution>
+#include <limits>
 
 namespace Falcor
 {
@@ -74,6 +79,9 @@ namespace Falcor
         // To achieve curveWidth on average, however, we need to scale the initial curveWidth by 1.11 (the number was deducted numerically).
         const float kMeshCompensationScale = 1.11f;
 
+        // Number of strands tessellated by each parallel task.
+        const uint32_t kStrandsPerBatch = 256;
+
         float4 transformSphere(const rmcv::mat4& xform, const float4& sphere)
         {
             // Spheres are represented as (center.x, center.y, center.z, radius).
@@ -191,7 +199,7 @@ namespace Falcor
             t = glm::rotate(rotQuat, t);
         }
 
-        void updateMeshResultBuffers(CurveTessellation::MeshResult& result, const CurveArrays& curveArrays, StrandArrays& optimizedStrandArrays, const float3& fwd, const float3& s, const float3& t, uint32_t pointCountPerCrossSection, const float& widthScale, uint32_t j)
+        void updateMeshResultBuffers(CurveTessellation::MeshResult& result, const CurveArrays& curveArrays, StrandArrays& optimizedStrandArrays, const float3& fwd, const float3& s, const float3& t, uint32_t pointCountPerCrossSection, const float& widthScale, uint32_t j, uint32_t meshVertexIndex)
         {
             // Mesh vertices, normals, tangents, and texCrds (if any).
             for (uint32_t k = 0; k < pointCountPerCrossSection; k++)
@@ -200,33 +208,124 @@ namespace Falcor
                 float3 vNormal = std::cos(phi) * s + std::sin(phi) * t;
 
                 float curveRadius = 0.5f * optimizedStrandArrays.widths[j];
-                result.vertices.push_back(optimizedStrandArrays.controlPoints[j] + curveRadius * vNormal);
-                result.normals.push_back(vNormal);
-                result.tangents.push_back(float4(fwd.x, fwd.y, fwd.z, 1));
-                result.radii.push_back(curveRadius);
+                uint32_t index = meshVertexIndex + k;
+                result.vertices[index] = optimizedStrandArrays.controlPoints[j] + curveRadius * vNormal;
+                result.normals[index] = vNormal;
+                result.tangents[index] = float4(fwd.x, fwd.y, fwd.z, 1);
+                result.radii[index] = curveRadius;
 
                 if (curveArrays.UVs)
                 {
-                    result.texCrds.push_back(optimizedStrandArrays.UVs[j]);
+                    result.texCrds[index] = optimizedStrandArrays.UVs[j];
                 }
             }
         }
 
-        void connectFaceVertices(CurveTessellation::MeshResult& result, uint32_t meshVertexOffset, uint32_t pointCountPerCrossSection, uint32_t quadCountLimit, uint32_t nextCrossSectionVertexOffset, uint32_t multiplier, uint32_t j)
+        void connectFaceVertices(CurveTessellation::MeshResult& result, uint32_t meshVertexOffset, uint32_t pointCountPerCrossSection, uint32_t quadCountLimit, uint32_t nextCrossSectionVertexOffset, uint32_t multiplier, uint32_t j, uint32_t faceIndex)
         {
             for (uint32_t k = 0; k < quadCountLimit; k++)
             {
-                result.faceVertexCounts.push_back(3);
-                result.faceVertexIndices.push_back(meshVertexOffset + multiplier * j * pointCountPerCrossSection + k);
-                result.faceVertexIndices.push_back(meshVertexOffset + multiplier * j * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection);
-                result.faceVertexIndices.push_back(meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection);
-
-                result.faceVertexCounts.push_back(3);
-                result.faceVertexIndices.push_back(meshVertexOffset + multiplier * j * pointCountPerCrossSection + k);
-                result.faceVertexIndices.push_back(meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection);
-                result.faceVertexIndices.push_back(meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + k);
+                uint32_t* pIndices = &result.faceVertexIndices[3 * (faceIndex + 2 * k)];
+
+                result.faceVertexCounts[faceIndex + 2 * k] = 3;
+                pIndices[0] = meshVertexOffset + multiplier * j * pointCountPerCrossSection + k;
+                pIndices[1] = meshVertexOffset + multiplier * j * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection;
+                pIndices[2] = meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection;
+
+                result.faceVertexCounts[faceIndex + 2 * k + 1] = 3;
+                pIndices[3] = meshVertexOffset + multiplier * j * pointCountPerCrossSection + k;
+                pIndices[4] = meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection;
+                pIndices[5] = meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + k;
             }
         }
+
+        /** Input and output offsets of the strands that are kept.
+            The output of each strand only depends on its own control points, so once the offsets are known the strands
+            can be tessellated in parallel into preallocated arrays, with the same result as tessellating them in order.
+        */
+        struct StrandLayout
+        {
+            uint32_t strandCount = 0;                   ///< Number of kept strands.
+            std::vector<uint32_t> inputOffsets;         ///< Offset of the first control point of each kept strand.
+            std::vector<uint32_t> outputOffsets;        ///< Offset of the first tessellated point of each kept strand. Has an extra entry holding the total point count.
+            uint32_t maxVertexCountPerStrand = 0;       ///< Maximum number of control points of a kept strand.
+
+            uint32_t getPointCount() const { return outputOffsets[strandCount]; }
+            uint32_t getSegmentCount() const { return getPointCount() - strandCount; }
+        };
+
+        StrandLayout computeStrandLayout(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand)
+        {
+            StrandLayout layout;
+            layout.strandCount = div_round_up(strandCount, keepOneEveryXStrands);
+            layout.inputOffsets.resize(layout.strandCount);
+            layout.outputOffsets.resize(layout.strandCount + 1);
+
+            // Control points of skipped strands still take up space in the input.
+            uint64_t pointOffset = 0;
+            for (uint32_t i = 0; i < strandCount; i++)
+            {
+                if (i % keepOneEveryXStrands == 0)
+                {
+                    layout.inputOffsets[i / keepOneEveryXStrands] = (uint32_t)pointOffset;
+                    layout.maxVertexCountPerStrand = std::max(layout.maxVertexCountPerStrand, vertexCountsPerStrand[i]);
+                }
+                pointOffset += vertexCountsPerStrand[i];
+            }
+            if (pointOffset > std::numeric_limits<uint32_t>::max()) throw RuntimeError("Curve has too many control points.");
+
+            // Count the tessellated points of each strand. Consecutive duplicate control points are removed before tessellation.
+            auto range = NumericRange<uint32_t>(0, layout.strandCount);
+            std::for_each(std::execution::par, range.begin(), range.end(), [&](uint32_t strand)
+            {
+                uint32_t vertexCount = vertexCountsPerStrand[strand * keepOneEveryXStrands];
+                const float3* pPoints = controlPoints + layout.inputOffsets[strand];
+                uint32_t uniqueCount = 1;
+                for (uint32_t j = 0; j < vertexCount - 1; j++)
+                {
+                    if (pPoints[j] != pPoints[j + 1]) uniqueCount++;
+                }
+                layout.outputOffsets[strand + 1] = div_round_up(subdivPerSegment * (uniqueCount - 1), keepOneEveryXVerticesPerStrand) + 1;
+            });
+
+            uint64_t outputOffset = 0;
+            for (uint32_t strand = 0; strand < layout.strandCount; strand++)
+            {
+                outputOffset += layout.outputOffsets[strand + 1];
+                if (outputOffset > std::numeric_limits<uint32_t>::max()) throw RuntimeError("Curve tessellation exceeds the supported number of points.");
+                layout.outputOffsets[strand + 1] = (uint32_t)outputOffset;
+            }
+
+            return layout;
+        }
+
+        /** Run a function over all kept strands in parallel. Strands are processed in batches sharing the per-strand scratch arrays.
+        */
+        template<typename Func>
+        void forEachStrand(const StrandLayout& layout, Func func)
+        {
+            auto batchRange = NumericRange<uint32_t>(0, div_round_up(layout.strandCount, kStrandsPerBatch));
+            std::for_each(std::execution::par, batchRange.begin(), batchRange.end(), [&](uint32_t batch)
+            {
+                StrandArrays strandArrays;
+                strandArrays.controlPoints.reserve(layout.maxVertexCountPerStrand);
+                strandArrays.widths.reserve(layout.maxVertexCountPerStrand);
+                strandArrays.UVs.reserve(layout.maxVertexCountPerStrand);
+                StrandArrays optimizedStrandArrays;
+                CubicSplineCache splineCache;
+
+                uint32_t end = std::min(layout.strandCount, (batch + 1) * kStrandsPerBatch);
+                for (uint32_t strand = batch * kStrandsPerBatch; strand < end; strand++)
+                {
+                    optimizedStrandArrays.controlPoints.clear();
+                    optimizedStrandArrays.UVs.clear();
+                    optimizedStrandArrays.widths.clear();
+                    optimizedStrandArrays.vertexCount = 0;
+
+                    func(strand, strandArrays, optimizedStrandArrays, splineCache);
+                }
+            });
+        }
     }
 
     CurveTessellation::SweptSphereResult CurveTessellation::convertToLinearSweptSphere(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t degree, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, const rmcv::mat4& xform)
@@ -238,44 +337,27 @@ namespace Falcor
         FALCOR_ASSERT(degree == 1);
         result.degree = degree;
 
-        uint32_t pointCounts = 0;
-        uint32_t segCounts = 0;
-        uint32_t maxVertexCountsPerStrand = 0;
-        for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
-        {
-            uint32_t tmpPointCount = div_round_up(subdivPerSegment * (vertexCountsPerStrand[i] - 1), keepOneEveryXVerticesPerStrand) + 1;
-            pointCounts += tmpPointCount;
-            segCounts += tmpPointCount - 1;
-            maxVertexCountsPerStrand = std::max(maxVertexCountsPerStrand, vertexCountsPerStrand[i]);
-        }
-        result.indices.reserve(segCounts);
-        result.points.reserve(pointCounts);
-        result.radius.reserve(pointCounts);
-        result.texCrds.reserve(pointCounts);
-
-        uint32_t pointOffset = 0;
+        StrandLayout layout = computeStrandLayout(strandCount, vertexCountsPerStrand, controlPoints, subdivPerSegment, keepOneEveryXStrands, keepOneEveryXVerticesPerStrand);
+        result.indices.resize(layout.getSegmentCount());
+        result.points.resize(layout.getPointCount());
+        result.radius.resize(layout.getPointCount());
+        if (UVs) result.texCrds.resize(layout.getPointCount());
 
-        StrandArrays strandArrays;
-        strandArrays.controlPoints.reserve(maxVertexCountsPerStrand);
-        strandArrays.widths.reserve(maxVertexCountsPerStrand);
-        strandArrays.UVs.reserve(maxVertexCountsPerStrand);
         CurveArrays curveArrays(controlPoints, widths, UVs);
 
-        StrandArrays optimizedStrandArrays;
-        CubicSplineCache splineCache;
-        for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
+        forEachStrand(layout, [&](uint32_t strand, StrandArrays& strandArrays, StrandArrays& optimizedStrandArrays, CubicSplineCache& splineCache)
         {
-            optimizedStrandArrays.controlPoints.clear();
-            optimizedStrandArrays.UVs.clear();
-            optimizedStrandArrays.widths.clear();
-            optimizedStrandArrays.vertexCount = 0;
-            strandArrays.vertexCount = vertexCountsPerStrand[i];
+            strandArrays.vertexCount = vertexCountsPerStrand[strand * keepOneEveryXStrands];
 
-            optimizeStrandGeometry(splineCache, curveArrays, strandArrays, optimizedStrandArrays, pointOffset, subdivPerSegment, keepOneEveryXVerticesPerStrand, widthScale);
+            optimizeStrandGeometry(splineCache, curveArrays, strandArrays, optimizedStrandArrays, layout.inputOffsets[strand], subdivPerSegment, keepOneEveryXVerticesPerStrand, widthScale);
 
             const CubicSpline<float3>& splinePoints = splineCache.splinePoints.setup(strandArrays.controlPoints.data(), optimizedStrandArrays.vertexCount);
             const CubicSpline<float>& splineWidths = splineCache.splineWidths.setup(strandArrays.widths.data(), optimizedStrandArrays.vertexCount);
 
+            // Each strand has one segment less than points.
+            uint32_t pointIndex = layout.outputOffsets[strand];
+            uint32_t segmentIndex = pointIndex - strand;
+
             uint32_t tmpCount = 0;
             for (uint32_t j = 0; j < optimizedStrandArrays.vertexCount - 1; j++)
             {
@@ -284,13 +366,14 @@ namespace Falcor
                     if (tmpCount % keepOneEveryXVerticesPerStrand == 0)
                     {
                         float t = (float)k / (float)subdivPerSegment;
-                        result.indices.push_back((uint32_t)result.points.size());
+                        result.indices[segmentIndex++] = pointIndex;
 
                         // Pre-transform curve points.
                         float4 sph = transformSphere(xform, float4(splinePoints.interpolate(j, t), splineWidths.interpolate(j, t) * 0.5f * widthScale));
 
-                        result.points.push_back(sph.xyz);
-                        result.radius.push_back(sph.w);
+                        result.points[pointIndex] = sph.xyz;
+                        result.radius[pointIndex] = sph.w;
+                        pointIndex++;
                     }
                     tmpCount++;
                 }
@@ -298,13 +381,15 @@ namespace Falcor
 
             // Always keep the last vertex.
             float4 sph = transformSphere(xform, float4(splinePoints.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f), splineWidths.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f) * 0.5f * widthScale));
-            result.points.push_back(sph.xyz);
-            result.radius.push_back(sph.w);
+            result.points[pointIndex] = sph.xyz;
+            result.radius[pointIndex] = sph.w;
+            FALCOR_ASSERT(pointIndex + 1 == layout.outputOffsets[strand + 1]);
 
             // Texture coordinates.
             if (UVs)
             {
                 const CubicSpline<float2>& splineUVs = splineCache.splineUVs.setup(strandArrays.UVs.data(), optimizedStrandArrays.vertexCount);
+                uint32_t texCrdIndex = layout.outputOffsets[strand];
                 tmpCount = 0;
                 for (uint32_t j = 0; j < optimizedStrandArrays.vertexCount - 1; j++)
                 {
@@ -313,18 +398,16 @@ namespace Falcor
                         if (tmpCount % keepOneEveryXVerticesPerStrand == 0)
                         {
                             float t = (float)k / (float)subdivPerSegment;
-                            result.texCrds.push_back(splineUVs.interpolate(j, t));
+                            result.texCrds[texCrdIndex++] = splineUVs.interpolate(j, t);
                         }
                         tmpCount++;
                     }
                 }
 
                 // Always keep the last vertex.
-                result.texCrds.push_back(splineUVs.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f));
+                result.texCrds[texCrdIndex] = splineUVs.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f);
             }
-
-            for (uint32_t j = i; j < std::min(strandCount, i + keepOneEveryXStrands); j++) pointOffset += vertexCountsPerStrand[j];
-        }
+        });
 
         return result;
     }
@@ -332,47 +415,32 @@ namespace Falcor
     CurveTessellation::MeshResult CurveTessellation::convertToPolytube(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, uint32_t pointCountPerCrossSection)
     {
         MeshResult result;
-        uint32_t vertexCounts = 0;
-        uint32_t faceCounts = 0;
-        uint32_t maxVertexCountsPerStrand = 0;
-        for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
-        {
-            uint32_t tmpPointCount = div_round_up(subdivPerSegment * (vertexCountsPerStrand[i] - 1), keepOneEveryXVerticesPerStrand) + 1;
-            vertexCounts += pointCountPerCrossSection * tmpPointCount;
-            faceCounts += 2 * pointCountPerCrossSection * (tmpPointCount - 1);
-            maxVertexCountsPerStrand = std::max(maxVertexCountsPerStrand, vertexCountsPerStrand[i]);
-        }
-        result.vertices.reserve(vertexCounts);
-        result.normals.reserve(vertexCounts);
-        result.tangents.reserve(vertexCounts);
-        result.texCrds.reserve(vertexCounts);
-        result.radii.reserve(vertexCounts);
-        result.faceVertexCounts.reserve(faceCounts);
-        result.faceVertexIndices.reserve(faceCounts * 3);
-
-        uint32_t pointOffset = 0;
-        uint32_t meshVertexOffset = 0;
-
-        StrandArrays strandArrays;
-        strandArrays.controlPoints.reserve(maxVertexCountsPerStrand);
-        strandArrays.widths.reserve(maxVertexCountsPerStrand);
-        strandArrays.UVs.reserve(maxVertexCountsPerStrand);
+
+        StrandLayout layout = computeStrandLayout(strandCount, vertexCountsPerStrand, controlPoints, subdivPerSegment, keepOneEveryXStrands, keepOneEveryXVerticesPerStrand);
+        uint64_t vertexCount = (uint64_t)pointCountPerCrossSection * layout.getPointCount();
+        uint64_t faceCount = 2ull * pointCountPerCrossSection * layout.getSegmentCount();
+        if (3 * faceCount > std::numeric_limits<uint32_t>::max()) throw RuntimeError("Curve tessellation exceeds the supported number of mesh vertices.");
+
+        result.vertices.resize(vertexCount);
+        result.normals.resize(vertexCount);
+        result.tangents.resize(vertexCount);
+        if (UVs) result.texCrds.resize(vertexCount);
+        result.radii.resize(vertexCount);
+        result.faceVertexCounts.resize(faceCount);
+        result.faceVertexIndices.resize(faceCount * 3);
+
         CurveArrays curveArrays(controlPoints, widths, UVs);
 
-        StrandArrays optimizedStrandArrays;
-        CubicSplineCache splineCache;
-        for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
+        forEachStrand(layout, [&](uint32_t strand, StrandArrays& strandArrays, StrandArrays& optimizedStrandArrays, CubicSplineCache& splineCache)
         {
-            optimizedStrandArrays.controlPoints.clear();
-            optimizedStrandArrays.UVs.clear();
-            optimizedStrandArrays.widths.clear();
-            optimizedStrandArrays.vertexCount = 0;
+            strandArrays.vertexCount = vertexCountsPerStrand[strand * keepOneEveryXStrands];
 
-            strandArrays.vertexCount = vertexCountsPerStrand[i];
+            optimizeStrandGeometry(splineCache, curveArrays, strandArrays, optimizedStrandArrays, layout.inputOffsets[strand], subdivPerSegment, keepOneEveryXVerticesPerStrand, widthScale);
+            FALCOR_ASSERT(optimizedStrandArrays.controlPoints.size() == layout.outputOffsets[strand + 1] - layout.outputOffsets[strand]);
 
-            optimizeStrandGeometry(splineCache, curveArrays, strandArrays, optimizedStrandArrays, pointOffset, subdivPerSegment, keepOneEveryXVerticesPerStrand, widthScale);
-
-            for (uint32_t j = i; j < std::min(strandCount, i + keepOneEveryXStrands); j++) pointOffset += vertexCountsPerStrand[j];
+            // Each strand has one segment less than points, and each segment has two triangles per cross-section point.
+            uint32_t meshVertexOffset = pointCountPerCrossSection * layout.outputOffsets[strand];
+            uint32_t faceOffset = 2 * pointCountPerCrossSection * (layout.outputOffsets[strand] - strand);
 
             // Build the initial frame.
             float3 fwd, s, t;
@@ -386,18 +454,17 @@ namespace Falcor
                 updateCurveFrame(optimizedStrandArrays, fwd, s, t, j);
 
                 // Mesh vertices, normals, tangents, and texCrds (if any).
-                updateMeshResultBuffers(result, curveArrays, optimizedStrandArrays, fwd, s, t, pointCountPerCrossSection, widthScale, j);
+                updateMeshResultBuffers(result, curveArrays, optimizedStrandArrays, fwd, s, t, pointCountPerCrossSection, widthScale, j, meshVertexOffset + j * pointCountPerCrossSection);
 
                 // Mesh faces.
                 if (j < optimizedStrandArrays.controlPoints.size() - 1)
                 {
                     uint32_t quadCountLimit = pointCountPerCrossSection;
-                    connectFaceVertices(result, meshVertexOffset, pointCountPerCrossSection, quadCountLimit, 1, 1, j);
+                    connectFaceVertices(result, meshVertexOffset, pointCountPerCrossSection, quadCountLimit, 1, 1, j, faceOffset + 2 * pointCountPerCrossSection * j);
                 }
             }
+        });
 
-            meshVertexOffset += pointCountPerCrossSection * (uint32_t)optimizedStrandArrays.controlPoints.size();
-        }
         return result;
     }
 
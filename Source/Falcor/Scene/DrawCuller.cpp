@@ -0,0 +1,133 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "DrawCuller.h"
+#include "Core/Errors.h"
+#include "Utils/NumericRange.h"
+#include "Utils/Math/Common.h"
+#include <algorithm>
+#include <execution>
+#include <limits>
+
+namespace Falcor
+{
+    namespace
+    {
+        // Number of instances culled per parallel task.
+        const size_t kBlockSize = 1024;
+    }
+
+    DrawCuller::View::View(const rmcv::mat4& viewProj, float2 viewportSize)
+        : mViewProj(viewProj)
+        , mViewportSize(viewportSize)
+    {
+        // Extract the world-space frustum planes from the view-projection matrix.
+        // See: https://fgiesen.wordpress.com/2012/08/31/frustum-planes-from-the-projection-matrix/
+        // The clip-space depth range is [0, w], so the near plane is z >= 0.
+        const float4 r0 = viewProj.getRow(0);
+        const float4 r1 = viewProj.getRow(1);
+        const float4 r2 = viewProj.getRow(2);
+        const float4 r3 = viewProj.getRow(3);
+        mPlanes = { r3 + r0, r3 - r0, r3 + r1, r3 - r1, r2, r3 - r2 };
+    }
+
+    DrawCuller::Result DrawCuller::cullInstance(const View& view, const Settings& settings, const AABB& bounds)
+    {
+        if (!bounds.valid()) return Result::Visible;
+
+        if (settings.frustumCulling)
+        {
+            // The box is outside if its corner furthest along the plane normal is outside.
+            for (const float4& plane : view.mPlanes)
+            {
+                float3 p = float3(plane.x >= 0.f ? bounds.maxPoint.x : bounds.minPoint.x,
+                                  plane.y >= 0.f ? bounds.maxPoint.y : bounds.minPoint.y,
+                                  plane.z >= 0.f ? bounds.maxPoint.z : bounds.minPoint.z);
+                if (glm::dot(float3(plane), p) + plane.w < 0.f) return Result::FrustumCulled;
+            }
+        }
+
+        if (settings.minPixelSize > 0.f)
+        {
+            // Project the corners of the box to get the bounding rectangle of its projection.
+            // Boxes that extend behind the camera are never culled.
+            float2 ndcMin = float2(std::numeric_limits<float>::infinity());
+            float2 ndcMax = float2(-std::numeric_limits<float>::infinity());
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                float3 corner = float3(i & 1 ? bounds.maxPoint.x : bounds.minPoint.x,
+                                       i & 2 ? bounds.maxPoint.y : bounds.minPoint.y,
+                                       i & 4 ? bounds.maxPoint.z : bounds.minPoint.z);
+                float4 clip = view.mViewProj * float4(corner, 1.f);
+                if (clip.w <= 0.f) return Result::Visible;
+                float2 ndc = float2(clip) / clip.w;
+                ndcMin = glm::min(ndcMin, ndc);
+                ndcMax = glm::max(ndcMax, ndc);
+            }
+
+            float2 size = 0.5f * (ndcMax - ndcMin) * view.mViewportSize;
+            if (size.x < settings.minPixelSize && size.y < settings.minPixelSize) return Result::SizeCulled;
+        }
+
+        return Result::Visible;
+    }
+
+    void DrawCuller::cull(const View& view, fstd::span<const AABB> bounds, const DrawListBuilder& drawList)
+    {
+        checkArgument(bounds.size() == drawList.getInstanceCount(), "Got {} bounding boxes but the draw list has {} instances.", bounds.size(), drawList.getInstanceCount());
+
+        const size_t count = bounds.size();
+        mResults.resize(count);
+        mVisibility.resize(count);
+
+        auto range = NumericRange<size_t>(0, div_round_up(count, kBlockSize));
+        std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t block)
+        {
+            size_t end = std::min((block + 1) * kBlockSize, count);
+            for (size_t i = block * kBlockSize; i < end; ++i)
+            {
+                mResults[i] = cullInstance(view, mSettings, bounds[i]);
+                mVisibility[i] = mResults[i] == Result::Visible ? 1 : 0;
+            }
+        });
+
+        mStats = {};
+        mStats.instanceCount = (uint32_t)count;
+        for (Result result : mResults)
+        {
+            switch (result)
+            {
+            case Result::Visible: mStats.visibleCount++; break;
+            case Result::FrustumCulled: mStats.frustumCulledCount++; break;
+            case Result::SizeCulled: mStats.sizeCulledCount++; break;
+            }
+        }
+
+        drawList.buildVisibleGroups(mVisibility, mGroups);
+        for (const auto& group : mGroups) mStats.drawCount += group.getDrawCount();
+    }
+}
@@ -0,0 +1,142 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "DrawListBuilder.h"
+#include "Core/Macros.h"
+#include "Utils/Math/AABB.h"
+#include "Utils/Math/Matrix.h"
+#include "Utils/Math/Vector.h"
+#include <fstd/span.h> // TODO C++20: Replace with <span>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Falcor
+{
+    /** CPU culling of triangle mesh instances for rasterization.
+
+        Each instance is tested by its world-space bounding box against the view frustum and, optionally, against a
+        minimum projected size in pixels. The instances are tested in parallel, and the visible instances are written to
+        compacted draw lists built by a DrawListBuilder, with the same grouping and merging as the full draw lists.
+    */
+    class FALCOR_API DrawCuller
+    {
+    public:
+        /** Culling result of an instance.
+        */
+        enum class Result : uint8_t
+        {
+            Visible,
+            FrustumCulled,  ///< Bounding box is outside the view frustum.
+            SizeCulled,     ///< Bounding box is inside the view frustum but its projection is smaller than the minimum size.
+        };
+
+        struct Settings
+        {
+            bool frustumCulling = true;     ///< Cull instances outside the view frustum.
+            float minPixelSize = 0.f;       ///< Cull instances whose projected bounding box is smaller than this many pixels in both dimensions. Zero disables small-object culling.
+
+            bool operator==(const Settings& other) const { return frustumCulling == other.frustumCulling && minPixelSize == other.minPixelSize; }
+            bool operator!=(const Settings& other) const { return !(*this == other); }
+        };
+
+        /** View to cull against.
+        */
+        class FALCOR_API View
+        {
+        public:
+            View() = default;
+
+            /** Create a view.
+                \param[in] viewProj View-projection matrix. The clip-space depth range is [0, w].
+                \param[in] viewportSize Viewport size in pixels.
+            */
+            View(const rmcv::mat4& viewProj, float2 viewportSize);
+
+            const rmcv::mat4& getViewProjMatrix() const { return mViewProj; }
+            float2 getViewportSize() const { return mViewportSize; }
+
+            bool operator==(const View& other) const { return mViewProj == other.mViewProj && mViewportSize == other.mViewportSize; }
+            bool operator!=(const View& other) const { return !(*this == other); }
+
+        private:
+            friend class DrawCuller;
+
+            rmcv::mat4 mViewProj;
+            float2 mViewportSize = float2(0.f);
+            std::array<float4, 6> mPlanes;  ///< Frustum planes in world space. Points p with dot(plane.xyz, p) + plane.w >= 0 are inside.
+        };
+
+        struct Stats
+        {
+            uint32_t instanceCount = 0;         ///< Number of instances tested.
+            uint32_t frustumCulledCount = 0;    ///< Number of instances outside the view frustum.
+            uint32_t sizeCulledCount = 0;       ///< Number of instances culled for their projected size.
+            uint32_t visibleCount = 0;          ///< Number of visible instances.
+            uint32_t drawCount = 0;             ///< Number of draws in the compacted draw lists.
+        };
+
+        /** Cull a single instance.
+            Instances with invalid bounds are always visible.
+            \param[in] view View to cull against.
+            \param[in] settings Culling settings.
+            \param[in] bounds World-space bounding box of the instance.
+            \return Culling result.
+        */
+        static Result cullInstance(const View& view, const Settings& settings, const AABB& bounds);
+
+        /** Cull all instances of a draw list and build the compacted draw lists of the visible instances.
+            \param[in] view View to cull against.
+            \param[in] bounds World-space bounding box per draw ID. Instances with invalid bounds are never culled.
+            \param[in] drawList Draw lists to compact.
+        */
+        void cull(const View& view, fstd::span<const AABB> bounds, const DrawListBuilder& drawList);
+
+        void setSettings(const Settings& settings) { mSettings = settings; }
+        const Settings& getSettings() const { return mSettings; }
+
+        /** Get the culling result per draw ID from the last call to cull().
+        */
+        const std::vector<Result>& getResults() const { return mResults; }
+
+        /** Get the compacted draw lists from the last call to cull().
+        */
+        const std::array<DrawListBuilder::Group, DrawListBuilder::kGroupCount>& getGroups() const { return mGroups; }
+
+        /** Get the statistics from the last call to cull().
+        */
+        const Stats& getStats() const { return mStats; }
+
+    private:
+        Settings mSettings;
+        std::vector<Result> mResults;
+        std::vector<uint8_t> mVisibility;
+        std::array<DrawListBuilder::Group, DrawListBuilder::kGroupCount> mGroups;
+        Stats mStats;
+    };
+}
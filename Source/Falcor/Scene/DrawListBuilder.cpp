@@ -0,0 +1,159 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "DrawListBuilder.h"
+#include "Core/Assert.h"
+#include "Core/Errors.h"
+#include <limits>
+
+namespace Falcor
+{
+    void DrawListBuilder::build(const std::vector<GeometryInstanceData>& instances, const std::vector<MeshDesc>& meshes, bool isIndexed)
+    {
+        mMeshes = meshes;
+        mIsIndexed = isIndexed;
+
+        for (uint32_t i = 0; i < kGroupCount; ++i)
+        {
+            Group& group = mGroups[i];
+            group.ccw = i >= 2;
+            group.ibFormat = isIndexed ? (i % 2 == 0 ? ResourceFormat::R16Uint : ResourceFormat::R32Uint) : ResourceFormat::Unknown;
+        }
+
+        mInstances.clear();
+        for (const auto& instance : instances)
+        {
+            if (instance.getType() != GeometryType::TriangleMesh) continue;
+
+            checkArgument(instance.geometryID < meshes.size(), "Instance references mesh {} but there are only {} meshes.", instance.geometryID, meshes.size());
+            FALCOR_ASSERT(isIndexed || meshes[instance.geometryID].indexCount == 0);
+            mInstances.push_back({ instance.geometryID, getGroupIndex(instance) });
+        }
+        checkArgument(mInstances.size() <= std::numeric_limits<uint32_t>::max(), "Too many triangle mesh instances.");
+
+        buildGroups(mGroups, (1u << kGroupCount) - 1, nullptr);
+    }
+
+    uint32_t DrawListBuilder::update(const std::vector<GeometryInstanceData>& instances)
+    {
+        uint32_t changedGroups = 0;
+        uint32_t drawID = 0;
+
+        for (const auto& instance : instances)
+        {
+            if (instance.getType() != GeometryType::TriangleMesh) continue;
+
+            checkArgument(drawID < mInstances.size() && mInstances[drawID].meshID == instance.geometryID, "Triangle mesh instances changed since the draw list was built.");
+            uint32_t& groupIndex = mInstances[drawID++].groupIndex;
+            uint32_t newGroupIndex = getGroupIndex(instance);
+            if (newGroupIndex != groupIndex)
+            {
+                changedGroups |= (1u << groupIndex) | (1u << newGroupIndex);
+                groupIndex = newGroupIndex;
+            }
+        }
+        checkArgument(drawID == mInstances.size(), "Triangle mesh instances changed since the draw list was built.");
+
+        if (changedGroups != 0) buildGroups(mGroups, changedGroups, nullptr);
+        return changedGroups;
+    }
+
+    uint32_t DrawListBuilder::getGroupIndex(const GeometryInstanceData& instance) const
+    {
+        bool use32Bit = mIsIndexed && !mMeshes[instance.geometryID].use16BitIndices();
+        return (instance.isWorldFrontFaceCW() ? 0 : 2) + (use32Bit ? 1 : 0);
+    }
+
+    void DrawListBuilder::buildVisibleGroups(fstd::span<const uint8_t> visibility, std::array<Group, kGroupCount>& groups) const
+    {
+        checkArgument(visibility.size() == mInstances.size(), "Visibility has {} entries but there are {} instances.", visibility.size(), mInstances.size());
+        buildGroups(groups, (1u << kGroupCount) - 1, visibility.data());
+    }
+
+    void DrawListBuilder::buildGroups(std::array<Group, kGroupCount>& groups, uint32_t groupMask, const uint8_t* pVisibility) const
+    {
+        for (uint32_t i = 0; i < kGroupCount; ++i)
+        {
+            if (groupMask & (1u << i))
+            {
+                groups[i].ccw = mGroups[i].ccw;
+                groups[i].ibFormat = mGroups[i].ibFormat;
+                groups[i].indexedDraws.clear();
+                groups[i].draws.clear();
+            }
+        }
+
+        auto isVisible = [&](uint32_t drawID) { return pVisibility == nullptr || pVisibility[drawID] != 0; };
+
+        for (uint32_t drawID = 0; drawID < (uint32_t)mInstances.size(); ++drawID)
+        {
+            const InstanceData& instance = mInstances[drawID];
+            if ((groupMask & (1u << instance.groupIndex)) == 0 || !isVisible(drawID)) continue;
+
+            Group& group = groups[instance.groupIndex];
+
+            // If the previous draw ID is the same mesh in the same group and is drawn, it is the last draw of this group.
+            // Extend that draw with one more instance instead of adding a new draw.
+            bool merge = drawID > 0 && mInstances[drawID - 1].meshID == instance.meshID && mInstances[drawID - 1].groupIndex == instance.groupIndex && isVisible(drawID - 1);
+
+            const MeshDesc& mesh = mMeshes[instance.meshID];
+            if (mIsIndexed)
+            {
+                if (merge)
+                {
+                    FALCOR_ASSERT(group.indexedDraws.back().StartInstanceLocation + group.indexedDraws.back().InstanceCount == drawID);
+                    group.indexedDraws.back().InstanceCount++;
+                    continue;
+                }
+
+                DrawIndexedArguments draw;
+                draw.IndexCountPerInstance = mesh.indexCount;
+                draw.InstanceCount = 1;
+                draw.StartIndexLocation = mesh.ibOffset * (mesh.use16BitIndices() ? 2 : 1);
+                draw.BaseVertexLocation = mesh.vbOffset;
+                draw.StartInstanceLocation = drawID;
+                group.indexedDraws.push_back(draw);
+            }
+            else
+            {
+                if (merge)
+                {
+                    FALCOR_ASSERT(group.draws.back().StartInstanceLocation + group.draws.back().InstanceCount == drawID);
+                    group.draws.back().InstanceCount++;
+                    continue;
+                }
+
+                DrawArguments draw;
+                draw.VertexCountPerInstance = mesh.vertexCount;
+                draw.InstanceCount = 1;
+                draw.StartVertexLocation = mesh.vbOffset;
+                draw.StartInstanceLocation = drawID;
+                group.draws.push_back(draw);
+            }
+        }
+    }
+}
@@ -0,0 +1,115 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "SceneTypes.slang"
+#include "Core/Macros.h"
+#include "Core/API/Formats.h"
+#include "Core/API/IndirectCommands.h"
+#include <fstd/span.h> // TODO C++20: Replace with <span>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Falcor
+{
+    /** Builds the draw-indirect argument lists for rasterizing the triangle mesh instances of a scene.
+
+        The triangle mesh instances are split into groups by index format and by triangle winding in world space,
+        as each group needs its own vertex array object and rasterizer state. Within a group, instances of the same mesh
+        with contiguous draw IDs are merged into a single multi-instance draw. The draw ID of an instance is its index
+        among all triangle mesh instances and is passed to the vertex shader through the per-instance draw ID attribute,
+        so merging draws does not change what the shaders see.
+
+        When instances change winding due to animation, update() moves them to their new group and rebuilds only the
+        groups that gained or lost instances.
+    */
+    class FALCOR_API DrawListBuilder
+    {
+    public:
+        static constexpr uint32_t kGroupCount = 4;
+
+        /** Draw list for one combination of index format and triangle winding.
+        */
+        struct Group
+        {
+            bool ccw = true;                                    ///< True if counterclockwise triangle winding.
+            ResourceFormat ibFormat = ResourceFormat::Unknown;  ///< Index buffer format, or Unknown for non-indexed draws.
+            std::vector<DrawIndexedArguments> indexedDraws;     ///< Draws if the meshes are indexed.
+            std::vector<DrawArguments> draws;                   ///< Draws if the meshes are non-indexed.
+
+            uint32_t getDrawCount() const { return (uint32_t)(ibFormat == ResourceFormat::Unknown ? draws.size() : indexedDraws.size()); }
+        };
+
+        /** Build the draw lists for all groups.
+            \param[in] instances Geometry instances. Only triangle mesh instances are drawn.
+            \param[in] meshes Mesh descs indexed by the geometry ID of the instances.
+            \param[in] isIndexed True if the meshes are indexed.
+        */
+        void build(const std::vector<GeometryInstanceData>& instances, const std::vector<MeshDesc>& meshes, bool isIndexed);
+
+        /** Update the draw lists after the instance flags have changed.
+            The meshes and the list of instances must be the same as in the last call to build(). Only the groups that
+            gained or lost instances are rebuilt.
+            \param[in] instances Geometry instances.
+            \return Bit mask of the rebuilt groups.
+        */
+        uint32_t update(const std::vector<GeometryInstanceData>& instances);
+
+        /** Build compacted draw lists containing only the visible instances.
+            Instances of the same mesh with contiguous draw IDs are merged as in the full draw lists, so a run of instances
+            interrupted by a culled instance is split into two draws.
+            \param[in] visibility Visibility per draw ID, nonzero if visible.
+            \param[out] groups Draw lists with the same layout as getGroups().
+        */
+        void buildVisibleGroups(fstd::span<const uint8_t> visibility, std::array<Group, kGroupCount>& groups) const;
+
+        /** Get the draw lists. Groups 0-3 are CW 16-bit, CW 32-bit, CCW 16-bit and CCW 32-bit.
+            For non-indexed meshes only groups 0 (CW) and 2 (CCW) are used.
+        */
+        const std::array<Group, kGroupCount>& getGroups() const { return mGroups; }
+
+        /** Get the number of triangle mesh instances, which is also the number of draw IDs.
+        */
+        uint32_t getInstanceCount() const { return (uint32_t)mInstances.size(); }
+
+    private:
+        struct InstanceData
+        {
+            uint32_t meshID = 0;        ///< Mesh drawn by the instance.
+            uint32_t groupIndex = 0;    ///< Group the instance is drawn in.
+        };
+
+        uint32_t getGroupIndex(const GeometryInstanceData& instance) const;
+        void buildGroups(std::array<Group, kGroupCount>& groups, uint32_t groupMask, const uint8_t* pVisibility) const;
+
+        std::vector<MeshDesc> mMeshes;
+        std::vector<InstanceData> mInstances;   ///< Triangle mesh instances indexed by draw ID.
+        bool mIsIndexed = false;
+        std::array<Group, kGroupCount> mGroups;
+    };
+}
@@ -41,6 +41,7 @@ namespace Falcor
         const size_t kBRDFSamplingResThetaH = 90;
         const size_t kBRDFSamplingResThetaD = 90;
         const size_t kBRDFSamplingResPhiD = 360;
+        const size_t kBRDFSampleCount = kBRDFSamplingResThetaH * kBRDFSamplingResThetaD * kBRDFSamplingResPhiD / 2;
 
         // Scale factors for the RGB channels of the measured data.
         const double kRedScale = 1.0 / 1500.0;
@@ -56,12 +57,57 @@ namespace Falcor
             throw RuntimeError("Failed to load MERL BRDF from '{}'", path);
     }
 
-    bool MERLFile::loadBRDF(const std::filesystem::path& path)
+    bool MERLFile::loadBRDF(const std::filesystem::path& path, bool useCache)
     {
         mDesc = {};
         mData.clear();
         mAlbedoLUT.clear();
 
+        mDesc.path = path;
+        mDesc.name = path.stem().string();
+
+        // Try loading the processed data from the cache before parsing the raw measurements.
+        std::optional<MeasuredBRDFCache::Key> cacheKey;
+        bool loadedFromCache = false;
+        if (useCache && (cacheKey = computeCacheKey(path)))
+        {
+            if (auto blobs = MeasuredBRDFCache::read(*cacheKey))
+            {
+                loadedFromCache = blobs->size() == 1 && MeasuredBRDFCache::fromBlob((*blobs)[0], mData) && mData.size() == kBRDFSampleCount;
+                if (!loadedFromCache) mData.clear();
+            }
+        }
+
+        if (!loadedFromCache)
+        {
+            if (!loadRawData(path))
+            {
+                mDesc = {};
+                mData.clear();
+                return false;
+            }
+            if (cacheKey) MeasuredBRDFCache::write(*cacheKey, { MeasuredBRDFCache::toBlob(mData.data(), mData.size()) });
+        }
+
+        // Load JSON sidecar file if it exists.
+        const auto jsonPath = std::filesystem::path(path).replace_extension("json");
+        if (!DiffuseSpecularUtils::loadJSONData(jsonPath, mDesc.extraData))
+            logWarning("MERLFile: Failed to load associated JSON data for BRDF '{}'.", mDesc.name);
+
+        logInfo("Loaded MERL BRDF '{}'{}.", mDesc.name, loadedFromCache ? " from cache" : "");
+        return true;
+    }
+
+    std::optional<MeasuredBRDFCache::Key> MERLFile::computeCacheKey(const std::filesystem::path& path)
+    {
+        // The tag includes the processing parameters so that changing them invalidates existing entries.
+        // Processing a MERL file is about as fast as hashing it, so the key is based on the file metadata instead of its content.
+        const std::string format = fmt::format("MERLFile:{}:{}:{}", kRedScale, kGreenScale, kBlueScale);
+        return MeasuredBRDFCache::computeFileInfoKey(path, format);
+    }
+
+    bool MERLFile::loadRawData(const std::filesystem::path& path)
+    {
         std::ifstream ifs(path, std::ios_base::in | std::ios_base::binary);
         if (!ifs.good())
         {
@@ -74,7 +120,7 @@ namespace Falcor
         ifs.read(reinterpret_cast<char*>(dims), sizeof(int) * 3);
 
         size_t n = (size_t)dims[0] * dims[1] * dims[2];
-        if (n != kBRDFSamplingResThetaH * kBRDFSamplingResThetaD * kBRDFSamplingResPhiD / 2)
+        if (n != kBRDFSampleCount)
         {
             logWarning("MERLFile: Dimensions don't match in file '{}'.", path);
             return false;
@@ -89,17 +135,7 @@ namespace Falcor
             return false;
         }
 
-        mDesc.path = path;
-        mDesc.name = path.stem().string();
-
         prepareData(dims, data);
-
-        // Load JSON sidecar file if it exists.
-        const auto jsonPath = std::filesystem::path(path).replace_extension("json");
-        if (!DiffuseSpecularUtils::loadJSONData(jsonPath, mDesc.extraData))
-            logWarning("MERLFile: Failed to load associated JSON data for BRDF '{}'.", mDesc.name);
-
-        logInfo("Loaded MERL BRDF '{}'.", mDesc.name);
         return true;
     }
 
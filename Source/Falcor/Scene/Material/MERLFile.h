@@ -29,8 +29,10 @@
 #include "Core/API/Formats.h"
 #include "Utils/Math/Vector.h"
 #include "Scene/Material/DiffuseSpecularData.slang"
+#include "Scene/Material/MeasuredBRDFCache.h"
 #include <filesystem>
 #include <memory>
+#include <optional>
 
 namespace Falcor
 {
@@ -59,10 +61,13 @@ namespace Falcor
         MERLFile(const std::filesystem::path& path);
 
         /** Loads a MERL BRDF.
+            The processed BRDF data is cached on disk (see `MeasuredBRDFCache`) and reused as long as the file path, size and modification time are unchanged.
+            This function is thread-safe as long as each thread uses its own object.
             \param[in] path Path to the binary MERL file.
+            \param[in] useCache Use the on-disk cache of processed data if available and update it otherwise.
             \return True if the BRDF was successfully loaded.
         */
-        bool loadBRDF(const std::filesystem::path& path);
+        bool loadBRDF(const std::filesystem::path& path, bool useCache = true);
 
         /** Prepare an albedo lookup table.
             The table is loaded from disk or recomputed if needed.
@@ -71,10 +76,17 @@ namespace Falcor
         */
         const std::vector<float4>& prepareAlbedoLUT(const std::shared_ptr<Device>& pDevice);
 
+        /** Compute the key used for caching the processed data of a MERL file.
+            \param[in] path Path to the binary MERL file.
+            \return Returns the cache key or an empty optional if the file could not be read.
+        */
+        static std::optional<MeasuredBRDFCache::Key> computeCacheKey(const std::filesystem::path& path);
+
         const Desc& getDesc() const { return mDesc; }
         const std::vector<float3>& getData() const { return mData; }
 
     private:
+        bool loadRawData(const std::filesystem::path& path);
         void prepareData(const int dims[3], const std::vector<double>& data);
         void computeAlbedoLUT(const std::shared_ptr<Device>&, const size_t binCount);
 
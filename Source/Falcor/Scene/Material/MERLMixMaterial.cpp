@@ -29,11 +29,14 @@
 #include "Core/API/Device.h"
 #include "Utils/Logger.h"
 #include "Utils/BufferAllocator.h"
+#include "Utils/NumericRange.h"
 #include "Utils/Scripting/ScriptBindings.h"
 #include "Scene/SceneBuilderAccess.h"
 #include "Scene/Material/MERLFile.h"
 #include "Scene/Material/MaterialSystem.h"
 #include "Scene/Material/DiffuseSpecularUtils.h"
+#include <algorithm>
+#include <execution>
 #include <fstream>
 
 namespace Falcor
@@ -60,18 +63,23 @@ namespace Falcor
         mTextureSlotInfo[(uint32_t)TextureSlot::Normal] = { "normal", TextureChannelFlags::RGB, false };
         mTextureSlotInfo[(uint32_t)TextureSlot::Index] = { "index", TextureChannelFlags::Red, false };
 
-        // Load all BRDFs.
+        // Load all BRDFs in parallel. This only touches the CPU side (file parsing or cache reads).
+        std::vector<MERLFile> merlFiles(paths.size());
+        std::vector<char> loaded(paths.size(), 0);
+        auto range = NumericRange<size_t>(0, paths.size());
+        std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t i) { loaded[i] = merlFiles[i].loadBRDF(paths[i]); });
+
         mBRDFs.resize(paths.size());
         std::vector<DiffuseSpecularData> extraData(paths.size());
         std::vector<float4> albedoLut;
         BufferAllocator buffer(128, 0 /* raw buffer */, 128, ResourceBindFlags::ShaderResource);
-        MERLFile merlFile;
 
         for (size_t i = 0; i < paths.size(); i++)
         {
-            if (!merlFile.loadBRDF(paths[i]))
+            if (!loaded[i])
                 throw RuntimeError("MERLMixMaterial: Failed to load BRDF from '{}'.", paths[i]);
 
+            auto& merlFile = merlFiles[i];
             auto& desc = mBRDFs[i];
             desc.path = merlFile.getDesc().path;
             desc.name = merlFile.getDesc().name;
@@ -84,10 +92,13 @@ namespace Falcor
             desc.byteOffset = buffer.allocate(desc.byteSize);
             buffer.setBlob(brdf.data(), desc.byteOffset, desc.byteSize);
 
-            // Copy albedo LUT into shared table.
+            // Copy albedo LUT into shared table. This may need the GPU and is done serially.
             const auto& lut = merlFile.prepareAlbedoLUT(mpDevice);
             checkInvariant(lut.size() == MERLMixMaterialData::kAlbedoLUTSize, "MERLMixMaterial: Unexpected albedo LUT size.");
             albedoLut.insert(albedoLut.end(), lut.begin(), lut.end());
+
+            // Release the CPU copy of the data as soon as it has been copied.
+            merlFile = MERLFile();
         }
 
         mData.brdfCount = static_cast<uint32_t>(mBRDFs.size());
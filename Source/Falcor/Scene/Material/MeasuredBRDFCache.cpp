@@ -0,0 +1,203 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "MeasuredBRDFCache.h"
+#include "Core/Errors.h"
+#include "Core/Platform/OS.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <random>
+
+namespace Falcor
+{
+    namespace
+    {
+        const std::string kDirectory = "NVIDIA/Falcor/MeasuredBRDFCache";
+
+        const uint32_t kMagic = 0x44524242; // "BBRD"
+        const uint32_t kVersion = 2;
+
+        // Hash algorithm used for cache keys.
+        const HashAlgorithm kKeyHashAlgorithm = HashAlgorithm::XXH3_128;
+
+        // Upper bound on the number of blobs in an entry. Used to reject corrupt files early.
+        const uint32_t kMaxBlobCount = 64;
+
+        struct Header
+        {
+            uint32_t magic = kMagic;
+            uint32_t version = kVersion;
+            MeasuredBRDFCache::Key key = {};
+            uint32_t blobCount = 0;
+        };
+
+        std::mutex gDirectoryMutex;
+        std::filesystem::path gDirectory;
+    }
+
+    std::optional<MeasuredBRDFCache::Key> MeasuredBRDFCache::computeKey(const std::filesystem::path& path, std::string_view format)
+    {
+        Hasher hasher(kKeyHashAlgorithm);
+        hasher.update(format);
+        hasher.update(kVersion);
+        if (!hasher.updateFile(path)) return {};
+
+        return hasher.finalize();
+    }
+
+    std::optional<MeasuredBRDFCache::Key> MeasuredBRDFCache::computeFileInfoKey(const std::filesystem::path& path, std::string_view format)
+    {
+        std::error_code ec;
+        const auto absolutePath = std::filesystem::absolute(path, ec).lexically_normal().u8string();
+        const uint64_t size = std::filesystem::file_size(path, ec);
+        if (ec) return {};
+        const int64_t modifiedTime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+        if (ec) return {};
+
+        Hasher hasher(kKeyHashAlgorithm);
+        hasher.update(format);
+        hasher.update(kVersion);
+        hasher.update(absolutePath.data(), absolutePath.size());
+        hasher.update(size);
+        hasher.update(modifiedTime);
+        return hasher.finalize();
+    }
+
+    std::optional<std::vector<MeasuredBRDFCache::Blob>> MeasuredBRDFCache::read(const Key& key)
+    {
+        const auto cachePath = getCachePath(key);
+        std::ifstream ifs(cachePath, std::ios_base::in | std::ios_base::binary);
+        if (!ifs.good()) return {};
+
+        std::error_code ec;
+        const uint64_t fileSize = std::filesystem::file_size(cachePath, ec);
+        if (ec) return {};
+
+        Header header;
+        ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!ifs.good() || header.magic != kMagic || header.version != kVersion || header.key != key || header.blobCount > kMaxBlobCount)
+        {
+            logWarning("MeasuredBRDFCache: Ignoring invalid cache file '{}'.", cachePath);
+            return {};
+        }
+
+        std::vector<Blob> blobs(header.blobCount);
+        for (auto& blob : blobs)
+        {
+            uint64_t size = 0;
+            ifs.read(reinterpret_cast<char*>(&size), sizeof(size));
+            if (!ifs.good()) break;
+
+            // Validate the size before allocating, a corrupt size could otherwise request an arbitrarily large allocation.
+            const uint64_t remaining = fileSize - std::min<uint64_t>(fileSize, (uint64_t)ifs.tellg());
+            if (size > remaining)
+            {
+                logWarning("MeasuredBRDFCache: Ignoring invalid cache file '{}'.", cachePath);
+                return {};
+            }
+            blob.resize(size);
+            ifs.read(reinterpret_cast<char*>(blob.data()), size);
+        }
+
+        if (!ifs.good())
+        {
+            logWarning("MeasuredBRDFCache: Failed to read cache file '{}'.", cachePath);
+            return {};
+        }
+
+        return blobs;
+    }
+
+    bool MeasuredBRDFCache::write(const Key& key, const std::vector<Blob>& blobs)
+    {
+        checkArgument(blobs.size() <= kMaxBlobCount, "Too many blobs ({}) in measured BRDF cache entry.", blobs.size());
+
+        const auto cachePath = getCachePath(key);
+
+        // Write to a file with a random suffix, unique across threads and processes, and move it in place afterwards.
+        std::random_device rd;
+        auto tempPath = cachePath;
+        tempPath += fmt::format(".{:08x}{:08x}.tmp", rd(), rd());
+
+        std::error_code ec;
+        std::filesystem::create_directories(cachePath.parent_path(), ec);
+
+        {
+            std::ofstream ofs(tempPath, std::ios_base::out | std::ios_base::binary);
+            if (ofs.good())
+            {
+                Header header;
+                header.key = key;
+                header.blobCount = (uint32_t)blobs.size();
+                ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+                for (const auto& blob : blobs)
+                {
+                    uint64_t size = blob.size();
+                    ofs.write(reinterpret_cast<const char*>(&size), sizeof(size));
+                    ofs.write(reinterpret_cast<const char*>(blob.data()), size);
+                }
+            }
+            if (!ofs.good())
+            {
+                logWarning("MeasuredBRDFCache: Failed to write cache file '{}'.", tempPath);
+                ofs.close();
+                std::filesystem::remove(tempPath, ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tempPath, cachePath, ec);
+        if (ec)
+        {
+            logWarning("MeasuredBRDFCache: Failed to move cache file to '{}': {}.", cachePath, ec.message());
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+
+        return true;
+    }
+
+    std::filesystem::path MeasuredBRDFCache::getCachePath(const Key& key)
+    {
+        return getDirectory() / key.toString();
+    }
+
+    void MeasuredBRDFCache::setDirectory(const std::filesystem::path& directory)
+    {
+        std::lock_guard<std::mutex> lock(gDirectoryMutex);
+        gDirectory = directory;
+    }
+
+    std::filesystem::path MeasuredBRDFCache::getDirectory()
+    {
+        std::lock_guard<std::mutex> lock(gDirectoryMutex);
+        return gDirectory.empty() ? getAppDataDirectory() / kDirectory : gDirectory;
+    }
+}
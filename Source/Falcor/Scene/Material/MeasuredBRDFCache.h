@@ -0,0 +1,115 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include "Utils/FastHash.h"
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Falcor
+{
+    /** Helper class for caching processed measured BRDF data on disk.
+        Loaders for measured BRDFs (MERL, RGL) spend most of their time converting and preprocessing
+        the raw measurements. The cache stores the processed arrays keyed by a hash of the source file
+        content or metadata, so that it is automatically invalidated when the source file changes.
+        Each cache entry holds a list of binary blobs whose interpretation is up to the loader.
+        The cache lives in the application data directory by default, see setDirectory().
+    */
+    class FALCOR_API MeasuredBRDFCache
+    {
+    public:
+        using Key = Hasher::Digest;
+        using Blob = std::vector<uint8_t>;
+
+        /** Compute a cache key from the content of a source file.
+            \param[in] path Path to the source file.
+            \param[in] format Loader specific tag. Should change whenever the processing of the data changes.
+            \return Returns the cache key or an empty optional if the file could not be read.
+        */
+        static std::optional<Key> computeKey(const std::filesystem::path& path, std::string_view format);
+
+        /** Compute a cache key from the absolute path, size and modification time of a source file.
+            Use this instead of computeKey() when hashing the file content takes about as long as processing it.
+            \param[in] path Path to the source file.
+            \param[in] format Loader specific tag. Should change whenever the processing of the data changes.
+            \return Returns the cache key or an empty optional if the file does not exist.
+        */
+        static std::optional<Key> computeFileInfoKey(const std::filesystem::path& path, std::string_view format);
+
+        /** Read a cache entry.
+            \param[in] key Cache key.
+            \return Returns the cached blobs or an empty optional if there is no valid cache entry.
+        */
+        static std::optional<std::vector<Blob>> read(const Key& key);
+
+        /** Write a cache entry. Failing to write the cache is not an error and only logged.
+            The entry is written to a temporary file first and then moved in place, so concurrent writers are safe.
+            \param[in] key Cache key.
+            \param[in] blobs Blobs to store.
+            \return Returns true if the entry was written.
+        */
+        static bool write(const Key& key, const std::vector<Blob>& blobs);
+
+        /** Get the path of the cache file for a given key.
+        */
+        static std::filesystem::path getCachePath(const Key& key);
+
+        /** Set the cache directory.
+            \param[in] directory Cache directory. If empty, the default directory in the application data directory is used.
+        */
+        static void setDirectory(const std::filesystem::path& directory);
+
+        /** Get the cache directory.
+        */
+        static std::filesystem::path getDirectory();
+
+        /** Helpers for converting arrays of trivially copyable types to/from blobs.
+        */
+        template<typename T>
+        static Blob toBlob(const T* data, size_t count)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+            return Blob(bytes, bytes + count * sizeof(T));
+        }
+
+        template<typename T>
+        static bool fromBlob(const Blob& blob, std::vector<T>& data)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            if (blob.size() % sizeof(T) != 0) return false;
+            data.resize(blob.size() / sizeof(T));
+            std::memcpy(data.data(), blob.data(), blob.size());
+            return true;
+        }
+    };
+}
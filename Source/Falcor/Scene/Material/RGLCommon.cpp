@@ -27,25 +27,55 @@
  **************************************************************************/
 #include "RGLCommon.h"
 #include "Core/Assert.h"
+#include "Utils/NumericRange.h"
+#include <algorithm>
+#include <cstring>
+#include <execution>
 
 namespace Falcor
 {
     SamplableDistribution4D::SamplableDistribution4D(const float* pdf, uint4 size)
         : mSize(size)
     {
-        uint32_t N = size.x * size.y * size.z * size.w;
+        const size_t N = getElementCount();
+        const size_t M = getMarginalCount();
 
         mPDF        .reset(new float[N]);
         mConditional.reset(new float[N]);
-        mMarginal   .reset(new float[N / size.z]);
+        mMarginal   .reset(new float[M]);
 
         std::memcpy(mPDF.get(), pdf, N * sizeof(float));
 
-        uint32_t sliceStride = size.z * size.w;
-        for (uint32_t i = 0; i < N; i += sliceStride)
+        // The 2D slices are independent. Build them in parallel.
+        const size_t sliceStride = (size_t)size.z * size.w;
+        auto range = NumericRange<uint32_t>(0, size.x * size.y);
+        std::for_each(std::execution::par, range.begin(), range.end(), [&](uint32_t slice)
         {
-            build2DSlice(int2(size.z, size.w), mPDF.get() + i, mMarginal.get() + i / size.z, mConditional.get() + i);
-        }
+            build2DSlice(int2(size.z, size.w), mPDF.get() + slice * sliceStride, mMarginal.get() + slice * size.w, mConditional.get() + slice * sliceStride);
+        });
+    }
+
+    SamplableDistribution4D::SamplableDistribution4D(uint4 size, const float* pdf, const float* marginal, const float* conditional)
+        : mSize(size)
+    {
+        const size_t N = getElementCount();
+        const size_t M = getMarginalCount();
+
+        mPDF        .reset(new float[N]);
+        mConditional.reset(new float[N]);
+        mMarginal   .reset(new float[M]);
+
+        std::memcpy(mPDF.get(), pdf, N * sizeof(float));
+        std::memcpy(mConditional.get(), conditional, N * sizeof(float));
+        std::memcpy(mMarginal.get(), marginal, M * sizeof(float));
+    }
+
+    std::vector<float16_t> SamplableDistribution4D::packCDFToHalf(const float* cdf, size_t count)
+    {
+        // Rounding to nearest is monotonic, so the CDFs stay non-decreasing.
+        std::vector<float16_t> packed((count + 1) & ~size_t(1), float16_t(0.f));
+        for (size_t i = 0; i < count; ++i) packed[i] = float16_t(cdf[i]);
+        return packed;
     }
 
     void SamplableDistribution4D::build2DSlice(int2 size, float* pdf, float* marginalCDF, float* conditionalCDF)
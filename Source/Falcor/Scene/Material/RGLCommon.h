@@ -26,8 +26,10 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #pragma once
+#include "Utils/Math/Float16.h"
 #include "Utils/Math/Vector.h"
 #include <memory>
+#include <vector>
 
 namespace Falcor
 {
@@ -47,18 +49,47 @@ namespace Falcor
         interpolated PDF instead of the straight sum of the PDF.
 
         The actual interpolation/sampling at runtime happens on the GPU
-        (see RGLCommon.slang)
+        (see RGLCommon.slang). The CDFs can be uploaded at half precision
+        to reduce their memory footprint (see packCDFToHalf()).
     */
     class SamplableDistribution4D
     {
     public:
+        /** Build a distribution from a 4D table. The 2D slices are built in parallel.
+            \param[in] pdf Unnormalized PDF of size `size.x * size.y * size.z * size.w`.
+            \param[in] size Size of the 4D table.
+        */
         SamplableDistribution4D(const float* pdf, uint4 size);
 
-        const float* getPDF()         { return mPDF.get();         }
+        /** Create a distribution from previously built tables, e.g. loaded from a cache.
+            \param[in] size Size of the 4D table.
+            \param[in] pdf Normalized PDF with `getElementCount()` entries.
+            \param[in] marginal Marginal CDFs with `getMarginalCount()` entries.
+            \param[in] conditional Conditional CDFs with `getElementCount()` entries.
+        */
+        SamplableDistribution4D(uint4 size, const float* pdf, const float* marginal, const float* conditional);
 
-        const float* getMarginal()    { return mMarginal.get();    }
+        uint4 getSize() const { return mSize; }
 
-        const float* getConditional() { return mConditional.get(); }
+        /// Number of entries in the PDF and conditional tables.
+        size_t getElementCount() const { return (size_t)mSize.x * mSize.y * mSize.z * mSize.w; }
+
+        /// Number of entries in the marginal table.
+        size_t getMarginalCount() const { return (size_t)mSize.x * mSize.y * mSize.w; }
+
+        const float* getPDF() const         { return mPDF.get();         }
+
+        const float* getMarginal() const    { return mMarginal.get();    }
+
+        const float* getConditional() const { return mConditional.get(); }
+
+        /** Convert CDF values to fp16 for upload to the GPU.
+            The layout matches the fp16 tables read by InterpolatedDistribution2D in RGLCommon.slang.
+            \param[in] cdf CDF values, e.g. from getMarginal() or getConditional().
+            \param[in] count Number of values.
+            \return CDF values in fp16, padded with zeros to a multiple of 4 bytes.
+        */
+        static std::vector<float16_t> packCDFToHalf(const float* cdf, size_t count);
 
     private:
         uint4 mSize;
@@ -66,6 +97,6 @@ namespace Falcor
         std::unique_ptr<float[]> mMarginal;
         std::unique_ptr<float[]> mConditional;
 
-        void build2DSlice(int2 size, float* pdf, float* marginalCdf, float* conditionalCdf);
+        static void build2DSlice(int2 size, float* pdf, float* marginalCdf, float* conditionalCdf);
     };
 }
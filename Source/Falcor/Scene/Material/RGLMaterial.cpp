@@ -28,6 +28,7 @@
 #include "RGLMaterial.h"
 #include "RGLFile.h"
 #include "RGLCommon.h"
+#include "MeasuredBRDFCache.h"
 #include "Core/API/Device.h"
 #include "Utils/Logger.h"
 #include "Utils/Image/ImageIO.h"
@@ -35,6 +36,7 @@
 #include "Scene/SceneBuilderAccess.h"
 #include "Rendering/Materials/BSDFIntegrator.h"
 #include <fstream>
+#include <optional>
 
 namespace Falcor
 {
@@ -48,15 +50,51 @@ namespace Falcor
         const ResourceFormat kAlbedoLUTFormat = ResourceFormat::RGBA32Float;
 
         const std::string kLoadFile = "load";
+
+        // Tag for the measured BRDF cache. Change when the distribution building changes.
+        const char kCacheFormat[] = "RGLMaterial:SamplableDistribution4D:1";
+
+        void appendToBlobs(const SamplableDistribution4D& dist, std::vector<MeasuredBRDFCache::Blob>& blobs)
+        {
+            blobs.push_back(MeasuredBRDFCache::toBlob(dist.getPDF(), dist.getElementCount()));
+            blobs.push_back(MeasuredBRDFCache::toBlob(dist.getMarginal(), dist.getMarginalCount()));
+            blobs.push_back(MeasuredBRDFCache::toBlob(dist.getConditional(), dist.getElementCount()));
+        }
+
+        std::optional<SamplableDistribution4D> readFromBlobs(const std::vector<MeasuredBRDFCache::Blob>& blobs, size_t first, uint4 size)
+        {
+            const size_t N = (size_t)size.x * size.y * size.z * size.w;
+            const size_t M = N / size.z;
+            if (blobs.size() < first + 3 ||
+                blobs[first].size() != N * sizeof(float) ||
+                blobs[first + 1].size() != M * sizeof(float) ||
+                blobs[first + 2].size() != N * sizeof(float))
+            {
+                return {};
+            }
+            auto data = [&](size_t i) { return reinterpret_cast<const float*>(blobs[first + i].data()); };
+            return SamplableDistribution4D(size, data(0), data(1), data(2));
+        }
+
+        Buffer::SharedPtr createCDFBuffer(Device* pDevice, const float* cdf, size_t count, bool halfPrecision)
+        {
+            if (halfPrecision)
+            {
+                auto packed = SamplableDistribution4D::packCDFToHalf(cdf, count);
+                return Buffer::create(pDevice, packed.size() * sizeof(float16_t), ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, packed.data());
+            }
+            return Buffer::create(pDevice, count * sizeof(float), ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, cdf);
+        }
     }
 
-    RGLMaterial::SharedPtr RGLMaterial::create(std::shared_ptr<Device> pDevice, const std::string& name, const std::filesystem::path& path)
+    RGLMaterial::SharedPtr RGLMaterial::create(std::shared_ptr<Device> pDevice, const std::string& name, const std::filesystem::path& path, bool halfPrecisionCDFs)
     {
-        return SharedPtr(new RGLMaterial(std::move(pDevice), name, path));
+        return SharedPtr(new RGLMaterial(std::move(pDevice), name, path, halfPrecisionCDFs));
     }
 
-    RGLMaterial::RGLMaterial(std::shared_ptr<Device> pDevice, const std::string& name, const std::filesystem::path& path)
+    RGLMaterial::RGLMaterial(std::shared_ptr<Device> pDevice, const std::string& name, const std::filesystem::path& path, bool halfPrecisionCDFs)
         : Material(std::move(pDevice), name, MaterialType::RGL)
+        , mHalfPrecisionCDFs(halfPrecisionCDFs)
     {
         if (!loadBRDF(path))
         {
@@ -134,6 +172,7 @@ namespace Falcor
 
         if (!isBaseEqual(*other)) return false;
         if (mFilePath != other->mFilePath) return false;
+        if (mHalfPrecisionCDFs != other->mHalfPrecisionCDFs) return false;
 
         return true;
     }
@@ -214,20 +253,44 @@ namespace Falcor
         auto prod3 = [&](uint4 v) { return v.x * v.y * v.z; };
         auto prod4 = [&](uint4 v) { return v.x * v.y * v.z * v.w; };
 
-        SamplableDistribution4D vndfDist(reinterpret_cast<float*>(vndf->data.get()), vndfSize);
-        SamplableDistribution4D lumiDist(reinterpret_cast<float*>(lumi->data.get()), lumiSize);
+        // Building the sampling distributions is expensive. Reuse the tables from the cache if the file is unchanged.
+        std::optional<SamplableDistribution4D> vndfDist, lumiDist;
+        auto cacheKey = MeasuredBRDFCache::computeKey(fullPath, kCacheFormat);
+        if (cacheKey)
+        {
+            if (auto blobs = MeasuredBRDFCache::read(*cacheKey))
+            {
+                vndfDist = readFromBlobs(*blobs, 0, vndfSize);
+                lumiDist = readFromBlobs(*blobs, 3, lumiSize);
+            }
+        }
+
+        if (!vndfDist || !lumiDist)
+        {
+            vndfDist.emplace(reinterpret_cast<float*>(vndf->data.get()), vndfSize);
+            lumiDist.emplace(reinterpret_cast<float*>(lumi->data.get()), lumiSize);
+
+            if (cacheKey)
+            {
+                std::vector<MeasuredBRDFCache::Blob> blobs;
+                appendToBlobs(*vndfDist, blobs);
+                appendToBlobs(*lumiDist, blobs);
+                MeasuredBRDFCache::write(*cacheKey, blobs);
+            }
+        }
 
-        mpVNDFMarginalBuf    = Buffer::create(mpDevice.get(), prod3(vndfSize) * 4, ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, vndfDist.getMarginal());
-        mpLumiMarginalBuf    = Buffer::create(mpDevice.get(), prod3(lumiSize) * 4, ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, lumiDist.getMarginal());
-        mpVNDFConditionalBuf = Buffer::create(mpDevice.get(), prod4(vndfSize) * 4, ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, vndfDist.getConditional());
-        mpLumiConditionalBuf = Buffer::create(mpDevice.get(), prod4(lumiSize) * 4, ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, lumiDist.getConditional());
+        mData.halfPrecisionCDFs = mHalfPrecisionCDFs ? 1 : 0;
+        mpVNDFMarginalBuf    = createCDFBuffer(mpDevice.get(), vndfDist->getMarginal(),    prod3(vndfSize), mHalfPrecisionCDFs);
+        mpLumiMarginalBuf    = createCDFBuffer(mpDevice.get(), lumiDist->getMarginal(),    prod3(lumiSize), mHalfPrecisionCDFs);
+        mpVNDFConditionalBuf = createCDFBuffer(mpDevice.get(), vndfDist->getConditional(), prod4(vndfSize), mHalfPrecisionCDFs);
+        mpLumiConditionalBuf = createCDFBuffer(mpDevice.get(), lumiDist->getConditional(), prod4(lumiSize), mHalfPrecisionCDFs);
 
         mpThetaBuf = Buffer::create(mpDevice.get(), theta->numElems * sizeof(float), ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, theta->data.get());
         mpPhiBuf   = Buffer::create(mpDevice.get(), phi  ->numElems * sizeof(float), ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, phi  ->data.get());
         mpSigmaBuf = Buffer::create(mpDevice.get(), sigma->numElems * sizeof(float), ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, sigma->data.get());
         mpNDFBuf   = Buffer::create(mpDevice.get(), ndf  ->numElems * sizeof(float), ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, ndf  ->data.get());
-        mpVNDFBuf  = Buffer::create(mpDevice.get(), vndf ->numElems * sizeof(float), ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, vndfDist.getPDF());
-        mpLumiBuf  = Buffer::create(mpDevice.get(), lumi ->numElems * sizeof(float), ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, lumiDist.getPDF());
+        mpVNDFBuf  = Buffer::create(mpDevice.get(), vndf ->numElems * sizeof(float), ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, vndfDist->getPDF());
+        mpLumiBuf  = Buffer::create(mpDevice.get(), lumi ->numElems * sizeof(float), ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, lumiDist->getPDF());
         mpRGBBuf   = Buffer::create(mpDevice.get(), rgb  ->numElems * sizeof(float), ResourceBindFlags::ShaderResource, Buffer::CpuAccess::None, rgb  ->data.get());
 
         markUpdates(Material::UpdateFlags::ResourcesChanged);
@@ -316,11 +379,11 @@ namespace Falcor
         FALCOR_SCRIPT_BINDING_DEPENDENCY(Material)
 
         pybind11::class_<RGLMaterial, Material, RGLMaterial::SharedPtr> material(m, "RGLMaterial");
-        auto create = [] (const std::string& name, const std::filesystem::path& path)
+        auto create = [] (const std::string& name, const std::filesystem::path& path, bool halfPrecisionCDFs)
         {
-            return RGLMaterial::create(getActivePythonSceneBuilder().getDevice(), name, path);
+            return RGLMaterial::create(getActivePythonSceneBuilder().getDevice(), name, path, halfPrecisionCDFs);
         };
-        material.def(pybind11::init(create), "name"_a, "path"_a); // PYTHONDEPRECATED
+        material.def(pybind11::init(create), "name"_a, "path"_a, "halfPrecisionCDFs"_a = false); // PYTHONDEPRECATED
         material.def(kLoadFile.c_str(), &RGLMaterial::loadBRDF, "path"_a);
     }
 }
@@ -47,9 +47,10 @@ namespace Falcor
         /** Create a new RGL material.
             \param[in] name The material name.
             \param[in] path Path of BRDF file to load.
+            \param[in] halfPrecisionCDFs Store the sampling CDFs as fp16 on the GPU. This halves their memory footprint at the cost of sampling accuracy.
             \return A new object, or throws an exception if creation failed.
         */
-        static SharedPtr create(std::shared_ptr<Device> pDevice, const std::string& name, const std::filesystem::path& path);
+        static SharedPtr create(std::shared_ptr<Device> pDevice, const std::string& name, const std::filesystem::path& path, bool halfPrecisionCDFs = false);
 
         bool renderUI(Gui::Widgets& widget) override;
         Material::UpdateFlags update(MaterialSystem* pOwner) override;
@@ -63,7 +64,7 @@ namespace Falcor
         bool loadBRDF(const std::filesystem::path& path);
 
     protected:
-        RGLMaterial(std::shared_ptr<Device> pDevice, const std::string& name, const std::filesystem::path& path);
+        RGLMaterial(std::shared_ptr<Device> pDevice, const std::string& name, const std::filesystem::path& path, bool halfPrecisionCDFs);
 
         void prepareData(const int dims[3], const std::vector<double>& data);
         void prepareAlbedoLUT(RenderContext* pRenderContext);
@@ -74,6 +75,7 @@ namespace Falcor
         std::string mBRDFDescription;       ///< Description of the BRDF given in the BRDF file.
 
         bool mBRDFUploaded = false;         ///< True if BRDF data buffers have been uploaded to the material system.
+        bool mHalfPrecisionCDFs = false;    ///< True if the marginal and conditional CDFs are stored as fp16.
         RGLMaterialData mData;              ///< Material parameters.
         Buffer::SharedPtr mpThetaBuf;
         Buffer::SharedPtr mpPhiBuf;
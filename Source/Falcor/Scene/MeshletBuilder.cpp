@@ -0,0 +1,229 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "MeshletBuilder.h"
+#include "Core/Assert.h"
+#include "Core/Errors.h"
+#include "Utils/Math/AABB.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Falcor
+{
+    namespace
+    {
+        const uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        void computeMeshletBounds(MeshletDesc& meshlet, fstd::span<const uint32_t> triangleIndices, fstd::span<const uint32_t> vertices, fstd::span<const float3> positions)
+        {
+            // Bounding sphere centered at the center of the vertex bounds.
+            AABB bounds;
+            for (uint32_t v : vertices) bounds.include(positions[v]);
+            meshlet.sphereCenter = bounds.center();
+            float radiusSq = 0.f;
+            for (uint32_t v : vertices)
+            {
+                float3 d = positions[v] - meshlet.sphereCenter;
+                radiusSq = std::max(radiusSq, dot(d, d));
+            }
+            meshlet.sphereRadius = std::sqrt(radiusSq);
+
+            // Normal cone around the average triangle normal. Degenerate triangles are ignored.
+            std::vector<float3> normals;
+            normals.reserve(triangleIndices.size() / 3);
+            float3 normalSum = float3(0.f);
+            for (size_t i = 0; i < triangleIndices.size(); i += 3)
+            {
+                const float3& p0 = positions[triangleIndices[i]];
+                float3 n = cross(positions[triangleIndices[i + 1]] - p0, positions[triangleIndices[i + 2]] - p0);
+                float len = length(n);
+                if (len > 0.f)
+                {
+                    normals.push_back(n / len);
+                    normalSum += normals.back();
+                }
+            }
+
+            float sumLength = length(normalSum);
+            if (normals.empty() || sumLength < 1e-6f)
+            {
+                meshlet.coneAxis = float3(0.f, 0.f, 1.f);
+                meshlet.coneCutoff = -1.f;
+                return;
+            }
+
+            meshlet.coneAxis = normalSum / sumLength;
+            meshlet.coneCutoff = 1.f;
+            for (const float3& n : normals) meshlet.coneCutoff = std::min(meshlet.coneCutoff, dot(n, meshlet.coneAxis));
+        }
+    }
+
+    std::vector<MeshletDesc> buildMeshlets(fstd::span<uint32_t> indices, fstd::span<const float3> positions, const MeshletLimits& limits)
+    {
+        checkArgument(indices.size() % 3 == 0, "'indices' must contain a triangle list.");
+        checkArgument(indices.size() <= std::numeric_limits<uint32_t>::max(), "'indices' has too many entries.");
+        checkArgument(limits.maxVertices >= 3 && limits.maxTriangles >= 1, "Meshlet limits must allow at least one triangle.");
+
+        const uint32_t triangleCount = (uint32_t)(indices.size() / 3);
+        const uint32_t vertexCount = (uint32_t)positions.size();
+        for (uint32_t index : indices) checkArgument(index < vertexCount, "Vertex index {} is out of range.", index);
+
+        // Build vertex to triangle adjacency.
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (uint32_t index : indices) adjacencyOffsets[index + 1]++;
+        for (uint32_t v = 0; v < vertexCount; ++v) adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+
+        std::vector<uint32_t> adjacency(indices.size());
+        std::vector<uint32_t> liveTriangleCount(vertexCount, 0);
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            for (uint32_t k = 0; k < 3; ++k)
+            {
+                uint32_t v = indices[3 * t + k];
+                adjacency[adjacencyOffsets[v] + liveTriangleCount[v]++] = t;
+            }
+        }
+
+        std::vector<uint8_t> emitted(triangleCount, 0);
+        std::vector<uint32_t> vertexStamp(vertexCount, kInvalidIndex);      // Meshlet that last referenced each vertex.
+        std::vector<uint32_t> candidateStamp(triangleCount, kInvalidIndex); // Meshlet that last added each triangle as a candidate.
+
+        std::vector<uint32_t> reordered;
+        reordered.reserve(indices.size());
+        std::vector<MeshletDesc> meshlets;
+        std::vector<uint32_t> candidates;
+        std::vector<uint32_t> meshletVertices;
+        uint32_t emittedCount = 0;
+        uint32_t cursor = 0;  // All triangles before the cursor have been emitted.
+
+        auto liveCount = [&](uint32_t t)
+        {
+            return liveTriangleCount[indices[3 * t]] + liveTriangleCount[indices[3 * t + 1]] + liveTriangleCount[indices[3 * t + 2]];
+        };
+
+        auto nextUnemitted = [&]()
+        {
+            while (cursor < triangleCount && emitted[cursor]) cursor++;
+            return cursor < triangleCount ? cursor : kInvalidIndex;
+        };
+
+        while (emittedCount < triangleCount)
+        {
+            const uint32_t stamp = (uint32_t)meshlets.size();
+            MeshletDesc meshlet = {};
+            meshlet.triangleOffset = emittedCount;
+
+            // Seed the meshlet next to the previous one, preferring triangles on the border of the remaining geometry.
+            uint32_t seed = kInvalidIndex;
+            for (uint32_t t : candidates)
+            {
+                if (!emitted[t] && (seed == kInvalidIndex || liveCount(t) < liveCount(seed))) seed = t;
+            }
+            if (seed == kInvalidIndex) seed = nextUnemitted();
+            candidates.clear();
+            meshletVertices.clear();
+
+            auto addTriangle = [&](uint32_t t)
+            {
+                FALCOR_ASSERT(!emitted[t]);
+                emitted[t] = 1;
+                emittedCount++;
+                meshlet.triangleCount++;
+                for (uint32_t k = 0; k < 3; ++k)
+                {
+                    uint32_t v = indices[3 * t + k];
+                    reordered.push_back(v);
+                    liveTriangleCount[v]--;
+                    if (vertexStamp[v] == stamp) continue;
+
+                    vertexStamp[v] = stamp;
+                    meshletVertices.push_back(v);
+                    for (uint32_t i = adjacencyOffsets[v]; i < adjacencyOffsets[v + 1]; ++i)
+                    {
+                        uint32_t a = adjacency[i];
+                        if (emitted[a] || candidateStamp[a] == stamp) continue;
+                        candidateStamp[a] = stamp;
+                        candidates.push_back(a);
+                    }
+                }
+            };
+
+            addTriangle(seed);
+
+            while (meshlet.triangleCount < limits.maxTriangles)
+            {
+                // Pick the candidate that adds the fewest new vertices. Ties are broken by preferring triangles whose vertices
+                // have few remaining triangles, to avoid leaving isolated triangles behind.
+                uint32_t best = kInvalidIndex;
+                uint32_t bestNewVertices = 4;
+                uint32_t bestLiveCount = 0;
+                size_t candidateCount = 0;
+                for (uint32_t t : candidates)
+                {
+                    if (emitted[t]) continue;
+                    candidates[candidateCount++] = t;
+
+                    uint32_t newVertices = 0;
+                    for (uint32_t k = 0; k < 3; ++k) newVertices += vertexStamp[indices[3 * t + k]] != stamp ? 1 : 0;
+                    if (meshletVertices.size() + newVertices > limits.maxVertices) continue;
+
+                    uint32_t live = liveCount(t);
+                    if (newVertices < bestNewVertices || (newVertices == bestNewVertices && live < bestLiveCount))
+                    {
+                        best = t;
+                        bestNewVertices = newVertices;
+                        bestLiveCount = live;
+                    }
+                }
+                candidates.resize(candidateCount);
+
+                if (best == kInvalidIndex)
+                {
+                    // Small disconnected pieces are merged with the next triangles in the original order, which are
+                    // usually spatially close. Larger meshlets end when their connected geometry is exhausted.
+                    if (!candidates.empty() || meshlet.triangleCount >= limits.maxTriangles / 4) break;
+                    if (meshletVertices.size() + 3 > limits.maxVertices) break;
+                    best = nextUnemitted();
+                    if (best == kInvalidIndex) break;
+                }
+
+                addTriangle(best);
+            }
+
+            meshlet.vertexCount = (uint32_t)meshletVertices.size();
+            fstd::span<const uint32_t> meshletIndices(reordered.data() + 3 * (size_t)meshlet.triangleOffset, 3 * (size_t)meshlet.triangleCount);
+            computeMeshletBounds(meshlet, meshletIndices, meshletVertices, positions);
+            meshlets.push_back(meshlet);
+        }
+
+        FALCOR_ASSERT(reordered.size() == indices.size());
+        std::copy(reordered.begin(), reordered.end(), indices.begin());
+
+        return meshlets;
+    }
+}
@@ -0,0 +1,58 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "SceneTypes.slang"
+#include "Core/Macros.h"
+#include "Utils/Math/Vector.h"
+#include <fstd/span.h> // TODO C++20: Replace with <span>
+#include <cstdint>
+#include <vector>
+
+namespace Falcor
+{
+    /** Size limits for meshlets.
+    */
+    struct MeshletLimits
+    {
+        uint32_t maxVertices = 64;      ///< Maximum number of unique vertices per meshlet.
+        uint32_t maxTriangles = 124;    ///< Maximum number of triangles per meshlet.
+    };
+
+    /** Partition a triangle mesh into meshlets.
+        Meshlets are grown greedily from a seed triangle by adding the adjacent triangle that introduces the fewest new
+        vertices, and each new seed is picked next to the previous meshlet. The triangles are reordered in place so that
+        each meshlet is a contiguous range of triangles and consecutive triangles share vertices, which also improves
+        vertex cache locality when drawing the whole mesh.
+        The normal cones are computed from the geometric normals of the triangles with counter-clockwise winding.
+        \param[in,out] indices Triangle list indices. The triangles are reordered in place.
+        \param[in] positions Vertex positions in object space.
+        \param[in] limits Size limits for the meshlets.
+        \return List of meshlets in triangle order. The meshID of all meshlets is zero.
+    */
+    FALCOR_API std::vector<MeshletDesc> buildMeshlets(fstd::span<uint32_t> indices, fstd::span<const float3> positions, const MeshletLimits& limits = {});
+}
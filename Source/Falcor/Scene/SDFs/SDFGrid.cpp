@@ -30,6 +30,7 @@
 #include "SparseVoxelSet/SDFSVS.h"
 #include "SparseBrickSet/SDFSBS.h"
 #include "SparseVoxelOctree/SDFSVO.h"
+#include "SDFGridSparseFile.h"
 #include "Core/Assert.h"
 #include "Core/Errors.h"
 #include "Core/API/Device.h"
@@ -283,6 +284,15 @@ namespace Falcor
     }
 
     void SDFGrid::setValues(const std::vector<float>& cornerValues, uint32_t gridWidth)
+    {
+        checkGridWidth(gridWidth);
+
+        mGridWidth = gridWidth;
+
+        setValuesInternal(cornerValues);
+    }
+
+    void SDFGrid::checkGridWidth(uint32_t gridWidth) const
     {
         // All types except SBS need to have a gridWidth that is a power of 2.
         Type type = getType();
@@ -290,8 +300,16 @@ namespace Falcor
         {
             checkArgument(isPowerOf2(gridWidth), "'gridWidth' ({}) must be a power of 2 for SDFGrid type of {}", gridWidth, getTypeName(type));
         }
+    }
 
-        mGridWidth = gridWidth;
+    void SDFGrid::setQuantizedValuesInternal(std::vector<int8_t>&& values)
+    {
+        std::vector<float> cornerValues(values.size());
+        for (size_t v = 0; v < values.size(); v++)
+        {
+            cornerValues[v] = SDFGridSparseFile::dequantizeValue(values[v], mGridWidth);
+        }
+        values.clear();
 
         setValuesInternal(cornerValues);
     }
@@ -301,6 +319,27 @@ namespace Falcor
         std::filesystem::path fullPath;
         if (findFileInDataDirectories(path, fullPath))
         {
+            if (hasExtension(fullPath, "sdfgs"))
+            {
+                try
+                {
+                    std::vector<int8_t> values;
+                    uint32_t gridWidth = SDFGridSparseFile::readQuantizedValues(fullPath, values);
+                    checkGridWidth(gridWidth);
+
+                    mGridWidth = gridWidth;
+                    setQuantizedValuesInternal(std::move(values));
+
+                    mInitializedWithPrimitives = false;
+                    return true;
+                }
+                catch (const std::exception& e)
+                {
+                    logWarning("SDFGrid::loadValuesFromFile() failed to load sparse file '{}': {}", path, e.what());
+                    return false;
+                }
+            }
+
             std::ifstream file(fullPath, std::ios::in | std::ios::binary);
 
             if (file.is_open())
@@ -541,6 +580,9 @@ namespace Falcor
         sdfGrid.def_static("createSBS", createSBS); // PYTHONDEPRECATED
         sdfGrid.def_static("createSVO", [](){ return SDFGrid::SharedPtr(SDFSVO::create(getActivePythonSceneBuilder().getDevice())); }); // PYTHONDEPRECATED
         sdfGrid.def("loadValuesFromFile", &SDFGrid::loadValuesFromFile, "path"_a);
+        sdfGrid.def_static("convertValuesFileToSparse", [](const std::filesystem::path& densePath, const std::filesystem::path& sparsePath, uint32_t brickWidth)
+            { SDFGridSparseFile::convertFromDenseFile(densePath, sparsePath, brickWidth); },
+            "densePath"_a, "sparsePath"_a, "brickWidth"_a = SDFGridSparseFile::kDefaultBrickWidth);
         sdfGrid.def("loadPrimitivesFromFile", &SDFGrid::loadPrimitivesFromFile, "path"_a, "gridWidth"_a, "dir"_a = "");
         sdfGrid.def("generateCheeseValues", &SDFGrid::generateCheeseValues, "gridWidth"_a, "seed"_a);
         sdfGrid.def_property("name", &SDFGrid::getName, &SDFGrid::setName);
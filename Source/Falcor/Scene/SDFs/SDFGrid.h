@@ -124,7 +124,8 @@ namespace Falcor
         void setValues(const std::vector<float>& cornerValues, uint32_t gridWidth);
 
         /** Set the signed distance values of the SDF grid from a file.
-            \param[in] path The path of a .sdfg file.
+            Sparse narrow-band files (.sdfgs, see SDFGridSparseFile) are streamed directly into the quantized representation of the SDF grid.
+            \param[in] path The path of a dense .sdfg file or a sparse .sdfgs file.
             \return true if the values could be set, otherwise false.
         */
         bool loadValuesFromFile(const std::filesystem::path& path);
@@ -237,6 +238,14 @@ namespace Falcor
     protected:
         virtual void setValuesInternal(const std::vector<float>& cornerValues) = 0;
 
+        /** Set the values of the SDF grid from snorm8 quantized values (see SDFGridSparseFile::quantizeValue()).
+            The default implementation reconstructs float values and calls setValuesInternal().
+            \param[in] values The quantized corner values for all voxels in the grid, (mGridWidth + 1)^3 values.
+        */
+        virtual void setQuantizedValuesInternal(std::vector<int8_t>&& values);
+
+        void checkGridWidth(uint32_t gridWidth) const;
+
         void createEvaluatePrimitivesPass(bool writeToTexture3D, bool mergeWithSDField);
 
         void updatePrimitivesBuffer();
@@ -0,0 +1,280 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "SDFGridSparseFile.h"
+#include "Core/Errors.h"
+#include "Utils/Math/Common.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Falcor
+{
+    namespace
+    {
+        /** Specifies the current file version.
+            This needs to be incremented every time the file format changes!
+        */
+        const uint32_t kVersion = 1;
+
+        const char kMagic[8] = { 'F', 'a', 'l', 'c', 'o', 'r', 'S', 'D' };
+
+        const float kRootThree = 1.73205080756887729353f;
+
+        /** Write a sparse SDF grid file from a sequence of value slices.
+            \param[in] getSlice Function filling the quantized values of slice z, i.e., (gridWidth + 1)^2 values.
+        */
+        template<typename SliceFunc>
+        void writeSparseFile(const std::filesystem::path& path, uint32_t gridWidth, uint32_t brickWidth, SliceFunc getSlice)
+        {
+            checkArgument(gridWidth > 0, "'gridWidth' must be larger than zero.");
+            checkArgument(brickWidth > 0, "'brickWidth' must be larger than zero.");
+
+            SDFGridSparseFile::Header header;
+            std::memcpy(header.magic, kMagic, sizeof(header.magic));
+            header.version = kVersion;
+            header.gridWidth = gridWidth;
+            header.brickWidth = brickWidth;
+            header.bricksPerAxis = div_round_up(header.getValueWidth(), brickWidth);
+
+            std::ofstream fs(path, std::ios::out | std::ios::binary);
+            if (!fs.good()) throw RuntimeError("Failed to create sparse SDF grid file '{}'.", path);
+
+            // Write placeholders for the header and occupancy index, they are rewritten once all bricks are classified.
+            std::vector<SDFGridSparseFile::BrickState> states(header.getBrickCount(), SDFGridSparseFile::BrickState::Outside);
+            fs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            fs.write(reinterpret_cast<const char*>(states.data()), states.size());
+
+            const uint32_t valueWidth = header.getValueWidth();
+            const size_t sliceSize = (size_t)valueWidth * valueWidth;
+            const uint32_t n = header.bricksPerAxis;
+            std::vector<int8_t> slab(sliceSize * brickWidth);
+            std::vector<int8_t> brick(header.getBrickValueCount());
+
+            for (uint32_t bz = 0; bz < n; bz++)
+            {
+                // Fetch the slices covered by this layer of bricks.
+                const uint32_t z0 = bz * brickWidth;
+                const uint32_t sliceCount = std::min(brickWidth, valueWidth - z0);
+                for (uint32_t s = 0; s < sliceCount; s++) getSlice(z0 + s, slab.data() + s * sliceSize);
+
+                for (uint32_t by = 0; by < n; by++)
+                {
+                    for (uint32_t bx = 0; bx < n; bx++)
+                    {
+                        const uint32_t x0 = bx * brickWidth;
+                        const uint32_t y0 = by * brickWidth;
+                        const uint32_t countX = std::min(brickWidth, valueWidth - x0);
+                        const uint32_t countY = std::min(brickWidth, valueWidth - y0);
+
+                        std::fill(brick.begin(), brick.end(), int8_t(0));
+                        bool allOutside = true;
+                        bool allInside = true;
+
+                        for (uint32_t z = 0; z < sliceCount; z++)
+                        {
+                            for (uint32_t y = 0; y < countY; y++)
+                            {
+                                const int8_t* pSrc = slab.data() + z * sliceSize + (size_t)(y0 + y) * valueWidth + x0;
+                                int8_t* pDst = brick.data() + (size_t)(z * brickWidth + y) * brickWidth;
+                                for (uint32_t x = 0; x < countX; x++)
+                                {
+                                    const int8_t v = pSrc[x];
+                                    pDst[x] = v;
+                                    allOutside = allOutside && v == INT8_MAX;
+                                    allInside = allInside && v == -INT8_MAX;
+                                }
+                            }
+                        }
+
+                        auto& state = states[bx + (size_t)n * (by + (size_t)n * bz)];
+                        if (allOutside) state = SDFGridSparseFile::BrickState::Outside;
+                        else if (allInside) state = SDFGridSparseFile::BrickState::Inside;
+                        else
+                        {
+                            state = SDFGridSparseFile::BrickState::Surface;
+                            fs.write(reinterpret_cast<const char*>(brick.data()), brick.size());
+                            header.surfaceBrickCount++;
+                        }
+                    }
+                }
+            }
+
+            fs.seekp(0);
+            fs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            fs.write(reinterpret_cast<const char*>(states.data()), states.size());
+
+            if (!fs.good()) throw RuntimeError("Failed to write sparse SDF grid file '{}'.", path);
+        }
+
+        SDFGridSparseFile::Header readHeaderFromStream(std::istream& stream, const std::filesystem::path& path)
+        {
+            SDFGridSparseFile::Header header;
+            stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+            if (!stream.good() || std::memcmp(header.magic, kMagic, sizeof(header.magic)) != 0)
+            {
+                throw RuntimeError("'{}' is not a sparse SDF grid file.", path);
+            }
+            if (header.version != kVersion)
+            {
+                throw RuntimeError("Sparse SDF grid file '{}' has unsupported version {} (expected {}).", path, header.version, kVersion);
+            }
+            if (header.gridWidth == 0 || header.brickWidth == 0 || header.bricksPerAxis != div_round_up(header.getValueWidth(), header.brickWidth))
+            {
+                throw RuntimeError("Sparse SDF grid file '{}' has an invalid header.", path);
+            }
+            return header;
+        }
+    }
+
+    int8_t SDFGridSparseFile::quantizeValue(float value, uint32_t gridWidth)
+    {
+        // Matches the quantization done by SDFSVS, SDFSBS and SDFSVO.
+        float normalizationFactor = 2.0f * gridWidth / kRootThree;
+        float normalizedValue = std::clamp(value * normalizationFactor, -1.0f, 1.0f);
+        float integerScale = normalizedValue * float(INT8_MAX);
+        return integerScale >= 0.0f ? int8_t(integerScale + 0.5f) : int8_t(integerScale - 0.5f);
+    }
+
+    float SDFGridSparseFile::dequantizeValue(int8_t value, uint32_t gridWidth)
+    {
+        float normalizationFactor = 2.0f * gridWidth / kRootThree;
+        return (float(value) / float(INT8_MAX)) / normalizationFactor;
+    }
+
+    void SDFGridSparseFile::write(const std::filesystem::path& path, const std::vector<float>& cornerValues, uint32_t gridWidth, uint32_t brickWidth)
+    {
+        const size_t valueWidth = (size_t)gridWidth + 1;
+        const size_t sliceSize = valueWidth * valueWidth;
+        checkArgument(cornerValues.size() == sliceSize * valueWidth, "'cornerValues' size ({}) does not match 'gridWidth' ({}).", cornerValues.size(), gridWidth);
+
+        writeSparseFile(path, gridWidth, brickWidth, [&](uint32_t z, int8_t* pDst)
+        {
+            const float* pSrc = cornerValues.data() + z * sliceSize;
+            for (size_t i = 0; i < sliceSize; i++) pDst[i] = quantizeValue(pSrc[i], gridWidth);
+        });
+    }
+
+    void SDFGridSparseFile::convertFromDenseFile(const std::filesystem::path& densePath, const std::filesystem::path& sparsePath, uint32_t brickWidth)
+    {
+        std::ifstream file(densePath, std::ios::in | std::ios::binary);
+        if (!file.good()) throw RuntimeError("Failed to open SDF grid file '{}'.", densePath);
+
+        uint32_t gridWidth = 0;
+        file.read(reinterpret_cast<char*>(&gridWidth), sizeof(uint32_t));
+        if (!file.good() || gridWidth == 0) throw RuntimeError("SDF grid file '{}' has an invalid header.", densePath);
+
+        // Slices are read in order, so the dense file is streamed through a single slice buffer.
+        const size_t valueWidth = (size_t)gridWidth + 1;
+        const size_t sliceSize = valueWidth * valueWidth;
+        std::vector<float> slice(sliceSize);
+
+        writeSparseFile(sparsePath, gridWidth, brickWidth, [&](uint32_t z, int8_t* pDst)
+        {
+            file.read(reinterpret_cast<char*>(slice.data()), sliceSize * sizeof(float));
+            if (!file.good()) throw RuntimeError("Failed to read slice {} from SDF grid file '{}'.", z, densePath);
+            for (size_t i = 0; i < sliceSize; i++) pDst[i] = quantizeValue(slice[i], gridWidth);
+        });
+    }
+
+    SDFGridSparseFile::Header SDFGridSparseFile::readHeader(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file.good()) throw RuntimeError("Failed to open sparse SDF grid file '{}'.", path);
+        return readHeaderFromStream(file, path);
+    }
+
+    uint32_t SDFGridSparseFile::readQuantizedValues(const std::filesystem::path& path, std::vector<int8_t>& values)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file.good()) throw RuntimeError("Failed to open sparse SDF grid file '{}'.", path);
+
+        const Header header = readHeaderFromStream(file, path);
+
+        std::vector<BrickState> states(header.getBrickCount());
+        file.read(reinterpret_cast<char*>(states.data()), states.size());
+        if (!file.good()) throw RuntimeError("Failed to read occupancy index from sparse SDF grid file '{}'.", path);
+
+        const uint64_t surfaceBrickCount = std::count(states.begin(), states.end(), BrickState::Surface);
+        if (surfaceBrickCount != header.surfaceBrickCount) throw RuntimeError("Sparse SDF grid file '{}' has an inconsistent occupancy index.", path);
+
+        const uint32_t valueWidth = header.getValueWidth();
+        const size_t sliceSize = (size_t)valueWidth * valueWidth;
+        const uint32_t brickWidth = header.brickWidth;
+        const uint32_t n = header.bricksPerAxis;
+
+        values.resize(sliceSize * valueWidth);
+        std::vector<int8_t> brick(header.getBrickValueCount());
+
+        for (uint32_t bz = 0; bz < n; bz++)
+        {
+            for (uint32_t by = 0; by < n; by++)
+            {
+                for (uint32_t bx = 0; bx < n; bx++)
+                {
+                    const BrickState state = states[bx + (size_t)n * (by + (size_t)n * bz)];
+                    const uint32_t x0 = bx * brickWidth;
+                    const uint32_t y0 = by * brickWidth;
+                    const uint32_t z0 = bz * brickWidth;
+                    const uint32_t countX = std::min(brickWidth, valueWidth - x0);
+                    const uint32_t countY = std::min(brickWidth, valueWidth - y0);
+                    const uint32_t countZ = std::min(brickWidth, valueWidth - z0);
+
+                    if (state == BrickState::Surface)
+                    {
+                        file.read(reinterpret_cast<char*>(brick.data()), brick.size());
+                        if (!file.good()) throw RuntimeError("Failed to read brick values from sparse SDF grid file '{}'.", path);
+
+                        for (uint32_t z = 0; z < countZ; z++)
+                        {
+                            for (uint32_t y = 0; y < countY; y++)
+                            {
+                                const int8_t* pSrc = brick.data() + (size_t)(z * brickWidth + y) * brickWidth;
+                                int8_t* pDst = values.data() + (z0 + z) * sliceSize + (size_t)(y0 + y) * valueWidth + x0;
+                                std::memcpy(pDst, pSrc, countX);
+                            }
+                        }
+                    }
+                    else
+                    {
+                        const int8_t fillValue = state == BrickState::Inside ? -INT8_MAX : INT8_MAX;
+                        for (uint32_t z = 0; z < countZ; z++)
+                        {
+                            for (uint32_t y = 0; y < countY; y++)
+                            {
+                                int8_t* pDst = values.data() + (z0 + z) * sliceSize + (size_t)(y0 + y) * valueWidth + x0;
+                                std::memset(pDst, fillValue, countX);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        return header.gridWidth;
+    }
+}
@@ -0,0 +1,130 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace Falcor
+{
+    /** Reader/writer for sparse narrow-band SDF grid files (.sdfgs).
+
+        The dense .sdfg format stores (gridWidth + 1)^3 floats. The sparse SDF grid types (SDFSVS, SDFSBS, SDFSVO) only
+        keep distances normalized to [-1, 1] (where 1 represents half of a voxel diagonal) and quantized to snorm8,
+        i.e., they only keep the narrow band around the surface.
+
+        The sparse format stores exactly this data. The grid of values is divided into bricks of brickWidth^3 values.
+        An occupancy index stores one state per brick: bricks that are completely outside (+1) or inside (-1) the narrow band
+        store no values, all other bricks store their quantized values. Loading therefore only costs I/O proportional to the
+        narrow band, and values can be fed directly to the quantized representation of the SDF grids without creating a
+        dense float grid.
+
+        File layout:
+        - Header
+        - Occupancy index: one BrickState per brick, bricks ordered x-fastest.
+        - Brick values: brickWidth^3 int8 values per surface brick (x-fastest), in the same order as the index.
+          Values of bricks crossing the grid border are padded with zero.
+    */
+    class FALCOR_API SDFGridSparseFile
+    {
+    public:
+        static constexpr uint32_t kDefaultBrickWidth = 8;
+
+        enum class BrickState : uint8_t
+        {
+            Outside = 0,    ///< All values are +1, no values stored.
+            Inside = 1,     ///< All values are -1, no values stored.
+            Surface = 2,    ///< Brick intersects the narrow band, values stored.
+        };
+
+        struct Header
+        {
+            uint8_t magic[8]{};
+            uint32_t version = 0;
+            uint32_t gridWidth = 0;             ///< Grid width in voxels. The grid holds (gridWidth + 1)^3 values.
+            uint32_t brickWidth = 0;            ///< Brick width in values.
+            uint32_t bricksPerAxis = 0;         ///< Number of bricks along each axis.
+            uint32_t surfaceBrickCount = 0;     ///< Number of bricks with stored values.
+            uint32_t reserved = 0;
+
+            uint32_t getValueWidth() const { return gridWidth + 1; }
+            uint64_t getBrickCount() const { return (uint64_t)bricksPerAxis * bricksPerAxis * bricksPerAxis; }
+            uint64_t getBrickValueCount() const { return (uint64_t)brickWidth * brickWidth * brickWidth; }
+        };
+
+        /** Quantize a distance to the snorm8 representation used by the sparse SDF grids.
+            \param[in] value Signed distance in the local space of the SDF grid.
+            \param[in] gridWidth The grid width in voxels.
+            \return The quantized distance.
+        */
+        static int8_t quantizeValue(float value, uint32_t gridWidth);
+
+        /** Reconstruct a distance from its quantized representation.
+            Distances outside the narrow band are clamped to half a voxel diagonal.
+            \param[in] value Quantized distance.
+            \param[in] gridWidth The grid width in voxels.
+            \return Signed distance in the local space of the SDF grid.
+        */
+        static float dequantizeValue(int8_t value, uint32_t gridWidth);
+
+        /** Write a sparse SDF grid file from dense corner values.
+            Throws an exception on failure.
+            \param[in] path Path of the output file.
+            \param[in] cornerValues The corner values for all voxels in the grid, (gridWidth + 1)^3 values.
+            \param[in] gridWidth The grid width in voxels.
+            \param[in] brickWidth Brick width in values.
+        */
+        static void write(const std::filesystem::path& path, const std::vector<float>& cornerValues, uint32_t gridWidth, uint32_t brickWidth = kDefaultBrickWidth);
+
+        /** Convert a dense SDF grid file (.sdfg) to the sparse format.
+            The dense file is streamed, only brickWidth slices of values are kept in memory at a time.
+            Throws an exception on failure.
+            \param[in] densePath Path of the dense input file.
+            \param[in] sparsePath Path of the sparse output file.
+            \param[in] brickWidth Brick width in values.
+        */
+        static void convertFromDenseFile(const std::filesystem::path& densePath, const std::filesystem::path& sparsePath, uint32_t brickWidth = kDefaultBrickWidth);
+
+        /** Read the header of a sparse SDF grid file.
+            Throws an exception on failure.
+            \param[in] path Path of the sparse file.
+            \return The file header.
+        */
+        static Header readHeader(const std::filesystem::path& path);
+
+        /** Read a sparse SDF grid file into a dense field of quantized values.
+            The brick values are streamed from the file, no dense float grid is created.
+            Throws an exception on failure.
+            \param[in] path Path of the sparse file.
+            \param[out] values The quantized values, (gridWidth + 1)^3 values.
+            \return The grid width in voxels.
+        */
+        static uint32_t readQuantizedValues(const std::filesystem::path& path, std::vector<int8_t>& values);
+    };
+}
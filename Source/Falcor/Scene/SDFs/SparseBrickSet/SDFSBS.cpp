@@ -976,6 +976,11 @@ namespace Falcor
         }
     }
 
+    void SDFSBS::setQuantizedValuesInternal(std::vector<int8_t>&& values)
+    {
+        mSDField = std::move(values);
+    }
+
     void SDFSBS::createSDFGridTexture(RenderContext* pRenderContext, const std::vector<int8_t>& sdField)
     {
         checkArgument(!sdField.empty(), "Cannot create SDF grid texture from empty values vector");
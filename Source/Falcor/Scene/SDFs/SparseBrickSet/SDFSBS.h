@@ -78,6 +78,7 @@ namespace Falcor
         void allocatePrimitiveBits();
 
         virtual void setValuesInternal(const std::vector<float>& cornerValues) override;
+        virtual void setQuantizedValuesInternal(std::vector<int8_t>&& values) override;
 
         void createSDFGridTexture(RenderContext* pRenderContext, const std::vector<int8_t>& sdField);
 
@@ -62,6 +62,7 @@ namespace Falcor
 
     protected:
         virtual void setValuesInternal(const std::vector<float>& cornerValues) override;
+        virtual void setQuantizedValuesInternal(std::vector<int8_t>&& values) override;
 
     private:
         SDFSVO(std::shared_ptr<Device> pDevice) : SDFGrid(std::move(pDevice)) {}
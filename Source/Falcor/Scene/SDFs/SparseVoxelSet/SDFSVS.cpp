@@ -187,4 +187,9 @@ namespace Falcor
             mValues[v] = integerScale >= 0.0f ? int8_t(integerScale + 0.5f) : int8_t(integerScale - 0.5f);
         }
     }
+
+    void SDFSVS::setQuantizedValuesInternal(std::vector<int8_t>&& values)
+    {
+        mValues = std::move(values);
+    }
 }
@@ -59,6 +59,7 @@ namespace Falcor
 
     protected:
         virtual void setValuesInternal(const std::vector<float>& cornerValues) override;
+        virtual void setQuantizedValuesInternal(std::vector<int8_t>&& values) override;
 
     private:
         SDFSVS(std::shared_ptr<Device> pDevice) : SDFGrid(std::move(pDevice)) {}
@@ -172,6 +172,7 @@ namespace Falcor
         mMeshBBs = std::move(sceneData.meshBBs);
         mMeshIdToInstanceIds = std::move(sceneData.meshIdToInstanceIds);
         mMeshGroups = std::move(sceneData.meshGroups);
+        mMeshlets = std::move(sceneData.meshlets);
 
         mUseCompressedHitInfo = sceneData.useCompressedHitInfo;
         mHas16BitIndices = sceneData.has16BitIndices;
@@ -241,6 +242,9 @@ namespace Falcor
 
         // Finalize scene.
         finalize();
+
+        // Build the CPU BVH. This requires the global matrices computed in finalize().
+        if (sceneData.buildCPUBVH) createCPUBVH(sceneData.meshIndexData, sceneData.meshStaticData);
     }
 
     Scene::SharedPtr Scene::create(std::shared_ptr<Device> pDevice, const std::filesystem::path& path, const Settings& settings)
@@ -350,9 +354,11 @@ namespace Falcor
         auto pCurrentRS = pState->getRasterizerState();
         bool isIndexed = hasIndexBuffer();
 
-        for (const auto& draw : mDrawArgs)
+        const auto& drawArgs = mDrawCullingEnabled ? cullDraws(pState) : mDrawArgs;
+
+        for (const auto& draw : drawArgs)
         {
-            FALCOR_ASSERT(draw.count > 0);
+            if (draw.count == 0) continue;
 
             // Set state.
             pState->setVao(draw.ibFormat == ResourceFormat::R16Uint ? mpMeshVao16Bit : mpMeshVao);
@@ -617,6 +623,63 @@ namespace Falcor
         }
     }
 
+    void Scene::createCPUBVH(const std::vector<uint32_t>& indexData, const std::vector<PackedStaticVertexData>& staticData)
+    {
+        // Extract the object-space positions and 32-bit indices of all meshes.
+        const uint8_t* indexData8 = reinterpret_cast<const uint8_t*>(indexData.data());
+        std::vector<SceneBVH::Mesh> meshes(mMeshDesc.size());
+        for (size_t meshID = 0; meshID < mMeshDesc.size(); ++meshID)
+        {
+            const MeshDesc& desc = mMeshDesc[meshID];
+            SceneBVH::Mesh& mesh = meshes[meshID];
+
+            FALCOR_ASSERT((size_t)desc.vbOffset + desc.vertexCount <= staticData.size());
+            mesh.positions.resize(desc.vertexCount);
+            for (uint32_t i = 0; i < desc.vertexCount; ++i) mesh.positions[i] = staticData[(size_t)desc.vbOffset + i].position;
+
+            const uint32_t indexCount = desc.getTriangleCount() * 3;
+            mesh.indices.resize(indexCount);
+            if (!desc.useVertexIndices())
+            {
+                std::iota(mesh.indices.begin(), mesh.indices.end(), 0);
+            }
+            else if (desc.use16BitIndices())
+            {
+                const uint16_t* indices = reinterpret_cast<const uint16_t*>(indexData8 + desc.ibOffset * 4);
+                std::copy(indices, indices + indexCount, mesh.indices.begin());
+            }
+            else
+            {
+                const uint32_t* indices = reinterpret_cast<const uint32_t*>(indexData8 + desc.ibOffset * 4);
+                std::copy(indices, indices + indexCount, mesh.indices.begin());
+            }
+        }
+
+        const auto& globalMatrices = mpAnimationController->getGlobalMatrices();
+        std::vector<SceneBVH::Instance> instances;
+        for (uint32_t instanceID = 0; instanceID < getGeometryInstanceCount(); ++instanceID)
+        {
+            const auto& inst = mGeometryInstanceData[instanceID];
+            if (inst.getType() != GeometryType::TriangleMesh) continue;
+            instances.push_back({ inst.geometryID, instanceID, globalMatrices[inst.globalMatrixID] });
+        }
+
+        mpCPUBVH = SceneBVH::create(std::move(meshes), std::move(instances));
+    }
+
+    void Scene::updateCPUBVH()
+    {
+        // The instances are in the same order as in createCPUBVH().
+        const auto& globalMatrices = mpAnimationController->getGlobalMatrices();
+        std::vector<float4x4> transforms;
+        transforms.reserve(mpCPUBVH->getInstanceCount());
+        for (const auto& inst : mGeometryInstanceData)
+        {
+            if (inst.getType() == GeometryType::TriangleMesh) transforms.push_back(globalMatrices[inst.globalMatrixID]);
+        }
+        mpCPUBVH->setInstanceTransforms(transforms);
+    }
+
     void Scene::setSDFGridConfig()
     {
         if (mSDFGrids.empty()) return;
@@ -906,6 +969,9 @@ namespace Falcor
             uint32_t byteSize = (uint32_t)(mGeometryInstanceData.size() * sizeof(GeometryInstanceData));
             mpGeometryInstancesBuffer->setBlob(mGeometryInstanceData.data(), 0, byteSize);
         }
+
+        // The draw list is created after the initial forced update in finalize().
+        if (dataChanged && !forceUpdate) updateDrawList();
     }
 
     Scene::UpdateFlags Scene::updateRaytracingAABBData(bool forceUpdate)
@@ -1371,8 +1437,12 @@ namespace Falcor
 
         for (const auto& draw : mDrawArgs)
         {
-            FALCOR_ASSERT(draw.pBuffer);
-            s.geometryMemoryInBytes += draw.pBuffer->getSize();
+            s.geometryMemoryInBytes += draw.pBuffer ? draw.pBuffer->getSize() : 0;
+        }
+
+        for (const auto& draw : mCulledDrawArgs)
+        {
+            s.geometryMemoryInBytes += draw.pBuffer ? draw.pBuffer->getSize() : 0;
         }
 
         s.animationMemoryInBytes += getAnimationController()->getMemoryUsageInBytes();
@@ -1802,6 +1872,8 @@ namespace Falcor
         {
             invalidateTlasCache();
             updateGeometryInstances(false);
+            if (mpCPUBVH) updateCPUBVH();
+            mDrawCullingBoundsDirty = true;
         }
 
         // Update existing BLASes if skinned animation and/or procedural primitives moved.
@@ -1959,6 +2031,30 @@ namespace Falcor
             renderSettingsGroup.slider("Diffuse albedo multiplier", mRenderSettings.diffuseAlbedoMultiplier);
         }
 
+        if (auto cullingGroup = widget.group("Draw Culling"))
+        {
+            cullingGroup.checkbox("Enable", mDrawCullingEnabled);
+            cullingGroup.tooltip("This enables culling of the rasterized meshes on the CPU against the selected camera.", true);
+
+            auto settings = getDrawCullingSettings();
+            bool changed = cullingGroup.checkbox("Frustum culling", settings.frustumCulling);
+            changed |= cullingGroup.var("Min pixel size", settings.minPixelSize, 0.f, 64.f, 0.25f);
+            cullingGroup.tooltip("Meshes whose projected bounding box is smaller than this in both dimensions are culled. Zero disables small-object culling.", true);
+            if (changed) setDrawCullingSettings(settings);
+
+            if (mDrawCullingEnabled)
+            {
+                const auto& stats = getDrawCullingStats();
+                std::ostringstream oss;
+                oss << "Instances: " << stats.instanceCount << std::endl
+                    << "Frustum culled: " << stats.frustumCulledCount << std::endl
+                    << "Size culled: " << stats.sizeCulledCount << std::endl
+                    << "Visible: " << stats.visibleCount << std::endl
+                    << "Draws: " << stats.drawCount << std::endl;
+                cullingGroup.text(oss.str());
+            }
+        }
+
         if (mSDFGridConfig.implementation != SDFGrid::Type::None)
         {
             if (auto sdfGridConfigGroup = widget.group("SDF Grid Settings"))
@@ -2583,82 +2679,120 @@ namespace Falcor
         // This function creates argument buffers for draw indirect calls to rasterize the scene.
         // The updateGeometryInstances() function must have been called before so that the flags are accurate.
         //
-        // Note that we create four draw buffers to handle all combinations of:
+        // Note that the draw list has four groups to handle all combinations of:
         // 1) mesh is using 16- or 32-bit indices,
         // 2) mesh triangle winding is CW or CCW after transformation.
-        //
-        // TODO: Update the draw args if a mesh undergoes animation that flips the winding.
+        // Instances of the same mesh with contiguous instance IDs are merged into multi-instance draws.
 
-        mDrawArgs.clear();
+        mDrawListBuilder.build(mGeometryInstanceData, mMeshDesc, hasIndexBuffer());
+        updateDrawArgs((1u << DrawListBuilder::kGroupCount) - 1);
+    }
+
+    void Scene::updateDrawList()
+    {
+        // Move instances whose winding flipped due to animation to their new group.
+        // Only the groups that gained or lost instances are rebuilt and uploaded.
+        uint32_t changedGroups = mDrawListBuilder.update(mGeometryInstanceData);
+        if (changedGroups != 0) updateDrawArgs(changedGroups);
+    }
+
+    void Scene::updateDrawArgs(uint32_t groupMask)
+    {
+        const auto& groups = mDrawListBuilder.getGroups();
 
-        // Helper to create the draw-indirect buffer.
-        auto createDrawBuffer = [this](const auto& drawMeshes, bool ccw, ResourceFormat ibFormat = ResourceFormat::Unknown)
+        for (uint32_t i = 0; i < DrawListBuilder::kGroupCount; ++i)
         {
-            if (drawMeshes.size() > 0)
+            if ((groupMask & (1u << i)) == 0) continue;
+
+            const auto& group = groups[i];
+            DrawArgs& draw = mDrawArgs[i];
+            draw.count = group.getDrawCount();
+            draw.ccw = group.ccw;
+            draw.ibFormat = group.ibFormat;
+            draw.pBuffer = nullptr;
+
+            if (draw.count == 0) continue;
+
+            if (group.ibFormat != ResourceFormat::Unknown)
             {
-                DrawArgs draw;
-                draw.pBuffer = Buffer::create(mpDevice.get(), sizeof(drawMeshes[0]) * drawMeshes.size(), Resource::BindFlags::IndirectArg, Buffer::CpuAccess::None, drawMeshes.data());
-                draw.pBuffer->setName("Scene draw buffer");
-                FALCOR_ASSERT(drawMeshes.size() <= std::numeric_limits<uint32_t>::max());
-                draw.count = (uint32_t)drawMeshes.size();
-                draw.ccw = ccw;
-                draw.ibFormat = ibFormat;
-                mDrawArgs.push_back(draw);
+                draw.pBuffer = Buffer::create(mpDevice.get(), sizeof(DrawIndexedArguments) * draw.count, Resource::BindFlags::IndirectArg, Buffer::CpuAccess::None, group.indexedDraws.data());
             }
-        };
+            else
+            {
+                draw.pBuffer = Buffer::create(mpDevice.get(), sizeof(DrawArguments) * draw.count, Resource::BindFlags::IndirectArg, Buffer::CpuAccess::None, group.draws.data());
+            }
+            draw.pBuffer->setName("Scene draw buffer");
+        }
+    }
+
+        // The culled draw lists are built from the full draw lists.
+        mDrawCullingDirty = true;
+    }
 
-        if (hasIndexBuffer())
+    void Scene::setDrawCullingSettings(const DrawCuller::Settings& settings)
+    {
+        if (settings != mDrawCuller.getSettings())
         {
-            std::vector<DrawIndexedArguments> drawClockwiseMeshes[2], drawCounterClockwiseMeshes[2];
+            mDrawCuller.setSettings(settings);
+            mDrawCullingDirty = true;
+        }
+    }
 
-            uint32_t instanceID = 0;
-            for (const auto& instance : mGeometryInstanceData)
-            {
-                if (instance.getType() != GeometryType::TriangleMesh) continue;
+    void Scene::updateDrawCullingBounds()
+    {
+        // Skinned and vertex-animated meshes get invalid bounds so they are never culled,
+        // as their object-space bounds are not updated by the animation.
+        const auto& globalMatrices = mpAnimationController->getGlobalMatrices();
 
-                const auto& mesh = mMeshDesc[instance.geometryID];
-                bool use16Bit = mesh.use16BitIndices();
+        mDrawCullingBounds.clear();
+        for (const auto& inst : mGeometryInstanceData)
+        {
+            if (inst.getType() != GeometryType::TriangleMesh) continue;
+            mDrawCullingBounds.push_back(inst.isDynamic() ? AABB() : mMeshBBs[inst.geometryID].transform(globalMatrices[inst.globalMatrixID]));
+        }
+        mDrawCullingBoundsDirty = false;
+    }
 
-                DrawIndexedArguments draw;
-                draw.IndexCountPerInstance = mesh.indexCount;
-                draw.InstanceCount = 1;
-                draw.StartIndexLocation = mesh.ibOffset * (use16Bit ? 2 : 1);
-                draw.BaseVertexLocation = mesh.vbOffset;
-                draw.StartInstanceLocation = instanceID++;
+    const std::array<Scene::DrawArgs, DrawListBuilder::kGroupCount>& Scene::cullDraws(const GraphicsState* pState)
+    {
+        const auto& viewport = pState->getViewport(0);
+        DrawCuller::View view(getCamera()->getViewProjMatrix(), float2(viewport.width, viewport.height));
 
-                int i = use16Bit ? 0 : 1;
-                (instance.isWorldFrontFaceCW()) ? drawClockwiseMeshes[i].push_back(draw) : drawCounterClockwiseMeshes[i].push_back(draw);
-            }
+        if (!mDrawCullingDirty && !mDrawCullingBoundsDirty && view == mDrawCullingView) return mCulledDrawArgs;
 
-            createDrawBuffer(drawClockwiseMeshes[0], false, ResourceFormat::R16Uint);
-            createDrawBuffer(drawClockwiseMeshes[1], false, ResourceFormat::R32Uint);
-            createDrawBuffer(drawCounterClockwiseMeshes[0], true, ResourceFormat::R16Uint);
-            createDrawBuffer(drawCounterClockwiseMeshes[1], true, ResourceFormat::R32Uint);
-        }
-        else
-        {
-            std::vector<DrawArguments> drawClockwiseMeshes, drawCounterClockwiseMeshes;
+        if (mDrawCullingBoundsDirty) updateDrawCullingBounds();
+        mDrawCuller.cull(view, mDrawCullingBounds, mDrawListBuilder);
+        mDrawCullingView = view;
+        mDrawCullingDirty = false;
 
-            uint32_t instanceID = 0;
-            for (const auto& instance : mGeometryInstanceData)
-            {
-                if (instance.getType() != GeometryType::TriangleMesh) continue;
+        const auto& groups = mDrawCuller.getGroups();
+        for (uint32_t i = 0; i < DrawListBuilder::kGroupCount; ++i)
+        {
+            const auto& group = groups[i];
+            DrawArgs& draw = mCulledDrawArgs[i];
+            draw.count = group.getDrawCount();
+            draw.ccw = group.ccw;
+            draw.ibFormat = group.ibFormat;
 
-                const auto& mesh = mMeshDesc[instance.geometryID];
-                FALCOR_ASSERT(mesh.indexCount == 0);
+            if (draw.count == 0) continue;
 
-                DrawArguments draw;
-                draw.VertexCountPerInstance = mesh.vertexCount;
-                draw.InstanceCount = 1;
-                draw.StartVertexLocation = mesh.vbOffset;
-                draw.StartInstanceLocation = instanceID++;
+            bool isIndexed = group.ibFormat != ResourceFormat::Unknown;
+            const void* pData = isIndexed ? (const void*)group.indexedDraws.data() : (const void*)group.draws.data();
+            size_t size = draw.count * (isIndexed ? sizeof(DrawIndexedArguments) : sizeof(DrawArguments));
 
-                (instance.isWorldFrontFaceCW()) ? drawClockwiseMeshes.push_back(draw) : drawCounterClockwiseMeshes.push_back(draw);
+            // The buffers are only grown so that they are reused as the view changes.
+            if (!draw.pBuffer || draw.pBuffer->getSize() < size)
+            {
+                draw.pBuffer = Buffer::create(mpDevice.get(), size, Resource::BindFlags::IndirectArg, Buffer::CpuAccess::None, pData);
+                draw.pBuffer->setName("Scene culled draw buffer");
+            }
+            else
+            {
+                draw.pBuffer->setBlob(pData, 0, size);
             }
-
-            createDrawBuffer(drawClockwiseMeshes, false);
-            createDrawBuffer(drawCounterClockwiseMeshes, true);
         }
+
+        return mCulledDrawArgs;
     }
 
     void Scene::initGeomDesc(RenderContext* pRenderContext)
@@ -4080,6 +4214,8 @@ namespace Falcor
     {
         using namespace pybind11::literals;
 
+        FALCOR_SCRIPT_BINDING_DEPENDENCY(SceneBVH)
+
         pybind11::class_<Scene, Scene::SharedPtr> scene(m, "Scene");
 
         scene.def_property_readonly(kStats.c_str(), [](const Scene* pScene) { return pScene->getSceneStats().toPython(); });
@@ -4108,6 +4244,7 @@ namespace Falcor
             pScene->setCameraBounds(AABB(minPoint, maxPoint));
             }, "minPoint"_a, "maxPoint"_a);
         scene.def("getGeometryUVTiles", &Scene::getGeometryUVTiles, "geometryID"_a);
+        scene.def_property_readonly("cpuBVH", &Scene::getCPUBVH);
 
         // Materials
         scene.def_property_readonly(kMaterials.c_str(), &Scene::getMaterials);
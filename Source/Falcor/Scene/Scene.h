@@ -29,6 +29,9 @@
 #include "SceneIDs.h"
 #include "SceneTypes.slang"
 #include "HitInfo.h"
+#include "DrawCuller.h"
+#include "DrawListBuilder.h"
+#include "SceneBVH.h"
 #include "Animation/Animation.h"
 #include "Animation/AnimationController.h"
 #include "Displacement/DisplacementUpdateTask.slang"
@@ -327,10 +330,12 @@ namespace Falcor
             std::vector<GeometryInstanceData> meshInstanceData;     ///< List of mesh instances.
             std::vector<std::vector<uint32_t>> meshIdToInstanceIds; ///< Mapping of what instances belong to which mesh.
             std::vector<MeshGroup> meshGroups;                      ///< List of mesh groups. Each group maps to a BLAS for ray tracing.
+            std::vector<MeshletDesc> meshlets;                      ///< List of meshlets sorted by mesh ID. Only built with SceneBuilder::Flags::BuildMeshlets.
             std::vector<CachedMesh> cachedMeshes;                   ///< Cached data for vertex-animated meshes.
             uint32_t prevVertexCount = 0;                           ///< Number of vertices that the AnimationController needs to allocate to store previous frame vertices.
 
             bool useCompressedHitInfo = false;                      ///< True if scene should used compressed HitInfo (on scenes with triangles meshes only).
+            bool buildCPUBVH = false;                               ///< True if a CPU BVH should be built over the triangle mesh instances.
             bool has16BitIndices = false;                           ///< True if 16-bit mesh indices are used.
             bool has32BitIndices = false;                           ///< True if 32-bit mesh indices are used.
             uint32_t meshDrawCount = 0;                             ///< Number of meshes to draw.
@@ -883,6 +888,18 @@ namespace Falcor
         */
         const AABB& getMeshBounds(uint32_t meshID) const { return mMeshBBs[meshID]; }
 
+        /** Get the list of meshlets, sorted by mesh ID.
+            The list is empty unless the scene was built with SceneBuilder::Flags::BuildMeshlets.
+        */
+        const std::vector<MeshletDesc>& getMeshlets() const { return mMeshlets; }
+
+        /** Get the CPU BVH over the triangle mesh instances, for picking and other spatial queries without the GPU.
+            The BVH is only built with SceneBuilder::Flags::BuildCPUBVH, otherwise nullptr is returned.
+            The instance IDs reported by the queries are global geometry instance IDs. The BVH is refit when instances move,
+            but skinned and vertex-animated meshes are represented in their rest pose.
+        */
+        const SceneBVH::SharedPtr& getCPUBVH() const { return mpCPUBVH; }
+
         /** Get a curve's bounds in object space.
         */
         const AABB& getCurveBounds(uint32_t curveID) const { return mCurveBBs[curveID]; }
@@ -977,6 +994,29 @@ namespace Falcor
         */
         void rasterize(RenderContext* pRenderContext, GraphicsState* pState, GraphicsVars* pVars, const RasterizerState::SharedPtr& pRasterizerStateCW, const RasterizerState::SharedPtr& pRasterizerStateCCW);
 
+        /** Enable or disable CPU culling of the rasterized meshes.
+            When enabled, rasterize() culls the triangle mesh instances against the selected camera and the first viewport of
+            the graphics state, and draws only the visible instances. Skinned and vertex-animated instances are never culled.
+            \param[in] enabled True to enable culling.
+        */
+        void setDrawCullingEnabled(bool enabled) { mDrawCullingEnabled = enabled; }
+
+        /** Check if CPU culling of the rasterized meshes is enabled.
+        */
+        bool isDrawCullingEnabled() const { return mDrawCullingEnabled; }
+
+        /** Set the settings for CPU culling of the rasterized meshes.
+        */
+        void setDrawCullingSettings(const DrawCuller::Settings& settings);
+
+        /** Get the settings for CPU culling of the rasterized meshes.
+        */
+        const DrawCuller::Settings& getDrawCullingSettings() const { return mDrawCuller.getSettings(); }
+
+        /** Get the statistics of the last culling of the rasterized meshes.
+        */
+        const DrawCuller::Stats& getDrawCullingStats() const { return mDrawCuller.getStats(); }
+
         /** Get the required raytracing maximum attribute size for this scene.
             Note: This depends on what types of geometry are used in the scene.
             \return Max attribute size in bytes.
@@ -1113,6 +1153,8 @@ namespace Falcor
         void createMeshVao(uint32_t drawCount, const std::vector<uint32_t>& indexData, const std::vector<PackedStaticVertexData>& staticData, const std::vector<SkinningVertexData>& skinningData);
         void createCurveVao(const std::vector<uint32_t>& indexData, const std::vector<StaticCurveVertexData>& staticData);
         void createMeshUVTiles(const std::vector<MeshDesc>& meshDesc, const std::vector<uint32_t>& indexData, const std::vector<PackedStaticVertexData>& staticData);
+        void createCPUBVH(const std::vector<uint32_t>& indexData, const std::vector<PackedStaticVertexData>& staticData);
+        void updateCPUBVH();
 
         void updateSceneDefines();
         Shader::DefineList getSceneSDFGridDefines() const;
@@ -1157,6 +1199,24 @@ namespace Falcor
         */
         void createDrawList();
 
+        /** Update the draw list for rasterization after the instance winding changed.
+        */
+        void updateDrawList();
+
+        /** Upload the draw-indirect arguments of the draw list groups in the given bit mask.
+        */
+        void updateDrawArgs(uint32_t groupMask);
+
+        /** Compute the world-space bounds of the triangle mesh instances for culling.
+        */
+        void updateDrawCullingBounds();
+
+        /** Cull the rasterized meshes against the selected camera and the viewport of the graphics state.
+            The culled draw lists are cached and only rebuilt if the view, the settings or the geometry changed.
+            \return Draw arguments for the visible meshes.
+        */
+        const std::array<DrawArgs, DrawListBuilder::kGroupCount>& cullDraws(const GraphicsState* pState);
+
         /** Initialize geometry descs for each BLAS.
         */
         void initGeomDesc(RenderContext* pRenderContext);
@@ -1246,7 +1306,16 @@ namespace Falcor
         Vao::SharedPtr mpMeshVao;                                   ///< Vertex array object for the global mesh vertex/index buffers.
         Vao::SharedPtr mpMeshVao16Bit;                              ///< VAO for drawing meshes with 16-bit vertex indices.
         Vao::SharedPtr mpCurveVao;                                  ///< Vertex array object for the global curve vertex/index buffers.
-        std::vector<DrawArgs> mDrawArgs;                            ///< List of draw arguments for rasterizing the meshes in the scene.
+        DrawListBuilder mDrawListBuilder;                           ///< Builder of the draw lists for rasterizing the meshes in the scene.
+        std::array<DrawArgs, DrawListBuilder::kGroupCount> mDrawArgs; ///< Draw arguments for rasterizing the meshes in the scene, one per draw list group. Empty groups have zero count.
+
+        DrawCuller mDrawCuller;                                     ///< CPU culling of the rasterized meshes.
+        bool mDrawCullingEnabled = false;                           ///< True if rasterize() culls the meshes.
+        bool mDrawCullingDirty = true;                              ///< True if the culled draw lists must be rebuilt even if the view is unchanged.
+        bool mDrawCullingBoundsDirty = true;                        ///< True if the instance bounds for culling must be recomputed.
+        DrawCuller::View mDrawCullingView;                          ///< View the culled draw lists were built for.
+        std::vector<AABB> mDrawCullingBounds;                       ///< World-space bounds of the triangle mesh instances indexed by draw ID. Dynamic instances have invalid bounds.
+        std::array<DrawArgs, DrawListBuilder::kGroupCount> mCulledDrawArgs; ///< Draw arguments for the visible meshes, one per draw list group.
 
         // Triangle meshes
         std::vector<MeshDesc> mMeshDesc;                            ///< Copy of mesh data GPU buffer (mpMeshesBuffer).
@@ -1306,6 +1375,8 @@ namespace Falcor
 
         // Scene metadata (CPU only)
         std::vector<AABB> mMeshBBs;                                 ///< Bounding boxes for meshes (not instances) in object space.
+        std::vector<MeshletDesc> mMeshlets;                         ///< Meshlets of static meshes, sorted by mesh ID.
+        SceneBVH::SharedPtr mpCPUBVH;                               ///< CPU BVH over the triangle mesh instances, or nullptr if not built.
         std::vector<std::vector<uint32_t>> mMeshIdToInstanceIds;    ///< Mapping of what instances belong to which mesh. The instanceID are sorted in ascending order.
         std::vector<AABB> mCurveBBs;                                ///< Bounding boxes for curves (not instances) in object space.
         std::vector<std::vector<uint32_t>> mCurveIdToInstanceIds;   ///< Mapping of what instances belong to which curve.
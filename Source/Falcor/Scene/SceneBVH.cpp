@@ -0,0 +1,608 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "SceneBVH.h"
+#include "Core/Assert.h"
+#include "Core/Errors.h"
+#include "Utils/NumericRange.h"
+#include "Utils/Scripting/ScriptBindings.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <execution>
+#include <numeric>
+
+namespace Falcor
+{
+    namespace
+    {
+        const uint32_t kBinCount = 16;              ///< Number of bins for the SAH split search.
+        const uint32_t kMaxLeafSize = 4;            ///< Nodes with at most this many primitives become leaves.
+        const uint32_t kMaxSAHDepth = 64;           ///< Depth below which nodes are split at the median to bound the tree depth.
+        const uint32_t kMaxStackSize = 128;         ///< Traversal stack size. Median splits below kMaxSAHDepth add at most 32 levels.
+
+        float3 transformPoint(const float4x4& m, const float3& p)
+        {
+            return float3(m * float4(p, 1.f));
+        }
+
+        float3 transformVector(const float4x4& m, const float3& v)
+        {
+            return float3(m * float4(v, 0.f));
+        }
+
+        bool overlaps(const AABB& a, const AABB& b)
+        {
+            return a.minPoint.x <= b.maxPoint.x && a.minPoint.y <= b.maxPoint.y && a.minPoint.z <= b.maxPoint.z &&
+                b.minPoint.x <= a.maxPoint.x && b.minPoint.y <= a.maxPoint.y && b.minPoint.z <= a.maxPoint.z;
+        }
+
+        /** Slab test. Returns true if the ray overlaps the box within [tMin, tMax] and the entry distance in tEnter.
+        */
+        bool intersectRayAABB(const AABB& bounds, const float3& origin, const float3& invDir, float tMin, float tMax, float& tEnter)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                float t0 = (bounds.minPoint[i] - origin[i]) * invDir[i];
+                float t1 = (bounds.maxPoint[i] - origin[i]) * invDir[i];
+                if (t0 > t1) std::swap(t0, t1);
+                // fmin/fmax ignore the NaNs produced by rays lying in the plane of a slab.
+                tMin = std::fmax(t0, tMin);
+                tMax = std::fmin(t1, tMax);
+            }
+            tEnter = tMin;
+            return tMin <= tMax;
+        }
+
+        /** Ray/triangle intersection (Moeller-Trumbore). Returns true if there is a hit within [tMin, tMax].
+        */
+        bool intersectTriangle(const float3& origin, const float3& dir, const float3 v[3], float tMin, float tMax, float& t, float2& barycentrics)
+        {
+            const float3 e1 = v[1] - v[0];
+            const float3 e2 = v[2] - v[0];
+            const float3 p = cross(dir, e2);
+            const float det = dot(e1, p);
+            if (det == 0.f) return false;
+
+            const float invDet = 1.f / det;
+            const float3 s = origin - v[0];
+            const float u = dot(s, p) * invDet;
+            if (u < 0.f || u > 1.f) return false;
+
+            const float3 q = cross(s, e1);
+            const float w = dot(dir, q) * invDet;
+            if (w < 0.f || u + w > 1.f) return false;
+
+            t = dot(e2, q) * invDet;
+            if (t < tMin || t > tMax) return false;
+
+            barycentrics = float2(u, w);
+            return true;
+        }
+
+        /** Triangle/box overlap test using the separating axis theorem (Akenine-Moeller).
+        */
+        bool triangleOverlapsBox(const float3& center, const float3& halfExtent, const float3 tri[3])
+        {
+            const float3 v[3] = { tri[0] - center, tri[1] - center, tri[2] - center };
+
+            // Returns true if the axis separates the triangle from the box.
+            auto isSeparatingAxis = [&](const float3& axis)
+            {
+                const float p0 = dot(axis, v[0]);
+                const float p1 = dot(axis, v[1]);
+                const float p2 = dot(axis, v[2]);
+                const float r = dot(halfExtent, abs(axis));
+                return std::min({ p0, p1, p2 }) > r || std::max({ p0, p1, p2 }) < -r;
+            };
+
+            // Box face normals.
+            for (int i = 0; i < 3; ++i)
+            {
+                float3 axis(0.f);
+                axis[i] = 1.f;
+                if (isSeparatingAxis(axis)) return false;
+            }
+
+            // Triangle normal.
+            const float3 edges[3] = { v[1] - v[0], v[2] - v[1], v[0] - v[2] };
+            if (isSeparatingAxis(cross(edges[0], edges[1]))) return false;
+
+            // Cross products of the box and triangle edges.
+            for (int i = 0; i < 3; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    float3 boxEdge(0.f);
+                    boxEdge[j] = 1.f;
+                    if (isSeparatingAxis(cross(boxEdge, edges[i]))) return false;
+                }
+            }
+
+            return true;
+        }
+
+        void loadTriangle(const SceneBVH::Mesh& mesh, uint32_t triangleIndex, float3 v[3])
+        {
+            for (uint32_t i = 0; i < 3; ++i) v[i] = mesh.positions[mesh.indices[triangleIndex * 3 + i]];
+        }
+    }
+
+    SceneBVH::SharedPtr SceneBVH::create(std::vector<Mesh> meshes, std::vector<Instance> instances)
+    {
+        return SharedPtr(new SceneBVH(std::move(meshes), std::move(instances)));
+    }
+
+    SceneBVH::SceneBVH(std::vector<Mesh> meshes, std::vector<Instance> instances)
+    {
+        // Validate the input before the parallel build, which must not throw.
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            const Mesh& mesh = meshes[i];
+            checkArgument(mesh.indices.size() % 3 == 0, "Mesh {} has {} indices, which is not a multiple of 3.", i, mesh.indices.size());
+            checkArgument(
+                std::all_of(mesh.indices.begin(), mesh.indices.end(), [&](uint32_t index) { return index < mesh.positions.size(); }),
+                "Mesh {} has indices that are out of range.", i);
+        }
+        for (size_t i = 0; i < instances.size(); ++i)
+        {
+            checkArgument(instances[i].meshIndex < meshes.size(), "Instance {} references mesh {}, but there are only {} meshes.", i, instances[i].meshIndex, meshes.size());
+        }
+
+        mMeshes.resize(meshes.size());
+        auto range = NumericRange<size_t>(0, meshes.size());
+        std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t i)
+        {
+            mMeshes[i].mesh = std::move(meshes[i]);
+            mMeshes[i].tree = buildTree(getTriangleBounds(mMeshes[i].mesh));
+        });
+
+        mInstances.reserve(instances.size());
+        for (const auto& instance : instances)
+        {
+            mInstances.push_back({ instance.meshIndex, instance.instanceID, instance.transform, rmcv::inverse(instance.transform) });
+        }
+        mTopLevel = buildTree(getInstanceBounds());
+    }
+
+    template<typename Callback>
+    void SceneBVH::traverseTree(const Tree& tree, const float3& origin, const float3& dir, float tMin, float& tMax, Callback callback)
+    {
+        if (tree.nodes.empty()) return;
+
+        const float3 invDir = 1.f / dir;
+
+        struct StackEntry
+        {
+            uint32_t nodeIndex;
+            float tEnter;
+        };
+        StackEntry stack[kMaxStackSize];
+        uint32_t stackSize = 0;
+
+        float tEnter;
+        if (intersectRayAABB(tree.nodes[0].bounds, origin, invDir, tMin, tMax, tEnter)) stack[stackSize++] = { 0, tEnter };
+
+        while (stackSize > 0)
+        {
+            const StackEntry entry = stack[--stackSize];
+            // Skip nodes that are farther away than a hit found after they were pushed.
+            if (entry.tEnter > tMax) continue;
+
+            uint32_t nodeIndex = entry.nodeIndex;
+            while (true)
+            {
+                const Node& node = tree.nodes[nodeIndex];
+                if (node.isLeaf())
+                {
+                    for (uint32_t i = 0; i < node.count; ++i)
+                    {
+                        if (callback(tree.primitives[node.index + i], tMax)) return;
+                    }
+                    break;
+                }
+
+                // Visit the nearer child first and push the other one.
+                float tLeft, tRight;
+                const bool hitLeft = intersectRayAABB(tree.nodes[node.index].bounds, origin, invDir, tMin, tMax, tLeft);
+                const bool hitRight = intersectRayAABB(tree.nodes[node.index + 1].bounds, origin, invDir, tMin, tMax, tRight);
+                if (hitLeft && hitRight)
+                {
+                    const bool rightFirst = tRight < tLeft;
+                    FALCOR_ASSERT(stackSize < kMaxStackSize);
+                    stack[stackSize++] = rightFirst ? StackEntry{ node.index, tLeft } : StackEntry{ node.index + 1, tRight };
+                    nodeIndex = rightFirst ? node.index + 1 : node.index;
+                }
+                else if (hitLeft || hitRight)
+                {
+                    nodeIndex = hitLeft ? node.index : node.index + 1;
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    template<typename Callback>
+    void SceneBVH::traverseTree(const Tree& tree, const AABB& bounds, Callback callback)
+    {
+        if (tree.nodes.empty()) return;
+
+        uint32_t stack[kMaxStackSize];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const Node& node = tree.nodes[stack[--stackSize]];
+            if (!overlaps(node.bounds, bounds)) continue;
+
+            if (node.isLeaf())
+            {
+                for (uint32_t i = 0; i < node.count; ++i) callback(tree.primitives[node.index + i]);
+            }
+            else
+            {
+                FALCOR_ASSERT(stackSize + 2 <= kMaxStackSize);
+                stack[stackSize++] = node.index + 1;
+                stack[stackSize++] = node.index;
+            }
+        }
+    }
+
+    SceneBVH::Hit SceneBVH::closestHit(const Ray& ray) const
+    {
+        Hit hit;
+        float tMax = ray.tMax;
+        traverseTree(mTopLevel, ray.origin, ray.dir, ray.tMin, tMax, [&](uint32_t instanceIndex, float& tInstance)
+        {
+            const InstanceData& instance = mInstances[instanceIndex];
+            const Mesh& mesh = mMeshes[instance.meshIndex].mesh;
+            const float3 origin = transformPoint(instance.invTransform, ray.origin);
+            const float3 dir = transformVector(instance.invTransform, ray.dir);
+
+            // The object-space direction is not normalized, so hit distances are the same as in world space.
+            traverseTree(mMeshes[instance.meshIndex].tree, origin, dir, ray.tMin, tInstance, [&](uint32_t triangleIndex, float& tTriangle)
+            {
+                float3 v[3];
+                loadTriangle(mesh, triangleIndex, v);
+                float t;
+                float2 barycentrics;
+                if (intersectTriangle(origin, dir, v, ray.tMin, tTriangle, t, barycentrics))
+                {
+                    tTriangle = t;
+                    hit = { instance.instanceID, triangleIndex, t, barycentrics };
+                }
+                return false;
+            });
+            return false;
+        });
+        return hit;
+    }
+
+    bool SceneBVH::anyHit(const Ray& ray) const
+    {
+        bool found = false;
+        float tMax = ray.tMax;
+        traverseTree(mTopLevel, ray.origin, ray.dir, ray.tMin, tMax, [&](uint32_t instanceIndex, float& tInstance)
+        {
+            const InstanceData& instance = mInstances[instanceIndex];
+            const Mesh& mesh = mMeshes[instance.meshIndex].mesh;
+            const float3 origin = transformPoint(instance.invTransform, ray.origin);
+            const float3 dir = transformVector(instance.invTransform, ray.dir);
+
+            traverseTree(mMeshes[instance.meshIndex].tree, origin, dir, ray.tMin, tInstance, [&](uint32_t triangleIndex, float& tTriangle)
+            {
+                float3 v[3];
+                loadTriangle(mesh, triangleIndex, v);
+                float t;
+                float2 barycentrics;
+                found = intersectTriangle(origin, dir, v, ray.tMin, tTriangle, t, barycentrics);
+                return found;
+            });
+            return found;
+        });
+        return found;
+    }
+
+    std::vector<SceneBVH::Overlap> SceneBVH::overlap(const AABB& bounds) const
+    {
+        std::vector<Overlap> overlaps;
+        if (!bounds.valid()) return overlaps;
+
+        const float3 center = bounds.center();
+        const float3 halfExtent = bounds.extent() * 0.5f;
+
+        traverseTree(mTopLevel, bounds, [&](uint32_t instanceIndex)
+        {
+            const InstanceData& instance = mInstances[instanceIndex];
+            const Mesh& mesh = mMeshes[instance.meshIndex].mesh;
+
+            // Find candidates with the conservative object-space bounds of the box and test them exactly in world space.
+            traverseTree(mMeshes[instance.meshIndex].tree, bounds.transform(instance.invTransform), [&](uint32_t triangleIndex)
+            {
+                float3 v[3];
+                loadTriangle(mesh, triangleIndex, v);
+                for (auto& p : v) p = transformPoint(instance.transform, p);
+                if (triangleOverlapsBox(center, halfExtent, v)) overlaps.push_back({ instance.instanceID, triangleIndex });
+            });
+        });
+
+        std::sort(overlaps.begin(), overlaps.end(), [](const Overlap& a, const Overlap& b)
+        {
+            return a.instanceID != b.instanceID ? a.instanceID < b.instanceID : a.primitiveIndex < b.primitiveIndex;
+        });
+        return overlaps;
+    }
+
+    std::vector<SceneBVH::Hit> SceneBVH::closestHit(fstd::span<const Ray> rays) const
+    {
+        std::vector<Hit> hits(rays.size());
+        auto range = NumericRange<size_t>(0, rays.size());
+        std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t i) { hits[i] = closestHit(rays[i]); });
+        return hits;
+    }
+
+    std::vector<uint8_t> SceneBVH::anyHit(fstd::span<const Ray> rays) const
+    {
+        std::vector<uint8_t> hits(rays.size());
+        auto range = NumericRange<size_t>(0, rays.size());
+        std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t i) { hits[i] = anyHit(rays[i]) ? 1 : 0; });
+        return hits;
+    }
+
+    void SceneBVH::setInstanceTransforms(fstd::span<const float4x4> transforms)
+    {
+        checkArgument(transforms.size() == mInstances.size(), "Expected {} instance transforms, got {}.", mInstances.size(), transforms.size());
+
+        for (size_t i = 0; i < mInstances.size(); ++i)
+        {
+            mInstances[i].transform = transforms[i];
+            mInstances[i].invTransform = rmcv::inverse(transforms[i]);
+        }
+        refitTree(mTopLevel, getInstanceBounds());
+    }
+
+    void SceneBVH::setMeshPositions(uint32_t meshIndex, fstd::span<const float3> positions)
+    {
+        checkArgument(meshIndex < mMeshes.size(), "Mesh index {} is out of range.", meshIndex);
+        MeshData& meshData = mMeshes[meshIndex];
+        checkArgument(positions.size() == meshData.mesh.positions.size(), "Expected {} positions, got {}.", meshData.mesh.positions.size(), positions.size());
+
+        std::copy(positions.begin(), positions.end(), meshData.mesh.positions.begin());
+        refitTree(meshData.tree, getTriangleBounds(meshData.mesh));
+        refitTree(mTopLevel, getInstanceBounds());
+    }
+
+    SceneBVH::Tree SceneBVH::buildTree(const std::vector<AABB>& primitiveBounds)
+    {
+        Tree tree;
+        const uint32_t primitiveCount = (uint32_t)primitiveBounds.size();
+        if (primitiveCount == 0) return tree;
+
+        std::vector<float3> centers(primitiveCount);
+        for (uint32_t i = 0; i < primitiveCount; ++i) centers[i] = primitiveBounds[i].center();
+
+        tree.primitives.resize(primitiveCount);
+        std::iota(tree.primitives.begin(), tree.primitives.end(), 0);
+        tree.nodes.reserve(2 * primitiveCount - 1);
+        tree.nodes.emplace_back();
+
+        struct Task
+        {
+            uint32_t nodeIndex;
+            uint32_t begin;
+            uint32_t end;
+            uint32_t depth;
+        };
+        std::vector<Task> tasks = { { 0, 0, primitiveCount, 0 } };
+
+        while (!tasks.empty())
+        {
+            const Task task = tasks.back();
+            tasks.pop_back();
+
+            const auto first = tree.primitives.begin() + task.begin;
+            const auto last = tree.primitives.begin() + task.end;
+            const uint32_t count = task.end - task.begin;
+
+            AABB bounds;
+            AABB centerBounds;
+            for (auto it = first; it != last; ++it)
+            {
+                bounds.include(primitiveBounds[*it]);
+                centerBounds.include(centers[*it]);
+            }
+
+            Node& node = tree.nodes[task.nodeIndex];
+            node.bounds = bounds;
+            if (count <= kMaxLeafSize)
+            {
+                node.index = task.begin;
+                node.count = count;
+                continue;
+            }
+
+            // Split along the axis with the largest extent of the primitive centers.
+            const float3 extent = centerBounds.extent();
+            const int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+            uint32_t mid = task.begin + count / 2;
+
+            if (extent[axis] > 0.f && task.depth < kMaxSAHDepth)
+            {
+                // Binned SAH. Bin i holds the centers in [min + i * extent / kBinCount, min + (i + 1) * extent / kBinCount).
+                const float scale = kBinCount / extent[axis];
+                auto getBin = [&](uint32_t primitive)
+                {
+                    return std::min(kBinCount - 1, (uint32_t)((centers[primitive][axis] - centerBounds.minPoint[axis]) * scale));
+                };
+
+                std::array<AABB, kBinCount> binBounds;
+                std::array<uint32_t, kBinCount> binCounts = {};
+                for (auto it = first; it != last; ++it)
+                {
+                    uint32_t bin = getBin(*it);
+                    binBounds[bin].include(primitiveBounds[*it]);
+                    binCounts[bin]++;
+                }
+
+                // Sweep from the right to compute the cost of the right side of each split.
+                std::array<float, kBinCount> rightCosts = {};
+                AABB rightBounds;
+                uint32_t rightCount = 0;
+                for (uint32_t i = kBinCount - 1; i > 0; --i)
+                {
+                    rightBounds.include(binBounds[i]);
+                    rightCount += binCounts[i];
+                    rightCosts[i] = rightCount > 0 ? rightBounds.area() * rightCount : 0.f;
+                }
+
+                // Sweep from the left to find the cheapest split. The split before bin i puts bins [0, i) on the left.
+                float bestCost = std::numeric_limits<float>::infinity();
+                uint32_t bestSplit = 0;
+                AABB leftBounds;
+                uint32_t leftCount = 0;
+                for (uint32_t i = 1; i < kBinCount; ++i)
+                {
+                    leftBounds.include(binBounds[i - 1]);
+                    leftCount += binCounts[i - 1];
+                    if (leftCount == 0 || leftCount == count) continue;
+                    float cost = leftBounds.area() * leftCount + rightCosts[i];
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestSplit = i;
+                    }
+                }
+
+                if (bestSplit > 0)
+                {
+                    mid = task.begin + (uint32_t)(std::partition(first, last, [&](uint32_t primitive) { return getBin(primitive) < bestSplit; }) - first);
+                }
+            }
+            else if (extent[axis] > 0.f)
+            {
+                // Median split to bound the depth of degenerate trees.
+                std::nth_element(first, tree.primitives.begin() + mid, last, [&](uint32_t a, uint32_t b) { return centers[a][axis] < centers[b][axis]; });
+            }
+            FALCOR_ASSERT(mid > task.begin && mid < task.end);
+
+            // Note: The node reference is invalidated by adding the children.
+            const uint32_t leftChild = (uint32_t)tree.nodes.size();
+            node.index = leftChild;
+            node.count = 0;
+            tree.nodes.emplace_back();
+            tree.nodes.emplace_back();
+
+            tasks.push_back({ leftChild + 1, mid, task.end, task.depth + 1 });
+            tasks.push_back({ leftChild, task.begin, mid, task.depth + 1 });
+        }
+
+        return tree;
+    }
+
+    void SceneBVH::refitTree(Tree& tree, const std::vector<AABB>& primitiveBounds)
+    {
+        // Children are stored after their parents, so a reverse sweep updates the nodes bottom-up.
+        for (size_t i = tree.nodes.size(); i-- > 0;)
+        {
+            Node& node = tree.nodes[i];
+            if (node.isLeaf())
+            {
+                node.bounds = AABB();
+                for (uint32_t j = 0; j < node.count; ++j) node.bounds.include(primitiveBounds[tree.primitives[node.index + j]]);
+            }
+            else
+            {
+                node.bounds = tree.nodes[node.index].bounds;
+                node.bounds.include(tree.nodes[node.index + 1].bounds);
+            }
+        }
+    }
+
+    std::vector<AABB> SceneBVH::getTriangleBounds(const Mesh& mesh)
+    {
+        std::vector<AABB> bounds(mesh.indices.size() / 3);
+        for (uint32_t i = 0; i < bounds.size(); ++i)
+        {
+            float3 v[3];
+            loadTriangle(mesh, i, v);
+            bounds[i] = AABB(v[0]).include(v[1]).include(v[2]);
+        }
+        return bounds;
+    }
+
+    std::vector<AABB> SceneBVH::getInstanceBounds() const
+    {
+        std::vector<AABB> bounds(mInstances.size());
+        for (size_t i = 0; i < mInstances.size(); ++i)
+        {
+            const InstanceData& instance = mInstances[i];
+            const Tree& tree = mMeshes[instance.meshIndex].tree;
+            // Instances of empty meshes get a point at their origin, which never produces hits.
+            bounds[i] = tree.nodes.empty() ? AABB(transformPoint(instance.transform, float3(0.f))) : tree.nodes[0].bounds.transform(instance.transform);
+        }
+        return bounds;
+    }
+
+    FALCOR_SCRIPT_BINDING(SceneBVH)
+    {
+        using namespace pybind11::literals;
+
+        FALCOR_SCRIPT_BINDING_DEPENDENCY(AABB)
+
+        pybind11::class_<SceneBVH::Hit> hit(m, "SceneBVHHit");
+        hit.def_readonly("instanceID", &SceneBVH::Hit::instanceID);
+        hit.def_readonly("primitiveIndex", &SceneBVH::Hit::primitiveIndex);
+        hit.def_readonly("t", &SceneBVH::Hit::t);
+        hit.def_readonly("barycentrics", &SceneBVH::Hit::barycentrics);
+        hit.def_property_readonly("valid", &SceneBVH::Hit::isValid);
+
+        pybind11::class_<SceneBVH::Overlap> overlap(m, "SceneBVHOverlap");
+        overlap.def_readonly("instanceID", &SceneBVH::Overlap::instanceID);
+        overlap.def_readonly("primitiveIndex", &SceneBVH::Overlap::primitiveIndex);
+
+        pybind11::class_<SceneBVH, SceneBVH::SharedPtr> bvh(m, "SceneBVH");
+        bvh.def_property_readonly("bounds", &SceneBVH::getBounds);
+        bvh.def_property_readonly("meshCount", &SceneBVH::getMeshCount);
+        bvh.def_property_readonly("instanceCount", &SceneBVH::getInstanceCount);
+        bvh.def("closestHit", [](const SceneBVH& bvh, const float3& origin, const float3& dir, float tMin, float tMax)
+        {
+            return bvh.closestHit(Ray(origin, dir, tMin, tMax));
+        }, "origin"_a, "dir"_a, "tMin"_a = 0.f, "tMax"_a = std::numeric_limits<float>::max());
+        bvh.def("anyHit", [](const SceneBVH& bvh, const float3& origin, const float3& dir, float tMin, float tMax)
+        {
+            return bvh.anyHit(Ray(origin, dir, tMin, tMax));
+        }, "origin"_a, "dir"_a, "tMin"_a = 0.f, "tMax"_a = std::numeric_limits<float>::max());
+        bvh.def("overlap", [](const SceneBVH& bvh, const float3& minPoint, const float3& maxPoint)
+        {
+            return bvh.overlap(AABB(minPoint, maxPoint));
+        }, "minPoint"_a, "maxPoint"_a);
+    }
+}
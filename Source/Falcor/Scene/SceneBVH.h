@@ -0,0 +1,196 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include "Utils/Math/AABB.h"
+#include "Utils/Math/Matrix.h"
+#include "Utils/Math/Ray.h"
+#include "Utils/Math/Vector.h"
+#include <fstd/span.h> // TODO C++20: Replace with <span>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace Falcor
+{
+    /** CPU bounding volume hierarchy over triangle mesh instances.
+
+        This is a two-level structure similar to the ray tracing acceleration structures on the GPU.
+        Each mesh has a bottom-level BVH in object space that is shared by all instances of the mesh,
+        and a top-level BVH is built over the world-space bounds of the instances.
+        Both levels are built with a binned SAH and can be refit when instances move or meshes deform.
+
+        The queries are const and can be called concurrently from multiple threads.
+        The batched versions process the queries in parallel.
+        All triangles are treated as opaque and double-sided.
+    */
+    class FALCOR_API SceneBVH
+    {
+    public:
+        using SharedPtr = std::shared_ptr<SceneBVH>;
+
+        static constexpr uint32_t kInvalidID = std::numeric_limits<uint32_t>::max();
+
+        /** Triangle mesh in object space.
+        */
+        struct Mesh
+        {
+            std::vector<float3> positions;          ///< Vertex positions.
+            std::vector<uint32_t> indices;          ///< Triangle list indices into the positions.
+        };
+
+        /** Instance of a mesh.
+        */
+        struct Instance
+        {
+            uint32_t meshIndex = 0;                 ///< Index of the mesh in the list of meshes.
+            uint32_t instanceID = 0;                ///< ID reported by the queries. Scenes use the global geometry instance ID.
+            float4x4 transform;                     ///< Object-to-world transform.
+        };
+
+        /** Result of a ray query.
+        */
+        struct Hit
+        {
+            uint32_t instanceID = kInvalidID;       ///< ID of the hit instance, or kInvalidID if nothing was hit.
+            uint32_t primitiveIndex = kInvalidID;   ///< Index of the hit triangle within its mesh.
+            float t = std::numeric_limits<float>::infinity(); ///< Ray parameter of the hit.
+            float2 barycentrics = float2(0.f);      ///< Barycentric coordinates of the 2nd and 3rd vertex.
+
+            bool isValid() const { return instanceID != kInvalidID; }
+        };
+
+        /** Triangle found by an overlap query.
+        */
+        struct Overlap
+        {
+            uint32_t instanceID;                    ///< ID of the instance.
+            uint32_t primitiveIndex;                ///< Index of the triangle within its mesh.
+        };
+
+        /** Build a BVH. The bottom-level BVHs of the meshes are built in parallel.
+            \param[in] meshes List of meshes.
+            \param[in] instances List of mesh instances.
+            \return New object, or throws an exception if the input is invalid.
+        */
+        static SharedPtr create(std::vector<Mesh> meshes, std::vector<Instance> instances);
+
+        /** Find the closest intersection along a ray.
+            \param[in] ray Ray in world space. Hits are reported within [tMin, tMax].
+            \return Closest hit, or an invalid hit if nothing was hit.
+        */
+        Hit closestHit(const Ray& ray) const;
+
+        /** Check if a ray intersects any triangle.
+            \param[in] ray Ray in world space. Hits are reported within [tMin, tMax].
+            \return True if there is an intersection.
+        */
+        bool anyHit(const Ray& ray) const;
+
+        /** Find the triangles that overlap a box.
+            \param[in] bounds Box in world space.
+            \return List of overlapping triangles, sorted by instance and triangle index.
+        */
+        std::vector<Overlap> overlap(const AABB& bounds) const;
+
+        /** Find the closest intersection for a batch of rays in parallel.
+        */
+        std::vector<Hit> closestHit(fstd::span<const Ray> rays) const;
+
+        /** Check a batch of rays for intersections in parallel.
+            \return List with one entry per ray, non-zero if the ray intersects any triangle.
+        */
+        std::vector<uint8_t> anyHit(fstd::span<const Ray> rays) const;
+
+        /** Update the instance transforms and refit the top-level BVH.
+            \param[in] transforms Object-to-world transform for each instance, in the order the instances were created.
+        */
+        void setInstanceTransforms(fstd::span<const float4x4> transforms);
+
+        /** Update the vertex positions of a mesh and refit its BVH and the top-level BVH.
+            The topology of the mesh is unchanged, so this is only efficient for moderate deformations.
+            \param[in] meshIndex Index of the mesh.
+            \param[in] positions New vertex positions. The vertex count must match.
+        */
+        void setMeshPositions(uint32_t meshIndex, fstd::span<const float3> positions);
+
+        /** Get the world-space bounds of all instances.
+        */
+        AABB getBounds() const { return mTopLevel.nodes.empty() ? AABB() : mTopLevel.nodes[0].bounds; }
+
+        uint32_t getMeshCount() const { return (uint32_t)mMeshes.size(); }
+        uint32_t getInstanceCount() const { return (uint32_t)mInstances.size(); }
+
+    private:
+        struct Node
+        {
+            AABB bounds;
+            uint32_t index = 0;                     ///< First primitive for leaves, left child for interior nodes. The right child follows the left child.
+            uint32_t count = 0;                     ///< Number of primitives for leaves, zero for interior nodes.
+
+            bool isLeaf() const { return count > 0; }
+        };
+
+        struct Tree
+        {
+            std::vector<Node> nodes;                ///< Nodes in depth-first order. Children are always stored after their parent.
+            std::vector<uint32_t> primitives;       ///< Primitive indices referenced by the leaves.
+        };
+
+        struct MeshData
+        {
+            Mesh mesh;
+            Tree tree;
+        };
+
+        struct InstanceData
+        {
+            uint32_t meshIndex;
+            uint32_t instanceID;
+            float4x4 transform;
+            float4x4 invTransform;
+        };
+
+        SceneBVH(std::vector<Mesh> meshes, std::vector<Instance> instances);
+
+        static Tree buildTree(const std::vector<AABB>& primitiveBounds);
+        static void refitTree(Tree& tree, const std::vector<AABB>& primitiveBounds);
+        static std::vector<AABB> getTriangleBounds(const Mesh& mesh);
+        std::vector<AABB> getInstanceBounds() const;
+
+        template<typename Callback>
+        static void traverseTree(const Tree& tree, const float3& origin, const float3& dir, float tMin, float& tMax, Callback callback);
+        template<typename Callback>
+        static void traverseTree(const Tree& tree, const AABB& bounds, Callback callback);
+
+        std::vector<MeshData> mMeshes;
+        std::vector<InstanceData> mInstances;
+        Tree mTopLevel;
+    };
+}
@@ -29,6 +29,7 @@
 #include "SceneBuilderAccess.h"
 #include "SceneCache.h"
 #include "Importer.h"
+#include "MeshletBuilder.h"
 #include "Curves/CurveConfig.h"
 #include "Material/StandardMaterial.h"
 #include "Utils/Logger.h"
@@ -38,6 +39,9 @@
 #include "Utils/Scripting/ScriptBindings.h"
 #include "Utils/Math/MathHelpers.h"
 #include <mikktspace.h>
+#include <pybind11/numpy.h>
+#include <algorithm>
+#include <optional>
 #include <filesystem>
 #include <cmath>
 
@@ -193,13 +197,23 @@ namespace Falcor
         SceneCache::Key computeSceneCacheKey(const std::filesystem::path& path, SceneBuilder::Flags buildFlags)
         {
             SceneBuilder::Flags cacheFlags = buildFlags & (~(SceneBuilder::Flags::UseCache | SceneBuilder::Flags::RebuildCache));
-            SHA1 sha1;
+            Hasher hasher(SceneCache::kKeyHashAlgorithm);
             auto pathStr = path.string();
-            sha1.update(pathStr.data(), pathStr.size());
-            sha1.update(&cacheFlags, sizeof(cacheFlags));
-            return sha1.finalize();
+            hasher.update(pathStr.data(), pathStr.size());
+            hasher.update(&cacheFlags, sizeof(cacheFlags));
+            return hasher.finalize();
 
         }
+
+        /** Reserve capacity for at least 'needed' elements. Unlike a plain reserve(), the capacity is at least doubled
+            when it needs to grow, so that calling this repeatedly with slowly increasing sizes doesn't reallocate every time.
+        */
+        template<typename Container>
+        void reserveGeometric(Container& container, size_t needed)
+        {
+            if (container.capacity() >= needed) return;
+            container.reserve(std::max(needed, 2 * container.capacity()));
+        }
     }
 
     SceneBuilder::SceneBuilder(std::shared_ptr<Device> pDevice, const Settings& settings, Flags flags)
@@ -311,6 +325,7 @@ namespace Falcor
         createMeshGroups();
         optimizeGeometry();
         sortMeshes();
+        buildMeshlets();
         createGlobalBuffers();
         createCurveGlobalBuffers();
         collectVolumeGrids();
@@ -339,6 +354,7 @@ namespace Falcor
         for (auto& sdfInstanceData : mSceneData.sdfGridInstances) sdfInstanceData.instanceIndex = tlasInstanceIndex++;
 
         mSceneData.useCompressedHitInfo = is_set(mFlags, Flags::UseCompressedHitInfo);
+        mSceneData.buildCPUBVH = is_set(mFlags, Flags::BuildCPUBVH);
 
         // Write scene cache if requested.
         if (mWriteSceneCache)
@@ -354,6 +370,9 @@ namespace Falcor
         timeReport.measure("Creating resources");
         timeReport.printToLog();
 
+        // Report warnings suppressed by rate limiting during import.
+        Logger::flush();
+
         return mpScene;
     }
 
@@ -365,6 +384,11 @@ namespace Falcor
     }
 
     MeshID SceneBuilder::addTriangleMesh(const TriangleMesh::SharedPtr& pTriangleMesh, const Material::SharedPtr& pMaterial)
+    {
+        return addProcessedMesh(processTriangleMesh(pTriangleMesh, pMaterial));
+    }
+
+    SceneBuilder::ProcessedMesh SceneBuilder::processTriangleMesh(const TriangleMesh::SharedPtr& pTriangleMesh, const Material::SharedPtr& pMaterial) const
     {
         checkArgument(pTriangleMesh != nullptr, "'pTriangleMesh' is missing");
         checkArgument(pMaterial != nullptr, "'pMaterial' is missing");
@@ -394,7 +418,7 @@ namespace Falcor
         mesh.normals = { normals.data(), SceneBuilder::Mesh::AttributeFrequency::Vertex };
         mesh.texCrds = { texCoords.data(), SceneBuilder::Mesh::AttributeFrequency::Vertex };
 
-        return addMesh(mesh);
+        return processMesh(mesh);
     }
 
     SceneBuilder::ProcessedMesh SceneBuilder::processMesh(const Mesh& mesh_, MeshAttributeIndices* pAttributeIndices) const
@@ -977,9 +1001,19 @@ namespace Falcor
             return m;
         };
 
-        InternalNode internalNode(node);
+        InternalNode internalNode;
         internalNode.transform = validateMatrix(node.transform, "transform");
-        internalNode.localToBindPose = validateMatrix(node.localToBindPose, "localToBindPose");
+        internalNode.parent = node.parent;
+        internalNode.nameIndex = internNodeName(node.name);
+
+        // Only store bind matrices for nodes that need them (skinned meshes and bones).
+        const rmcv::mat4 identity = rmcv::identity<rmcv::mat4>();
+        rmcv::mat4 localToBindPose = validateMatrix(node.localToBindPose, "localToBindPose");
+        if (node.meshBind != identity || localToBindPose != identity)
+        {
+            internalNode.bindMatricesIndex = (uint32_t)mNodeBindMatrices.size();
+            mNodeBindMatrices.push_back({ node.meshBind, localToBindPose });
+        }
 
         static_assert(NodeID::kInvalidID >= std::numeric_limits<uint32_t>::max());
         if (node.parent.isValid() && node.parent.get() >= mSceneGraph.size()) throw RuntimeError("Node parent is out of range");
@@ -993,6 +1027,53 @@ namespace Falcor
         return newNodeID;
     }
 
+    size_t SceneBuilder::getSceneGraphByteSize() const
+    {
+        size_t byteSize = mSceneGraph.size() * sizeof(InternalNode);
+        for (const auto& node : mSceneGraph)
+        {
+            byteSize += node.children.size() * sizeof(NodeID);
+            byteSize += node.meshes.size() * sizeof(MeshID);
+            byteSize += node.curves.size() * sizeof(CurveID);
+            byteSize += node.sdfGrids.size() * sizeof(SdfGridID);
+            byteSize += node.animatable.size() * sizeof(Animatable*);
+        }
+
+        for (const auto& name : mNodeNames) byteSize += sizeof(std::string) + name.size();
+        byteSize += mNodeNameIndices.size() * (sizeof(std::string_view) + sizeof(uint32_t));
+        byteSize += mNodeBindMatrices.size() * sizeof(NodeBindMatrices);
+
+        for (const auto& mesh : mMeshes) byteSize += mesh.instances.size() * sizeof(NodeID);
+        for (const auto& curve : mCurves) byteSize += curve.instances.size() * sizeof(NodeID);
+
+        return byteSize;
+    }
+
+    uint32_t SceneBuilder::internNodeName(const std::string& name)
+    {
+        if (name.empty()) return 0;
+
+        auto it = mNodeNameIndices.find(name);
+        if (it != mNodeNameIndices.end()) return it->second;
+
+        uint32_t index = (uint32_t)mNodeNames.size();
+        const std::string& storedName = mNodeNames.emplace_back(name);
+        mNodeNameIndices.emplace(storedName, index);
+        return index;
+    }
+
+    const rmcv::mat4& SceneBuilder::getNodeMeshBind(const InternalNode& node) const
+    {
+        static const rmcv::mat4 kIdentity = rmcv::identity<rmcv::mat4>();
+        return node.bindMatricesIndex == InternalNode::kNoBindMatrices ? kIdentity : mNodeBindMatrices[node.bindMatricesIndex].meshBind;
+    }
+
+    const rmcv::mat4& SceneBuilder::getNodeLocalToBindPose(const InternalNode& node) const
+    {
+        static const rmcv::mat4 kIdentity = rmcv::identity<rmcv::mat4>();
+        return node.bindMatricesIndex == InternalNode::kNoBindMatrices ? kIdentity : mNodeBindMatrices[node.bindMatricesIndex].localToBindPose;
+    }
+
     void SceneBuilder::addMeshInstance(NodeID nodeID, MeshID meshID)
     {
         checkArgument(nodeID.get() < mSceneGraph.size(), "'nodeID' ({}) is out of range", nodeID);
@@ -1030,6 +1111,125 @@ namespace Falcor
         mSceneData.sdfGridInstances.push_back(instance);
     }
 
+    PrototypeID SceneBuilder::addPrototype(const Prototype& prototype)
+    {
+        if (mPrototypes.size() >= std::numeric_limits<PrototypeID::IntType>::max()) throw RuntimeError("Too many prototypes");
+
+        PrototypeSpec spec;
+        spec.nameIndex = internNodeName(prototype.name);
+
+        // Group meshes and curves by their prototype space transform.
+        auto getPart = [&](const rmcv::mat4& transform) -> PrototypeSpec::Part&
+        {
+            if (!isMatrixValid(transform)) throw RuntimeError("Prototype '{}' has a transform with inf/nan values", prototype.name);
+            for (auto& part : spec.parts)
+            {
+                if (part.transform == transform) return part;
+            }
+            return spec.parts.emplace_back(PrototypeSpec::Part{ transform });
+        };
+
+        for (const auto& [meshID, transform] : prototype.meshes)
+        {
+            checkArgument(meshID.get() < mMeshes.size(), "'meshID' ({}) is out of range", meshID);
+            getPart(transform).meshes.push_back(meshID);
+        }
+        for (const auto& [curveID, transform] : prototype.curves)
+        {
+            checkArgument(curveID.get() < mCurves.size(), "'curveID' ({}) is out of range", curveID);
+            getPart(transform).curves.push_back(curveID);
+        }
+
+        // Move the part at the prototype origin first, it is attached directly to the instance root node.
+        const rmcv::mat4 identity = rmcv::identity<rmcv::mat4>();
+        auto it = std::find_if(spec.parts.begin(), spec.parts.end(), [&](const auto& part) { return part.transform == identity; });
+        if (it != spec.parts.end())
+        {
+            std::rotate(spec.parts.begin(), it, it + 1);
+            spec.rootPartCount = 1;
+        }
+
+        PrototypeID prototypeID{ mPrototypes.size() };
+        mPrototypes.push_back(std::move(spec));
+        return prototypeID;
+    }
+
+    std::vector<NodeID> SceneBuilder::addInstances(PrototypeID prototypeID, const rmcv::mat4* pTransforms, size_t count, NodeID parent)
+    {
+        checkArgument(prototypeID.get() < mPrototypes.size(), "'prototypeID' ({}) is out of range", prototypeID);
+        checkArgument(pTransforms != nullptr || count == 0, "'pTransforms' is missing");
+        checkArgument(!parent.isValid() || parent.get() < mSceneGraph.size(), "'parent' ({}) is out of range", parent);
+
+        const PrototypeSpec& prototype = mPrototypes[prototypeID.get()];
+        const size_t nodesPerInstance = 1 + prototype.parts.size() - prototype.rootPartCount;
+        if (mSceneGraph.size() + count * nodesPerInstance >= std::numeric_limits<NodeID::IntType>::max()) throw RuntimeError("Scene graph is too large");
+
+        // Reserve all storage up front. Node IDs are allocated in increasing order, so the instance sets are appended to in O(1).
+        // Storage is grown geometrically so that repeated calls with small batches stay amortized O(1) per instance.
+        reserveGeometric(mSceneGraph, mSceneGraph.size() + count * nodesPerInstance);
+        if (parent.isValid()) reserveGeometric(mSceneGraph[parent.get()].children, mSceneGraph[parent.get()].children.size() + count);
+        for (const auto& part : prototype.parts)
+        {
+            for (MeshID meshID : part.meshes) reserveGeometric(mMeshes[meshID.get()].instances, mMeshes[meshID.get()].instances.size() + count);
+            for (CurveID curveID : part.curves) reserveGeometric(mCurves[curveID.get()].instances, mCurves[curveID.get()].instances.size() + count);
+        }
+
+        auto addPart = [&](NodeID nodeID, const PrototypeSpec::Part& part)
+        {
+            InternalNode& node = mSceneGraph[nodeID.get()];
+            node.meshes = part.meshes;
+            node.curves = part.curves;
+            for (MeshID meshID : part.meshes) mMeshes[meshID.get()].instances.insert(nodeID);
+            for (CurveID curveID : part.curves) mCurves[curveID.get()].instances.insert(nodeID);
+        };
+
+        std::vector<NodeID> rootNodeIDs;
+        rootNodeIDs.reserve(count);
+        size_t nonAffineCount = 0;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            rmcv::mat4 transform = pTransforms[i];
+            if (!isMatrixValid(transform)) throw RuntimeError("Instance {} of prototype {} has a transform with inf/nan values", i, prototypeID);
+            if (!isMatrixAffine(transform))
+            {
+                transform[3] = rmcv::vec4(0, 0, 0, 1);
+                nonAffineCount++;
+            }
+
+            NodeID rootNodeID{ mSceneGraph.size() };
+            InternalNode& rootNode = mSceneGraph.emplace_back();
+            rootNode.transform = transform;
+            rootNode.parent = parent;
+            rootNode.nameIndex = prototype.nameIndex;
+            rootNode.children.reserve(nodesPerInstance - 1);
+            if (parent.isValid()) mSceneGraph[parent.get()].children.push_back(rootNodeID);
+            rootNodeIDs.push_back(rootNodeID);
+
+            for (size_t p = 0; p < prototype.parts.size(); ++p)
+            {
+                NodeID nodeID = rootNodeID;
+                if (p >= prototype.rootPartCount)
+                {
+                    nodeID = NodeID{ mSceneGraph.size() };
+                    InternalNode& node = mSceneGraph.emplace_back();
+                    node.transform = prototype.parts[p].transform;
+                    node.parent = rootNodeID;
+                    node.nameIndex = prototype.nameIndex;
+                    mSceneGraph[rootNodeID.get()].children.push_back(nodeID);
+                }
+                addPart(nodeID, prototype.parts[p]);
+            }
+        }
+
+        if (nonAffineCount > 0)
+        {
+            logWarning("SceneBuilder::addInstances() - {} instance transforms of prototype {} are not affine. Setting last row to (0,0,0,1).", nonAffineCount, prototypeID);
+        }
+
+        return rootNodeIDs;
+    }
+
     bool SceneBuilder::doesNodeHaveAnimation(NodeID nodeID) const
     {
         FALCOR_ASSERT(nodeID != NodeID::Invalid() && nodeID.get() < mSceneGraph.size());
@@ -1201,7 +1401,7 @@ namespace Falcor
 
         if (dst.parent != src.parent ||
             dst.transform != src.transform ||
-            dst.localToBindPose != src.localToBindPose) return false;
+            getNodeLocalToBindPose(dst) != getNodeLocalToBindPose(src)) return false;
 
         // Update all linked objects to point to the dest node.
         updateLinkedObjects(srcNodeID, dstNodeID);
@@ -1387,7 +1587,7 @@ namespace Falcor
             FALCOR_ASSERT(!mesh.instances.empty());
             FALCOR_ASSERT(mesh.skinningData.empty() && mesh.skinningVertexCount == 0);
 
-            std::set<NodeID> newInstances;  // Construct a new set of instances, rather than modifying the one we're iterating over
+            NodeIDSet newInstances;  // Construct a new set of instances, rather than modifying the one we're iterating over
             uint32_t instCount = 0;
             for (auto instIter = mesh.instances.cbegin(); instIter != mesh.instances.cend(); ++instIter)
             {
@@ -1466,7 +1666,7 @@ namespace Falcor
                     newMeshes.push_back(*newMesh);
                 }
             }
-            mesh.instances = newInstances;
+            mesh.instances = std::move(newInstances);
         }
 
         if (mMeshes.size() == 0)
@@ -1512,7 +1712,9 @@ namespace Falcor
             const auto& rhs = mSceneGraph[rhsID.get()];
             if (lhs.parent != rhs.parent) return lhs.parent < rhs.parent;
             if (lhs.transform != rhs.transform) return lessThan(lhs.transform, rhs.transform);
-            if (lhs.localToBindPose != rhs.localToBindPose) return lessThan(lhs.localToBindPose, rhs.localToBindPose);
+            const auto& lhsLocalToBindPose = getNodeLocalToBindPose(lhs);
+            const auto& rhsLocalToBindPose = getNodeLocalToBindPose(rhs);
+            if (lhsLocalToBindPose != rhsLocalToBindPose) return lessThan(lhsLocalToBindPose, rhsLocalToBindPose);
             return false;
         };
 
@@ -1781,10 +1983,20 @@ namespace Falcor
         // Classify instanced meshes.
         // The instanced meshes are grouped based on their lists of instances.
         // Meshes with an identical set of instances can be placed together in a BLAS.
-        std::map<std::set<NodeID>, meshList> instancesToMeshList;
-        std::map<std::set<NodeID>, meshList> displacedInstancesToMeshList;
+        // Instance sets are looked up by hash, and the mesh lists are kept in order of first occurrence.
+        std::vector<meshList> instancesToMeshList;
+        std::vector<meshList> displacedInstancesToMeshList;
+        std::unordered_map<NodeIDSet, size_t> instancesToIndex;
+        std::unordered_map<NodeIDSet, size_t> displacedInstancesToIndex;
         size_t instancedMeshCount = 0;
 
+        auto addInstancedMesh = [](std::vector<meshList>& meshLists, std::unordered_map<NodeIDSet, size_t>& indices, const NodeIDSet& instances, MeshID meshID)
+        {
+            auto [it, inserted] = indices.try_emplace(instances, meshLists.size());
+            if (inserted) meshLists.emplace_back();
+            meshLists[it->second].push_back(meshID);
+        };
+
         for (MeshID meshID{ 0 }; meshID.get() < (uint32_t)mMeshes.size(); ++meshID)
         {
             auto& mesh = mMeshes[meshID.get()];
@@ -1794,25 +2006,25 @@ namespace Falcor
             const auto& pMaterial = mSceneData.pMaterials->getMaterial(mesh.materialId);
             if (pMaterial->isDisplaced()) mesh.isDisplaced = true;
 
-            if (mesh.isDisplaced) displacedInstancesToMeshList[mesh.instances].push_back(meshID);
-            else instancesToMeshList[mesh.instances].push_back(meshID);
+            if (mesh.isDisplaced) addInstancedMesh(displacedInstancesToMeshList, displacedInstancesToIndex, mesh.instances, meshID);
+            else addInstancedMesh(instancesToMeshList, instancesToIndex, mesh.instances, meshID);
             instancedMeshCount++;
         }
 
         // Validate that each mesh is only indexed once.
         std::set<MeshID> instancedMeshes;
         size_t instancedCount = 0;
-        for (const auto& it : instancesToMeshList)
+        for (const auto& meshes : instancesToMeshList)
         {
-            instancedMeshes.insert(it.second.begin(), it.second.end());
-            instancedCount += it.second.size();
+            instancedMeshes.insert(meshes.begin(), meshes.end());
+            instancedCount += meshes.size();
         }
         std::set<MeshID> displacedInstancedMeshes;
         size_t displacedInstancedCount = 0;
-        for (const auto& it : displacedInstancesToMeshList)
+        for (const auto& meshes : displacedInstancesToMeshList)
         {
-            displacedInstancedMeshes.insert(it.second.begin(), it.second.end());
-            displacedInstancedCount += it.second.size();
+            displacedInstancedMeshes.insert(meshes.begin(), meshes.end());
+            displacedInstancedCount += meshes.size();
         }
         if ((instancedCount + displacedInstancedCount) != instancedMeshCount ||
             (instancedMeshes.size() + displacedInstancedMeshes.size()) != instancedMeshCount) throw RuntimeError("Error in instanced mesh grouping logic");
@@ -1849,9 +2061,9 @@ namespace Falcor
         }
 
         // Instanced static and dynamic meshes are grouped based on instance lists.
-        for (const auto& it : instancesToMeshList)
+        for (const auto& meshes : instancesToMeshList)
         {
-            addMeshes(it.second, false, false, is_set(mFlags, Flags::RTDontMergeInstanced));
+            addMeshes(meshes, false, false, is_set(mFlags, Flags::RTDontMergeInstanced));
         }
 
         // All static displaced meshes go in a single group or individual groups depending on config.
@@ -1867,9 +2079,9 @@ namespace Falcor
         }
 
         // Instanced displaced meshes are grouped based on instance lists.
-        for (const auto& it : displacedInstancesToMeshList)
+        for (const auto& meshes : displacedInstancesToMeshList)
         {
-            addMeshes(it.second, false, true, is_set(mFlags, Flags::RTDontMergeInstanced));
+            addMeshes(meshes, false, true, is_set(mFlags, Flags::RTDontMergeInstanced));
         }
     }
 
@@ -2286,6 +2498,48 @@ namespace Falcor
         }
     }
 
+    void SceneBuilder::buildMeshlets()
+    {
+        if (!is_set(mFlags, Flags::BuildMeshlets)) return;
+
+        FALCOR_ASSERT(mSceneData.meshlets.empty());
+
+        // Meshlets are built for static indexed triangle meshes. Dynamic meshes are skipped as their bounds change at runtime.
+        // The triangles of each mesh are reordered in place, so this needs to run before the global buffers are created.
+        std::vector<uint32_t> indices;
+        std::vector<float3> positions;
+        size_t meshCount = 0;
+
+        for (MeshID meshID{ 0 }; meshID.get() < mMeshes.size(); ++meshID)
+        {
+            auto& mesh = mMeshes[meshID.get()];
+            if (mesh.isDynamic() || mesh.indexCount == 0 || mesh.topology != Vao::Topology::TriangleList) continue;
+
+            indices.resize(mesh.indexCount);
+            for (uint32_t i = 0; i < mesh.indexCount; ++i) indices[i] = mesh.getIndex(i);
+            positions.resize(mesh.staticData.size());
+            for (size_t i = 0; i < positions.size(); ++i) positions[i] = mesh.staticData[i].position;
+
+            auto meshlets = Falcor::buildMeshlets(indices, positions);
+
+            if (mesh.use16BitIndices)
+            {
+                uint16_t* pIndices = reinterpret_cast<uint16_t*>(mesh.indexData.data());
+                for (uint32_t i = 0; i < mesh.indexCount; ++i) pIndices[i] = static_cast<uint16_t>(indices[i]);
+            }
+            else
+            {
+                std::copy(indices.begin(), indices.end(), mesh.indexData.begin());
+            }
+
+            for (auto& meshlet : meshlets) meshlet.meshID = meshID.get();
+            mSceneData.meshlets.insert(mSceneData.meshlets.end(), meshlets.begin(), meshlets.end());
+            meshCount++;
+        }
+
+        logInfo("Built {} meshlets for {} out of {} meshes.", mSceneData.meshlets.size(), meshCount, mMeshes.size());
+    }
+
     void SceneBuilder::createGlobalBuffers()
     {
         FALCOR_ASSERT(mSceneData.meshIndexData.empty());
@@ -2771,7 +3025,8 @@ namespace Falcor
         for (size_t i = 0; i < mSceneGraph.size(); i++)
         {
             FALCOR_ASSERT(mSceneGraph[i].parent.get() <= std::numeric_limits<uint32_t>::max());
-            mSceneData.sceneGraph[i] = Scene::Node(mSceneGraph[i].name, mSceneGraph[i].parent, mSceneGraph[i].transform, mSceneGraph[i].meshBind, mSceneGraph[i].localToBindPose);
+            const auto& node = mSceneGraph[i];
+            mSceneData.sceneGraph[i] = Scene::Node(getNodeName(node), node.parent, node.transform, getNodeMeshBind(node), getNodeLocalToBindPose(node));
         }
     }
 
@@ -2807,6 +3062,106 @@ namespace Falcor
         }
     }
 
+    namespace
+    {
+        using PyFloatArray = pybind11::array_t<float, pybind11::array::c_style | pybind11::array::forcecast>;
+        using PyIndexArray = pybind11::array_t<uint32_t, pybind11::array::c_style | pybind11::array::forcecast>;
+
+        /** Set a mesh attribute from a numpy array of shape (N, components).
+            Arrays of float32 in C order are referenced in place, other arrays are converted by pybind11 before the call.
+            \return Number of elements in the array.
+        */
+        template<typename T>
+        size_t setMeshAttribute(SceneBuilder::Mesh::Attribute<T>& attribute, const PyFloatArray& array, SceneBuilder::Mesh::AttributeFrequency frequency, const char* name)
+        {
+            constexpr size_t kComponentCount = sizeof(T) / sizeof(float);
+            checkArgument(array.ndim() == 2 && (size_t)array.shape(1) == kComponentCount, "'{}' must be an array of shape (N, {})", name, kComponentCount);
+            checkArgument(frequency != SceneBuilder::Mesh::AttributeFrequency::None, "'{}' frequency must not be None", name);
+
+            attribute.pData = reinterpret_cast<const T*>(array.data());
+            attribute.frequency = frequency;
+            return (size_t)array.shape(0);
+        }
+
+        /** Python binding wrapper for adding a mesh from numpy arrays.
+            The vertex data is referenced without copying and the mesh is processed with the GIL released.
+        */
+        MeshID pySceneBuilderAddMesh(
+            SceneBuilder& sceneBuilder, const std::string& name, const Material::SharedPtr& pMaterial, const PyFloatArray& positions, const PyIndexArray& indices,
+            const std::optional<PyFloatArray>& normals, const std::optional<PyFloatArray>& tangents, const std::optional<PyFloatArray>& texCrds,
+            SceneBuilder::Mesh::AttributeFrequency positionsFrequency, SceneBuilder::Mesh::AttributeFrequency normalsFrequency,
+            SceneBuilder::Mesh::AttributeFrequency tangentsFrequency, SceneBuilder::Mesh::AttributeFrequency texCrdsFrequency,
+            bool isFrontFaceCW, bool mergeDuplicateVertices)
+        {
+            using AttributeFrequency = SceneBuilder::Mesh::AttributeFrequency;
+
+            checkArgument(pMaterial != nullptr, "'material' is missing");
+            checkArgument(indices.size() > 0 && indices.size() % 3 == 0, "'indices' must contain a non-zero multiple of 3 indices");
+            checkArgument((size_t)indices.size() <= std::numeric_limits<uint32_t>::max(), "'indices' has too many elements");
+
+            SceneBuilder::Mesh mesh;
+            mesh.name = name;
+            mesh.topology = Vao::Topology::TriangleList;
+            mesh.pMaterial = pMaterial;
+            mesh.indexCount = (uint32_t)indices.size();
+            mesh.faceCount = mesh.indexCount / 3;
+            mesh.pIndices = indices.data();
+            mesh.isFrontFaceCW = isFrontFaceCW;
+            mesh.useOriginalTangentSpace = tangents.has_value();
+            mesh.mergeDuplicateVertices = mergeDuplicateVertices;
+
+            // Validate the element counts. The vertex count is given by the per-vertex attributes.
+            std::optional<size_t> vertexCount;
+            auto validateCount = [&](size_t count, AttributeFrequency frequency, const char* name)
+            {
+                switch (frequency)
+                {
+                case AttributeFrequency::Constant:
+                    checkArgument(count == 1, "'{}' has {} elements, expected 1 for constant frequency", name, count);
+                    break;
+                case AttributeFrequency::Uniform:
+                    checkArgument(count == mesh.faceCount, "'{}' has {} elements, expected {} for uniform frequency", name, count, mesh.faceCount);
+                    break;
+                case AttributeFrequency::FaceVarying:
+                    checkArgument(count == mesh.indexCount, "'{}' has {} elements, expected {} for face-varying frequency", name, count, mesh.indexCount);
+                    break;
+                case AttributeFrequency::Vertex:
+                    if (!vertexCount) vertexCount = count;
+                    checkArgument(count == *vertexCount, "'{}' has {} elements, expected {} for vertex frequency", name, count, *vertexCount);
+                    break;
+                default:
+                    FALCOR_UNREACHABLE();
+                }
+            };
+
+            validateCount(setMeshAttribute(mesh.positions, positions, positionsFrequency, "positions"), positionsFrequency, "positions");
+            if (normals) validateCount(setMeshAttribute(mesh.normals, *normals, normalsFrequency, "normals"), normalsFrequency, "normals");
+            if (tangents) validateCount(setMeshAttribute(mesh.tangents, *tangents, tangentsFrequency, "tangents"), tangentsFrequency, "tangents");
+            if (texCrds) validateCount(setMeshAttribute(mesh.texCrds, *texCrds, texCrdsFrequency, "texCrds"), texCrdsFrequency, "texCrds");
+
+            SceneBuilder::ProcessedMesh processedMesh;
+            {
+                // The arrays are kept alive by the caller, so the GIL is not needed while reading them.
+                pybind11::gil_scoped_release release;
+
+                uint32_t maxIndex = *std::max_element(mesh.pIndices, mesh.pIndices + mesh.indexCount);
+                if (vertexCount)
+                {
+                    checkArgument(maxIndex < *vertexCount, "'indices' references vertex {}, but only {} vertices are given", maxIndex, *vertexCount);
+                    mesh.vertexCount = (uint32_t)*vertexCount;
+                }
+                else
+                {
+                    mesh.vertexCount = maxIndex + 1;
+                }
+
+                processedMesh = sceneBuilder.processMesh(mesh);
+            }
+
+            return sceneBuilder.addProcessedMesh(processedMesh);
+        }
+    }
+
     static SceneBuilder* spActivePythonSceneBuilder; // TODO: REMOVEGLOBAL
 
     void setActivePythonSceneBuilder(SceneBuilder* pSceneBuilder)
@@ -2854,10 +3209,18 @@ namespace Falcor
         flags.value("DontUseDisplacement", SceneBuilder::Flags::DontUseDisplacement);
         flags.value("UseCompressedHitInfo", SceneBuilder::Flags::UseCompressedHitInfo);
         flags.value("TessellateCurvesIntoPolyTubes", SceneBuilder::Flags::TessellateCurvesIntoPolyTubes);
+        flags.value("BuildMeshlets", SceneBuilder::Flags::BuildMeshlets);
+        flags.value("BuildCPUBVH", SceneBuilder::Flags::BuildCPUBVH);
         flags.value("UseCache", SceneBuilder::Flags::UseCache);
         flags.value("RebuildCache", SceneBuilder::Flags::RebuildCache);
         ScriptBindings::addEnumBinaryOperators(flags);
 
+        pybind11::enum_<SceneBuilder::Mesh::AttributeFrequency> attributeFrequency(m, "MeshAttributeFrequency");
+        attributeFrequency.value("Constant", SceneBuilder::Mesh::AttributeFrequency::Constant);
+        attributeFrequency.value("Uniform", SceneBuilder::Mesh::AttributeFrequency::Uniform);
+        attributeFrequency.value("Vertex", SceneBuilder::Mesh::AttributeFrequency::Vertex);
+        attributeFrequency.value("FaceVarying", SceneBuilder::Mesh::AttributeFrequency::FaceVarying);
+
         pybind11::class_<SceneBuilder, SceneBuilder::SharedPtr> sceneBuilder(m, "SceneBuilder");
         sceneBuilder.def_property_readonly("flags", &SceneBuilder::getFlags);
         sceneBuilder.def_property_readonly("materials", &SceneBuilder::getMaterials);
@@ -2874,6 +3237,11 @@ namespace Falcor
             pSceneBuilder->import(path, Dictionary(dict));
         }, "path"_a, "dict"_a = pybind11::dict());
         sceneBuilder.def("addTriangleMesh", &SceneBuilder::addTriangleMesh, "triangleMesh"_a, "material"_a);
+        sceneBuilder.def("addMesh", pySceneBuilderAddMesh, "name"_a, "material"_a, "positions"_a, "indices"_a,
+            "normals"_a = std::nullopt, "tangents"_a = std::nullopt, "texCrds"_a = std::nullopt,
+            "positionsFrequency"_a = SceneBuilder::Mesh::AttributeFrequency::Vertex, "normalsFrequency"_a = SceneBuilder::Mesh::AttributeFrequency::Vertex,
+            "tangentsFrequency"_a = SceneBuilder::Mesh::AttributeFrequency::Vertex, "texCrdsFrequency"_a = SceneBuilder::Mesh::AttributeFrequency::Vertex,
+            "isFrontFaceCW"_a = false, "mergeDuplicateVertices"_a = true);
         sceneBuilder.def("addSDFGrid", &SceneBuilder::addSDFGrid, "sdfGrid"_a, "material"_a);
         sceneBuilder.def("addMaterial", &SceneBuilder::addMaterial, "material"_a);
         sceneBuilder.def("replaceMaterial", &SceneBuilder::replaceMaterial, "material"_a, "replacement"_a);
@@ -2900,6 +3268,25 @@ namespace Falcor
         }, "name"_a, "transform"_a = Transform(), "parent"_a = NodeID::kInvalidID);
         sceneBuilder.def("addMeshInstance", &SceneBuilder::addMeshInstance);
         sceneBuilder.def("addSDFGridInstance", &SceneBuilder::addSDFGridInstance);
+        sceneBuilder.def("addPrototype", [] (SceneBuilder* pSceneBuilder, const std::string& name, const std::vector<MeshID>& meshes, const std::vector<CurveID>& curves) {
+            checkArgument(pSceneBuilder, "'pSceneBuilder' is missing");
+            SceneBuilder::Prototype prototype;
+            prototype.name = name;
+            for (MeshID meshID : meshes) prototype.meshes.emplace_back(meshID, rmcv::identity<rmcv::mat4>());
+            for (CurveID curveID : curves) prototype.curves.emplace_back(curveID, rmcv::identity<rmcv::mat4>());
+            return pSceneBuilder->addPrototype(prototype);
+        }, "name"_a, "meshes"_a, "curves"_a = std::vector<CurveID>());
+        sceneBuilder.def("addInstances", [] (SceneBuilder* pSceneBuilder, PrototypeID prototypeID, pybind11::array_t<float, pybind11::array::c_style | pybind11::array::forcecast> transforms, NodeID parent) {
+            checkArgument(pSceneBuilder, "'pSceneBuilder' is missing");
+            checkArgument(transforms.ndim() == 3 && transforms.shape(1) == 4 && transforms.shape(2) == 4, "'transforms' must be an array of shape (N, 4, 4)");
+            static_assert(sizeof(rmcv::mat4) == 16 * sizeof(float));
+            // The numpy array is row-major like rmcv::mat4, so the transforms can be used in place.
+            auto nodeIDs = pSceneBuilder->addInstances(prototypeID, reinterpret_cast<const rmcv::mat4*>(transforms.data()), (size_t)transforms.shape(0), parent);
+            pybind11::array_t<uint32_t> result(nodeIDs.size());
+            static_assert(sizeof(NodeID) == sizeof(uint32_t));
+            std::memcpy(result.mutable_data(), nodeIDs.data(), nodeIDs.size() * sizeof(uint32_t));
+            return result;
+        }, "prototype"_a, "transforms"_a, "parent"_a = NodeID::kInvalidID);
         sceneBuilder.def("addCustomPrimitive", &SceneBuilder::addCustomPrimitive);
 
         sceneBuilder.def("getSettings", static_cast<Settings&(SceneBuilder::*)()>(&SceneBuilder::getSettings), pybind11::return_value_policy::reference);
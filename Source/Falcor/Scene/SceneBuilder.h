@@ -37,15 +37,19 @@
 
 #include "Core/Macros.h"
 #include "Core/API/VAO.h"
+#include "Utils/Algorithm/SortedVectorSet.h"
 #include "Utils/Math/AABB.h"
 #include "Utils/Math/Vector.h"
 #include "Utils/Math/Matrix.h"
 #include "Utils/Scripting/Dictionary.h"
 #include "Utils/Settings.h"
 
+#include <deque>
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace Falcor
@@ -77,6 +81,8 @@ namespace Falcor
             DontUseDisplacement             = 0x4000,   ///< Don't use displacement mapping.
             UseCompressedHitInfo            = 0x8000,   ///< Use compressed hit info (on scenes with triangle meshes only).
             TessellateCurvesIntoPolyTubes   = 0x10000,  ///< Tessellate curves into poly-tubes (the default is linear swept spheres).
+            BuildMeshlets                   = 0x20000,  ///< Partition static triangle meshes into meshlets. The triangles are reordered so that each meshlet is a contiguous index range.
+            BuildCPUBVH                     = 0x40000,  ///< Build a CPU BVH over the triangle mesh instances for spatial queries without the GPU (see Scene::getCPUBVH()).
 
             UseCache                        = 0x10000000, ///< Enable scene caching. This caches the runtime scene representation on disk to reduce load time.
             RebuildCache                    = 0x20000000, ///< Rebuild scene cache.
@@ -325,6 +331,16 @@ namespace Falcor
             NodeID parent{ NodeID::Invalid() };
         };
 
+        /** Prototype for bulk instancing.
+            A prototype is a list of meshes and curves, each placed with a transform relative to the prototype origin.
+        */
+        struct Prototype
+        {
+            std::string name;                                       ///< Name given to the instance nodes.
+            std::vector<std::pair<MeshID, rmcv::mat4>> meshes;      ///< Mesh IDs and their prototype space transforms.
+            std::vector<std::pair<CurveID, rmcv::mat4>> curves;     ///< Curve IDs and their prototype space transforms.
+        };
+
         /** Create a new object
         */
         static SharedPtr create(std::shared_ptr<Device> pDevice, const Settings& settings, Flags flags = Flags::Default);
@@ -402,6 +418,15 @@ namespace Falcor
         */
         ProcessedMesh processMesh(const Mesh& mesh, MeshAttributeIndices* pAttributeIndices = nullptr) const;
 
+        /** Pre-process a triangle mesh into the data format that is used in the global scene buffers.
+            This function is thread safe, so triangle meshes can be processed in parallel and then added with addProcessedMesh().
+            Throws an exception if something went wrong.
+            \param pTriangleMesh The triangle mesh to pre-process.
+            \param pMaterial The material to use for the mesh.
+            \return The pre-processed mesh.
+        */
+        ProcessedMesh processTriangleMesh(const TriangleMesh::SharedPtr& pTriangleMesh, const Material::SharedPtr& pMaterial) const;
+
         /** Generate tangents for a mesh.
             \param mesh The mesh to generate tangents for. If successful, the tangent attribute on the mesh will be set to the output vector.
             \param tangents Output for generated tangents.
@@ -613,6 +638,13 @@ namespace Falcor
         */
         uint32_t getNodeCount() const { return uint32_t(mSceneGraph.size()); }
 
+        /** Get the number of bytes used by the scene graph.
+            This counts the nodes and their object lists, the interned node names, the bind matrices and the mesh and curve instance lists.
+            Spare container capacity is not included, so the result does not depend on the growth policy of the standard library.
+            \return The size in bytes.
+        */
+        size_t getSceneGraphByteSize() const;
+
         /** Add a mesh instance to a node
         */
         void addMeshInstance(NodeID nodeID, MeshID meshID);
@@ -625,6 +657,39 @@ namespace Falcor
         */
         void addSDFGridInstance(NodeID nodeID, SdfDescID sdfGridID);
 
+        /** Add a prototype for bulk instancing.
+            \param[in] prototype The prototype.
+            \return The prototype ID.
+        */
+        PrototypeID addPrototype(const Prototype& prototype);
+
+        /** Add instances of a prototype.
+            Each instance gets a single root node holding the instance transform. Meshes and curves placed at the prototype origin
+            are attached directly to the root node, the remaining ones are attached to one child node per distinct prototype space transform.
+            \param[in] prototypeID The prototype ID.
+            \param[in] pTransforms Array of instance transforms.
+            \param[in] count Number of instances.
+            \param[in] parent Parent node of the instances, or NodeID::Invalid() to add them as root nodes.
+            \return The root node IDs of the instances.
+        */
+        std::vector<NodeID> addInstances(PrototypeID prototypeID, const rmcv::mat4* pTransforms, size_t count, NodeID parent = NodeID::Invalid());
+
+        /** Add instances of a prototype.
+            \param[in] prototypeID The prototype ID.
+            \param[in] transforms Instance transforms.
+            \param[in] parent Parent node of the instances, or NodeID::Invalid() to add them as root nodes.
+            \return The root node IDs of the instances.
+        */
+        std::vector<NodeID> addInstances(PrototypeID prototypeID, const std::vector<rmcv::mat4>& transforms, NodeID parent = NodeID::Invalid())
+        {
+            return addInstances(prototypeID, transforms.data(), transforms.size(), parent);
+        }
+
+        /** Get how many prototypes have been added.
+            \return The prototype count.
+        */
+        uint32_t getPrototypeCount() const { return uint32_t(mPrototypes.size()); }
+
         /** Check if a scene node is animated. This check is done recursively through parent nodes.
             \return Returns true if node is animated.
         */
@@ -637,10 +702,18 @@ namespace Falcor
     private:
         SceneBuilder(std::shared_ptr<Device> pDevice, const Settings& settings, Flags buildFlags);
 
-        struct InternalNode : Node
+        /** Internal representation of a scene graph node.
+            Scenes with many instances have millions of nodes, so the representation is kept compact:
+            node names are interned and the bind matrices are stored in a separate table, only for nodes that have non-identity bind matrices.
+        */
+        struct InternalNode
         {
-            InternalNode() = default;
-            InternalNode(const Node& n) : Node(n) {}
+            static constexpr uint32_t kNoBindMatrices = uint32_t(-1);
+
+            rmcv::mat4 transform;
+            NodeID parent{ NodeID::Invalid() };
+            uint32_t nameIndex = 0;                 ///< Index into mNodeNames. Index 0 is the empty name.
+            uint32_t bindMatricesIndex = kNoBindMatrices; ///< Index into mNodeBindMatrices, or kNoBindMatrices if all bind matrices are identity.
             std::vector<NodeID> children;          ///< Node IDs of all child nodes.
             std::vector<MeshID> meshes;            ///< Mesh IDs of all meshes this node transforms.
             std::vector<CurveID> curves;           ///< Curve IDs of all curves this node transforms.
@@ -652,6 +725,31 @@ namespace Falcor
             */
             bool hasObjects() const { return !meshes.empty() || !curves.empty() || !sdfGrids.empty() || !animatable.empty(); }
         };
+
+        struct NodeBindMatrices
+        {
+            rmcv::mat4 meshBind;
+            rmcv::mat4 localToBindPose;
+        };
+
+        /** Internal representation of a prototype.
+            Meshes and curves are grouped by their prototype space transform so that each instance needs one node per distinct transform.
+        */
+        struct PrototypeSpec
+        {
+            struct Part
+            {
+                rmcv::mat4 transform;
+                std::vector<MeshID> meshes;
+                std::vector<CurveID> curves;
+            };
+
+            uint32_t nameIndex = 0;             ///< Index into mNodeNames.
+            std::vector<Part> parts;            ///< Groups of meshes/curves sharing a transform. Parts with identity transform come first.
+            size_t rootPartCount = 0;           ///< Number of parts attached directly to the instance root node (0 or 1).
+        };
+
+        using NodeIDSet = SortedVectorSet<NodeID>;
         struct MeshSpec
         {
             std::string name;
@@ -674,7 +772,7 @@ namespace Falcor
             bool isDisplaced = false;               ///< True if mesh has displacement map.
             bool isAnimated = false;                ///< True if mesh has vertex animations.
             AABB boundingBox;                       ///< Mesh bounding-box in object space.
-            std::set<NodeID> instances;             ///< IDs of all nodes that instantiate this mesh.
+            NodeIDSet instances;                    ///< IDs of all nodes that instantiate this mesh.
 
             // Pre-processed vertex data.
             std::vector<uint32_t> indexData;    ///< Vertex indices in either 32-bit or 16-bit format packed tightly, or empty if non-indexed.
@@ -716,7 +814,7 @@ namespace Falcor
             uint32_t indexCount = 0;            ///< Number of indices.
             uint32_t vertexCount = 0;           ///< Number of vertices.
             uint32_t degree = 1;                ///< Polynomial degree of curve; linear (1) by default.
-            std::set<NodeID> instances;         ///< IDs of all nodes that instantiate this curve.
+            NodeIDSet instances;                ///< IDs of all nodes that instantiate this curve.
 
             // Pre-processed curve vertex data.
             std::vector<uint32_t> indexData;    ///< Vertex indices in 32-bit.
@@ -741,6 +839,10 @@ namespace Falcor
         bool mWriteSceneCache = false;  ///< True if scene cache should be written after import.
 
         SceneGraph mSceneGraph;
+        std::deque<std::string> mNodeNames{ std::string() };            ///< Interned node names. Deque keeps the strings at stable addresses for the lookup table.
+        std::unordered_map<std::string_view, uint32_t> mNodeNameIndices; ///< Map from node name to index into mNodeNames.
+        std::vector<NodeBindMatrices> mNodeBindMatrices;                ///< Bind matrices of nodes that have non-identity bind matrices.
+        std::vector<PrototypeSpec> mPrototypes;
 
         MeshList mMeshes;
         MeshGroupList mMeshGroups; ///< Groups of meshes. Each group represents all the geometries in a BLAS for ray tracing.
@@ -751,6 +853,10 @@ namespace Falcor
         GpuFence::SharedPtr mpFence;
 
         // Helpers
+        uint32_t internNodeName(const std::string& name);
+        const std::string& getNodeName(const InternalNode& node) const { return mNodeNames[node.nameIndex]; }
+        const rmcv::mat4& getNodeMeshBind(const InternalNode& node) const;
+        const rmcv::mat4& getNodeLocalToBindPose(const InternalNode& node) const;
         bool doesNodeHaveAnimation(NodeID nodeID) const;
         void updateLinkedObjects(NodeID oldNodeID, NodeID newNodeID);
         bool collapseNodes(NodeID parentNodeID, NodeID childNodeID);
@@ -787,6 +893,7 @@ namespace Falcor
         void createMeshGroups();
         void optimizeGeometry();
         void sortMeshes();
+        void buildMeshlets();
         void createGlobalBuffers();
         void createCurveGlobalBuffers();
         void optimizeMaterials();
@@ -44,7 +44,7 @@ namespace Falcor
         /** Specfies the current cache file version.
             This needs to be incremented every time the file format changes!
         */
-        const uint32_t kVersion = 25;
+        const uint32_t kVersion = 27;
 
         /** Scene cache directory (subdirectory in the application data directory).
         */
@@ -258,7 +258,7 @@ namespace Falcor
 
     std::filesystem::path SceneCache::getCachePath(const Key& key)
     {
-        return getAppDataDirectory() / kDirectory / SHA1::toString(key);
+        return getAppDataDirectory() / kDirectory / key.toString();
     }
 
     // SceneData
@@ -335,6 +335,7 @@ namespace Falcor
             stream.write(group.isStatic);
             stream.write(group.isDisplaced);
         }
+        stream.write(sceneData.meshlets);
         stream.write((uint32_t)sceneData.cachedMeshes.size());
         for (const auto& cachedMesh : sceneData.cachedMeshes)
         {
@@ -344,6 +345,7 @@ namespace Falcor
             for (const auto& data : cachedMesh.vertexData) stream.write(data);
         }
         stream.write(sceneData.useCompressedHitInfo);
+        stream.write(sceneData.buildCPUBVH);
         stream.write(sceneData.has16BitIndices);
         stream.write(sceneData.has32BitIndices);
         stream.write(sceneData.meshDrawCount);
@@ -456,6 +458,7 @@ namespace Falcor
             stream.read(group.isStatic);
             stream.read(group.isDisplaced);
         }
+        stream.read(sceneData.meshlets);
         sceneData.cachedMeshes.resize(stream.read<uint32_t>());
         for (auto& cachedMesh : sceneData.cachedMeshes)
         {
@@ -465,6 +468,7 @@ namespace Falcor
             for (auto& data : cachedMesh.vertexData) stream.read(data);
         }
         stream.read(sceneData.useCompressedHitInfo);
+        stream.read(sceneData.buildCPUBVH);
         stream.read(sceneData.has16BitIndices);
         stream.read(sceneData.has32BitIndices);
         stream.read(sceneData.meshDrawCount);
@@ -39,7 +39,7 @@
 
 #include "Core/Macros.h"
 #include "Core/API/fwd.h"
-#include "Utils/CryptoUtils.h"
+#include "Utils/FastHash.h"
 
 #include <filesystem>
 #include <string>
@@ -54,7 +54,11 @@ namespace Falcor
     class FALCOR_API SceneCache
     {
     public:
-        using Key = SHA1::MD;
+        using Key = Hasher::Digest;
+
+        /** Hash algorithm used for computing cache keys.
+        */
+        static constexpr HashAlgorithm kKeyHashAlgorithm = HashAlgorithm::XXH3_128;
 
         /** Check if there is a valid scene cache for a given cache key.
             \param[in] key Cache key.
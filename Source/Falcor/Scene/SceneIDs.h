@@ -44,6 +44,7 @@ namespace Falcor
         kCamera,
         kVolume,
         kGlobalGeometry, ///< The linearized global ID, current in order: mest, curve, sdf, custom. Not to be confused with geometryID in curves, which is "either Mesh or Curve, depending on tessellation mode".
+        kPrototype,   ///< Instancing prototype, only used by the scene builder.
     };
 
 
@@ -58,4 +59,5 @@ namespace Falcor
     using CameraID = ObjectID<SceneObjectKind, SceneObjectKind::kCamera, uint32_t>;
     using VolumeID = ObjectID<SceneObjectKind, SceneObjectKind::kVolume, uint32_t>;
     using GlobalGeometryID = ObjectID<SceneObjectKind, SceneObjectKind::kGlobalGeometry, uint32_t>;
+    using PrototypeID = ObjectID<SceneObjectKind, SceneObjectKind::kPrototype, uint32_t>;
 }
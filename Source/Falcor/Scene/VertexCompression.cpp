@@ -0,0 +1,110 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "VertexCompression.h"
+#include "Utils/Math/PackedFormats.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Falcor
+{
+    namespace
+    {
+        const float kUnorm16Max = 65535.f;
+
+        float angleDegrees(const float3& a, const float3& b)
+        {
+            float cosTheta = std::clamp(dot(normalize(a), normalize(b)), -1.f, 1.f);
+            return glm::degrees(std::acos(cosTheta));
+        }
+    }
+
+    CompressedStaticVertexData compressVertex(const StaticVertexData& v, const AABB& bounds)
+    {
+        CompressedStaticVertexData c = {};
+
+        float3 extent = bounds.extent();
+        for (int i = 0; i < 3; i++)
+        {
+            float u = extent[i] > 0.f ? (v.position[i] - bounds.minPoint[i]) / extent[i] : 0.f;
+            c.position[i] = (uint16_t)(std::clamp(u, 0.f, 1.f) * kUnorm16Max + 0.5f);
+        }
+
+        c.normal = encodeNormal2x16(v.normal);
+        if (v.tangent.w != 0.f)
+        {
+            c.tangent = encodeNormal2x16(v.tangent.xyz);
+            c.tangentSign = v.tangent.w > 0.f ? 1 : 2;
+        }
+        c.texCrd = glm::packHalf2x16(v.texCrd);
+
+        return c;
+    }
+
+    StaticVertexData decompressVertex(const CompressedStaticVertexData& c, const AABB& bounds)
+    {
+        StaticVertexData v = {};
+
+        float3 extent = bounds.extent();
+        for (int i = 0; i < 3; i++)
+        {
+            v.position[i] = bounds.minPoint[i] + c.position[i] * (extent[i] / kUnorm16Max);
+        }
+
+        v.normal = decodeNormal2x16(c.normal);
+        if (c.tangentSign != 0)
+        {
+            v.tangent = float4(decodeNormal2x16(c.tangent), c.tangentSign == 1 ? 1.f : -1.f);
+        }
+        v.texCrd = glm::unpackHalf2x16(c.texCrd);
+        v.curveRadius = 0.f;
+
+        return v;
+    }
+
+    VertexQuantizationError computeQuantizationError(fstd::span<const StaticVertexData> vertices, const AABB& bounds)
+    {
+        VertexQuantizationError error;
+
+        for (const auto& v : vertices)
+        {
+            StaticVertexData q = decompressVertex(compressVertex(v, bounds), bounds);
+
+            float3 positionError = abs(q.position - v.position);
+            error.position = std::max({ error.position, positionError.x, positionError.y, positionError.z });
+
+            // Degenerate normals and invalid tangents carry no direction to preserve.
+            if (dot(v.normal, v.normal) > 0.f) error.normal = std::max(error.normal, angleDegrees(v.normal, q.normal));
+            if (v.tangent.w != 0.f) error.normal = std::max(error.normal, angleDegrees(v.tangent.xyz, q.tangent.xyz));
+
+            float2 texCrdError = abs(q.texCrd - v.texCrd);
+            error.texCrd = std::max({ error.texCrd, texCrdError.x, texCrdError.y });
+        }
+
+        return error;
+    }
+}
@@ -0,0 +1,96 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "SceneTypes.slang"
+#include "Core/Macros.h"
+#include "Utils/Math/AABB.h"
+#include "Utils/Math/Vector.h"
+#include <fstd/span.h> // TODO C++20: Replace with <span>
+#include <cstdint>
+
+namespace Falcor
+{
+    /** Compressed vertex format for static mesh vertices (20B instead of 32B for PackedStaticVertexData).
+        Positions are stored as 16-bit unorms relative to the mesh bounds, normals and tangents as octahedral
+        2x 16-bit snorms and texture coordinates as fp16. Curve radii are not supported.
+    */
+    struct CompressedStaticVertexData
+    {
+        uint16_t position[3];   ///< Position in 16-bit unorm relative to the mesh bounds.
+        uint16_t tangentSign;   ///< Tangent sign: 0 = invalid tangent, 1 = positive, 2 = negative.
+        uint32_t normal;        ///< Normal encoded as 2x 16-bit snorms in the octahedral mapping.
+        uint32_t tangent;       ///< Tangent encoded as 2x 16-bit snorms in the octahedral mapping.
+        uint32_t texCrd;        ///< Texture coordinates as 2x fp16.
+    };
+
+    static_assert(sizeof(CompressedStaticVertexData) == 20);
+
+    /** Maximum quantization error allowed for a mesh to use the compressed vertex format.
+    */
+    struct VertexQuantizationBudget
+    {
+        float maxPositionError = 1e-3f;     ///< Maximum position error in object space units.
+        float maxNormalError = 0.1f;        ///< Maximum angular error of normals and tangents in degrees.
+        float maxTexCrdError = 1e-3f;       ///< Maximum texture coordinate error.
+    };
+
+    /** Quantization error measured over a set of vertices.
+    */
+    struct VertexQuantizationError
+    {
+        float position = 0.f;               ///< Maximum position error (per component) in object space units.
+        float normal = 0.f;                 ///< Maximum angular error of normals and tangents in degrees.
+        float texCrd = 0.f;                 ///< Maximum texture coordinate error (per component).
+
+        bool isWithin(const VertexQuantizationBudget& budget) const
+        {
+            return position <= budget.maxPositionError && normal <= budget.maxNormalError && texCrd <= budget.maxTexCrdError;
+        }
+    };
+
+    /** Compress a vertex.
+        \param[in] v Vertex to compress.
+        \param[in] bounds Bounds of the mesh the vertex belongs to. The position is clamped to the bounds.
+        \return Compressed vertex.
+    */
+    FALCOR_API CompressedStaticVertexData compressVertex(const StaticVertexData& v, const AABB& bounds);
+
+    /** Decompress a vertex.
+        \param[in] v Compressed vertex.
+        \param[in] bounds Bounds of the mesh the vertex belongs to. Must match the bounds used for compression.
+        \return Decompressed vertex. The curve radius is always zero.
+    */
+    FALCOR_API StaticVertexData decompressVertex(const CompressedStaticVertexData& v, const AABB& bounds);
+
+    /** Measure the error introduced by compressing a set of vertices.
+        \param[in] vertices Vertices to measure.
+        \param[in] bounds Bounds of the mesh the vertices belong to.
+        \return Maximum errors over all vertices. Texture coordinates outside the fp16 range give an infinite error.
+    */
+    FALCOR_API VertexQuantizationError computeQuantizationError(fstd::span<const StaticVertexData> vertices, const AABB& bounds);
+}
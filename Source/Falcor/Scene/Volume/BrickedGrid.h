@@ -27,6 +27,10 @@
  **************************************************************************/
 #pragma once
 #include "Core/API/Texture.h"
+#include "Core/API/Formats.h"
+#include "Utils/Math/Common.h"
+#include "Utils/Math/Vector.h"
+#include <algorithm>
 
 namespace Falcor
 {
@@ -36,4 +40,67 @@ namespace Falcor
         Texture::SharedPtr indirection;
         Texture::SharedPtr atlas;
     };
+
+    /** Host-side view of the data backing a BrickedGrid.
+        The data is not owned by this struct. It either references the buffers of a grid converter or a memory mapped grid cache file.
+    */
+    struct BrickedGridData
+    {
+        static constexpr uint32_t kRangeMipCount = 4;
+
+        uint3 leafDim = uint3(0);                               ///< Size of the range and indirection textures at mip 0.
+        uint3 atlasSizePixels = uint3(0);                       ///< Size of the brick atlas texture.
+        ResourceFormat atlasFormat = ResourceFormat::Unknown;   ///< Format of the brick atlas texture.
+
+        const void* pRangeData = nullptr;       ///< Minorant/majorant ranges for all mips (RG16Float).
+        size_t rangeSize = 0;                   ///< Size of range data in bytes.
+        const void* pIndirectionData = nullptr; ///< Brick indirection data (RGBA8Uint).
+        size_t indirectionSize = 0;             ///< Size of indirection data in bytes.
+        const void* pAtlasData = nullptr;       ///< Brick atlas data.
+        size_t atlasSize = 0;                   ///< Size of atlas data in bytes.
+
+        /** Get the size in bytes of the range data expected by createTextures().
+        */
+        uint64_t getExpectedRangeSize() const
+        {
+            uint64_t size = 0;
+            for (uint32_t mip = 0; mip < kRangeMipCount; ++mip)
+            {
+                uint64_t mipWidth = std::max(leafDim.x >> mip, 1u);
+                uint64_t mipHeight = std::max(leafDim.y >> mip, 1u);
+                uint64_t mipDepth = std::max(leafDim.z >> mip, 1u);
+                size += mipWidth * mipHeight * mipDepth * getFormatBytesPerBlock(ResourceFormat::RG16Float);
+            }
+            return size;
+        }
+
+        /** Get the size in bytes of the indirection data expected by createTextures().
+        */
+        uint64_t getExpectedIndirectionSize() const
+        {
+            return (uint64_t)leafDim.x * leafDim.y * leafDim.z * getFormatBytesPerBlock(ResourceFormat::RGBA8Uint);
+        }
+
+        /** Get the size in bytes of the atlas data expected by createTextures().
+        */
+        uint64_t getExpectedAtlasSize() const
+        {
+            uint64_t blocksX = div_round_up(atlasSizePixels.x, getFormatWidthCompressionRatio(atlasFormat));
+            uint64_t blocksY = div_round_up(atlasSizePixels.y, getFormatHeightCompressionRatio(atlasFormat));
+            return blocksX * blocksY * atlasSizePixels.z * getFormatBytesPerBlock(atlasFormat);
+        }
+
+        /** Create the GPU textures from the host data.
+            \param[in] pDevice GPU device.
+            \return The bricked grid textures.
+        */
+        BrickedGrid createTextures(Device* pDevice) const
+        {
+            BrickedGrid bricks;
+            bricks.range = Texture::create3D(pDevice, leafDim.x, leafDim.y, leafDim.z, ResourceFormat::RG16Float, kRangeMipCount, pRangeData, ResourceBindFlags::ShaderResource, false);
+            bricks.indirection = Texture::create3D(pDevice, leafDim.x, leafDim.y, leafDim.z, ResourceFormat::RGBA8Uint, 1, pIndirectionData, ResourceBindFlags::ShaderResource, false);
+            bricks.atlas = Texture::create3D(pDevice, atlasSizePixels.x, atlasSizePixels.y, atlasSizePixels.z, atlasFormat, 1, pAtlasData, ResourceBindFlags::ShaderResource, false);
+            return bricks;
+        }
+    };
 }
@@ -27,6 +27,7 @@
  **************************************************************************/
 #include "Grid.h"
 #include "GridConverter.h"
+#include "GridCache.h"
 #include "Core/API/Device.h"
 #include "Core/Program/ShaderVar.h"
 #include "Utils/StringUtils.h"
@@ -74,6 +75,8 @@ namespace Falcor
         {
             return int3(c[0], c[1], c[2]);
         }
+
+        using NanoVDBGridConverter = NanoVDBConverterBC4;
     }
 
     Grid::SharedPtr Grid::createSphere(std::shared_ptr<Device> pDevice, float radius, float voxelSize, float blendRange)
@@ -202,7 +205,7 @@ namespace Falcor
         return rmcv::translate(rmcv::mat4(invAffine), -translation);
     }
 
-    Grid::Grid(std::shared_ptr<Device> pDevice, nanovdb::GridHandle<nanovdb::HostBuffer> gridHandle)
+    Grid::Grid(std::shared_ptr<Device> pDevice, nanovdb::GridHandle<nanovdb::HostBuffer> gridHandle, const BrickedGridData* pBrickedGridData)
         : mpDevice(std::move(pDevice))
         , mGridHandle(std::move(gridHandle))
         , mpFloatGrid(mGridHandle.grid<float>())
@@ -222,8 +225,14 @@ namespace Falcor
             Buffer::CpuAccess::None,
             mGridHandle.data()
         );
-        using NanoVDBGridConverter = NanoVDBConverterBC4;
-        mBrickedGrid = NanoVDBGridConverter(mpFloatGrid).convert(mpDevice.get());
+        if (pBrickedGridData)
+        {
+            mBrickedGrid = pBrickedGridData->createTextures(mpDevice.get());
+        }
+        else
+        {
+            mBrickedGrid = NanoVDBGridConverter(mpFloatGrid).convert(mpDevice.get());
+        }
     }
 
     Grid::SharedPtr Grid::createFromNanoVDBFile(std::shared_ptr<Device> pDevice, const std::filesystem::path& path, const std::string& gridname)
@@ -259,6 +268,15 @@ namespace Falcor
 
     Grid::SharedPtr Grid::createFromOpenVDBFile(std::shared_ptr<Device> pDevice, const std::filesystem::path& path, const std::string& gridname)
     {
+        // Try loading the converted grid from the grid cache.
+        const bool useCache = GridCache::isEnabled();
+        GridCache::Key cacheKey;
+        if (useCache)
+        {
+            cacheKey = GridCache::computeKey(path, gridname);
+            if (auto pGrid = GridCache::readCache(pDevice, cacheKey)) return pGrid;
+        }
+
         openvdb::initialize();
 
         openvdb::io::File file(path.string());
@@ -297,7 +315,25 @@ namespace Falcor
         openvdb::FloatGrid::Ptr floatGrid = openvdb::gridPtrCast<openvdb::FloatGrid>(baseGrid);
         auto handle = nanovdb::openToNanoVDB(floatGrid);
 
-        return SharedPtr(new Grid(std::move(pDevice), std::move(handle)));
+        if (!useCache) return SharedPtr(new Grid(std::move(pDevice), std::move(handle)));
+
+        // Compute grid stats and bricks up front so they end up in the cache.
+        auto pFloatGrid = handle.grid<float>();
+        if (!pFloatGrid->hasMinMax()) nanovdb::gridStats(*pFloatGrid);
+        NanoVDBGridConverter converter(pFloatGrid);
+        converter.convertToHost();
+        BrickedGridData brickedGridData = converter.getHostData();
+
+        try
+        {
+            GridCache::writeCache(cacheKey, handle, brickedGridData);
+        }
+        catch (const std::exception& e)
+        {
+            logWarning("Failed to write grid cache for grid '{}' in '{}': {}", gridname, path, e.what());
+        }
+
+        return SharedPtr(new Grid(std::move(pDevice), std::move(handle), &brickedGridData));
     }
 
 
@@ -82,6 +82,7 @@ namespace Falcor
 
         /** Create a grid from a file.
             Currently only OpenVDB and NanoVDB grids of type float are supported.
+            Converted OpenVDB grids are stored in the grid cache (see GridCache) and reloaded from there on subsequent loads.
             \param[in] pDevice GPU device.
             \param[in] path File path of the grid. Can also include a full path or relative path from a data directory.
             \param[in] gridname Name of the grid to load.
@@ -145,7 +146,12 @@ namespace Falcor
         rmcv::mat4 getInvTransform() const;
 
     private:
-        Grid(std::shared_ptr<Device> pDevice, nanovdb::GridHandle<nanovdb::HostBuffer> gridHandle);
+        /** Constructor.
+            \param[in] pDevice GPU device.
+            \param[in] gridHandle NanoVDB grid handle.
+            \param[in] pBrickedGridData Optional precomputed brick data. If nullptr, the bricks are computed from the NanoVDB grid.
+        */
+        Grid(std::shared_ptr<Device> pDevice, nanovdb::GridHandle<nanovdb::HostBuffer> gridHandle, const BrickedGridData* pBrickedGridData = nullptr);
 
         static SharedPtr createFromNanoVDBFile(std::shared_ptr<Device>, const std::filesystem::path& path, const std::string& gridname);
         static SharedPtr createFromOpenVDBFile(std::shared_ptr<Device>, const std::filesystem::path& path, const std::string& gridname);
@@ -161,5 +167,6 @@ namespace Falcor
         BrickedGrid mBrickedGrid;
 
         friend class SceneCache;
+        friend class GridCache;
     };
 }
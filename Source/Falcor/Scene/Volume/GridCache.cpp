@@ -0,0 +1,350 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "GridCache.h"
+#include "Core/Assert.h"
+#include "Core/Errors.h"
+#include "Core/Platform/OS.h"
+#include "Core/Platform/MemoryMappedFile.h"
+#include "Utils/Logger.h"
+#include "Utils/Math/Common.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <random>
+
+namespace Falcor
+{
+    namespace
+    {
+        /** Specifies the current cache file version.
+            This needs to be incremented every time the file format or the grid conversion changes!
+        */
+        const uint32_t kVersion = 1;
+
+        /** Grid cache directory (subdirectory in the application data directory).
+        */
+        const std::string kDirectory = "NVIDIA/Falcor/GridCache";
+
+        /** Alignment of the data sections in the cache file.
+            NanoVDB requires grid buffers to be aligned to NANOVDB_DATA_ALIGNMENT (32 bytes).
+        */
+        const uint64_t kSectionAlignment = 64;
+
+        /** Hash algorithm used for cache keys. Grid files are large, so a fast non-cryptographic hash is used.
+        */
+        const HashAlgorithm kKeyHashAlgorithm = HashAlgorithm::XXH3_128;
+
+        const char* kMagic = "FalcorG$";
+
+        /** Largest texture dimension accepted from a cache file. Larger values indicate a corrupt file.
+        */
+        const uint32_t kMaxTextureDim = 1 << 16;
+
+        struct Section
+        {
+            uint64_t offset = 0;
+            uint64_t size = 0;
+        };
+
+        struct Header
+        {
+            uint8_t magic[8]{};
+            uint32_t version{};
+            uint32_t atlasFormat{};
+            uint32_t leafDim[3]{};
+            uint32_t atlasSizePixels[3]{};
+            Section grid;
+            Section range;
+            Section indirection;
+            Section atlas;
+
+            bool isValid() const
+            {
+                return std::memcmp(magic, kMagic, sizeof(Header::magic)) == 0 && version == kVersion;
+            }
+
+            bool isInside(const Section& section, uint64_t fileSize) const
+            {
+                return section.offset >= sizeof(Header) && section.offset <= fileSize && section.size <= fileSize - section.offset;
+            }
+
+            bool hasValidTextureDesc() const
+            {
+                if (atlasFormat == (uint32_t)ResourceFormat::Unknown || atlasFormat >= (uint32_t)ResourceFormat::Count) return false;
+                for (int i = 0; i < 3; ++i)
+                {
+                    if (leafDim[i] == 0 || leafDim[i] > kMaxTextureDim) return false;
+                    if (atlasSizePixels[i] == 0 || atlasSizePixels[i] > kMaxTextureDim) return false;
+                }
+                return true;
+            }
+        };
+
+        std::atomic<bool> gEnabled{true};
+        std::atomic<uint64_t> gMaxSize{GridCache::kDefaultMaxSize};
+
+        std::mutex gDirectoryMutex;
+        std::filesystem::path gDirectory;
+    }
+
+    void GridCache::setEnabled(bool enabled)
+    {
+        gEnabled = enabled;
+    }
+
+    bool GridCache::isEnabled()
+    {
+        return gEnabled;
+    }
+
+    void GridCache::setMaxSize(uint64_t maxSize)
+    {
+        gMaxSize = maxSize;
+    }
+
+    uint64_t GridCache::getMaxSize()
+    {
+        return gMaxSize;
+    }
+
+    void GridCache::setDirectory(const std::filesystem::path& directory)
+    {
+        std::lock_guard<std::mutex> lock(gDirectoryMutex);
+        gDirectory = directory;
+    }
+
+    std::filesystem::path GridCache::getDirectory()
+    {
+        std::lock_guard<std::mutex> lock(gDirectoryMutex);
+        return gDirectory.empty() ? getAppDataDirectory() / kDirectory : gDirectory;
+    }
+
+    GridCache::Key GridCache::computeKey(const std::filesystem::path& path, const std::string& gridname)
+    {
+        Hasher hasher(kKeyHashAlgorithm);
+        hasher.update(kVersion);
+        hasher.update(std::string_view(gridname));
+
+        // Hash the file content through a memory mapping. Hashing is much cheaper than converting the grid.
+        std::error_code ec;
+        const uint64_t size = std::filesystem::file_size(path, ec);
+        hasher.update(size);
+        if (ec || !hasher.updateFile(path)) throw RuntimeError("Failed to open grid file '{}' for hashing.", path);
+
+        return hasher.finalize();
+    }
+
+    void GridCache::writeCache(const Key& key, const nanovdb::GridHandle<nanovdb::HostBuffer>& gridHandle, const BrickedGridData& brickedGridData)
+    {
+        auto cachePath = getCachePath(key);
+
+        // Entries that would be rejected by readCache() are not written.
+        if (brickedGridData.rangeSize != brickedGridData.getExpectedRangeSize() || brickedGridData.indirectionSize != brickedGridData.getExpectedIndirectionSize() ||
+            brickedGridData.atlasSize != brickedGridData.getExpectedAtlasSize())
+        {
+            throw RuntimeError("Brick data sizes do not match the brick texture sizes.");
+        }
+
+        logInfo("Writing grid cache to '{}'.", cachePath);
+
+        // Create directories if not existing.
+        std::filesystem::create_directories(cachePath.parent_path());
+
+        // Setup header and section layout.
+        Header header;
+        std::memcpy(header.magic, kMagic, sizeof(Header::magic));
+        header.version = kVersion;
+        header.atlasFormat = (uint32_t)brickedGridData.atlasFormat;
+        for (int i = 0; i < 3; ++i)
+        {
+            header.leafDim[i] = brickedGridData.leafDim[i];
+            header.atlasSizePixels[i] = brickedGridData.atlasSizePixels[i];
+        }
+
+        uint64_t offset = sizeof(Header);
+        auto allocSection = [&](Section& section, uint64_t size)
+        {
+            section.offset = align_to(kSectionAlignment, offset);
+            section.size = size;
+            offset = section.offset + size;
+        };
+        allocSection(header.grid, gridHandle.size());
+        allocSection(header.range, brickedGridData.rangeSize);
+        allocSection(header.indirection, brickedGridData.indirectionSize);
+        allocSection(header.atlas, brickedGridData.atlasSize);
+
+        // Write to a temporary file first and rename it afterwards, so concurrent readers never see a partial file.
+        // The random suffix keeps the file unique across threads and processes sharing the cache directory.
+        std::random_device rd;
+        auto tempPath = cachePath;
+        tempPath += fmt::format(".{:08x}{:08x}.tmp", rd(), rd());
+
+        {
+            std::ofstream fs(tempPath, std::ios_base::binary);
+            if (!fs.good()) throw RuntimeError("Failed to create grid cache file '{}'.", tempPath);
+
+            fs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            auto writeSection = [&](const Section& section, const void* pData)
+            {
+                const uint64_t pos = (uint64_t)fs.tellp();
+                FALCOR_ASSERT(pos <= section.offset);
+                const char padding[kSectionAlignment] = {};
+                fs.write(padding, section.offset - pos);
+                if (section.size > 0) fs.write(reinterpret_cast<const char*>(pData), section.size);
+            };
+            writeSection(header.grid, gridHandle.data());
+            writeSection(header.range, brickedGridData.pRangeData);
+            writeSection(header.indirection, brickedGridData.pIndirectionData);
+            writeSection(header.atlas, brickedGridData.pAtlasData);
+
+            if (!fs.good()) throw RuntimeError("Failed to write grid cache file '{}'.", tempPath);
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, cachePath, ec);
+        if (ec)
+        {
+            std::filesystem::remove(tempPath, ec);
+            throw RuntimeError("Failed to move grid cache file to '{}'.", cachePath);
+        }
+
+        evict(gMaxSize);
+    }
+
+    Grid::SharedPtr GridCache::readCache(std::shared_ptr<Device> pDevice, const Key& key)
+    {
+        auto cachePath = getCachePath(key);
+        if (!std::filesystem::exists(cachePath)) return nullptr;
+
+        MemoryMappedFile file(cachePath, MemoryMappedFile::kWholeFile, MemoryMappedFile::AccessHint::SequentialScan);
+        if (!file.isOpen() || file.getSize() < sizeof(Header))
+        {
+            logWarning("Failed to open grid cache file '{}'.", cachePath);
+            return nullptr;
+        }
+
+        const uint8_t* pFileData = reinterpret_cast<const uint8_t*>(file.getData());
+        Header header;
+        std::memcpy(&header, pFileData, sizeof(header));
+
+        if (!header.isValid()) return nullptr;
+
+        const uint64_t fileSize = file.getSize();
+        if (!header.isInside(header.grid, fileSize) || !header.isInside(header.range, fileSize) ||
+            !header.isInside(header.indirection, fileSize) || !header.isInside(header.atlas, fileSize) || header.grid.size == 0 ||
+            !header.hasValidTextureDesc())
+        {
+            logWarning("Invalid grid cache file '{}'.", cachePath);
+            return nullptr;
+        }
+
+        // The brick data is uploaded directly from the mapping.
+        BrickedGridData brickedGridData;
+        brickedGridData.leafDim = uint3(header.leafDim[0], header.leafDim[1], header.leafDim[2]);
+        brickedGridData.atlasSizePixels = uint3(header.atlasSizePixels[0], header.atlasSizePixels[1], header.atlasSizePixels[2]);
+        brickedGridData.atlasFormat = (ResourceFormat)header.atlasFormat;
+
+        // The textures are created from the section data, so the sections must match the sizes implied by the texture descs.
+        if (header.range.size != brickedGridData.getExpectedRangeSize() || header.indirection.size != brickedGridData.getExpectedIndirectionSize() ||
+            header.atlas.size != brickedGridData.getExpectedAtlasSize())
+        {
+            logWarning("Invalid brick data in grid cache file '{}'.", cachePath);
+            return nullptr;
+        }
+
+        logInfo("Loading grid cache from '{}'.", cachePath);
+
+        // Update the modification time, which is used for evicting the least recently used entries.
+        std::error_code ec;
+        std::filesystem::last_write_time(cachePath, std::filesystem::file_time_type::clock::now(), ec);
+
+        // The NanoVDB grid is kept on the host for the lifetime of the grid, so it is copied out of the mapping.
+        auto buffer = nanovdb::HostBuffer::create(header.grid.size);
+        std::memcpy(buffer.data(), pFileData + header.grid.offset, header.grid.size);
+        nanovdb::GridHandle<nanovdb::HostBuffer> gridHandle(std::move(buffer));
+        if (!gridHandle.grid<float>())
+        {
+            logWarning("Invalid grid in grid cache file '{}'.", cachePath);
+            return nullptr;
+        }
+
+        brickedGridData.pRangeData = pFileData + header.range.offset;
+        brickedGridData.rangeSize = header.range.size;
+        brickedGridData.pIndirectionData = pFileData + header.indirection.offset;
+        brickedGridData.indirectionSize = header.indirection.size;
+        brickedGridData.pAtlasData = pFileData + header.atlas.offset;
+        brickedGridData.atlasSize = header.atlas.size;
+
+        return Grid::SharedPtr(new Grid(std::move(pDevice), std::move(gridHandle), &brickedGridData));
+    }
+
+    void GridCache::evict(uint64_t maxSize)
+    {
+        struct Entry
+        {
+            std::filesystem::path path;
+            uint64_t size;
+            std::filesystem::file_time_type time;
+        };
+
+        // Collect cache files. Temporary files of concurrent writers are skipped.
+        std::error_code ec;
+        std::vector<Entry> entries;
+        uint64_t totalSize = 0;
+        for (const auto& it : std::filesystem::directory_iterator(getDirectory(), ec))
+        {
+            if (!it.is_regular_file(ec) || it.path().extension() == ".tmp") continue;
+            Entry entry{ it.path(), it.file_size(ec), it.last_write_time(ec) };
+            if (ec) continue;
+            totalSize += entry.size;
+            entries.push_back(std::move(entry));
+        }
+        if (totalSize <= maxSize) return;
+
+        // Remove the least recently used entries first.
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+        for (const auto& entry : entries)
+        {
+            if (totalSize <= maxSize) break;
+            if (std::filesystem::remove(entry.path, ec))
+            {
+                logInfo("Evicted grid cache file '{}'.", entry.path);
+                totalSize -= entry.size;
+            }
+        }
+    }
+
+    std::filesystem::path GridCache::getCachePath(const Key& key)
+    {
+        return getDirectory() / key.toString();
+    }
+}
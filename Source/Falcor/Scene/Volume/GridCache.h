@@ -0,0 +1,111 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Grid.h"
+#include "BrickedGrid.h"
+#include "Core/Macros.h"
+#include "Utils/FastHash.h"
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace Falcor
+{
+    /** Persistent cache for grids converted from OpenVDB files.
+        Converting an OpenVDB grid to NanoVDB and building the brick atlas is expensive. The cache stores
+        the NanoVDB grid buffer together with the brick range/indirection/atlas data in an uncompressed file
+        that is memory mapped on load, so reloading a grid only costs I/O.
+        Cache entries are keyed by a hash of the source file content and the grid name, i.e. entries are
+        implicitly invalidated when the source file changes.
+        The total size of the cache is bounded. When a new entry is written, the least recently used entries
+        are evicted until the cache fits into the size limit.
+    */
+    class FALCOR_API GridCache
+    {
+    public:
+        using Key = Hasher::Digest;
+
+        static constexpr uint64_t kDefaultMaxSize = 8ull << 30; ///< Default size limit of the cache in bytes.
+
+        /** Enable/disable the grid cache. The cache is enabled by default.
+        */
+        static void setEnabled(bool enabled);
+
+        /** Check if the grid cache is enabled.
+        */
+        static bool isEnabled();
+
+        /** Compute the cache key for a grid in a file.
+            \param[in] path Path of the source grid file.
+            \param[in] gridname Name of the grid.
+            \return Returns the cache key.
+        */
+        static Key computeKey(const std::filesystem::path& path, const std::string& gridname);
+
+        /** Set the size limit of the cache.
+            \param[in] maxSize Maximum total size of the cache files in bytes.
+        */
+        static void setMaxSize(uint64_t maxSize);
+
+        /** Get the size limit of the cache in bytes.
+        */
+        static uint64_t getMaxSize();
+
+        /** Set the cache directory. This is mainly useful for testing.
+            \param[in] directory Cache directory. If empty, the default directory in the application data directory is used.
+        */
+        static void setDirectory(const std::filesystem::path& directory);
+
+        /** Get the cache directory.
+        */
+        static std::filesystem::path getDirectory();
+
+        /** Write a grid to the cache.
+            \param[in] key Cache key.
+            \param[in] gridHandle NanoVDB grid handle.
+            \param[in] brickedGridData Host-side brick data of the grid.
+        */
+        static void writeCache(const Key& key, const nanovdb::GridHandle<nanovdb::HostBuffer>& gridHandle, const BrickedGridData& brickedGridData);
+
+        /** Read a grid from the cache.
+            \param[in] pDevice GPU device.
+            \param[in] key Cache key.
+            \return Returns the grid, or nullptr if there is no valid cache entry.
+        */
+        static Grid::SharedPtr readCache(std::shared_ptr<Device> pDevice, const Key& key);
+
+        /** Evict least recently used entries until the total size of the cache is at most the given size.
+            \param[in] maxSize Maximum total size of the cache files in bytes.
+        */
+        static void evict(uint64_t maxSize);
+
+        /** Get the path of the cache file for a given key.
+        */
+        static std::filesystem::path getCachePath(const Key& key);
+    };
+}
@@ -63,8 +63,19 @@ namespace Falcor
         NanoVDBToBricksConverter(const nanovdb::FloatGrid* grid);
         NanoVDBToBricksConverter(const NanoVDBToBricksConverter& rhs) = delete;
 
+        /** Convert the grid to bricks and create the GPU textures.
+        */
         BrickedGrid convert(Device* pDevice);
 
+        /** Convert the grid to bricks on the host only.
+            The result is available through getHostData().
+        */
+        void convertToHost();
+
+        /** Get a view of the host-side brick data. Only valid after convertToHost() and during the lifetime of the converter.
+        */
+        BrickedGridData getHostData() const;
+
     private:
         const static uint32_t kBrickSize = 8; // Must be 8, to match both NanoVDB leaf size.
         const static int32_t kBC4Compress = kBitsPerTexel == 4;
@@ -76,7 +87,7 @@ namespace Falcor
         inline uint3 getAtlasSizePixels() const { return mAtlasSizeBricks * kBrickSize; }
         inline uint32_t getAtlasMaxBrick() const { return mAtlasSizeBricks.x * mAtlasSizeBricks.y * mAtlasSizeBricks.z; }
 
-        inline ResourceFormat getAtlasFormat() {
+        inline ResourceFormat getAtlasFormat() const {
             switch (kBitsPerTexel) {
             case 4: return ResourceFormat::BC4Unorm;
             case 8: return ResourceFormat::R8Unorm;
@@ -283,7 +294,7 @@ namespace Falcor
     }
 
     template <typename TexelType, unsigned int kBitsPerTexel>
-    BrickedGrid NanoVDBToBricksConverter<TexelType, kBitsPerTexel>::convert(Device* pDevice)
+    void NanoVDBToBricksConverter<TexelType, kBitsPerTexel>::convertToHost()
     {
         auto t0 = CpuTimer::getCurrentTimePoint();
         auto range = NumericRange<int>(0, mLeafDim[0].z);
@@ -291,11 +302,28 @@ namespace Falcor
         for (int mip = 1; mip < 4; ++mip) computeMip(mip);
         double dt = CpuTimer::calcDuration(t0, CpuTimer::getCurrentTimePoint());
         logInfo("converted in {}ms: mNonEmptyCount {} vs max {}", dt, mNonEmptyCount, getAtlasMaxBrick());
+    }
 
-        BrickedGrid bricks;
-        bricks.range = Texture::create3D(pDevice, mLeafDim[0].x, mLeafDim[0].y, mLeafDim[0].z, ResourceFormat::RG16Float, 4, mRangeData.data(), ResourceBindFlags::ShaderResource, false);
-        bricks.indirection = Texture::create3D(pDevice, mLeafDim[0].x, mLeafDim[0].y, mLeafDim[0].z, ResourceFormat::RGBA8Uint, 1, mPtrData.data(), ResourceBindFlags::ShaderResource, false);
-        bricks.atlas = Texture::create3D(pDevice, getAtlasSizePixels().x, getAtlasSizePixels().y, getAtlasSizePixels().z, getAtlasFormat(), 1, mAtlasData.data(), ResourceBindFlags::ShaderResource, false);
-        return bricks;
+    template <typename TexelType, unsigned int kBitsPerTexel>
+    BrickedGridData NanoVDBToBricksConverter<TexelType, kBitsPerTexel>::getHostData() const
+    {
+        BrickedGridData data;
+        data.leafDim = uint3(mLeafDim[0]);
+        data.atlasSizePixels = getAtlasSizePixels();
+        data.atlasFormat = getAtlasFormat();
+        data.pRangeData = mRangeData.data();
+        data.rangeSize = mRangeData.size() * sizeof(uint32_t);
+        data.pIndirectionData = mPtrData.data();
+        data.indirectionSize = mPtrData.size() * sizeof(uint32_t);
+        data.pAtlasData = mAtlasData.data();
+        data.atlasSize = mAtlasData.size() * sizeof(TexelType);
+        return data;
+    }
+
+    template <typename TexelType, unsigned int kBitsPerTexel>
+    BrickedGrid NanoVDBToBricksConverter<TexelType, kBitsPerTexel>::convert(Device* pDevice)
+    {
+        convertToHost();
+        return getHostData().createTextures(pDevice);
     }
 }
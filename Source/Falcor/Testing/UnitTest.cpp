@@ -37,10 +37,15 @@
 #include <fmt/color.h>
 #include <algorithm>
 #include <chrono>
+#include <future>
 #include <regex>
+#include <thread>
 #include <inttypes.h>
 
 #include <pugixml.hpp>
+#include <nlohmann/json.hpp>
+
+#include <fstream>
 
 namespace Falcor
 {
@@ -79,6 +84,7 @@ struct Test
     GPUTestFunc gpuFunc;
     UnitTestDeviceFlags supportedDevices;
     Device::Type deviceType;
+    bool isThreadSafe = false;
 };
 
 struct TestResult
@@ -102,6 +108,22 @@ static std::vector<Test>& getTestRegistry()
     return registry;
 }
 
+struct Benchmark
+{
+    std::string getTitle() const { return fmt::format("{}/{}", path.filename(), name); }
+
+    std::filesystem::path path;
+    std::string name;
+    std::string skipMessage;
+    CPUBenchmarkFunc func;
+};
+
+static std::vector<Benchmark>& getBenchmarkRegistry()
+{
+    static std::vector<Benchmark> registry;
+    return registry;
+}
+
 } // end anonymous namespace
 
 const char* plural(size_t count, const char* suffix)
@@ -111,16 +133,33 @@ const char* plural(size_t count, const char* suffix)
     return suffix;
 }
 
-void registerCPUTest(const std::filesystem::path& path, const std::string& name, const std::string& skipMessage, CPUTestFunc func)
+void registerCPUTest(
+    const std::filesystem::path& path,
+    const std::string& name,
+    const std::string& skipMessage,
+    CPUTestFunc func,
+    bool isThreadSafe
+)
 {
     Test test;
     test.path = path;
     test.name = name;
     test.skipMessage = skipMessage;
     test.cpuFunc = std::move(func);
+    test.isThreadSafe = isThreadSafe;
     getTestRegistry().push_back(test);
 }
 
+void registerCPUBenchmark(const std::filesystem::path& path, const std::string& name, const std::string& skipMessage, CPUBenchmarkFunc func)
+{
+    Benchmark benchmark;
+    benchmark.path = path;
+    benchmark.name = name;
+    benchmark.skipMessage = skipMessage;
+    benchmark.func = std::move(func);
+    getBenchmarkRegistry().push_back(benchmark);
+}
+
 void registerGPUTest(
     const std::filesystem::path& path,
     const std::string& name,
@@ -268,9 +307,14 @@ int32_t runTests(
     UnitTestCategoryFlags categoryFlags,
     const std::string& testFilter,
     const std::filesystem::path& xmlReportPath,
-    uint32_t repeatCount
+    uint32_t repeatCount,
+    uint32_t threadCount,
+    uint32_t shardIndex,
+    uint32_t shardCount
 )
 {
+    checkArgument(shardCount > 0 && shardIndex < shardCount, "Invalid test shard {}/{}.", shardIndex, shardCount);
+
     // Abort on Ctrl-C.
     std::atomic<bool> abort{false};
     setKeyboardInterruptHandler(
@@ -310,6 +354,65 @@ int32_t runTests(
         std::sort(it.second.begin(), it.second.end(), [](const Test& a, const Test& b) { return a.name < b.name; });
     }
 
+    // Select the tests of this shard. Tests are distributed round-robin in sorted order.
+    // Shards run as separate processes, so serial CPU tests are all kept in shard 0
+    // to make sure they never run concurrently with each other.
+    if (shardCount > 1)
+    {
+        size_t testIndex = 0;
+        totalTestCount = 0;
+        auto isSkipped = [&](const Test& test)
+        {
+            if (test.cpuFunc && !test.isThreadSafe)
+                return shardIndex != 0;
+            return testIndex++ % shardCount != shardIndex;
+        };
+        for (auto suiteIt = tests.begin(); suiteIt != tests.end();)
+        {
+            auto& suiteTests = suiteIt->second;
+            suiteTests.erase(std::remove_if(suiteTests.begin(), suiteTests.end(), isSkipped), suiteTests.end());
+            totalTestCount += suiteTests.size();
+            suiteIt = suiteTests.empty() ? tests.erase(suiteIt) : std::next(suiteIt);
+        }
+    }
+
+    // Thread-safe CPU tests are run on worker threads ahead of time. All other tests run on the calling
+    // thread once the workers are done. Results are reported in the same order as for serial execution,
+    // so the console output and the XML report are deterministic.
+    auto runsInParallel = [&](const Test& test) { return threadCount > 1 && test.cpuFunc && test.isThreadSafe; };
+
+    std::vector<const Test*> parallelTests;
+    for (const auto& [suiteName, suiteTests] : tests)
+        for (const auto& test : suiteTests)
+            if (runsInParallel(test))
+                parallelTests.insert(parallelTests.end(), repeatCount, &test);
+
+    std::vector<std::promise<TestResult>> parallelResults(parallelTests.size());
+    std::atomic<size_t> nextParallelTest{0};
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < std::min<size_t>(threadCount, parallelTests.size()); ++i)
+    {
+        workers.emplace_back(
+            [&]()
+            {
+                for (size_t j = nextParallelTest++; j < parallelTests.size(); j = nextParallelTest++)
+                {
+                    if (abort)
+                        parallelResults[j].set_value({TestResult::Status::Skipped, {}, "Aborted."});
+                    else
+                        parallelResults[j].set_value(runTest(*parallelTests[j], pDevice, pTargetFbo));
+                }
+            }
+        );
+    }
+    auto joinWorkers = [&]()
+    {
+        for (auto& worker : workers)
+            if (worker.joinable())
+                worker.join();
+    };
+    size_t parallelResultIndex = 0;
+
     int32_t failureCount = 0;
     uint64_t totalMS = 0;
     reportLine(
@@ -339,7 +442,16 @@ int32_t runTests(
                 if (repeatCount > 1)
                     repeats = fmt::format("[{}/{}]", repeatIndex + 1, repeatCount);
                 reportLine("[ RUN      ] {}:{}{}", suiteName, test.name, repeats);
-                TestResult result = runTest(test, pDevice, pTargetFbo);
+                TestResult result;
+                if (runsInParallel(test))
+                {
+                    result = parallelResults[parallelResultIndex++].get_future().get();
+                }
+                else
+                {
+                    joinWorkers();
+                    result = runTest(test, pDevice, pTargetFbo);
+                }
                 report.emplace_back(test, result);
 
                 std::string statusTag;
@@ -355,8 +467,16 @@ int32_t runTests(
                     statusTag = "[  SKIPPED ]";
                     break;
                 }
-                if (!result.extraMessage.empty())
+                // Failure messages are buffered during the test and reported here (the extra message is the last one).
+                if (result.status == TestResult::Status::Failed)
+                {
+                    for (const auto& message : result.messages)
+                        reportLine("{}", message);
+                }
+                else if (!result.extraMessage.empty())
+                {
                     reportLine("{}", result.extraMessage);
+                }
                 reportLine("{} {}:{}{} ({} ms)", statusTag, suiteName, test.name, repeats, result.elapsedMS);
                 suiteMS += result.elapsedMS;
                 if (success && result.status == TestResult::Status::Failed)
@@ -375,6 +495,8 @@ int32_t runTests(
         totalMS += suiteMS;
     }
 
+    joinWorkers();
+
     if (abort)
     {
         reportLine("[ ABORTED  ]");
@@ -404,11 +526,238 @@ int32_t runTests(
 
 ///////////////////////////////////////////////////////////////////////////
 
+BenchmarkStats computeBenchmarkStats(std::vector<double> samples)
+{
+    BenchmarkStats stats;
+    if (samples.empty())
+        return stats;
+
+    auto median = [](std::vector<double>& values)
+    {
+        std::sort(values.begin(), values.end());
+        size_t n = values.size();
+        return n % 2 == 1 ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+    };
+
+    stats.repetitionCount = (uint32_t)samples.size();
+    stats.median = median(samples);
+    stats.min = samples.front();
+    double sum = 0.0;
+    for (double v : samples)
+        sum += v;
+    stats.mean = sum / samples.size();
+
+    std::vector<double> deviations(samples.size());
+    std::transform(samples.begin(), samples.end(), deviations.begin(), [&](double v) { return std::abs(v - stats.median); });
+    stats.mad = median(deviations);
+
+    return stats;
+}
+
+void CPUBenchmarkContext::run(const std::function<void()>& func)
+{
+    const uint32_t warmupCount = mOptions.warmupCount.value_or(mWarmupCount);
+    const uint32_t repetitionCount = std::max(1u, mOptions.repetitionCount.value_or(mRepetitionCount));
+
+    for (uint32_t i = 0; i < warmupCount; ++i)
+        func();
+
+    mSamples.clear();
+    mSamples.reserve(repetitionCount);
+    for (uint32_t i = 0; i < repetitionCount; ++i)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        func();
+        auto endTime = std::chrono::steady_clock::now();
+        mSamples.push_back(std::chrono::duration<double, std::milli>(endTime - startTime).count());
+    }
+}
+
+namespace
+{
+nlohmann::json benchmarkStatsToJson(const Benchmark& benchmark, const BenchmarkStats& stats)
+{
+    return {
+        {"name", benchmark.name},
+        {"file", benchmark.path.filename().string()},
+        {"repetitions", stats.repetitionCount},
+        {"median_ms", stats.median},
+        {"mad_ms", stats.mad},
+        {"min_ms", stats.min},
+        {"mean_ms", stats.mean},
+    };
+}
+
+/// Load the median times of a previous benchmark report, indexed by benchmark name.
+std::map<std::string, double> loadBenchmarkBaseline(const std::filesystem::path& path)
+{
+    std::ifstream ifs(path);
+    if (!ifs.good())
+        throw RuntimeError("Failed to open benchmark baseline '{}'.", path);
+
+    std::map<std::string, double> baseline;
+    try
+    {
+        auto doc = nlohmann::json::parse(ifs);
+        for (const auto& entry : doc.at("benchmarks"))
+            baseline[entry.at("name").get<std::string>()] = entry.at("median_ms").get<double>();
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+        throw RuntimeError("Failed to parse benchmark baseline '{}': {}", path, e.what());
+    }
+    return baseline;
+}
+} // namespace
+
+int32_t runBenchmarks(const BenchmarkOptions& options)
+{
+    // Abort on Ctrl-C.
+    std::atomic<bool> abort{false};
+    setKeyboardInterruptHandler(
+        [&abort]()
+        {
+            reportLine("\nDetected Ctrl-C, aborting ...\n");
+            abort = true;
+        }
+    );
+
+    std::map<std::string, double> baseline;
+    if (!options.baselinePath.empty())
+    {
+        try
+        {
+            baseline = loadBenchmarkBaseline(options.baselinePath);
+        }
+        catch (const RuntimeError& e)
+        {
+            reportLine("{}", e.what());
+            return 1;
+        }
+    }
+
+    // Filter benchmarks.
+    std::vector<Benchmark> benchmarks;
+    std::regex filterRegex(options.filter, std::regex::icase | std::regex::basic);
+    for (const auto& it : getBenchmarkRegistry())
+    {
+        if (std::regex_search(it.getTitle(), filterRegex))
+            benchmarks.push_back(it);
+    }
+    std::sort(benchmarks.begin(), benchmarks.end(), [](const Benchmark& a, const Benchmark& b) { return a.getTitle() < b.getTitle(); });
+
+    int32_t failureCount = 0;
+    std::vector<std::string> failedBenchmarks;
+    nlohmann::json report = {{"benchmarks", nlohmann::json::array()}};
+
+    reportLine("[==========] Running {} benchmark{}.", benchmarks.size(), plural(benchmarks.size(), "s"));
+    for (const auto& benchmark : benchmarks)
+    {
+        if (abort)
+            break;
+
+        const std::string title = benchmark.getTitle();
+        reportLine("[ RUN      ] {}", title);
+
+        if (!benchmark.skipMessage.empty())
+        {
+            reportLine("[  SKIPPED ] {} ({})", title, benchmark.skipMessage);
+            continue;
+        }
+
+        CPUBenchmarkContext ctx(options);
+        std::vector<std::string> messages;
+        try
+        {
+            benchmark.func(ctx);
+        }
+        catch (const TooManyFailedTestsException&)
+        {
+            messages.push_back("Gave up after " + std::to_string(kMaxTestFailures) + " failures.");
+        }
+        catch (const std::exception& e)
+        {
+            messages.push_back(e.what());
+        }
+
+        auto failureMessages = ctx.getFailureMessages();
+        messages.insert(messages.begin(), failureMessages.begin(), failureMessages.end());
+        if (messages.empty() && ctx.getSamples().empty())
+            messages.push_back("Benchmark did not call CPUBenchmarkContext::run().");
+
+        if (!messages.empty())
+        {
+            for (const auto& message : messages)
+                reportLine("{}", message);
+            reportLine("[  FAILED  ] {}", title);
+            failedBenchmarks.push_back(title);
+            ++failureCount;
+            continue;
+        }
+
+        BenchmarkStats stats = computeBenchmarkStats(ctx.getSamples());
+        report["benchmarks"].push_back(benchmarkStatsToJson(benchmark, stats));
+
+        std::string summary = fmt::format(
+            "median {:.3f} ms, MAD {:.3f} ms, min {:.3f} ms, {} run{}", stats.median, stats.mad, stats.min, stats.repetitionCount,
+            plural(stats.repetitionCount, "s")
+        );
+
+        bool regressed = false;
+        if (auto it = baseline.find(benchmark.name); it != baseline.end() && it->second > 0.0)
+        {
+            double change = stats.median / it->second - 1.0;
+            summary += fmt::format(", {:+.1f}% vs. baseline", change * 100.0);
+            regressed = change > options.regressionThreshold;
+        }
+
+        if (regressed)
+        {
+            reportLine("[ REGRESSED] {} ({})", title, summary);
+            failedBenchmarks.push_back(title);
+            ++failureCount;
+        }
+        else
+        {
+            reportLine("[     DONE ] {} ({})", title, summary);
+        }
+    }
+
+    if (abort)
+    {
+        reportLine("[ ABORTED  ]");
+        return 1;
+    }
+
+    if (!options.jsonReportPath.empty())
+    {
+        std::ofstream ofs(options.jsonReportPath);
+        ofs << report.dump(4);
+        if (!ofs.good())
+            reportLine("Failed to write benchmark report to '{}'.", options.jsonReportPath);
+    }
+
+    reportLine("[==========] {} benchmark{} ran.", benchmarks.size(), plural(benchmarks.size(), "s"));
+    if (failureCount > 0)
+    {
+        reportLine(
+            "[  FAILED  ] {} benchmark{} failed or regressed by more than {:.1f}%, listed below.", failureCount, plural(failureCount, "s"),
+            options.regressionThreshold * 100.0
+        );
+        for (const auto& title : failedBenchmarks)
+            reportLine("[  FAILED  ] {}", title);
+    }
+
+    return failureCount;
+}
+
+///////////////////////////////////////////////////////////////////////////
+
 void UnitTestContext::reportFailure(const std::string& message)
 {
+    // Messages are printed by the test runner after the test has finished.
     if (message.empty())
         return;
-    reportLine("{}", message);
     mFailureMessages.push_back(message);
 }
 
@@ -549,6 +898,21 @@ CPU_TEST(TestSingleEval)
     EXPECT_EQ(i, 7);
 }
 
+CPU_TEST(TestBenchmarkStats)
+{
+    BenchmarkStats stats = computeBenchmarkStats({5.0, 1.0, 3.0, 100.0, 2.0});
+    EXPECT_EQ(stats.repetitionCount, 5u);
+    EXPECT_EQ(stats.median, 3.0);
+    EXPECT_EQ(stats.min, 1.0);
+    EXPECT_EQ(stats.mean, 22.2);
+    // Deviations are {2, 2, 0, 97, 1}, the outlier does not affect the MAD.
+    EXPECT_EQ(stats.mad, 2.0);
+
+    stats = computeBenchmarkStats({4.0, 1.0, 2.0, 3.0});
+    EXPECT_EQ(stats.median, 2.5);
+    EXPECT_EQ(stats.mad, 1.0);
+}
+
 GPU_TEST(TestGPUTest)
 {
     ctx.createProgram("Testing/UnitTest.cs.slang");
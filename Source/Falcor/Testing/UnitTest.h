@@ -42,6 +42,7 @@
 #include <filesystem>
 #include <functional>
 #include <map>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -60,6 +61,7 @@ class RenderContext;
 
 class CPUUnitTestContext;
 class GPUUnitTestContext;
+class CPUBenchmarkContext;
 
 static constexpr int kMaxTestFailures = 25;
 
@@ -88,6 +90,7 @@ public:
 
 using CPUTestFunc = std::function<void(CPUUnitTestContext& ctx)>;
 using GPUTestFunc = std::function<void(GPUUnitTestContext& ctx)>;
+using CPUBenchmarkFunc = std::function<void(CPUBenchmarkContext& ctx)>;
 
 enum class UnitTestCategoryFlags
 {
@@ -112,7 +115,8 @@ FALCOR_API void registerCPUTest(
     const std::filesystem::path& path,
     const std::string& name,
     const std::string& skipMessage,
-    CPUTestFunc func
+    CPUTestFunc func,
+    bool isThreadSafe = true
 );
 FALCOR_API void registerGPUTest(
     const std::filesystem::path& path,
@@ -127,9 +131,54 @@ FALCOR_API int32_t runTests(
     UnitTestCategoryFlags categoryFlags,
     const std::string& testFilterRegexp,
     const std::filesystem::path& xmlReportPath,
-    uint32_t repeatCount = 1
+    uint32_t repeatCount = 1,
+    uint32_t threadCount = 1,
+    uint32_t shardIndex = 0,
+    uint32_t shardCount = 1
 );
 
+/**
+ * Robust statistics over the measured repetitions of a benchmark.
+ * All times are in milliseconds.
+ */
+struct BenchmarkStats
+{
+    uint32_t repetitionCount = 0;
+    double median = 0.0;
+    double mad = 0.0; ///< Median absolute deviation from the median.
+    double min = 0.0;
+    double mean = 0.0;
+};
+
+/**
+ * Compute benchmark statistics from a list of measured times.
+ * @param[in] samples Measured times in milliseconds.
+ */
+FALCOR_API BenchmarkStats computeBenchmarkStats(std::vector<double> samples);
+
+struct BenchmarkOptions
+{
+    std::string filter;                     ///< Regular expression for filtering benchmarks to run.
+    std::optional<uint32_t> warmupCount;    ///< Overrides the number of warm-up runs of all benchmarks if set.
+    std::optional<uint32_t> repetitionCount;///< Overrides the number of measured runs of all benchmarks if set.
+    std::filesystem::path jsonReportPath;   ///< JSON report output file. The report can be used as a baseline for later runs.
+    std::filesystem::path baselinePath;     ///< JSON report of a previous run to compare against.
+    double regressionThreshold = 0.1;       ///< Relative increase of the median over the baseline that is reported as a regression.
+};
+
+FALCOR_API void registerCPUBenchmark(
+    const std::filesystem::path& path,
+    const std::string& name,
+    const std::string& skipMessage,
+    CPUBenchmarkFunc func
+);
+
+/**
+ * Run all registered CPU benchmarks matching the filter.
+ * @return Number of benchmarks that failed or regressed compared to the baseline.
+ */
+FALCOR_API int32_t runBenchmarks(const BenchmarkOptions& options);
+
 class FALCOR_API UnitTestContext
 {
 public:
@@ -151,6 +200,41 @@ private:
 class FALCOR_API CPUUnitTestContext : public UnitTestContext
 {};
 
+class FALCOR_API CPUBenchmarkContext : public CPUUnitTestContext
+{
+public:
+    CPUBenchmarkContext(const BenchmarkOptions& options) : mOptions(options) {}
+
+    /**
+     * Set the number of unmeasured warm-up runs (default 1).
+     * Ignored if the count is overridden on the command line.
+     */
+    void setWarmupCount(uint32_t count) { mWarmupCount = count; }
+
+    /**
+     * Set the number of measured runs (default 10).
+     * Ignored if the count is overridden on the command line.
+     */
+    void setRepetitionCount(uint32_t count) { mRepetitionCount = count; }
+
+    /**
+     * Measure the given function. Any setup done by the benchmark outside of
+     * the function is not measured. Each benchmark should call this once.
+     */
+    void run(const std::function<void()>& func);
+
+    /**
+     * Returns the measured times in milliseconds.
+     */
+    const std::vector<double>& getSamples() const { return mSamples; }
+
+private:
+    const BenchmarkOptions& mOptions;
+    uint32_t mWarmupCount = 1;
+    uint32_t mRepetitionCount = 10;
+    std::vector<double> mSamples;
+};
+
 class FALCOR_API GPUUnitTestContext : public UnitTestContext
 {
 public:
@@ -447,20 +531,59 @@ inline std::optional<std::string> createBinaryMessage(std::string_view lhsStr, s
  * constructor executes at program startup time. Next, it starts the
  * definition of the testing function, up to the point at which
  * the user should supply an open brace and start writing code.
+ * CPU tests may run concurrently with other CPU tests on worker threads or,
+ * when sharded, in other processes. Tests writing files must therefore use
+ * unique paths, e.g. from getTempFilePath().
  */
-#define CPU_TEST(name, ...)                                               \
-    static void CPUUnitTest##name(CPUUnitTestContext& ctx);               \
-    struct CPUUnitTestRegisterer##name                                    \
-    {                                                                     \
-        CPUUnitTestRegisterer##name()                                     \
-        {                                                                 \
-            std::filesystem::path path = __FILE__;                        \
-            const char* skipMessage = "" __VA_ARGS__;                     \
-            registerCPUTest(path, #name, skipMessage, CPUUnitTest##name); \
-        }                                                                 \
-    } RegisterCPUTest##name;                                              \
+#define CPU_TEST_INTERNAL(name, isThreadSafe, ...)                                      \
+    static void CPUUnitTest##name(CPUUnitTestContext& ctx);                             \
+    struct CPUUnitTestRegisterer##name                                                  \
+    {                                                                                   \
+        CPUUnitTestRegisterer##name()                                                   \
+        {                                                                               \
+            std::filesystem::path path = __FILE__;                                      \
+            const char* skipMessage = "" __VA_ARGS__;                                   \
+            registerCPUTest(path, #name, skipMessage, CPUUnitTest##name, isThreadSafe); \
+        }                                                                               \
+    } RegisterCPUTest##name;                                                            \
     static void CPUUnitTest##name(CPUUnitTestContext& ctx) /* over to the user for the braces */
 
+#define CPU_TEST(name, ...) CPU_TEST_INTERNAL(name, true, __VA_ARGS__)
+
+/**
+ * Define CPU_TEST_SERIAL macro that defines a CPU unit test that never runs
+ * concurrently with other tests. Use this for tests that are not thread-safe,
+ * e.g. because they modify global state. Serial tests are all run by the first
+ * shard, so they are also serialized when the tests are split across processes.
+ */
+#define CPU_TEST_SERIAL(name, ...) CPU_TEST_INTERNAL(name, false, __VA_ARGS__)
+
+/**
+ * Macro to define a CPU benchmark. Benchmarks are not run as part of the unit
+ * tests but by runBenchmarks(). The function receives a CPUBenchmarkContext
+ * that is used to time the code under test, e.g.:
+ *
+ * CPU_BENCHMARK(MyBenchmark)
+ * {
+ *     auto data = createTestData();
+ *     ctx.run([&]() { process(data); });
+ * }
+ *
+ * The EXPECT/ASSERT macros can be used to validate results as in CPU tests.
+ */
+#define CPU_BENCHMARK(name, ...)                                                \
+    static void CPUBenchmark##name(CPUBenchmarkContext& ctx);                   \
+    struct CPUBenchmarkRegisterer##name                                         \
+    {                                                                           \
+        CPUBenchmarkRegisterer##name()                                          \
+        {                                                                       \
+            std::filesystem::path path = __FILE__;                              \
+            const char* skipMessage = "" __VA_ARGS__;                           \
+            registerCPUBenchmark(path, #name, skipMessage, CPUBenchmark##name); \
+        }                                                                       \
+    } RegisterCPUBenchmark##name;                                               \
+    static void CPUBenchmark##name(CPUBenchmarkContext& ctx) /* over to the user for the braces */
+
 /**
  * Macro to define a GPU unit test. The optional skip message will
  * disable the test from running without leading to a failure.
@@ -0,0 +1,169 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+namespace Falcor
+{
+
+/**
+ * Set of values stored as a sorted vector.
+ * Compared to std::set it uses a single allocation and no per-element overhead, which makes it suitable for storing
+ * a large number of small sets. Insertions are O(n) in general, but O(1) when values are inserted in increasing order.
+ * The hash of the values is computed on demand and cached until the set is modified, so the set can be used
+ * efficiently as a key in hash maps.
+ * @tparam T Value type. Must be less-than comparable and hashable with std::hash.
+ */
+template<typename T>
+class SortedVectorSet
+{
+public:
+    using value_type = T;
+    using const_iterator = typename std::vector<T>::const_iterator;
+    using const_reverse_iterator = typename std::vector<T>::const_reverse_iterator;
+
+    SortedVectorSet() = default;
+    SortedVectorSet(std::initializer_list<T> values)
+    {
+        for (const auto& v : values)
+            insert(v);
+    }
+
+    /**
+     * Insert a value.
+     * @return True if the value was inserted, false if it already existed.
+     */
+    bool insert(const T& value)
+    {
+        if (mValues.empty() || mValues.back() < value)
+        {
+            mValues.push_back(value);
+        }
+        else
+        {
+            auto it = std::lower_bound(mValues.begin(), mValues.end(), value);
+            if (it != mValues.end() && !(value < *it))
+                return false;
+            mValues.insert(it, value);
+        }
+        mHashValid = false;
+        return true;
+    }
+
+    /**
+     * Erase a value.
+     * @return Number of erased values (0 or 1).
+     */
+    size_t erase(const T& value)
+    {
+        auto it = find(value);
+        if (it == mValues.end())
+            return 0;
+        mValues.erase(it);
+        mHashValid = false;
+        return 1;
+    }
+
+    const_iterator find(const T& value) const
+    {
+        auto it = std::lower_bound(mValues.begin(), mValues.end(), value);
+        return (it != mValues.end() && !(value < *it)) ? it : mValues.end();
+    }
+
+    size_t count(const T& value) const { return find(value) != mValues.end() ? 1 : 0; }
+    bool contains(const T& value) const { return count(value) != 0; }
+
+    void clear()
+    {
+        mValues.clear();
+        mHashValid = false;
+    }
+
+    void reserve(size_t capacity) { mValues.reserve(capacity); }
+    void shrink_to_fit() { mValues.shrink_to_fit(); }
+
+    size_t size() const { return mValues.size(); }
+    size_t capacity() const { return mValues.capacity(); }
+    bool empty() const { return mValues.empty(); }
+
+    const_iterator begin() const { return mValues.begin(); }
+    const_iterator end() const { return mValues.end(); }
+    const_iterator cbegin() const { return mValues.cbegin(); }
+    const_iterator cend() const { return mValues.cend(); }
+    const_reverse_iterator rbegin() const { return mValues.rbegin(); }
+    const_reverse_iterator rend() const { return mValues.rend(); }
+
+    const T& front() const { return mValues.front(); }
+    const T& back() const { return mValues.back(); }
+
+    /// Get the sorted values.
+    const std::vector<T>& getValues() const { return mValues; }
+
+    /// Get the hash of the values. The hash is cached until the set is modified.
+    size_t getHash() const
+    {
+        if (!mHashValid)
+        {
+            // FNV-1a style combination of the element hashes.
+            size_t h = 14695981039346656037ull;
+            for (const auto& v : mValues)
+                h = (h ^ std::hash<T>{}(v)) * 1099511628211ull;
+            mHash = h;
+            mHashValid = true;
+        }
+        return mHash;
+    }
+
+    bool operator==(const SortedVectorSet& other) const
+    {
+        if (mValues.size() != other.mValues.size())
+            return false;
+        if (mHashValid && other.mHashValid && mHash != other.mHash)
+            return false;
+        return mValues == other.mValues;
+    }
+    bool operator!=(const SortedVectorSet& other) const { return !(*this == other); }
+    bool operator<(const SortedVectorSet& other) const { return mValues < other.mValues; }
+
+private:
+    std::vector<T> mValues;
+    mutable size_t mHash = 0;
+    mutable bool mHashValid = false;
+};
+
+} // namespace Falcor
+
+template<typename T>
+struct std::hash<Falcor::SortedVectorSet<T>>
+{
+    size_t operator()(const Falcor::SortedVectorSet<T>& set) const { return set.getHash(); }
+};
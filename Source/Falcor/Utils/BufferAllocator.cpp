@@ -27,6 +27,8 @@
  **************************************************************************/
 #include "BufferAllocator.h"
 #include "Utils/Math/Common.h"
+#include <algorithm>
+#include <cstring>
 
 namespace Falcor
 {
@@ -54,8 +56,96 @@ namespace Falcor
 
     size_t BufferAllocator::allocate(size_t byteSize)
     {
+        // Zero-sized allocations don't occupy memory and are not tracked.
+        if (byteSize == 0)
+        {
+            computeAndAllocatePadding(byteSize);
+            return mBuffer.size();
+        }
+
+        if (auto byteOffset = allocFromFreeList(byteSize))
+        {
+            // Reused memory is cleared to match the behavior for new memory.
+            std::memset(mBuffer.data() + *byteOffset, 0, byteSize);
+            markAsDirty(*byteOffset, byteSize);
+            mAllocations.emplace(*byteOffset, byteSize);
+            return *byteOffset;
+        }
+
         computeAndAllocatePadding(byteSize);
-        return allocInternal(byteSize);
+        size_t byteOffset = allocInternal(byteSize);
+        mAllocations.emplace_hint(mAllocations.end(), byteOffset, byteSize);
+
+        // The GPU copy may hold stale data below its end, e.g. after the buffer was shrunk.
+        if (byteOffset < mGpuSize) markAsDirty(byteOffset, std::min(byteSize, mGpuSize - byteOffset));
+
+        return byteOffset;
+    }
+
+    void BufferAllocator::free(size_t byteOffset)
+    {
+        auto it = mAllocations.find(byteOffset);
+        checkArgument(it != mAllocations.end(), "No allocation at offset {}.", byteOffset);
+
+        // The freed block spans the whole gap between the neighboring live allocations.
+        // This merges it with adjacent free blocks and any padding.
+        size_t start = 0;
+        if (it != mAllocations.begin())
+        {
+            auto prev = std::prev(it);
+            start = prev->first + prev->second;
+        }
+        auto next = mAllocations.erase(it);
+        size_t end = next != mAllocations.end() ? next->first : mBuffer.size();
+
+        mFreeBlocks.erase(mFreeBlocks.lower_bound(start), mFreeBlocks.lower_bound(end));
+
+        if (next == mAllocations.end())
+        {
+            // The block is at the end of the buffer. Shrink the buffer instead of adding it to the free list.
+            shrink(start);
+        }
+        else if (end > start)
+        {
+            mFreeBlocks.emplace(start, end - start);
+        }
+    }
+
+    std::vector<BufferAllocator::Relocation> BufferAllocator::compact()
+    {
+        std::vector<Relocation> relocations;
+        relocations.reserve(mAllocations.size());
+
+        // Allocations are moved in order. The placement rules are monotonic, so each allocation
+        // moves towards the start of the buffer and never overwrites an allocation that hasn't been moved yet.
+        std::map<size_t, size_t> allocations;
+        size_t end = 0;
+        for (const auto& [byteOffset, byteSize] : mAllocations)
+        {
+            const size_t newOffset = computeAlignedOffset(end, byteSize);
+            FALCOR_ASSERT(newOffset <= byteOffset);
+            if (newOffset != byteOffset)
+            {
+                std::memmove(mBuffer.data() + newOffset, mBuffer.data() + byteOffset, byteSize);
+                markAsDirty(newOffset, byteSize);
+            }
+            allocations.emplace_hint(allocations.end(), newOffset, byteSize);
+            relocations.push_back({ byteOffset, newOffset, byteSize });
+            end = newOffset + byteSize;
+        }
+
+        mAllocations = std::move(allocations);
+        mFreeBlocks.clear();
+        shrink(end);
+
+        return relocations;
+    }
+
+    size_t BufferAllocator::getFreeSize() const
+    {
+        size_t freeSize = 0;
+        for (const auto& block : mFreeBlocks) freeSize += block.second;
+        return freeSize;
     }
 
     void BufferAllocator::setBlob(const void* pData, size_t byteOffset, size_t byteSize)
@@ -75,7 +165,20 @@ namespace Falcor
     void BufferAllocator::clear()
     {
         mBuffer.clear();
-        mDirty = {};
+        mDirtyRanges.clear();
+        mAllocations.clear();
+        mFreeBlocks.clear();
+    }
+
+    void BufferAllocator::uploadDirtyRanges(const UploadFunc& upload)
+    {
+        for (const auto& range : mDirtyRanges)
+        {
+            FALCOR_ASSERT(range.start < range.end && range.end <= mBuffer.size());
+            upload(range.start, mBuffer.data() + range.start, range.getSize());
+        }
+        mDirtyRanges.clear();
+        mGpuSize = std::max(mGpuSize, mBuffer.size());
     }
 
     Buffer::SharedPtr BufferAllocator::getGPUBuffer(Device* pDevice)
@@ -104,30 +207,21 @@ namespace Falcor
                 mpGpuBuffer = Buffer::create(pDevice, bufSize, mBindFlags, Buffer::CpuAccess::None, nullptr);
             }
 
-            mDirty = Range(0, mBuffer.size()); // Mark entire buffer as dirty so the data gets uploaded.
+            mDirtyRanges.assign(1, Range(0, mBuffer.size())); // Mark entire buffer as dirty so the data gets uploaded.
+            mGpuSize = mpGpuBuffer->getSize();
         }
 
-        // If any range is dirty, upload the data from the CPU to the GPU.
-        if (mDirty.start < mDirty.end)
-        {
-            size_t byteSize = mDirty.end - mDirty.start;
-            size_t byteOffset = mDirty.start;
-            FALCOR_ASSERT(byteOffset + byteSize <= mBuffer.size());
-            FALCOR_ASSERT(mBuffer.size() <= mpGpuBuffer->getSize());
-            mpGpuBuffer->setBlob(mBuffer.data() + byteOffset, byteOffset, byteSize);
-
-            mDirty = { mBuffer.size(), 0 }; // Reset dirty range to inverted range. Any min/max operation on it will work.
-        }
+        // Upload the dirty ranges from the CPU to the GPU.
+        FALCOR_ASSERT(mBuffer.size() <= mpGpuBuffer->getSize());
+        uploadDirtyRanges([&](size_t byteOffset, const uint8_t* pData, size_t byteSize) { mpGpuBuffer->setBlob(pData, byteOffset, byteSize); });
 
         return mpGpuBuffer;
     }
 
     // Private
 
-    void BufferAllocator::computeAndAllocatePadding(size_t byteSize)
+    size_t BufferAllocator::computeAlignedOffset(size_t currentOffset, size_t byteSize) const
     {
-        size_t currentOffset = mBuffer.size();
-
         if (mAlignment > 0 && currentOffset % mAlignment > 0)
         {
             // We're not at the minimum alignment; get aligned.
@@ -145,6 +239,12 @@ namespace Falcor
             }
         }
 
+        return currentOffset;
+    }
+
+    void BufferAllocator::computeAndAllocatePadding(size_t byteSize)
+    {
+        size_t currentOffset = computeAlignedOffset(mBuffer.size(), byteSize);
         size_t pad = currentOffset - mBuffer.size();
         if (pad > 0)
         {
@@ -160,10 +260,60 @@ namespace Falcor
         return byteOffset;
     }
 
+    std::optional<size_t> BufferAllocator::allocFromFreeList(size_t byteSize)
+    {
+        // First fit. The aligned offset within each block follows the same rules as for new allocations.
+        for (auto it = mFreeBlocks.begin(); it != mFreeBlocks.end(); ++it)
+        {
+            const size_t blockStart = it->first;
+            const size_t blockEnd = it->first + it->second;
+            const size_t byteOffset = computeAlignedOffset(blockStart, byteSize);
+            if (byteOffset + byteSize > blockEnd) continue;
+
+            // Split the remainder of the block.
+            mFreeBlocks.erase(it);
+            if (byteOffset > blockStart) mFreeBlocks.emplace(blockStart, byteOffset - blockStart);
+            if (byteOffset + byteSize < blockEnd) mFreeBlocks.emplace(byteOffset + byteSize, blockEnd - byteOffset - byteSize);
+            return byteOffset;
+        }
+        return {};
+    }
+
+    void BufferAllocator::shrink(size_t byteSize)
+    {
+        FALCOR_ASSERT(byteSize <= mBuffer.size());
+        mBuffer.resize(byteSize);
+
+        // Drop the dirty ranges beyond the new end of the buffer.
+        while (!mDirtyRanges.empty() && mDirtyRanges.back().start >= byteSize) mDirtyRanges.pop_back();
+        if (!mDirtyRanges.empty()) mDirtyRanges.back().end = std::min(mDirtyRanges.back().end, byteSize);
+    }
+
     void BufferAllocator::markAsDirty(const Range& range)
     {
         FALCOR_ASSERT(range.start < range.end);
-        mDirty.start = std::min(mDirty.start, range.start);
-        mDirty.end = std::max(mDirty.end, range.end);
+
+        // Find the first range that ends within the merge distance before the new range.
+        auto first = std::lower_bound(mDirtyRanges.begin(), mDirtyRanges.end(), range.start,
+            [this](const Range& r, size_t start) { return r.end + mDirtyMergeDistance < start; });
+
+        // Merge all ranges that start within the merge distance after the new range.
+        Range merged = range;
+        auto last = first;
+        for (; last != mDirtyRanges.end() && last->start <= merged.end + mDirtyMergeDistance; ++last)
+        {
+            merged.start = std::min(merged.start, last->start);
+            merged.end = std::max(merged.end, last->end);
+        }
+
+        if (first == last)
+        {
+            mDirtyRanges.insert(first, merged);
+        }
+        else
+        {
+            *first = merged;
+            mDirtyRanges.erase(std::next(first), last);
+        }
     }
 }
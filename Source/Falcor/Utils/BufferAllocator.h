@@ -30,6 +30,9 @@
 #include "Core/Macros.h"
 #include "Core/API/Buffer.h"
 
+#include <functional>
+#include <map>
+#include <optional>
 #include <vector>
 
 namespace Falcor
@@ -48,10 +51,52 @@ namespace Falcor
         It is assumed that the base pointer of the GPU buffer starts at a
         cache line. The implementation doesn't provide any alignment
         guarantees for the CPU side buffer (where it doesn't matter anyway).
+
+        Allocations can be released with `free`. Released memory is kept in a
+        free list and reused by later allocations of matching size and alignment.
+        `compact` removes all holes by moving allocations towards the start of
+        the buffer and returns the new offsets.
+
+        Modified memory is tracked as a set of disjoint dirty ranges. Ranges that
+        are closer than the dirty merge distance are coalesced, and each remaining
+        range is uploaded separately. Memory that is appended below the end of the
+        GPU side copy, e.g. after freeing at the end of the buffer, is marked as
+        dirty as the GPU may still hold stale data there.
     */
     class FALCOR_API BufferAllocator
     {
     public:
+        /** Byte range [start, end).
+        */
+        struct Range
+        {
+            size_t start = 0;
+            size_t end = 0;
+            Range() {};
+            Range(size_t s, size_t e) : start(s), end(e) {}
+
+            size_t getSize() const { return end - start; }
+            bool operator==(const Range& other) const { return start == other.start && end == other.end; }
+        };
+
+        /** New location of an allocation after compaction.
+        */
+        struct Relocation
+        {
+            size_t oldOffset = 0;   ///< Offset in bytes before compaction.
+            size_t newOffset = 0;   ///< Offset in bytes after compaction.
+            size_t byteSize = 0;    ///< Size of the allocation in bytes.
+        };
+
+        /** Callback for uploading a dirty range.
+            The arguments are the offset in bytes, a pointer to the CPU side data at that offset and the size in bytes.
+        */
+        using UploadFunc = std::function<void(size_t byteOffset, const uint8_t* pData, size_t byteSize)>;
+
+        /** Default maximum gap in bytes between two dirty ranges for them to be merged into one upload.
+        */
+        static constexpr size_t kDefaultDirtyMergeDistance = 4096;
+
         /** Create a buffer allocator.
             \param[in] alignment Minimum alignment in bytes for any allocation.
             \param[in] elementSize Element size for structured buffer. If zero a raw buffer is created.
@@ -61,6 +106,8 @@ namespace Falcor
         BufferAllocator(size_t alignment, size_t elementSize, size_t cacheLineSize = 128, ResourceBindFlags bindFlags = ResourceBindFlags::ShaderResource | ResourceBindFlags::UnorderedAccess);
 
         /** Allocates a memory region.
+            Previously freed memory is reused if a large enough block is available, otherwise the buffer grows.
+            Zero-sized allocations are not tracked and must not be freed.
             \param[in] byteSize Amount of memory in bytes to allocate.
             \return Offset in bytes to the allocated memory.
         */
@@ -83,8 +130,7 @@ namespace Falcor
         template <typename T> size_t pushBack(const T& obj)
         {
             const size_t byteSize = sizeof(T);
-            computeAndAllocatePadding(byteSize);
-            size_t byteOffset = allocInternal(byteSize);
+            size_t byteOffset = allocate(byteSize);
             T* ptr = reinterpret_cast<T*>(mBuffer.data() + byteOffset);
             *ptr = obj;
             markAsDirty(byteOffset, byteSize);
@@ -98,14 +144,34 @@ namespace Falcor
         template <typename T, typename ...Args> size_t emplaceBack(Args&&... args)
         {
             const size_t byteSize = sizeof(T);
-            computeAndAllocatePadding(byteSize);
-            size_t byteOffset = allocInternal(byteSize);
+            size_t byteOffset = allocate(byteSize);
             void* ptr = mBuffer.data() + byteOffset;
             new (ptr) T(std::forward<Args>(args)...);
             markAsDirty(byteOffset, byteSize);
             return byteOffset;
         }
 
+        /** Release a previously allocated memory region. The memory is added to the free list for reuse.
+            If the region is at the end of the buffer, the buffer is shrunk instead.
+            \param[in] byteOffset Offset in bytes returned by the allocation.
+        */
+        void free(size_t byteOffset);
+
+        /** Move all allocations towards the start of the buffer to remove the space left by freed allocations.
+            The alignment and cache line rules are applied to the new locations. Moved memory is marked as dirty.
+            Offsets returned by earlier allocations are invalidated and need to be updated using the returned relocations.
+            \return List of relocations for all live allocations, sorted by offset.
+        */
+        std::vector<Relocation> compact();
+
+        /** Get the total size in bytes of the freed memory that is available for reuse.
+        */
+        size_t getFreeSize() const;
+
+        /** Get the number of live allocations.
+        */
+        size_t getAllocationCount() const { return mAllocations.size(); }
+
         /** Set data into a memory region.
             \param[in] pData Pointer to the source data.
             \param[in] byteOffset Offset in bytes to the destination memory region.
@@ -169,22 +235,38 @@ namespace Falcor
         */
         void clear();
 
+        /** Set the maximum gap in bytes between two dirty ranges for them to be merged.
+            Merging uploads some unmodified data but reduces the number of uploads.
+            \param[in] byteDistance Maximum gap in bytes. Zero only merges touching ranges.
+        */
+        void setDirtyMergeDistance(size_t byteDistance) { mDirtyMergeDistance = byteDistance; }
+
+        /** Get the maximum gap in bytes between two dirty ranges for them to be merged.
+        */
+        size_t getDirtyMergeDistance() const { return mDirtyMergeDistance; }
+
+        /** Get the dirty ranges that need to be uploaded, sorted by offset.
+        */
+        const std::vector<Range>& getDirtyRanges() const { return mDirtyRanges; }
+
+        /** Upload all dirty ranges and reset the dirty state.
+            This is used by `getGPUBuffer` and allows the upload to be redirected, e.g., for testing.
+            Afterwards the upload target is assumed to hold a copy of the entire buffer.
+            \param[in] upload Function called once per dirty range.
+        */
+        void uploadDirtyRanges(const UploadFunc& upload);
+
         /** Get GPU buffer. The buffer is updated and ready for use.
             The buffer is transient and only valid until the next allocation operation.
         */
         Buffer::SharedPtr getGPUBuffer(Device* pDevice);
 
     private:
+        size_t computeAlignedOffset(size_t offset, size_t byteSize) const;
         void computeAndAllocatePadding(size_t byteSize);
         size_t allocInternal(size_t byteSize);
-
-        struct Range
-        {
-            size_t start = 0;
-            size_t end = 0;
-            Range() {};
-            Range(size_t s, size_t e) : start(s), end(e) {}
-        };
+        std::optional<size_t> allocFromFreeList(size_t byteSize);
+        void shrink(size_t byteSize);
 
         void markAsDirty(const Range& range);
         void markAsDirty(size_t byteOffset, size_t byteSize) { markAsDirty(Range(byteOffset, byteOffset + byteSize)); }
@@ -194,9 +276,14 @@ namespace Falcor
         const size_t mCacheLineSize;        ///< Allocation are aligned to not span multiple cache lines (if possible). A value of zero means do not care about cache line alignment.
         const ResourceBindFlags mBindFlags; ///< Bind flags for the GPU buffer.
 
-        Range mDirty;                       ///< Range of buffer that is dirty and needs to be updatd on the GPU. We track a single dirty range for now to minimize the number of uploads, but this could be changed.
+        std::vector<Range> mDirtyRanges;    ///< Sorted disjoint ranges of the buffer that are dirty and need to be updated on the GPU.
+        size_t mDirtyMergeDistance = kDefaultDirtyMergeDistance; ///< Dirty ranges closer than this are merged.
+
+        std::map<size_t, size_t> mAllocations; ///< Live allocations (offset -> size in bytes).
+        std::map<size_t, size_t> mFreeBlocks;  ///< Free blocks between live allocations (offset -> size in bytes).
 
         std::vector<uint8_t> mBuffer;       ///< CPU buffer holding a copy of the data.
         Buffer::SharedPtr mpGpuBuffer;      ///< GPU buffer holding the data.
+        size_t mGpuSize = 0;                ///< Size in bytes of the GPU side copy. Memory below this may hold stale data on the GPU.
     };
 }
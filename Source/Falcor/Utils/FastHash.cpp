@@ -0,0 +1,630 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "FastHash.h"
+#include "Core/Assert.h"
+#include "Core/Platform/MemoryMappedFile.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Falcor
+{
+    namespace
+    {
+        // Constants from the xxHash reference implementation.
+        const uint64_t kPrime32_1 = 0x9E3779B1ull;
+        const uint64_t kPrime32_2 = 0x85EBCA77ull;
+        const uint64_t kPrime32_3 = 0xC2B2AE3Dull;
+        const uint64_t kPrime64_1 = 0x9E3779B185EBCA87ull;
+        const uint64_t kPrime64_2 = 0xC2B2AE3D27D4EB4Full;
+        const uint64_t kPrime64_3 = 0x165667B19E3779F9ull;
+        const uint64_t kPrime64_4 = 0x85EBCA77C2B2AE63ull;
+        const uint64_t kPrime64_5 = 0x27D4EB2F165667C5ull;
+        const uint64_t kPrimeMx1 = 0x165667919E3779F9ull;
+        const uint64_t kPrimeMx2 = 0x9FB21C651E98DF25ull;
+
+        const size_t kStripeLen = 64;                                       ///< Bytes per stripe.
+        const size_t kAccCount = kStripeLen / sizeof(uint64_t);             ///< Number of accumulator lanes.
+        const size_t kSecretConsumeRate = 8;                                ///< Secret bytes consumed per stripe.
+        const size_t kSecretSize = 192;
+        const size_t kSecretLimit = kSecretSize - kStripeLen;
+        const size_t kStripesPerBlock = kSecretLimit / kSecretConsumeRate;
+        const size_t kBlockLen = kStripeLen * kStripesPerBlock;
+        const size_t kSecretSizeMin = 136;
+        const size_t kSecretMergeAccsStart = 11;
+        const size_t kSecretLastAccStart = 7;
+        const size_t kMidSizeMax = 240;
+        const size_t kMidSizeStartOffset = 3;
+        const size_t kMidSizeLastOffset = 17;
+        const size_t kBufferSize = 256;
+
+        alignas(64) const uint8_t kSecret[kSecretSize] =
+        {
+            0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+            0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+            0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+            0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+            0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+            0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+            0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+            0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+            0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+            0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+            0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+            0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+        };
+
+        using Hash128 = XXH3::Hash128;
+
+        // All supported platforms are little-endian, so reads are plain unaligned loads.
+        inline uint32_t readLE32(const uint8_t* p) { uint32_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+        inline uint64_t readLE64(const uint8_t* p) { uint64_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+
+        inline uint32_t rotl32(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+        inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+        inline uint32_t swap32(uint32_t x)
+        {
+            return ((x << 24) & 0xff000000u) | ((x << 8) & 0x00ff0000u) | ((x >> 8) & 0x0000ff00u) | ((x >> 24) & 0x000000ffu);
+        }
+
+        inline uint64_t swap64(uint64_t x)
+        {
+            return ((uint64_t)swap32((uint32_t)x) << 32) | swap32((uint32_t)(x >> 32));
+        }
+
+        inline Hash128 mult64to128(uint64_t lhs, uint64_t rhs)
+        {
+            Hash128 r;
+#if defined(_MSC_VER) && defined(_M_X64)
+            r.low64 = _umul128(lhs, rhs, &r.high64);
+#else
+            __uint128_t product = (__uint128_t)lhs * rhs;
+            r.low64 = (uint64_t)product;
+            r.high64 = (uint64_t)(product >> 64);
+#endif
+            return r;
+        }
+
+        inline uint64_t mul128Fold64(uint64_t lhs, uint64_t rhs)
+        {
+            Hash128 product = mult64to128(lhs, rhs);
+            return product.low64 ^ product.high64;
+        }
+
+        inline uint64_t xorshift64(uint64_t v, int shift) { return v ^ (v >> shift); }
+
+        inline uint64_t xxh64Avalanche(uint64_t h)
+        {
+            h ^= h >> 33;
+            h *= kPrime64_2;
+            h ^= h >> 29;
+            h *= kPrime64_3;
+            h ^= h >> 32;
+            return h;
+        }
+
+        inline uint64_t avalanche(uint64_t h)
+        {
+            h = xorshift64(h, 37);
+            h *= kPrimeMx1;
+            h = xorshift64(h, 32);
+            return h;
+        }
+
+        inline uint64_t rrmxmx(uint64_t h, uint64_t len)
+        {
+            h ^= rotl64(h, 49) ^ rotl64(h, 24);
+            h *= kPrimeMx2;
+            h ^= (h >> 35) + len;
+            h *= kPrimeMx2;
+            return xorshift64(h, 28);
+        }
+
+        inline uint64_t mix16B(const uint8_t* input, const uint8_t* secret)
+        {
+            return mul128Fold64(readLE64(input) ^ readLE64(secret), readLE64(input + 8) ^ readLE64(secret + 8));
+        }
+
+        inline Hash128 mix32B(Hash128 acc, const uint8_t* input1, const uint8_t* input2, const uint8_t* secret)
+        {
+            acc.low64 += mix16B(input1, secret);
+            acc.low64 ^= readLE64(input2) + readLE64(input2 + 8);
+            acc.high64 += mix16B(input2, secret + 16);
+            acc.high64 ^= readLE64(input1) + readLE64(input1 + 8);
+            return acc;
+        }
+
+        // Short inputs (up to kMidSizeMax bytes).
+
+        uint64_t hashShort64(const uint8_t* input, size_t len)
+        {
+            FALCOR_ASSERT(len <= kMidSizeMax);
+            const uint8_t* secret = kSecret;
+
+            if (len == 0)
+            {
+                return xxh64Avalanche(readLE64(secret + 56) ^ readLE64(secret + 64));
+            }
+            else if (len <= 3)
+            {
+                uint32_t combined = ((uint32_t)input[0] << 16) | ((uint32_t)input[len >> 1] << 24) | (uint32_t)input[len - 1] | ((uint32_t)len << 8);
+                uint64_t bitflip = readLE32(secret) ^ readLE32(secret + 4);
+                return xxh64Avalanche(combined ^ bitflip);
+            }
+            else if (len <= 8)
+            {
+                uint64_t input64 = readLE32(input + len - 4) + ((uint64_t)readLE32(input) << 32);
+                uint64_t bitflip = readLE64(secret + 8) ^ readLE64(secret + 16);
+                return rrmxmx(input64 ^ bitflip, len);
+            }
+            else if (len <= 16)
+            {
+                uint64_t bitflip1 = readLE64(secret + 24) ^ readLE64(secret + 32);
+                uint64_t bitflip2 = readLE64(secret + 40) ^ readLE64(secret + 48);
+                uint64_t inputLo = readLE64(input) ^ bitflip1;
+                uint64_t inputHi = readLE64(input + len - 8) ^ bitflip2;
+                return avalanche(len + swap64(inputLo) + inputHi + mul128Fold64(inputLo, inputHi));
+            }
+            else if (len <= 128)
+            {
+                uint64_t acc = len * kPrime64_1;
+                if (len > 32)
+                {
+                    if (len > 64)
+                    {
+                        if (len > 96)
+                        {
+                            acc += mix16B(input + 48, secret + 96);
+                            acc += mix16B(input + len - 64, secret + 112);
+                        }
+                        acc += mix16B(input + 32, secret + 64);
+                        acc += mix16B(input + len - 48, secret + 80);
+                    }
+                    acc += mix16B(input + 16, secret + 32);
+                    acc += mix16B(input + len - 32, secret + 48);
+                }
+                acc += mix16B(input, secret);
+                acc += mix16B(input + len - 16, secret + 16);
+                return avalanche(acc);
+            }
+            else
+            {
+                uint64_t acc = len * kPrime64_1;
+                for (size_t i = 0; i < 8; i++) acc += mix16B(input + 16 * i, secret + 16 * i);
+                acc = avalanche(acc);
+                const size_t roundCount = len / 16;
+                for (size_t i = 8; i < roundCount; i++) acc += mix16B(input + 16 * i, secret + 16 * (i - 8) + kMidSizeStartOffset);
+                acc += mix16B(input + len - 16, secret + kSecretSizeMin - kMidSizeLastOffset);
+                return avalanche(acc);
+            }
+        }
+
+        Hash128 hashShort128(const uint8_t* input, size_t len)
+        {
+            FALCOR_ASSERT(len <= kMidSizeMax);
+            const uint8_t* secret = kSecret;
+            Hash128 h;
+
+            if (len == 0)
+            {
+                h.low64 = xxh64Avalanche(readLE64(secret + 64) ^ readLE64(secret + 72));
+                h.high64 = xxh64Avalanche(readLE64(secret + 80) ^ readLE64(secret + 88));
+                return h;
+            }
+            else if (len <= 3)
+            {
+                uint32_t combinedLo = ((uint32_t)input[0] << 16) | ((uint32_t)input[len >> 1] << 24) | (uint32_t)input[len - 1] | ((uint32_t)len << 8);
+                uint32_t combinedHi = rotl32(swap32(combinedLo), 13);
+                uint64_t bitflipLo = readLE32(secret) ^ readLE32(secret + 4);
+                uint64_t bitflipHi = readLE32(secret + 8) ^ readLE32(secret + 12);
+                h.low64 = xxh64Avalanche(combinedLo ^ bitflipLo);
+                h.high64 = xxh64Avalanche(combinedHi ^ bitflipHi);
+                return h;
+            }
+            else if (len <= 8)
+            {
+                uint64_t input64 = readLE32(input) + ((uint64_t)readLE32(input + len - 4) << 32);
+                uint64_t bitflip = readLE64(secret + 16) ^ readLE64(secret + 24);
+                Hash128 m = mult64to128(input64 ^ bitflip, kPrime64_1 + (len << 2));
+                m.high64 += m.low64 << 1;
+                m.low64 ^= m.high64 >> 3;
+                m.low64 = xorshift64(m.low64, 35);
+                m.low64 *= kPrimeMx2;
+                m.low64 = xorshift64(m.low64, 28);
+                m.high64 = avalanche(m.high64);
+                return m;
+            }
+            else if (len <= 16)
+            {
+                uint64_t bitflipLo = readLE64(secret + 32) ^ readLE64(secret + 40);
+                uint64_t bitflipHi = readLE64(secret + 48) ^ readLE64(secret + 56);
+                uint64_t inputLo = readLE64(input);
+                uint64_t inputHi = readLE64(input + len - 8);
+                Hash128 m = mult64to128(inputLo ^ inputHi ^ bitflipLo, kPrime64_1);
+                m.low64 += (uint64_t)(len - 1) << 54;
+                inputHi ^= bitflipHi;
+                m.high64 += inputHi + (uint64_t)(uint32_t)inputHi * (kPrime32_2 - 1);
+                m.low64 ^= swap64(m.high64);
+                h = mult64to128(m.low64, kPrime64_2);
+                h.high64 += m.high64 * kPrime64_2;
+                h.low64 = avalanche(h.low64);
+                h.high64 = avalanche(h.high64);
+                return h;
+            }
+
+            Hash128 acc;
+            acc.low64 = len * kPrime64_1;
+            if (len <= 128)
+            {
+                if (len > 32)
+                {
+                    if (len > 64)
+                    {
+                        if (len > 96) acc = mix32B(acc, input + 48, input + len - 64, secret + 96);
+                        acc = mix32B(acc, input + 32, input + len - 48, secret + 64);
+                    }
+                    acc = mix32B(acc, input + 16, input + len - 32, secret + 32);
+                }
+                acc = mix32B(acc, input, input + len - 16, secret);
+            }
+            else
+            {
+                for (size_t i = 32; i < 160; i += 32) acc = mix32B(acc, input + i - 32, input + i - 16, secret + i - 32);
+                acc.low64 = avalanche(acc.low64);
+                acc.high64 = avalanche(acc.high64);
+                for (size_t i = 160; i <= len; i += 32) acc = mix32B(acc, input + i - 32, input + i - 16, secret + kMidSizeStartOffset + i - 160);
+                acc = mix32B(acc, input + len - 16, input + len - 32, secret + kSecretSizeMin - kMidSizeLastOffset - 16);
+            }
+
+            h.low64 = avalanche(acc.low64 + acc.high64);
+            h.high64 = 0 - avalanche(acc.low64 * kPrime64_1 + acc.high64 * kPrime64_4 + len * kPrime64_2);
+            return h;
+        }
+
+        // Long inputs. The accumulator lanes are independent, so these loops auto-vectorize.
+
+        inline void accumulate512(uint64_t* acc, const uint8_t* input, const uint8_t* secret)
+        {
+            uint64_t dataVal[kAccCount];
+            uint64_t dataKey[kAccCount];
+            for (size_t i = 0; i < kAccCount; i++)
+            {
+                dataVal[i] = readLE64(input + 8 * i);
+                dataKey[i] = dataVal[i] ^ readLE64(secret + 8 * i);
+            }
+            for (size_t i = 0; i < kAccCount; i++)
+            {
+                acc[i] += dataVal[i ^ 1] + (dataKey[i] & 0xffffffffull) * (dataKey[i] >> 32);
+            }
+        }
+
+        inline void accumulate(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t stripeCount)
+        {
+            for (size_t n = 0; n < stripeCount; n++) accumulate512(acc, input + n * kStripeLen, secret + n * kSecretConsumeRate);
+        }
+
+        inline void scramble(uint64_t* acc, const uint8_t* secret)
+        {
+            for (size_t i = 0; i < kAccCount; i++)
+            {
+                uint64_t a = xorshift64(acc[i], 47) ^ readLE64(secret + 8 * i);
+                acc[i] = a * kPrime32_1;
+            }
+        }
+
+        void initAcc(uint64_t* acc)
+        {
+            const uint64_t kInitAcc[kAccCount] = { kPrime32_3, kPrime64_1, kPrime64_2, kPrime64_3, kPrime64_4, kPrime32_2, kPrime64_5, kPrime32_1 };
+            std::memcpy(acc, kInitAcc, sizeof(kInitAcc));
+        }
+
+        uint64_t mergeAccs(const uint64_t* acc, const uint8_t* secret, uint64_t start)
+        {
+            uint64_t result = start;
+            for (size_t i = 0; i < 4; i++)
+            {
+                result += mul128Fold64(acc[2 * i] ^ readLE64(secret + 16 * i), acc[2 * i + 1] ^ readLE64(secret + 16 * i + 8));
+            }
+            return avalanche(result);
+        }
+
+        uint64_t mergeAccs64(const uint64_t* acc, uint64_t len)
+        {
+            return mergeAccs(acc, kSecret + kSecretMergeAccsStart, len * kPrime64_1);
+        }
+
+        Hash128 mergeAccs128(const uint64_t* acc, uint64_t len)
+        {
+            Hash128 h;
+            h.low64 = mergeAccs(acc, kSecret + kSecretMergeAccsStart, len * kPrime64_1);
+            h.high64 = mergeAccs(acc, kSecret + kSecretSize - kStripeLen - kSecretMergeAccsStart, ~(len * kPrime64_2));
+            return h;
+        }
+
+        void hashLong(uint64_t* acc, const uint8_t* input, size_t len)
+        {
+            FALCOR_ASSERT(len > kMidSizeMax);
+            initAcc(acc);
+
+            const size_t blockCount = (len - 1) / kBlockLen;
+            for (size_t n = 0; n < blockCount; n++)
+            {
+                accumulate(acc, input + n * kBlockLen, kSecret, kStripesPerBlock);
+                scramble(acc, kSecret + kSecretLimit);
+            }
+
+            const size_t stripeCount = ((len - 1) - kBlockLen * blockCount) / kStripeLen;
+            accumulate(acc, input + blockCount * kBlockLen, kSecret, stripeCount);
+            accumulate512(acc, input + len - kStripeLen, kSecret + kSecretLimit - kSecretLastAccStart);
+        }
+
+        /** Accumulate stripes in streaming mode, scrambling at block boundaries.
+            \return Returns a pointer past the consumed input.
+        */
+        const uint8_t* consumeStripes(uint64_t* acc, size_t& stripesSoFar, const uint8_t* input, size_t stripeCount)
+        {
+            const uint8_t* initialSecret = kSecret + stripesSoFar * kSecretConsumeRate;
+            if (stripeCount >= kStripesPerBlock - stripesSoFar)
+            {
+                size_t stripesThisIter = kStripesPerBlock - stripesSoFar;
+                do
+                {
+                    accumulate(acc, input, initialSecret, stripesThisIter);
+                    scramble(acc, kSecret + kSecretLimit);
+                    input += stripesThisIter * kStripeLen;
+                    stripeCount -= stripesThisIter;
+                    stripesThisIter = kStripesPerBlock;
+                    initialSecret = kSecret;
+                } while (stripeCount >= kStripesPerBlock);
+                stripesSoFar = 0;
+            }
+            if (stripeCount > 0)
+            {
+                accumulate(acc, input, initialSecret, stripeCount);
+                input += stripeCount * kStripeLen;
+                stripesSoFar += stripeCount;
+            }
+            return input;
+        }
+
+        std::string toHexString(const uint8_t* data, size_t len)
+        {
+            std::ostringstream oss;
+            for (size_t i = 0; i < len; i++) oss << std::hex << std::setw(2) << std::setfill('0') << (int)data[i];
+            return oss.str();
+        }
+
+        void writeBE64(uint8_t* dst, uint64_t v)
+        {
+            for (int i = 0; i < 8; i++) dst[i] = (uint8_t)(v >> (56 - 8 * i));
+        }
+    }
+
+    // XXH3
+
+    XXH3::XXH3()
+    {
+        initAcc(mAcc);
+        std::memset(mBuffer, 0, sizeof(mBuffer));
+    }
+
+    void XXH3::update(const void* data, size_t len)
+    {
+        if (len == 0) return;
+
+        const uint8_t* input = static_cast<const uint8_t*>(data);
+        const uint8_t* const end = input + len;
+        mTotalLen += len;
+
+        // Buffer small inputs. The buffer is only consumed once more data arrives, so that the last stripe is always in the buffer.
+        if (len <= kBufferSize - mBufferedSize)
+        {
+            std::memcpy(mBuffer + mBufferedSize, input, len);
+            mBufferedSize += len;
+            return;
+        }
+
+        // Fill and consume the buffer.
+        if (mBufferedSize > 0)
+        {
+            const size_t loadSize = kBufferSize - mBufferedSize;
+            std::memcpy(mBuffer + mBufferedSize, input, loadSize);
+            input += loadSize;
+            consumeStripes(mAcc, mStripesSoFar, mBuffer, kBufferSize / kStripeLen);
+            mBufferedSize = 0;
+        }
+
+        // Consume the input directly, keeping at least one byte and the preceding stripe for the final digest.
+        if ((size_t)(end - input) > kBufferSize)
+        {
+            const size_t stripeCount = (size_t)(end - 1 - input) / kStripeLen;
+            input = consumeStripes(mAcc, mStripesSoFar, input, stripeCount);
+            std::memcpy(mBuffer + kBufferSize - kStripeLen, input - kStripeLen, kStripeLen);
+        }
+
+        std::memcpy(mBuffer, input, (size_t)(end - input));
+        mBufferedSize = (size_t)(end - input);
+    }
+
+    void XXH3::digestLong(uint64_t* acc) const
+    {
+        std::memcpy(acc, mAcc, sizeof(mAcc));
+
+        const uint8_t* lastStripe = nullptr;
+        uint8_t lastStripeBuffer[kStripeLen];
+        if (mBufferedSize >= kStripeLen)
+        {
+            const size_t stripeCount = (mBufferedSize - 1) / kStripeLen;
+            size_t stripesSoFar = mStripesSoFar;
+            consumeStripes(acc, stripesSoFar, mBuffer, stripeCount);
+            lastStripe = mBuffer + mBufferedSize - kStripeLen;
+        }
+        else
+        {
+            // The last stripe wraps around the end of the buffer.
+            const size_t catchupSize = kStripeLen - mBufferedSize;
+            std::memcpy(lastStripeBuffer, mBuffer + kBufferSize - catchupSize, catchupSize);
+            std::memcpy(lastStripeBuffer + catchupSize, mBuffer, mBufferedSize);
+            lastStripe = lastStripeBuffer;
+        }
+        accumulate512(acc, lastStripe, kSecret + kSecretLimit - kSecretLastAccStart);
+    }
+
+    uint64_t XXH3::finalize64() const
+    {
+        if (mTotalLen <= kMidSizeMax) return hashShort64(mBuffer, (size_t)mTotalLen);
+
+        alignas(64) uint64_t acc[kAccCount];
+        digestLong(acc);
+        return mergeAccs64(acc, mTotalLen);
+    }
+
+    XXH3::Hash128 XXH3::finalize128() const
+    {
+        if (mTotalLen <= kMidSizeMax) return hashShort128(mBuffer, (size_t)mTotalLen);
+
+        alignas(64) uint64_t acc[kAccCount];
+        digestLong(acc);
+        return mergeAccs128(acc, mTotalLen);
+    }
+
+    uint64_t XXH3::compute64(const void* data, size_t len)
+    {
+        const uint8_t* input = static_cast<const uint8_t*>(data);
+        if (len <= kMidSizeMax) return hashShort64(input, len);
+
+        alignas(64) uint64_t acc[kAccCount];
+        hashLong(acc, input, len);
+        return mergeAccs64(acc, len);
+    }
+
+    XXH3::Hash128 XXH3::compute128(const void* data, size_t len)
+    {
+        const uint8_t* input = static_cast<const uint8_t*>(data);
+        if (len <= kMidSizeMax) return hashShort128(input, len);
+
+        alignas(64) uint64_t acc[kAccCount];
+        hashLong(acc, input, len);
+        return mergeAccs128(acc, len);
+    }
+
+    std::string XXH3::toString(uint64_t hash)
+    {
+        uint8_t bytes[8];
+        writeBE64(bytes, hash);
+        return toHexString(bytes, sizeof(bytes));
+    }
+
+    std::string XXH3::toString(const Hash128& hash)
+    {
+        uint8_t bytes[16];
+        writeBE64(bytes, hash.high64);
+        writeBE64(bytes + 8, hash.low64);
+        return toHexString(bytes, sizeof(bytes));
+    }
+
+    // Hasher
+
+    std::string Hasher::Digest::toString() const
+    {
+        return toHexString(bytes.data(), getSize());
+    }
+
+    Hasher::Hasher(HashAlgorithm algorithm)
+        : mAlgorithm(algorithm)
+    {}
+
+    void Hasher::update(const void* data, size_t len)
+    {
+        switch (mAlgorithm)
+        {
+        case HashAlgorithm::SHA1: mSHA1.update(data, len); break;
+        case HashAlgorithm::XXH3_128: mXXH3.update(data, len); break;
+        default: FALCOR_UNREACHABLE();
+        }
+    }
+
+    bool Hasher::updateFile(const std::filesystem::path& path)
+    {
+        // Empty files cannot be mapped.
+        std::error_code ec;
+        const auto fileSize = std::filesystem::file_size(path, ec);
+        if (ec) return false;
+        if (fileSize == 0) return true;
+
+        MemoryMappedFile file(path, MemoryMappedFile::kWholeFile, MemoryMappedFile::AccessHint::SequentialScan);
+        if (!file.isOpen()) return false;
+
+        update(file.getData(), file.getSize());
+        return true;
+    }
+
+    Hasher::Digest Hasher::finalize()
+    {
+        Digest digest;
+        digest.algorithm = mAlgorithm;
+        switch (mAlgorithm)
+        {
+        case HashAlgorithm::SHA1:
+        {
+            SHA1::MD md = mSHA1.finalize();
+            std::copy(md.begin(), md.end(), digest.bytes.begin());
+            break;
+        }
+        case HashAlgorithm::XXH3_128:
+        {
+            XXH3::Hash128 hash = mXXH3.finalize128();
+            writeBE64(digest.bytes.data(), hash.high64);
+            writeBE64(digest.bytes.data() + 8, hash.low64);
+            break;
+        }
+        default:
+            FALCOR_UNREACHABLE();
+        }
+        return digest;
+    }
+
+    Hasher::Digest Hasher::compute(HashAlgorithm algorithm, const void* data, size_t len)
+    {
+        Hasher hasher(algorithm);
+        hasher.update(data, len);
+        return hasher.finalize();
+    }
+
+    std::optional<Hasher::Digest> Hasher::computeFile(HashAlgorithm algorithm, const std::filesystem::path& path)
+    {
+        Hasher hasher(algorithm);
+        if (!hasher.updateFile(path)) return {};
+        return hasher.finalize();
+    }
+}
@@ -0,0 +1,208 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "CryptoUtils.h"
+#include "Core/Macros.h"
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Falcor
+{
+    /** Helper to compute XXH3 hashes.
+        XXH3 is a fast non-cryptographic hash function from the xxHash family (https://github.com/Cyan4973/xxHash).
+        This is a port of the reference implementation using the default secret and a seed of zero. The results match
+        XXH3_64bits() and XXH3_128bits() of xxHash 0.8. Large inputs are processed in 64-byte stripes with eight independent
+        64-bit lanes, which compilers auto-vectorize.
+        Like the reference implementation, the streaming interface gives the same result as hashing all data at once.
+    */
+    class FALCOR_API XXH3
+    {
+    public:
+        /** 128-bit hash value.
+        */
+        struct Hash128
+        {
+            uint64_t low64 = 0;
+            uint64_t high64 = 0;
+
+            bool operator==(const Hash128& other) const { return low64 == other.low64 && high64 == other.high64; }
+            bool operator!=(const Hash128& other) const { return !(*this == other); }
+        };
+
+        XXH3();
+
+        /** Update hash by adding the given data.
+            \param[in] data Data to hash.
+            \param[in] len Length of data in bytes.
+        */
+        void update(const void* data, size_t len);
+
+        /** Update hash by adding one value of fundamental type T.
+            \param[in] Value to hash.
+        */
+        template<typename T, std::enable_if_t<std::is_fundamental<T>::value, bool> = true>
+        void update(const T& value) { update(&value, sizeof(value)); }
+
+        /** Update hash by adding the given string view.
+        */
+        void update(const std::string_view str) { update(str.data(), str.size()); }
+
+        /** Return the 64-bit hash of the data added so far.
+            The hash can still be updated afterwards.
+        */
+        uint64_t finalize64() const;
+
+        /** Return the 128-bit hash of the data added so far.
+            The hash can still be updated afterwards.
+        */
+        Hash128 finalize128() const;
+
+        /** Compute 64-bit XXH3 hash over the given data.
+            \param[in] data Data to hash.
+            \param[in] len Length of data in bytes.
+            \return Returns the hash.
+        */
+        static uint64_t compute64(const void* data, size_t len);
+
+        /** Compute 128-bit XXH3 hash over the given data.
+            \param[in] data Data to hash.
+            \param[in] len Length of data in bytes.
+            \return Returns the hash.
+        */
+        static Hash128 compute128(const void* data, size_t len);
+
+        /** Convert 64-bit hash to 16-character string in hexadecimal notation.
+        */
+        static std::string toString(uint64_t hash);
+
+        /** Convert 128-bit hash to 32-character string in hexadecimal notation (canonical big-endian order, high half first).
+        */
+        static std::string toString(const Hash128& hash);
+
+    private:
+        void digestLong(uint64_t* acc) const;
+
+        alignas(64) uint64_t mAcc[8];
+        alignas(64) uint8_t mBuffer[256];
+        size_t mBufferedSize = 0;
+        size_t mStripesSoFar = 0;
+        uint64_t mTotalLen = 0;
+    };
+
+    /** Hash algorithms for cache keys.
+    */
+    enum class HashAlgorithm : uint32_t
+    {
+        SHA1,       ///< SHA-1, 160 bits.
+        XXH3_128,   ///< 128-bit XXH3. Much faster than SHA-1 but not cryptographic.
+    };
+
+    /** Helper to compute hashes with a selectable algorithm.
+        This is used to compute cache keys, so that each cache can choose the algorithm that fits the amount of data it hashes.
+    */
+    class FALCOR_API Hasher
+    {
+    public:
+        /** Message digest.
+            Only the first getSize() bytes are used, the rest is zero. The digest is trivially copyable and can be stored in files.
+        */
+        struct Digest
+        {
+            HashAlgorithm algorithm = HashAlgorithm::SHA1;
+            std::array<uint8_t, 20> bytes = {};
+
+            /** Get the size of the digest in bytes.
+            */
+            size_t getSize() const { return algorithm == HashAlgorithm::SHA1 ? 20 : 16; }
+
+            /** Convert digest to string in hexadecimal notation.
+            */
+            std::string toString() const;
+
+            bool operator==(const Digest& other) const { return algorithm == other.algorithm && bytes == other.bytes; }
+            bool operator!=(const Digest& other) const { return !(*this == other); }
+        };
+
+        explicit Hasher(HashAlgorithm algorithm);
+
+        HashAlgorithm getAlgorithm() const { return mAlgorithm; }
+
+        /** Update hash by adding the given data.
+            \param[in] data Data to hash.
+            \param[in] len Length of data in bytes.
+        */
+        void update(const void* data, size_t len);
+
+        /** Update hash by adding one value of fundamental type T.
+            \param[in] Value to hash.
+        */
+        template<typename T, std::enable_if_t<std::is_fundamental<T>::value, bool> = true>
+        void update(const T& value) { update(&value, sizeof(value)); }
+
+        /** Update hash by adding the given string view.
+        */
+        void update(const std::string_view str) { update(str.data(), str.size()); }
+
+        /** Update hash by adding the content of a file.
+            The file is read through a memory mapping.
+            \param[in] path File path.
+            \return Returns false if the file could not be opened. The hash is not updated in that case.
+        */
+        bool updateFile(const std::filesystem::path& path);
+
+        /** Return final message digest.
+        */
+        Digest finalize();
+
+        /** Compute hash over the given data.
+            \param[in] algorithm Hash algorithm.
+            \param[in] data Data to hash.
+            \param[in] len Length of data in bytes.
+            \return Returns the message digest.
+        */
+        static Digest compute(HashAlgorithm algorithm, const void* data, size_t len);
+
+        /** Compute hash over the content of a file. The file is read through a memory mapping.
+            \param[in] algorithm Hash algorithm.
+            \param[in] path File path.
+            \return Returns the message digest or an empty optional if the file could not be opened.
+        */
+        static std::optional<Digest> computeFile(HashAlgorithm algorithm, const std::filesystem::path& path);
+
+    private:
+        HashAlgorithm mAlgorithm;
+        SHA1 mSHA1;
+        XXH3 mXXH3;
+    };
+}
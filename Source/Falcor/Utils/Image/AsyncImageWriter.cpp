@@ -0,0 +1,318 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "AsyncImageWriter.h"
+#include "Core/Assert.h"
+#include "Core/Errors.h"
+#include "Utils/Logger.h"
+#include "Utils/Math/Float16.h"
+#include <algorithm>
+
+namespace Falcor
+{
+    namespace
+    {
+        /** Expand float images with less than three channels to RGBA32Float.
+            Bitmap::saveImage() only supports 3 or 4 channels for 32-bit float data, and would write 16-bit float data
+            with one channel as red. Expanding all float bit depths here makes them behave the same: single-channel
+            images are replicated to gray, two-channel images are written as red/green with zero blue.
+            This replaces the blit to a temporary RGBA32Float texture done by Texture::captureToFile().
+        */
+        std::vector<float> expandToRGBA32Float(uint32_t width, uint32_t height, ResourceFormat format, const void* pData)
+        {
+            const uint32_t channelCount = getFormatChannelCount(format);
+            const bool isHalf = getNumChannelBits(format, 0) == 16;
+
+            std::vector<float> newData(width * (size_t)height * 4, 0.f);
+            const float* pSrc = reinterpret_cast<const float*>(pData);
+            const float16_t* pSrcHalf = reinterpret_cast<const float16_t*>(pData);
+            float* pDst = newData.data();
+
+            for (size_t i = 0; i < width * (size_t)height; ++i)
+            {
+                for (uint32_t c = 0; c < channelCount; ++c)
+                {
+                    const size_t index = i * channelCount + c;
+                    pDst[c] = isHalf ? (float)pSrcHalf[index] : pSrc[index];
+                }
+                // Replicate single-channel data to RGB so that grayscale images stay grayscale.
+                if (channelCount == 1) pDst[1] = pDst[2] = pDst[0];
+                pDst[3] = 1.f;
+                pDst += 4;
+            }
+
+            return newData;
+        }
+
+        bool needsExpansion(ResourceFormat format)
+        {
+            if (getFormatType(format) != FormatType::Float || getFormatChannelCount(format) >= 3) return false;
+            const uint32_t bits = getNumChannelBits(format, 0);
+            return bits == 16 || bits == 32;
+        }
+    }
+
+    AsyncImageWriter::AsyncImageWriter(size_t threadCount, size_t maxPendingCount)
+        : mMaxPendingCount(std::max<size_t>(maxPendingCount, 1))
+    {
+        threadCount = std::max<size_t>(threadCount, 1);
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            mThreads.emplace_back(&AsyncImageWriter::runWorker, this);
+        }
+    }
+
+    AsyncImageWriter::~AsyncImageWriter()
+    {
+        processReadbacks(true);
+        terminateWorkers();
+    }
+
+    void AsyncImageWriter::write(const std::filesystem::path& path, Bitmap::UniqueConstPtr pBitmap, Bitmap::FileFormat fileFormat, Bitmap::ExportFlags exportFlags)
+    {
+        checkArgument(pBitmap != nullptr, "'pBitmap' must not be null.");
+
+        WriteRequest request;
+        request.path = path;
+        request.width = pBitmap->getWidth();
+        request.height = pBitmap->getHeight();
+        request.format = pBitmap->getFormat();
+        request.fileFormat = fileFormat;
+        request.exportFlags = exportFlags;
+        request.pBitmap = std::move(pBitmap);
+        enqueue(std::move(request));
+    }
+
+    void AsyncImageWriter::write(const std::filesystem::path& path, CopyContext::ReadTextureTask::SharedPtr pReadTask, uint32_t width, uint32_t height, ResourceFormat format, Bitmap::FileFormat fileFormat, Bitmap::ExportFlags exportFlags)
+    {
+        checkArgument(pReadTask != nullptr, "'pReadTask' must not be null.");
+
+        WriteRequest request;
+        request.path = path;
+        request.width = width;
+        request.height = height;
+        request.format = format;
+        request.fileFormat = fileFormat;
+        request.exportFlags = exportFlags;
+        request.pReadTask = std::move(pReadTask);
+
+        // Pass on finished readbacks first so they don't count against the queue limit for longer than needed.
+        processReadbacks(false);
+        enqueue(std::move(request));
+    }
+
+    void AsyncImageWriter::processReadbacks(bool wait)
+    {
+        while (!mReadbackQueue.empty())
+        {
+            WriteRequest& request = mReadbackQueue.front();
+            if (!wait && !request.pReadTask->isDataReady()) break;
+
+            bool success = false;
+            try
+            {
+                request.textureData = request.pReadTask->getData();
+                success = true;
+            }
+            catch (const std::exception& e)
+            {
+                logError("AsyncImageWriter failed to read back '{}': {}", request.path, e.what());
+            }
+
+            // Release the readback buffer here, deferred resource release is not thread-safe.
+            request.pReadTask.reset();
+            WriteRequest readyRequest = std::move(request);
+            mReadbackQueue.pop_front();
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (success)
+            {
+                mRequestQueue.push(std::move(readyRequest));
+                mWorkCondition.notify_one();
+            }
+            else
+            {
+                mStats.imagesFailed++;
+                FALCOR_ASSERT(mPendingCount > 0);
+                mPendingCount--;
+                mDoneCondition.notify_all();
+            }
+        }
+    }
+
+    void AsyncImageWriter::flush()
+    {
+        processReadbacks(true);
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDoneCondition.wait(lock, [&]() { return mPendingCount == 0; });
+    }
+
+    size_t AsyncImageWriter::getPendingCount() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mPendingCount;
+    }
+
+    AsyncImageWriter::Stats AsyncImageWriter::getStats() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mStats;
+    }
+
+    void AsyncImageWriter::enqueue(WriteRequest request)
+    {
+        if (request.fileFormat == Bitmap::FileFormat::DdsFile)
+        {
+            throw ArgumentError("AsyncImageWriter does not support saving to DDS.");
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        // Apply back-pressure if too many images are in flight.
+        if (mPendingCount >= mMaxPendingCount)
+        {
+            mStats.stallCount++;
+
+            // Pending readbacks are only completed on this thread. Finish them so the workers can make progress.
+            lock.unlock();
+            processReadbacks(true);
+            lock.lock();
+
+            mDoneCondition.wait(lock, [&]() { return mPendingCount < mMaxPendingCount; });
+        }
+
+        if (request.pReadTask)
+        {
+            mReadbackQueue.push_back(std::move(request));
+        }
+        else
+        {
+            mRequestQueue.push(std::move(request));
+            mWorkCondition.notify_one();
+        }
+        mPendingCount++;
+    }
+
+    void AsyncImageWriter::runWorker()
+    {
+        // This function is the entry point for worker threads.
+        // The workers wait on the request queue and write an image when woken up.
+
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWorkCondition.wait(lock, [&]() { return mTerminate || !mRequestQueue.empty(); });
+
+            // Terminate thread unless there is more work to do.
+            if (mRequestQueue.empty())
+            {
+                FALCOR_ASSERT(mTerminate);
+                break;
+            }
+
+            WriteRequest request = std::move(mRequestQueue.front());
+            mRequestQueue.pop();
+
+            lock.unlock();
+
+            // Convert and encode the image (this part is running in parallel).
+            bool success = false;
+            size_t byteSize = 0;
+            try
+            {
+                byteSize = (size_t)request.width * request.height * getFormatBytesPerBlock(request.format);
+                processRequest(request);
+                success = true;
+            }
+            catch (const std::exception& e)
+            {
+                logError("AsyncImageWriter failed to write '{}': {}", request.path, e.what());
+            }
+
+            // Release image memory before signaling completion.
+            request.pBitmap.reset();
+            request.textureData = {};
+
+            lock.lock();
+
+            if (success)
+            {
+                mStats.imagesWritten++;
+                mStats.bytesWritten += byteSize;
+            }
+            else
+            {
+                mStats.imagesFailed++;
+            }
+
+            FALCOR_ASSERT(mPendingCount > 0);
+            mPendingCount--;
+            mDoneCondition.notify_all();
+        }
+    }
+
+    void AsyncImageWriter::processRequest(WriteRequest& request)
+    {
+        void* pData = nullptr;
+
+        if (request.pBitmap)
+        {
+            // Bitmap::saveImage() may swizzle the data in-place. This is fine as we own the bitmap.
+            pData = request.pBitmap->getData();
+        }
+        else
+        {
+            // The GPU readback was completed before the request was queued.
+            pData = request.textureData.data();
+        }
+
+        ResourceFormat format = request.format;
+        std::vector<float> floatData;
+        if (needsExpansion(format))
+        {
+            floatData = expandToRGBA32Float(request.width, request.height, format, pData);
+            pData = floatData.data();
+            format = ResourceFormat::RGBA32Float;
+        }
+
+        // Errors are thrown and counted as failed images instead of being reported on the worker thread.
+        Bitmap::saveImageOrThrow(request.path, request.width, request.height, request.fileFormat, request.exportFlags, format, true, pData);
+    }
+
+    void AsyncImageWriter::terminateWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTerminate = true;
+        }
+
+        mWorkCondition.notify_all();
+
+        for (auto& thread : mThreads) thread.join();
+    }
+}
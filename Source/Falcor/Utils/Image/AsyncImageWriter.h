@@ -0,0 +1,156 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Bitmap.h"
+#include "Core/Macros.h"
+#include "Core/API/CopyContext.h"
+#include "Core/API/Formats.h"
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace Falcor
+{
+    /** Utility class to encode and write images to disk asynchronously using a pool of worker threads.
+
+        Images are either provided as in-memory bitmaps, or as pending GPU readbacks created with
+        CopyContext::asyncReadTextureSubresource(). Readbacks are completed on the calling thread,
+        as GPU resources must not be released on the worker threads. Call processReadbacks()
+        regularly (e.g. once per frame) to hand finished readbacks to the workers without blocking.
+        All functions queueing or completing readbacks must be called from the same thread.
+
+        The number of pending images is bounded. If the queue is full, write() blocks until a worker
+        has finished writing an image (back-pressure), which bounds the amount of host memory in flight.
+
+        Float images (16 or 32 bits per channel) with one channel are written as grayscale, and with two channels
+        as red/green. Images that fail to encode or write are logged and counted in Stats::imagesFailed.
+    */
+    class FALCOR_API AsyncImageWriter
+    {
+    public:
+        static constexpr size_t kDefaultThreadCount = 4;
+        static constexpr size_t kDefaultMaxPendingCount = 16;
+
+        struct Stats
+        {
+            uint64_t imagesWritten = 0;     ///< Number of images written successfully.
+            uint64_t imagesFailed = 0;      ///< Number of images that failed to write.
+            uint64_t bytesWritten = 0;      ///< Number of bytes of (unencoded) image data written.
+            uint64_t stallCount = 0;        ///< Number of times write() blocked because the queue was full.
+        };
+
+        /** Constructor.
+            \param[in] threadCount Number of worker threads.
+            \param[in] maxPendingCount Maximum number of images queued or being written before write() blocks.
+        */
+        AsyncImageWriter(size_t threadCount = kDefaultThreadCount, size_t maxPendingCount = kDefaultMaxPendingCount);
+
+        /** Destructor.
+            Blocks until all pending images are written and all threads have terminated.
+        */
+        ~AsyncImageWriter();
+
+        AsyncImageWriter(const AsyncImageWriter&) = delete;
+        AsyncImageWriter& operator=(const AsyncImageWriter&) = delete;
+
+        /** Queue an in-memory bitmap for writing.
+            Blocks if the maximum number of pending images is reached.
+            \param[in] path File path to write to.
+            \param[in] pBitmap Bitmap to write. The writer takes ownership of the bitmap.
+            \param[in] fileFormat Destination file format.
+            \param[in] exportFlags Export flags.
+        */
+        void write(const std::filesystem::path& path, Bitmap::UniqueConstPtr pBitmap, Bitmap::FileFormat fileFormat, Bitmap::ExportFlags exportFlags = Bitmap::ExportFlags::None);
+
+        /** Queue a pending texture readback for writing.
+            Blocks if the maximum number of pending images is reached.
+            \param[in] path File path to write to.
+            \param[in] pReadTask Readback task created with CopyContext::asyncReadTextureSubresource().
+            \param[in] width Width of the texture subresource in pixels.
+            \param[in] height Height of the texture subresource in pixels.
+            \param[in] format Resource format of the texture.
+            \param[in] fileFormat Destination file format.
+            \param[in] exportFlags Export flags.
+        */
+        void write(const std::filesystem::path& path, CopyContext::ReadTextureTask::SharedPtr pReadTask, uint32_t width, uint32_t height, ResourceFormat format, Bitmap::FileFormat fileFormat, Bitmap::ExportFlags exportFlags = Bitmap::ExportFlags::None);
+
+        /** Hand the finished GPU readbacks to the worker threads.
+            \param[in] wait If true, wait for all readbacks to finish. Otherwise only finished readbacks are processed.
+        */
+        void processReadbacks(bool wait = false);
+
+        /** Block until all queued images have been written.
+        */
+        void flush();
+
+        /** Get the number of images that are queued or currently being written.
+        */
+        size_t getPendingCount() const;
+
+        /** Get the writer statistics.
+        */
+        Stats getStats() const;
+
+    private:
+        struct WriteRequest
+        {
+            std::filesystem::path path;
+            uint32_t width = 0;
+            uint32_t height = 0;
+            ResourceFormat format = ResourceFormat::Unknown;
+            Bitmap::FileFormat fileFormat = Bitmap::FileFormat::PngFile;
+            Bitmap::ExportFlags exportFlags = Bitmap::ExportFlags::None;
+            Bitmap::UniqueConstPtr pBitmap;                     ///< Image data if writing a bitmap.
+            CopyContext::ReadTextureTask::SharedPtr pReadTask;  ///< Readback task if writing a texture. Only accessed on the calling thread.
+            std::vector<uint8_t> textureData;                   ///< Image data if writing a texture, available once the readback finished.
+        };
+
+        void enqueue(WriteRequest request);
+        void runWorker();
+        void processRequest(WriteRequest& request);
+        void terminateWorkers();
+
+        size_t mMaxPendingCount;
+
+        mutable std::mutex mMutex;                  ///< Mutex for synchronizing access to shared resources.
+        std::condition_variable mWorkCondition;     ///< Condition variable for workers to wait on new requests.
+        std::condition_variable mDoneCondition;     ///< Condition variable for producers to wait on finished requests.
+        std::vector<std::thread> mThreads;          ///< Worker threads.
+        std::deque<WriteRequest> mReadbackQueue;    ///< Requests waiting for their GPU readback, in submission order. Only accessed on the calling thread.
+
+        // Internal state. Do not access outside of critical section.
+        std::queue<WriteRequest> mRequestQueue;     ///< Write request queue.
+        size_t mPendingCount = 0;                   ///< Number of requests queued or in progress.
+        bool mTerminate = false;                    ///< Flag to terminate worker threads.
+        Stats mStats;
+    };
+}
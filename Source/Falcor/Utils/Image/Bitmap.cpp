@@ -460,23 +460,32 @@ namespace Falcor
     }
 
     void Bitmap::saveImage(const std::filesystem::path& path, uint32_t width, uint32_t height, FileFormat fileFormat, ExportFlags exportFlags, ResourceFormat resourceFormat, bool isTopDown, void* pData)
+    {
+        try
+        {
+            saveImageOrThrow(path, width, height, fileFormat, exportFlags, resourceFormat, isTopDown, pData);
+        }
+        catch (const RuntimeError& e)
+        {
+            reportError(e.what());
+        }
+    }
+
+    void Bitmap::saveImageOrThrow(const std::filesystem::path& path, uint32_t width, uint32_t height, FileFormat fileFormat, ExportFlags exportFlags, ResourceFormat resourceFormat, bool isTopDown, void* pData)
     {
         if (pData == nullptr)
         {
-            reportError("Bitmap::saveImage provided no data to save.");
-            return;
+            throw RuntimeError("Bitmap::saveImage provided no data to save.");
         }
 
         if (is_set(exportFlags, ExportFlags::Uncompressed) && is_set(exportFlags, ExportFlags::Lossy))
         {
-            reportError("Bitmap::saveImage incompatible flags: lossy cannot be combined with uncompressed.");
-            return;
+            throw RuntimeError("Bitmap::saveImage incompatible flags: lossy cannot be combined with uncompressed.");
         }
 
         if (fileFormat == FileFormat::DdsFile)
         {
-            reportError("Bitmap::saveImage cannot save DDS files. Use ImageIO instead.");
-            return;
+            throw RuntimeError("Bitmap::saveImage cannot save DDS files. Use ImageIO instead.");
         }
 
         int flags = 0;
@@ -512,8 +521,7 @@ namespace Falcor
             }
             else if (bytesPerPixel != 16 && bytesPerPixel != 12)
             {
-                reportError("Bitmap::saveImage supports only 32-bit/channel RGB/RGBA or 16-bit RGBA images as PFM/EXR files.");
-                return;
+                throw RuntimeError("Bitmap::saveImage supports only 32-bit/channel RGB/RGBA or 16-bit RGBA images as PFM/EXR files.");
             }
 
             const bool exportAlpha = is_set(exportFlags, ExportFlags::ExportAlpha);
@@ -522,20 +530,17 @@ namespace Falcor
             {
                 if (is_set(exportFlags, ExportFlags::Lossy))
                 {
-                    reportError("Bitmap::saveImage: PFM does not support lossy compression mode.");
-                    return;
+                    throw RuntimeError("Bitmap::saveImage: PFM does not support lossy compression mode.");
                 }
                 if (exportAlpha)
                 {
-                    reportError("Bitmap::saveImage: PFM does not support alpha channel.");
-                    return;
+                    throw RuntimeError("Bitmap::saveImage: PFM does not support alpha channel.");
                 }
             }
 
             if (exportAlpha && bytesPerPixel != 16)
             {
-                reportError("Bitmap::saveImage requesting to export alpha-channel to EXR file, but the resource doesn't have an alpha-channel");
-                return;
+                throw RuntimeError("Bitmap::saveImage requesting to export alpha-channel to EXR file, but the resource doesn't have an alpha-channel");
             }
 
             // Upload the image manually and flip it vertically
@@ -641,10 +646,8 @@ namespace Falcor
             }
         }
 
-        if (!FreeImage_Save(toFreeImageFormat(fileFormat), pImage, path.string().c_str(), flags))
-        {
-            reportError("Bitmap::saveImage: FreeImage failed to save image");
-        }
+        bool saved = FreeImage_Save(toFreeImageFormat(fileFormat), pImage, path.string().c_str(), flags);
         FreeImage_Unload(pImage);
+        if (!saved) throw RuntimeError("Bitmap::saveImage: FreeImage failed to save image '{}'.", path);
     }
 }
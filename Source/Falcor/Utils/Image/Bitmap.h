@@ -92,6 +92,11 @@ namespace Falcor
         */
         static void saveImage(const std::filesystem::path& path, uint32_t width, uint32_t height, FileFormat fileFormat, ExportFlags exportFlags, ResourceFormat resourceFormat, bool isTopDown, void* pData);
 
+        /** Store a memory buffer to a file. Same as saveImage() but throws a RuntimeError instead of reporting errors.
+            This is meant for code that handles errors itself, e.g., on worker threads.
+        */
+        static void saveImageOrThrow(const std::filesystem::path& path, uint32_t width, uint32_t height, FileFormat fileFormat, ExportFlags exportFlags, ResourceFormat resourceFormat, bool isTopDown, void* pData);
+
         /**  Open dialog to save image to a file
             \param[in] pTexture Texture to save to file
         */
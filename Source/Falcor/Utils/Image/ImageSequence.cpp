@@ -0,0 +1,254 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "ImageSequence.h"
+#include "Core/Assert.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <charconv>
+
+namespace Falcor
+{
+    namespace
+    {
+        const bool kTopDown = true; // Memory layout when loading from file
+    }
+
+    bool ImageSequence::isPattern(const std::filesystem::path& path)
+    {
+        return path.filename().string().find('#') != std::string::npos;
+    }
+
+    std::vector<std::filesystem::path> ImageSequence::findFrames(const std::filesystem::path& pattern)
+    {
+        // Split the filename into the parts before and after the frame number.
+        const std::string filename = pattern.filename().string();
+        const size_t first = filename.find('#');
+        if (first == std::string::npos) return {};
+        const size_t last = std::min(filename.find_first_not_of('#', first), filename.size());
+        const size_t width = last - first;
+        const std::string prefix = filename.substr(0, first);
+        const std::string suffix = filename.substr(last);
+
+        const std::filesystem::path directory = pattern.parent_path();
+        if (!std::filesystem::is_directory(directory)) return {};
+
+        std::vector<std::pair<uint64_t, std::filesystem::path>> frames;
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+        {
+            if (!entry.is_regular_file()) continue;
+
+            const std::string name = entry.path().filename().string();
+            if (name.size() < prefix.size() + width + suffix.size()) continue;
+            if (name.compare(0, prefix.size(), prefix) != 0) continue;
+            if (name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) continue;
+
+            // Frame numbers may be wider than the padding, but not padded to a larger width.
+            const std::string digits = name.substr(prefix.size(), name.size() - prefix.size() - suffix.size());
+            if (digits.size() > width && digits[0] == '0') continue;
+
+            // Skip names that are not entirely a frame number, or whose number is out of range.
+            uint64_t number = 0;
+            const char* pEnd = digits.data() + digits.size();
+            auto [ptr, ec] = std::from_chars(digits.data(), pEnd, number);
+            if (ec != std::errc() || ptr != pEnd) continue;
+
+            frames.emplace_back(number, entry.path());
+        }
+        std::sort(frames.begin(), frames.end());
+
+        std::vector<std::filesystem::path> paths;
+        paths.reserve(frames.size());
+        for (auto& [number, path] : frames) paths.push_back(std::move(path));
+        return paths;
+    }
+
+    ImageSequence::ImageSequence(std::vector<std::filesystem::path> framePaths, uint32_t prefetchCount, size_t cacheSize, uint32_t threadCount)
+        : mFramePaths(std::move(framePaths))
+        , mPrefetchCount(std::max(prefetchCount, 1u))
+        , mCacheSize(cacheSize)
+    {
+        FALCOR_ASSERT(!mFramePaths.empty());
+        threadCount = std::max(threadCount, 1u);
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            mThreads.emplace_back(&ImageSequence::runWorker, this);
+        }
+    }
+
+    ImageSequence::~ImageSequence()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTerminate = true;
+        }
+        mWorkCondition.notify_all();
+        for (auto& thread : mThreads) thread.join();
+    }
+
+    ImageSequence::Frame ImageSequence::getFrame(uint32_t frame, bool wait, FrameState* pState)
+    {
+        FALCOR_ASSERT(frame < getFrameCount());
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCurrentFrame = frame;
+        updateRequests();
+
+        auto isDone = [&]()
+        {
+            auto it = mEntries.find(frame);
+            return it == mEntries.end() || it->second.state == State::Ready || it->second.state == State::Failed;
+        };
+        if (wait) mDoneCondition.wait(lock, isDone);
+
+        auto it = mEntries.find(frame);
+        FrameState state = FrameState::Pending;
+        if (it != mEntries.end() && it->second.state == State::Ready) state = FrameState::Ready;
+        if (it != mEntries.end() && it->second.state == State::Failed) state = FrameState::Failed;
+        if (pState) *pState = state;
+        return state == FrameState::Ready ? it->second.pFrame : nullptr;
+    }
+
+    bool ImageSequence::isFrameCached(uint32_t frame) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mEntries.find(frame);
+        return it != mEntries.end() && it->second.state == State::Ready;
+    }
+
+    void ImageSequence::setCacheLimits(uint32_t prefetchCount, size_t cacheSize)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPrefetchCount = std::max(prefetchCount, 1u);
+        mCacheSize = cacheSize;
+        updateRequests();
+        evict();
+    }
+
+    size_t ImageSequence::getCachedBytes() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mCachedBytes;
+    }
+
+    void ImageSequence::runWorker()
+    {
+        while (true)
+        {
+            uint32_t frame;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mWorkCondition.wait(lock, [&]() { return mTerminate || !mQueue.empty(); });
+                if (mTerminate) break;
+
+                frame = mQueue.front();
+                mQueue.pop_front();
+                mEntries[frame].state = State::Loading;
+            }
+
+            Frame pFrame = Bitmap::createFromFile(mFramePaths[frame], kTopDown);
+            if (!pFrame) logWarning("ImageSequence: Failed to load frame '{}'.", mFramePaths[frame]);
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                Entry& entry = mEntries[frame];
+                entry.state = pFrame ? State::Ready : State::Failed;
+                entry.pFrame = pFrame;
+                if (pFrame)
+                {
+                    mCachedBytes += pFrame->getSize();
+                    mFrameSize = pFrame->getSize();
+                }
+                evict();
+            }
+            mDoneCondition.notify_all();
+        }
+    }
+
+    uint32_t ImageSequence::getWindowSize() const
+    {
+        // Don't prefetch more frames than fit in the cache.
+        uint32_t windowSize = std::min(mPrefetchCount, getFrameCount());
+        if (mFrameSize > 0) windowSize = (uint32_t)std::min<size_t>(windowSize, mCacheSize / mFrameSize);
+        return std::max(windowSize, 1u);
+    }
+
+    uint32_t ImageSequence::getForwardDistance(uint32_t frame, uint32_t from) const
+    {
+        // Sequences are played in a loop.
+        return (frame + getFrameCount() - from) % getFrameCount();
+    }
+
+    void ImageSequence::updateRequests()
+    {
+        const uint32_t windowSize = getWindowSize();
+
+        // Drop queued frames that are no longer in the prefetch window, for example after seeking.
+        mQueue.clear();
+        for (auto it = mEntries.begin(); it != mEntries.end();)
+        {
+            if (it->second.state == State::Queued && getForwardDistance(it->first, mCurrentFrame) >= windowSize) it = mEntries.erase(it);
+            else ++it;
+        }
+
+        // Queue the frames in the window that are not loaded yet, closest first.
+        for (uint32_t i = 0; i < windowSize; ++i)
+        {
+            uint32_t frame = (mCurrentFrame + i) % getFrameCount();
+            auto [it, inserted] = mEntries.try_emplace(frame);
+            if (it->second.state == State::Queued) mQueue.push_back(frame);
+        }
+
+        if (!mQueue.empty()) mWorkCondition.notify_all();
+    }
+
+    void ImageSequence::evict()
+    {
+        const uint32_t windowSize = getWindowSize();
+
+        while (mCachedBytes > mCacheSize)
+        {
+            // Evict the cached frame outside the prefetch window that is needed furthest in the future.
+            auto victim = mEntries.end();
+            uint32_t victimDistance = 0;
+            for (auto it = mEntries.begin(); it != mEntries.end(); ++it)
+            {
+                if (it->second.state != State::Ready) continue;
+                uint32_t distance = getForwardDistance(it->first, mCurrentFrame);
+                if (distance >= windowSize && distance >= victimDistance)
+                {
+                    victim = it;
+                    victimDistance = distance;
+                }
+            }
+            if (victim == mEntries.end()) break;
+
+            mCachedBytes -= victim->second.pFrame->getSize();
+            mEntries.erase(victim);
+        }
+    }
+}
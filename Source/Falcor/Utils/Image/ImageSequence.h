@@ -0,0 +1,149 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Bitmap.h"
+#include "Core/Macros.h"
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Falcor
+{
+    /** Streams the frames of an image sequence from disk.
+        Frames are decoded by background threads into a host memory cache of bounded size. The frames following
+        the requested frame are prefetched, so that playing the sequence at frame rate does not wait on file I/O.
+        When the cache is full, the cached frame that is needed furthest in the future (assuming looped playback) is evicted first.
+    */
+    class FALCOR_API ImageSequence
+    {
+    public:
+        using Frame = std::shared_ptr<const Bitmap>;
+
+        /** State of a requested frame.
+        */
+        enum class FrameState
+        {
+            Pending,    ///< The frame is queued or being decoded.
+            Ready,      ///< The frame is decoded.
+            Failed,     ///< The frame failed to load. Failed frames are not retried.
+        };
+
+        /** Check if a path is a sequence pattern.
+            In a sequence pattern, a run of '#' characters in the filename stands for the zero-padded frame number, e.g. 'frame_####.exr'.
+        */
+        static bool isPattern(const std::filesystem::path& path);
+
+        /** Find the files of an image sequence.
+            Files whose frame number is not a valid 64-bit number are ignored.
+            \param[in] pattern Sequence pattern. The directory must be a full path.
+            \return Paths of the frames, sorted by frame number.
+        */
+        static std::vector<std::filesystem::path> findFrames(const std::filesystem::path& pattern);
+
+        /** Constructor.
+            \param[in] framePaths Paths of the frames in playback order.
+            \param[in] prefetchCount Number of frames to decode ahead of the requested frame, including the requested frame.
+            \param[in] cacheSize Maximum size in bytes of the decoded frames kept in host memory.
+            \param[in] threadCount Number of decoding threads.
+        */
+        ImageSequence(std::vector<std::filesystem::path> framePaths, uint32_t prefetchCount, size_t cacheSize, uint32_t threadCount);
+
+        /** Destructor.
+            Blocks until the decoding threads have terminated.
+        */
+        ~ImageSequence();
+
+        uint32_t getFrameCount() const { return (uint32_t)mFramePaths.size(); }
+        const std::filesystem::path& getFramePath(uint32_t frame) const { return mFramePaths[frame]; }
+
+        /** Get a decoded frame and prefetch the frames following it.
+            \param[in] frame Frame index.
+            \param[in] wait If true, block until the frame is decoded or has failed to load.
+            \param[out] pState If not nullptr, receives the state of the frame.
+            \return The decoded frame, or nullptr if it is not ready or failed to load.
+        */
+        Frame getFrame(uint32_t frame, bool wait, FrameState* pState = nullptr);
+
+        /** Check if a frame is decoded and held in the cache.
+        */
+        bool isFrameCached(uint32_t frame) const;
+
+        /** Change the prefetch window and the cache size.
+            \param[in] prefetchCount Number of frames to decode ahead of the requested frame, including the requested frame.
+            \param[in] cacheSize Maximum size in bytes of the decoded frames kept in host memory.
+        */
+        void setCacheLimits(uint32_t prefetchCount, size_t cacheSize);
+
+        /** Get the number of bytes of decoded frames currently held in the cache.
+        */
+        size_t getCachedBytes() const;
+
+    private:
+        enum class State
+        {
+            Queued,
+            Loading,
+            Ready,
+            Failed,
+        };
+
+        struct Entry
+        {
+            State state = State::Queued;
+            Frame pFrame;
+        };
+
+        void runWorker();
+        uint32_t getWindowSize() const;
+        uint32_t getForwardDistance(uint32_t frame, uint32_t from) const;
+        void updateRequests();
+        void evict();
+
+        std::vector<std::filesystem::path> mFramePaths;
+        uint32_t mPrefetchCount;
+        size_t mCacheSize;
+
+        std::vector<std::thread> mThreads;              ///< Decoding threads.
+
+        // Internal state. Do not access outside of critical section.
+        mutable std::mutex mMutex;
+        std::condition_variable mWorkCondition;         ///< Signaled when frames are queued for decoding.
+        std::condition_variable mDoneCondition;         ///< Signaled when a frame has finished decoding.
+        std::unordered_map<uint32_t, Entry> mEntries;   ///< Frames that are queued, loading, cached or failed.
+        std::deque<uint32_t> mQueue;                    ///< Frames to decode, in order of priority.
+        uint32_t mCurrentFrame = 0;                     ///< Most recently requested frame.
+        size_t mCachedBytes = 0;                        ///< Size of the decoded frames in the cache.
+        size_t mFrameSize = 0;                          ///< Size of the most recently decoded frame, used to limit prefetching to the cache size.
+        bool mTerminate = false;
+    };
+}
@@ -28,18 +28,34 @@
 #include "Logger.h"
 #include "Core/Assert.h"
 #include "Core/Platform/OS.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace Falcor
 {
     namespace
     {
-        Logger::Level sVerbosity = Logger::Level::Info;
-        Logger::OutputFlags sOutputs = Logger::OutputFlags::Console | Logger::OutputFlags::File | Logger::OutputFlags::DebugWindow;
+        std::atomic<Logger::Level> sVerbosity{ Logger::Level::Info };
+        std::atomic<Logger::OutputFlags> sOutputs{ Logger::OutputFlags::Console | Logger::OutputFlags::File | Logger::OutputFlags::DebugWindow };
+
+        // Guards the log file state below. The file is written by the writer thread, or by the logging thread
+        // when messages are drained synchronously, while the path may be changed from any thread.
+        std::mutex sLogFileMutex;
         std::filesystem::path sLogFilePath;
 
+        // Number of messages logged per call site and time window before rate limiting kicks in.
+        const uint32_t kRateLimitCount = 10;
+        const std::chrono::seconds kRateLimitWindow{ 10 };
+
 #if FALCOR_ENABLE_LOGGER
         bool sInitialized = false;
+        bool sLogFileCreated = false;   ///< True once the log file has been created. Reopening it appends instead of truncating.
         FILE* sLogFile = nullptr;
 
         std::filesystem::path generateLogFilePath()
@@ -49,6 +65,8 @@ namespace Falcor
             return findAvailableFilename(prefix, directory, "log");
         }
 
+        /** Open the log file. Expects sLogFileMutex to be held.
+        */
         FILE* openLogFile()
         {
             FILE* pFile = nullptr;
@@ -58,10 +76,12 @@ namespace Falcor
                 sLogFilePath = generateLogFilePath();
             }
 
-            pFile = std::fopen(sLogFilePath.string().c_str(), "w");
+            // Messages logged after shutdown() reopen the file, don't discard what was written before.
+            pFile = std::fopen(sLogFilePath.string().c_str(), sLogFileCreated ? "a" : "w");
             if (pFile != nullptr)
             {
                 // Success
+                sLogFileCreated = true;
                 return pFile;
             }
 
@@ -72,6 +92,7 @@ namespace Falcor
 
         void printToLogFile(const std::string& s)
         {
+            std::lock_guard<std::mutex> lock(sLogFileMutex);
             if (!sInitialized)
             {
                 sLogFile = openLogFile();
@@ -80,16 +101,195 @@ namespace Falcor
 
             if (sLogFile)
             {
-                std::fprintf(sLogFile, "%s", s.c_str());
+                std::fwrite(s.data(), 1, s.size(), sLogFile);
                 std::fflush(sLogFile);
             }
         }
+
+        struct Message
+        {
+            Message* pNext = nullptr;
+            Logger::Level level;
+            Logger::OutputFlags outputs;
+            std::string text;
+        };
+
+        /** Writes log messages to the outputs on a background thread.
+            Producers push messages onto a lock-free stack. The writer takes the whole stack at once,
+            restores the submission order and writes the batch with one write per output.
+        */
+        class AsyncWriter
+        {
+        public:
+            AsyncWriter()
+            {
+                mThread = std::thread([this]() { run(); });
+            }
+
+            ~AsyncWriter()
+            {
+                stop();
+            }
+
+            void push(Message* pMessage)
+            {
+                // The message may be written and deleted by the writer as soon as it is published,
+                // so only the local copy of the previous head is accessed afterwards.
+                Message* pHead = mpHead.load(std::memory_order_relaxed);
+                do
+                {
+                    pMessage->pNext = pHead;
+                } while (!mpHead.compare_exchange_weak(pHead, pMessage));
+
+                if (mStopped.load())
+                {
+                    // No writer thread after shutdown, write synchronously.
+                    drain();
+                }
+                else if (pHead == nullptr)
+                {
+                    // Only wake the writer when the queue was empty, it picks up all queued messages at once.
+                    std::lock_guard<std::mutex> lock(mWakeMutex);
+                    mWakeCondition.notify_one();
+                }
+            }
+
+            /** Write all queued messages on the calling thread.
+            */
+            void drain()
+            {
+                std::lock_guard<std::mutex> lock(mWriteMutex);
+                writeBatch(mpHead.exchange(nullptr));
+            }
+
+            /** Stop the writer thread and write all remaining messages.
+            */
+            void stop()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mWakeMutex);
+                    if (mStopped.exchange(true)) return;
+                    mWakeCondition.notify_one();
+                }
+                if (mThread.joinable()) mThread.join();
+                drain();
+            }
+
+        private:
+            void run()
+            {
+                while (true)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(mWakeMutex);
+                        mWakeCondition.wait(lock, [this]() { return mStopped.load() || mpHead.load() != nullptr; });
+                        if (mStopped.load()) break;
+                    }
+                    drain();
+                }
+            }
+
+            void writeBatch(Message* pList)
+            {
+                if (!pList) return;
+
+                // Reverse the stack to restore the submission order.
+                Message* pFirst = nullptr;
+                while (pList)
+                {
+                    Message* pNext = pList->pNext;
+                    pList->pNext = pFirst;
+                    pFirst = pList;
+                    pList = pNext;
+                }
+
+                std::string fileText;
+                std::string consoleText;
+                bool consoleIsError = false;
+                auto flushConsole = [&]()
+                {
+                    if (consoleText.empty()) return;
+                    auto& os = consoleIsError ? std::cerr : std::cout;
+                    os << consoleText;
+                    os.flush();
+                    consoleText.clear();
+                };
+
+                for (Message* pMessage = pFirst; pMessage;)
+                {
+                    const std::string& s = pMessage->text;
+
+                    // Write to console. Consecutive messages to the same stream are written at once.
+                    if (is_set(pMessage->outputs, Logger::OutputFlags::Console))
+                    {
+                        bool isError = pMessage->level <= Logger::Level::Error;
+                        if (isError != consoleIsError) flushConsole();
+                        consoleIsError = isError;
+                        consoleText += s;
+                    }
+
+                    // Write to file.
+                    if (is_set(pMessage->outputs, Logger::OutputFlags::File))
+                    {
+                        fileText += s;
+                    }
+
+                    // Write to debug window if debugger is attached.
+                    if (is_set(pMessage->outputs, Logger::OutputFlags::DebugWindow) && isDebuggerPresent())
+                    {
+                        printToDebugWindow(s);
+                    }
+
+                    Message* pNext = pMessage->pNext;
+                    delete pMessage;
+                    pMessage = pNext;
+                }
+
+                flushConsole();
+                if (!fileText.empty()) printToLogFile(fileText);
+            }
+
+            std::atomic<Message*> mpHead{ nullptr };
+            std::atomic<bool> mStopped{ false };
+            std::mutex mWakeMutex;
+            std::condition_variable mWakeCondition;
+            std::mutex mWriteMutex;         ///< Serializes writing to the outputs.
+            std::thread mThread;
+        };
+
+        AsyncWriter& getWriter()
+        {
+            static AsyncWriter writer;
+            return writer;
+        }
+
+        /** Per call site state for rate limiting.
+        */
+        struct RateLimit
+        {
+            Logger::Level level;
+            std::string_view format;
+            std::chrono::steady_clock::time_point windowStart;
+            uint32_t count = 0;             ///< Number of messages in the current window.
+            uint32_t suppressedCount = 0;   ///< Number of messages suppressed in the current window.
+        };
+
+        std::mutex sRateLimitMutex;
+        std::unordered_map<const char*, RateLimit> sRateLimits;
+
+        std::string formatSuppressed(const RateLimit& rateLimit)
+        {
+            return fmt::format("{} similar messages suppressed: \"{}\"", rateLimit.suppressedCount, rateLimit.format);
+        }
 #endif
     }
 
     void Logger::shutdown()
     {
 #if FALCOR_ENABLE_LOGGER
+        flush();
+        getWriter().stop();
+        std::lock_guard<std::mutex> lock(sLogFileMutex);
         if(sLogFile)
         {
             fclose(sLogFile);
@@ -119,40 +319,94 @@ namespace Falcor
         }
     }
 
-    void Logger::log(Level level, const std::string_view msg)
+    bool Logger::isEnabled(Level level)
     {
 #if FALCOR_ENABLE_LOGGER
-        if (level <= sVerbosity)
+        return level <= sVerbosity.load(std::memory_order_relaxed);
+#else
+        return false;
+#endif
+    }
+
+    bool Logger::checkRateLimit(Level level, std::string_view format)
+    {
+#if FALCOR_ENABLE_LOGGER
+        if (!isEnabled(level)) return false;
+
+        auto now = std::chrono::steady_clock::now();
+        std::string suppressed;
         {
-            std::string s = fmt::format("{} {}\n", getLogLevelString(level), msg);
+            std::lock_guard<std::mutex> lock(sRateLimitMutex);
+            auto [it, inserted] = sRateLimits.try_emplace(format.data(), RateLimit{ level, format, now });
+            RateLimit& rateLimit = it->second;
 
-            // Write to console.
-            if (is_set(sOutputs, OutputFlags::Console))
+            // Start a new window, reporting the messages suppressed in the previous one.
+            if (now - rateLimit.windowStart >= kRateLimitWindow)
             {
-                auto& os = level > Logger::Level::Error ? std::cout : std::cerr;
-                os << s;
-                os.flush();
+                if (rateLimit.suppressedCount > 0) suppressed = formatSuppressed(rateLimit);
+                rateLimit.windowStart = now;
+                rateLimit.count = 0;
+                rateLimit.suppressedCount = 0;
             }
 
-            // Write to file.
-            if (is_set(sOutputs, OutputFlags::File))
+            if (rateLimit.count >= kRateLimitCount)
             {
-                printToLogFile(s);
+                rateLimit.suppressedCount++;
+                return false;
             }
+            rateLimit.count++;
+        }
+
+        if (!suppressed.empty()) log(level, suppressed);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void Logger::log(Level level, const std::string_view msg)
+    {
+#if FALCOR_ENABLE_LOGGER
+        if (isEnabled(level))
+        {
+            Message* pMessage = new Message();
+            pMessage->level = level;
+            pMessage->outputs = sOutputs.load(std::memory_order_relaxed);
+            pMessage->text = fmt::format("{} {}\n", getLogLevelString(level), msg);
 
-            // Write to debug window if debugger is attached.
-            if (is_set(sOutputs, OutputFlags::DebugWindow) && isDebuggerPresent())
+            auto& writer = getWriter();
+            writer.push(pMessage);
+
+            // Make sure errors are visible before the application reacts to them.
+            if (level <= Level::Error) writer.drain();
+        }
+#endif
+    }
+
+    void Logger::flush()
+    {
+#if FALCOR_ENABLE_LOGGER
+        // Report messages suppressed by rate limiting.
+        std::vector<std::pair<Level, std::string>> suppressed;
+        {
+            std::lock_guard<std::mutex> lock(sRateLimitMutex);
+            for (auto& [callSite, rateLimit] : sRateLimits)
             {
-                printToDebugWindow(s);
+                if (rateLimit.suppressedCount > 0) suppressed.emplace_back(rateLimit.level, formatSuppressed(rateLimit));
             }
+            sRateLimits.clear();
         }
+        for (const auto& [level, msg] : suppressed) log(level, msg);
+
+        getWriter().drain();
 #endif
     }
 
     bool Logger::setLogFilePath(const std::filesystem::path& path)
     {
 #if FALCOR_ENABLE_LOGGER
-        if (sLogFile)
+        std::lock_guard<std::mutex> lock(sLogFileMutex);
+        if (sLogFileCreated)
         {
             return false;
         }
@@ -172,5 +426,9 @@ namespace Falcor
     void Logger::setOutputs(OutputFlags outputs) { sOutputs = outputs; }
     Logger::OutputFlags Logger::getOutputs() { return sOutputs; }
 
-    const std::filesystem::path& Logger::getLogFilePath() { return sLogFilePath; }
+    std::filesystem::path Logger::getLogFilePath()
+    {
+        std::lock_guard<std::mutex> lock(sLogFileMutex);
+        return sLogFilePath;
+    }
 }
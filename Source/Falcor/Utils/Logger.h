@@ -97,20 +97,42 @@ namespace Falcor
         static bool setLogFilePath(const std::filesystem::path& path);
 
         /** Get the path of the logfile.
-            \return Returns the path of the logfile.
+            \return Returns the path of the logfile, or an empty path if it has not been opened or set yet.
         */
-        static const std::filesystem::path& getLogFilePath();
+        static std::filesystem::path getLogFilePath();
 
         /** Check if the logger is enabled.
         */
         static constexpr bool enabled() { return FALCOR_ENABLE_LOGGER != 0; }
 
+        /** Check if messages of a given level pass the verbosity filter.
+            Use this to skip formatting messages that would be discarded.
+            \param[in] level Log level.
+            \return True if messages of this level are logged.
+        */
+        static bool isEnabled(Level level);
+
+        /** Check if a message from a rate-limited call site should be logged.
+            Only the first few messages from each call site within a time window are logged. The rest are counted
+            and reported as a single "N similar messages suppressed" message once the window has passed or on flush().
+            \param[in] level Log level.
+            \param[in] format Format string of the message. Its address identifies the call site.
+            \return True if the message should be logged.
+        */
+        static bool checkRateLimit(Level level, std::string_view format);
+
         /** Log a message.
+            Messages are written to the outputs asynchronously by a background thread.
+            Error and fatal messages are written before this call returns.
             \param[in] level Log level.
             \param[in] msg Log message.
         */
         static void log(Level level, const std::string_view msg);
 
+        /** Report suppressed messages and wait until all pending messages have been written.
+        */
+        static void flush();
+
     private:
         Logger() = delete;
     };
@@ -120,6 +142,7 @@ namespace Falcor
     // We define two types of logging helpers, one taking raw strings,
     // the other taking formatted strings. We don't want string formatting and
     // errors being thrown due to missing arguments when passing raw strings.
+    // The formatted variants check the verbosity before formatting the message.
 
     inline void logDebug(const std::string_view msg)
     {
@@ -129,7 +152,8 @@ namespace Falcor
     template<typename... Args>
     inline void logDebug(fmt::format_string<Args...> format, Args&&... args)
     {
-        Logger::log(Logger::Level::Debug, fmt::format(format, std::forward<Args>(args)...));
+        if (Logger::isEnabled(Logger::Level::Debug))
+            Logger::log(Logger::Level::Debug, fmt::format(format, std::forward<Args>(args)...));
     }
 
     inline void logInfo(const std::string_view msg)
@@ -140,7 +164,8 @@ namespace Falcor
     template<typename... Args>
     inline void logInfo(fmt::format_string<Args...> format, Args&&... args)
     {
-        Logger::log(Logger::Level::Info, fmt::format(format, std::forward<Args>(args)...));
+        if (Logger::isEnabled(Logger::Level::Info))
+            Logger::log(Logger::Level::Info, fmt::format(format, std::forward<Args>(args)...));
     }
 
     inline void logWarning(const std::string_view msg)
@@ -151,7 +176,10 @@ namespace Falcor
     template<typename... Args>
     inline void logWarning(fmt::format_string<Args...> format, Args&&... args)
     {
-        Logger::log(Logger::Level::Warning, fmt::format(format, std::forward<Args>(args)...));
+        // Formatted warnings are rate limited per call site, as they are often emitted for each of many objects.
+        fmt::string_view callSite = format;
+        if (Logger::checkRateLimit(Logger::Level::Warning, std::string_view(callSite.data(), callSite.size())))
+            Logger::log(Logger::Level::Warning, fmt::format(format, std::forward<Args>(args)...));
     }
 
     inline void logError(const std::string_view msg)
@@ -162,7 +190,8 @@ namespace Falcor
     template<typename... Args>
     inline void logError(fmt::format_string<Args...> format, Args&&... args)
     {
-        Logger::log(Logger::Level::Error, fmt::format(format, std::forward<Args>(args)...));
+        if (Logger::isEnabled(Logger::Level::Error))
+            Logger::log(Logger::Level::Error, fmt::format(format, std::forward<Args>(args)...));
     }
 
     inline void logFatal(const std::string_view msg)
@@ -173,6 +202,7 @@ namespace Falcor
     template<typename... Args>
     inline void logFatal(fmt::format_string<Args...> format, Args&&... args)
     {
-        Logger::log(Logger::Level::Fatal, fmt::format(format, std::forward<Args>(args)...));
+        if (Logger::isEnabled(Logger::Level::Fatal))
+            Logger::log(Logger::Level::Fatal, fmt::format(format, std::forward<Args>(args)...));
     }
 }
@@ -30,7 +30,6 @@
 #include "Core/API/Buffer.h"
 #include "Core/Program/ShaderVar.h"
 #include <memory>
-#include <random>
 
 namespace Falcor
 {
@@ -45,10 +44,9 @@ namespace Falcor
             The weights don't need to be normalized to sum up to 1.
             \param[in] pDevice GPU device.
             \param[in] weights The weights we'd like to sample each entry proportional to.
-            \param[in] rng The random number generator to use when creating the table.
             \returns The alias table.
         */
-        static SharedPtr create(Device* pDevice, std::vector<float> weights, std::mt19937& rng);
+        static SharedPtr create(Device* pDevice, std::vector<float> weights);
 
         /** Bind the alias table data to a given shader var.
             \param[in] var The shader variable to set the data into.
@@ -64,7 +62,7 @@ namespace Falcor
         double getWeightSum() const { return mWeightSum; }
 
     private:
-        AliasTable(Device* pDevice, std::vector<float> weights, std::mt19937& rng);
+        AliasTable(Device* pDevice, std::vector<float> weights);
 
         // Item structure for the mpItems buffer.
         struct Item
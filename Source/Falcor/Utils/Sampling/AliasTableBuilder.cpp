@@ -0,0 +1,270 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "AliasTableBuilder.h"
+#include "Core/Errors.h"
+#include "Utils/NumericRange.h"
+#include "Utils/Math/Common.h"
+#include <algorithm>
+#include <execution>
+#include <limits>
+#include <numeric>
+
+namespace Falcor
+{
+    namespace
+    {
+        // Block size for the parallel reductions and scans.
+        // The block size is fixed so that the floating-point summation order does not depend on the number of threads.
+        const size_t kBlockSize = size_t(1) << 16;
+
+        /** Run a function for each block of items in parallel.
+            The function is called as func(blockIndex, begin, end).
+        */
+        template<typename Func>
+        void forEachBlock(size_t count, size_t blockSize, Func func)
+        {
+            auto range = NumericRange<size_t>(0, div_round_up(count, blockSize));
+            std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t block)
+            {
+                size_t begin = block * blockSize;
+                func(block, begin, std::min(begin + blockSize, count));
+            });
+        }
+
+        /** Split point in the sweep.
+            All light items before lightIndex and heavy items before heavyIndex own buckets before the split point.
+            Heavy item heavyIndex has donated spill weight to buckets before the split point.
+        */
+        struct Split
+        {
+            size_t lightIndex = 0;
+            size_t heavyIndex = 0;
+            double spill = 0.0;
+        };
+    }
+
+    // The sequential sweeping construction (Vose 1991, and the sweeping variant in Hübschle-Schneider and Sanders 2019,
+    // "Parallel Weighted Random Sampling") walks the light items in order and fills each light item's bucket from the
+    // current heavy item. Once a heavy item's residual weight drops below the average, it fills its own bucket from the next
+    // heavy item. With weights normalized to an average of 1, the state of the sweep after k buckets is given by the number
+    // of light items i and heavy items j = k - i whose buckets have been filled, and the weight the next heavy item has
+    // donated. These satisfy lightPrefix[i] + heavyPrefix[j] <= k < lightPrefix[i] + heavyPrefix[j + 1], so the split points
+    // of the sweep can be found independently with a binary search, and the parts between split points swept in parallel.
+    AliasTableData buildAliasTable(fstd::span<const float> weights, size_t itemsPerTask)
+    {
+        // Use < since the indices are stored as uint32_t.
+        if (weights.size() >= std::numeric_limits<uint32_t>::max()) throw RuntimeError("Too many entries for alias table.");
+        checkArgument(itemsPerTask > 0, "'itemsPerTask' must be positive");
+
+        const size_t n = weights.size();
+        AliasTableData table;
+        table.thresholds.resize(n);
+        table.aliases.resize(n);
+        if (n == 0) return table;
+
+        // Sum element weights, use double to minimize precision issues.
+        const size_t blockCount = div_round_up(n, kBlockSize);
+        std::vector<double> blockWeightSums(blockCount);
+        forEachBlock(n, kBlockSize, [&](size_t block, size_t begin, size_t end)
+        {
+            double sum = 0.0;
+            for (size_t i = begin; i < end; ++i) sum += weights[i];
+            blockWeightSums[block] = sum;
+        });
+        table.weightSum = std::accumulate(blockWeightSums.begin(), blockWeightSums.end(), 0.0);
+
+        // Sample uniformly if all weights are zero.
+        if (!(table.weightSum > 0.0))
+        {
+            std::fill(table.thresholds.begin(), table.thresholds.end(), 1.f);
+            std::iota(table.aliases.begin(), table.aliases.end(), 0u);
+            return table;
+        }
+
+        // Normalize the weights to an average of 1.
+        const double scale = double(n) / table.weightSum;
+        auto getWeight = [&](uint32_t index) { return double(weights[index]) * scale; };
+
+        // Count the light items and sum the light and heavy weights per block.
+        struct BlockInfo
+        {
+            size_t lightCount = 0;
+            double lightWeight = 0.0;
+            double heavyWeight = 0.0;
+        };
+        std::vector<BlockInfo> blocks(blockCount);
+        forEachBlock(n, kBlockSize, [&](size_t block, size_t begin, size_t end)
+        {
+            BlockInfo info;
+            for (size_t i = begin; i < end; ++i)
+            {
+                double w = getWeight((uint32_t)i);
+                if (w < 1.0)
+                {
+                    info.lightCount++;
+                    info.lightWeight += w;
+                }
+                else
+                {
+                    info.heavyWeight += w;
+                }
+            }
+            blocks[block] = info;
+        });
+
+        // Exclusive scan over the blocks.
+        std::vector<BlockInfo> blockOffsets(blockCount);
+        BlockInfo total;
+        for (size_t b = 0; b < blockCount; ++b)
+        {
+            blockOffsets[b] = total;
+            total.lightCount += blocks[b].lightCount;
+            total.lightWeight += blocks[b].lightWeight;
+            total.heavyWeight += blocks[b].heavyWeight;
+        }
+
+        // Partition the items into light and heavy lists in index order, and compute the prefix sums of their weights.
+        const size_t lightCount = total.lightCount;
+        const size_t heavyCount = n - lightCount;
+        std::vector<uint32_t> light(lightCount);
+        std::vector<uint32_t> heavy(heavyCount);
+        std::vector<double> lightPrefix(lightCount + 1, 0.0);
+        std::vector<double> heavyPrefix(heavyCount + 1, 0.0);
+        forEachBlock(n, kBlockSize, [&](size_t block, size_t begin, size_t end)
+        {
+            BlockInfo offset = blockOffsets[block];
+            size_t lightIndex = offset.lightCount;
+            size_t heavyIndex = begin - offset.lightCount;
+            double lightSum = offset.lightWeight;
+            double heavySum = offset.heavyWeight;
+            for (size_t i = begin; i < end; ++i)
+            {
+                double w = getWeight((uint32_t)i);
+                if (w < 1.0)
+                {
+                    light[lightIndex++] = (uint32_t)i;
+                    lightPrefix[lightIndex] = (lightSum += w);
+                }
+                else
+                {
+                    heavy[heavyIndex++] = (uint32_t)i;
+                    heavyPrefix[heavyIndex] = (heavySum += w);
+                }
+            }
+        });
+
+        // Find the split points between tasks.
+        const size_t taskCount = div_round_up(n, itemsPerTask);
+        std::vector<Split> splits(taskCount + 1);
+        splits[taskCount] = { lightCount, heavyCount, 0.0 };
+        for (size_t t = 1; t < taskCount; ++t)
+        {
+            const size_t k = t * n / taskCount;
+            const Split& prev = splits[t - 1];
+
+            // Find the smallest light count i such that lightPrefix[i] + heavyPrefix[k - i] <= k.
+            // The left-hand side is non-increasing in i as light items weigh less than heavy items.
+            size_t lo = k > heavyCount ? k - heavyCount : 0;
+            size_t hi = std::min(k, lightCount);
+            while (lo < hi)
+            {
+                size_t mid = lo + (hi - lo) / 2;
+                if (lightPrefix[mid] + heavyPrefix[k - mid] <= double(k)) hi = mid;
+                else lo = mid + 1;
+            }
+
+            // Guard against rounding errors making the split points non-monotonic.
+            Split split;
+            split.lightIndex = std::clamp(lo, prev.lightIndex, k - prev.heavyIndex);
+            split.heavyIndex = k - split.lightIndex;
+            double maxSpill = split.heavyIndex < heavyCount ? getWeight(heavy[split.heavyIndex]) : 0.0;
+            double minSpill = split.heavyIndex == prev.heavyIndex ? prev.spill : 0.0;
+            split.spill = std::clamp(double(k) - lightPrefix[split.lightIndex] - heavyPrefix[split.heavyIndex], minSpill, std::max(minSpill, maxSpill));
+            splits[t] = split;
+        }
+
+        // Sweep the parts between the split points in parallel.
+        auto taskRange = NumericRange<size_t>(0, taskCount);
+        std::for_each(std::execution::par, taskRange.begin(), taskRange.end(), [&](size_t t)
+        {
+            const Split& begin = splits[t];
+            const Split& end = splits[t + 1];
+
+            // Heavy items [begin.heavyIndex, end.heavyIndex) own their buckets in this part.
+            // Heavy item end.heavyIndex donates end.spill to this part without owning its bucket here.
+            auto getAvailableWeight = [&](size_t j)
+            {
+                double w = j == end.heavyIndex ? end.spill : getWeight(heavy[j]);
+                if (j == begin.heavyIndex) w -= begin.spill;
+                return w;
+            };
+
+            size_t j = begin.heavyIndex;
+            double residual = j < heavyCount ? getAvailableWeight(j) : 0.0;
+
+            // Fill the buckets of heavy items whose residual weight has dropped below the average from the next heavy item.
+            auto settle = [&]()
+            {
+                while (j < end.heavyIndex && residual < 1.0 && j + 1 < heavyCount)
+                {
+                    table.thresholds[heavy[j]] = (float)std::max(residual, 0.0);
+                    table.aliases[heavy[j]] = heavy[j + 1];
+                    residual = getAvailableWeight(j + 1) - (1.0 - residual);
+                    j++;
+                }
+            };
+
+            settle();
+            for (size_t i = begin.lightIndex; i < end.lightIndex; ++i)
+            {
+                uint32_t index = light[i];
+                if (j >= heavyCount)
+                {
+                    // Only possible due to rounding errors, treat the remaining items as having average weight.
+                    table.thresholds[index] = 1.f;
+                    table.aliases[index] = index;
+                    continue;
+                }
+                double w = getWeight(index);
+                table.thresholds[index] = (float)w;
+                table.aliases[index] = heavy[j];
+                residual -= 1.0 - w;
+                settle();
+            }
+
+            // The remaining heavy items have (up to rounding errors) exactly the average weight left.
+            for (; j < end.heavyIndex; ++j)
+            {
+                table.thresholds[heavy[j]] = 1.f;
+                table.aliases[heavy[j]] = heavy[j];
+            }
+        });
+
+        return table;
+    }
+}
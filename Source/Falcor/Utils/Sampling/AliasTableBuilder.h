@@ -0,0 +1,59 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include <fstd/span.h> // TODO C++20: Replace with <span>
+#include <cstdint>
+#include <vector>
+
+namespace Falcor
+{
+    /** Alias table for sampling from a discrete probability distribution, built on the CPU.
+        The table has one entry per item. To sample, pick an entry i uniformly, then return item i
+        with probability thresholds[i] and item aliases[i] otherwise.
+    */
+    struct AliasTableData
+    {
+        std::vector<float> thresholds;      ///< Probability of selecting the entry's own item.
+        std::vector<uint32_t> aliases;      ///< Item selected with probability 1 - thresholds[i].
+        double weightSum = 0.0;             ///< Total weight of all items.
+    };
+
+    /** Build an alias table.
+        The table is built with a parallel version of the linear-time sweeping construction: items are split into light
+        (below average weight) and heavy items, and the sweep is partitioned into independent tasks of roughly equal size
+        using prefix sums over the light and heavy weights. A heavy item straddling two tasks donates part of its weight to
+        the first task. The result only depends on the weights and the task size, not on the number of threads.
+        Throws an exception if there are too many weights.
+        \param[in] weights The weights we'd like to sample each item proportional to. Must be non-negative, don't need to be normalized.
+            If all weights are zero, the items are sampled uniformly.
+        \param[in] itemsPerTask Approximate number of items processed by each parallel task.
+        \return The alias table.
+    */
+    FALCOR_API AliasTableData buildAliasTable(fstd::span<const float> weights, size_t itemsPerTask = size_t(1) << 16);
+}
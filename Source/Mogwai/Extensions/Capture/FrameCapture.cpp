@@ -41,6 +41,7 @@ namespace Mogwai
         const std::string kUI = "ui";
         const std::string kOutputs = "outputs";
         const std::string kCapture = "capture";
+        const std::string kFlush = "flush";
 
         template<typename T>
         std::vector<typename T::value_type::first_type> getFirstOfPair(const T& pair)
@@ -63,6 +64,7 @@ namespace Mogwai
         : CaptureTrigger(pRenderer, "Frame Capture")
     {
         mpImageProcessing = std::make_unique<ImageProcessing>(pRenderer->getDevice());
+        mpImageWriter = std::make_unique<AsyncImageWriter>();
     }
 
     void FrameCapture::renderUI(Gui* pGui)
@@ -77,6 +79,9 @@ namespace Mogwai
             w.tooltip("Capture all available outputs instead of the marked ones only.");
 
             if (w.button("Capture Current Frame")) capture();
+
+            auto stats = mpImageWriter->getStats();
+            w.text(fmt::format("Pending writes: {}\nImages written: {}\nQueue stalls: {}", mpImageWriter->getPendingCount(), stats.imagesWritten, stats.stallCount));
         }
     }
 
@@ -95,6 +100,7 @@ namespace Mogwai
         auto printGraph = [](FrameCapture* pFC, RenderGraph* pGraph) { pybind11::print(pFC->graphFramesStr(pGraph)); };
         frameCapture.def(kPrintFrames.c_str(), printGraph, "graph"_a);
         frameCapture.def(kCapture.c_str(), &FrameCapture::capture);
+        frameCapture.def(kFlush.c_str(), &FrameCapture::flush);
         auto printAllGraphs = [](FrameCapture* pFC)
         {
             std::string s;
@@ -134,6 +140,9 @@ namespace Mogwai
 
     void FrameCapture::triggerFrame(RenderContext* pRenderContext, RenderGraph* pGraph, uint64_t frameID)
     {
+        // Hand the readbacks of earlier frames that have finished to the writer threads.
+        mpImageWriter->processReadbacks();
+
         std::vector<std::string> unmarkedOutputs;
 
         if (mCaptureAllOutputs)
@@ -156,6 +165,12 @@ namespace Mogwai
         }
     }
 
+    void FrameCapture::endRange(RenderGraph* pGraph, const Range& r)
+    {
+        // Make sure all images of the capture range are on disk.
+        flush();
+    }
+
     void FrameCapture::captureOutput(RenderContext* pRenderContext, RenderGraph* pGraph, const uint32_t outputIndex)
     {
         const std::string outputName = pGraph->getOutputName(outputIndex);
@@ -163,6 +178,7 @@ namespace Mogwai
 
         const Texture::SharedPtr pOutput = pGraph->getOutput(outputIndex)->asTexture();
         if (!pOutput) throw RuntimeError("Graph output {} is not a texture", outputName);
+        if (pOutput->getType() != Texture::Type::Texture2D) throw RuntimeError("Graph output {} is not a 2D texture", outputName);
 
         const ResourceFormat format = pOutput->getFormat();
         const uint32_t channels = getFormatChannelCount(format);
@@ -248,7 +264,10 @@ namespace Mogwai
             Bitmap::ExportFlags flags = Bitmap::ExportFlags::None;
             if (mask == TextureChannelFlags::RGBA) flags |= Bitmap::ExportFlags::ExportAlpha;
 
-            pTex->captureToFile(0, 0, filename, fileformat, flags);
+            // Issue the readback and queue it on the background writer. The readback is completed on this
+            // thread once the GPU has finished it. This blocks only if the writer queue is full.
+            auto pReadTask = pRenderContext->asyncReadTextureSubresource(pTex.get(), pTex->getSubresourceIndex(0, 0));
+            mpImageWriter->write(filename, pReadTask, pTex->getWidth(), pTex->getHeight(), pTex->getFormat(), fileformat, flags);
         }
     }
 
@@ -278,5 +297,11 @@ namespace Mogwai
         if (!pGraph) return;
         uint64_t frameID = mpRenderer->getGlobalClock().getFrame();
         triggerFrame(mpRenderer->getRenderContext(), pGraph, frameID);
+        flush();
+    }
+
+    void FrameCapture::flush()
+    {
+        mpImageWriter->flush();
     }
 }
@@ -28,6 +28,7 @@
 #pragma once
 #include "../../Mogwai.h"
 #include "CaptureTrigger.h"
+#include "Utils/Image/AsyncImageWriter.h"
 #include "Utils/Image/ImageProcessing.h"
 
 namespace Mogwai
@@ -41,7 +42,9 @@ namespace Mogwai
         virtual std::string getScriptVar() const override;
         virtual std::string getScript(const std::string& var) const override;
         virtual void triggerFrame(RenderContext* pRenderContext, RenderGraph* pGraph, uint64_t frameID) override;
+        virtual void endRange(RenderGraph* pGraph, const Range& r) override;
         void capture();
+        void flush();
 
     private:
         FrameCapture(Renderer* pRenderer);
@@ -54,5 +57,6 @@ namespace Mogwai
 
         bool mCaptureAllOutputs = false;
         std::unique_ptr<ImageProcessing> mpImageProcessing;
+        std::unique_ptr<AsyncImageWriter> mpImageWriter;    ///< Background writer encoding captured images off the render thread.
     };
 }
@@ -828,6 +828,7 @@ int main(int argc, char** argv)
     args::Flag generateShaderDebugInfoFlag(parser, "", "Generate shader debug info.", {"debug-shaders"});
     args::Flag enableDebugLayerFlag(parser, "", "Enable debug layer (enabled by default in Debug build).", {"enable-debug-layer"});
     args::Flag preciseProgramFlag(parser, "", "Force all slang programs to run in precise mode", { "precise" });
+    args::Flag prewarmShadersFlag(parser, "", "Record shader program versions and compile them in the background on the next start.", {"prewarm-shaders"});
 
     args::CompletionFlag completionFlag(parser, {"complete"});
 
@@ -906,6 +907,8 @@ int main(int argc, char** argv)
         config.generateShaderDebugInfo = true;
     if (preciseProgramFlag)
         config.shaderPreciseFloat = true;
+    if (prewarmShadersFlag)
+        config.prewarmShaders = true;
 
     config.windowDesc.title = "Mogwai";
     if (widthFlag)
@@ -38,6 +38,9 @@ namespace
     const std::string kSrgb = "srgb";
     const std::string kArraySlice = "arrayIndex";
     const std::string kMipLevel = "mipLevel";
+    const std::string kPrefetchCount = "prefetchCount";
+    const std::string kCacheSize = "cacheSizeMB";
+    const std::string kWaitForFrames = "waitForFrames";
 }
 
 extern "C" FALCOR_API_EXPORT void registerPlugin(Falcor::PluginRegistry& registry)
@@ -72,6 +75,9 @@ ImageLoader::ImageLoader(std::shared_ptr<Device> pDevice, const Dictionary& dict
         else if (key == kMips) mGenerateMips = value;
         else if (key == kArraySlice) mArraySlice = value;
         else if (key == kMipLevel) mMipLevel = value;
+        else if (key == kPrefetchCount) mPrefetchCount = value;
+        else if (key == kCacheSize) mCacheSizeMB = value;
+        else if (key == kWaitForFrames) mWaitForFrames = value;
         else logWarning("Unknown field '{}' in a ImageLoader dictionary.", key);
     }
 
@@ -94,6 +100,12 @@ Dictionary ImageLoader::getScriptingDictionary()
     dict[kSrgb] = mLoadSRGB;
     dict[kArraySlice] = mArraySlice;
     dict[kMipLevel] = mMipLevel;
+    if (mpSequence)
+    {
+        dict[kPrefetchCount] = mPrefetchCount;
+        dict[kCacheSize] = mCacheSizeMB;
+        dict[kWaitForFrames] = mWaitForFrames;
+    }
     return dict;
 }
 
@@ -109,6 +121,20 @@ void ImageLoader::execute(RenderContext* pRenderContext, const RenderData& rende
     mOutputFormat = pDstTex->getFormat();
     mOutputSize = { pDstTex->getWidth(), pDstTex->getHeight() };
 
+    if (mpSequence)
+    {
+        // Show the next frame if it has been decoded, otherwise keep showing the current one.
+        // Frames that failed to load are skipped, the last good frame stays visible in their place.
+        ImageSequence::FrameState state;
+        auto pFrame = mpSequence->getFrame(mSequenceFrame, mWaitForFrames, &state);
+        if (pFrame && mSequenceFrame != mDisplayedFrame)
+        {
+            uploadFrame(pRenderContext, *pFrame);
+            mDisplayedFrame = mSequenceFrame;
+        }
+        if (state != ImageSequence::FrameState::Pending && mPlaySequence) mSequenceFrame = (mSequenceFrame + 1) % mpSequence->getFrameCount();
+    }
+
     if (!mpTex)
     {
         pRenderContext->clearRtv(pDstTex->getRTV().get(), float4(0, 0, 0, 0));
@@ -134,6 +160,22 @@ void ImageLoader::renderUI(Gui::Widgets& widget)
     reloadImage |= widget.checkbox("Load As SRGB", mLoadSRGB);
     reloadImage |= widget.checkbox("Generate Mipmaps", mGenerateMips);
 
+    if (mpSequence)
+    {
+        if (auto group = widget.group("Sequence", true))
+        {
+            group.checkbox("Play", mPlaySequence);
+            group.slider("Frame", mSequenceFrame, 0u, mpSequence->getFrameCount() - 1);
+            group.checkbox("Wait For Frames", mWaitForFrames);
+            group.tooltip("Wait for each frame to be decoded. Otherwise the previous frame is shown until the next one is ready.", true);
+            bool limitsChanged = group.var("Prefetch Count", mPrefetchCount, 1u, 256u);
+            limitsChanged |= group.var("Cache Size (MB)", mCacheSizeMB, 1u, 1u << 20);
+            if (limitsChanged) mpSequence->setCacheLimits(mPrefetchCount, size_t(mCacheSizeMB) << 20);
+            group.text(fmt::format("Frames: {}", mpSequence->getFrameCount()));
+            group.text(fmt::format("Cached: {:.1f} MB", mpSequence->getCachedBytes() / (1024.0 * 1024.0)));
+        }
+    }
+
     if (widget.button("Load File"))
     {
         reloadImage |= openFileDialog({}, mImagePath);
@@ -174,6 +216,9 @@ bool ImageLoader::loadImage(const std::filesystem::path& path)
 {
     if (path.empty()) return false;
 
+    mpSequence.reset();
+    if (ImageSequence::isPattern(path)) return loadSequence(path);
+
     // Find the full path of the specified image.
     // We retain this for later as the search paths may change during execution.
     std::filesystem::path fullPath;
@@ -188,3 +233,52 @@ bool ImageLoader::loadImage(const std::filesystem::path& path)
         return false;
     }
 }
+
+bool ImageLoader::loadSequence(const std::filesystem::path& pattern)
+{
+    // Find the full path of the sequence directory.
+    std::filesystem::path directory;
+    if (!findFileInDataDirectories(pattern.parent_path(), directory)) return false;
+    mImagePath = directory / pattern.filename();
+
+    auto framePaths = ImageSequence::findFrames(mImagePath);
+    if (framePaths.empty()) return false;
+
+    logInfo("ImageLoader: Found {} frames matching '{}'.", framePaths.size(), mImagePath);
+    mpSequence = std::make_unique<ImageSequence>(std::move(framePaths), mPrefetchCount, size_t(mCacheSizeMB) << 20, Threading::getLogicalThreadCount());
+    mSequenceFrame = 0;
+    mDisplayedFrame = uint32_t(-1);
+
+    // Load the first frame synchronously to determine the image size and format.
+    auto pFrame = mpSequence->getFrame(0, true);
+    if (!pFrame) return false;
+    uploadFrame(mpDevice->getRenderContext(), *pFrame);
+    mDisplayedFrame = 0;
+    return true;
+}
+
+void ImageLoader::uploadFrame(RenderContext* pRenderContext, const Bitmap& frame)
+{
+    ResourceFormat format = mLoadSRGB ? linearToSrgbFormat(frame.getFormat()) : frame.getFormat();
+
+    if (mpTex && mpTex->getWidth() == frame.getWidth() && mpTex->getHeight() == frame.getHeight() && mpTex->getFormat() == format &&
+        (mpTex->getMipCount() > 1) == mGenerateMips)
+    {
+        // Reuse the texture.
+        pRenderContext->updateSubresourceData(mpTex.get(), 0, frame.getData());
+        if (mpTex->getMipCount() > 1) mpTex->generateMips(pRenderContext);
+        return;
+    }
+
+    uint2 prevSize = {};
+    if (mpTex) prevSize = { mpTex->getWidth(), mpTex->getHeight() };
+
+    mpTex = Texture::create2D(mpDevice.get(), frame.getWidth(), frame.getHeight(), format, 1, mGenerateMips ? Texture::kMaxPossible : 1, frame.getData());
+
+    // If output is set to native size and image dimensions have changed, we'll trigger a graph recompile to update the render pass I/O sizes.
+    if (mOutputSizeSelection == RenderPassHelpers::IOSize::Fixed && prevSize.x != 0 &&
+        (mpTex->getWidth() != prevSize.x || mpTex->getHeight() != prevSize.y))
+    {
+        requestRecompile();
+    }
+}
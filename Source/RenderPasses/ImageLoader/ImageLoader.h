@@ -28,6 +28,7 @@
 #pragma once
 #include "Falcor.h"
 #include "RenderGraph/RenderPassHelpers.h"
+#include "Utils/Image/ImageSequence.h"
 
 using namespace Falcor;
 
@@ -52,6 +53,8 @@ private:
     ImageLoader(std::shared_ptr<Device> pDevice, const Dictionary& dict);
 
     bool loadImage(const std::filesystem::path& path);
+    bool loadSequence(const std::filesystem::path& pattern);
+    void uploadFrame(RenderContext* pRenderContext, const Bitmap& frame);
 
     RenderPassHelpers::IOSize mOutputSizeSelection = RenderPassHelpers::IOSize::Default; ///< Selected output size.
     ResourceFormat mOutputFormat = ResourceFormat::Unknown;     ///< Current output resource format.
@@ -63,4 +66,13 @@ private:
     uint32_t mMipLevel = 0;
     bool mGenerateMips = false;
     bool mLoadSRGB = true;
+
+    // Image sequence streaming. A sequence is loaded if the image filename is a sequence pattern, see ImageSequence.
+    std::unique_ptr<ImageSequence> mpSequence;
+    uint32_t mPrefetchCount = 8;                                ///< Number of frames decoded ahead of the current frame.
+    uint32_t mCacheSizeMB = 2048;                               ///< Maximum host memory used for decoded frames.
+    bool mWaitForFrames = false;                                ///< Wait for each frame to be decoded instead of repeating the previous frame.
+    bool mPlaySequence = true;                                  ///< Advance to the next frame on every execution.
+    uint32_t mSequenceFrame = 0;                                ///< Next frame of the sequence to display.
+    uint32_t mDisplayedFrame = uint32_t(-1);                    ///< Frame of the sequence currently in the texture.
 };
@@ -31,8 +31,10 @@
 
 #include <args.hxx>
 
+#include <algorithm>
 #include <cstdio>
 #include <string>
+#include <thread>
 #include <vector>
 
 FALCOR_EXPORT_D3D12_AGILITY_SDK
@@ -43,8 +45,14 @@ FalcorTest::~FalcorTest() {}
 
 void FalcorTest::onFrameRender(RenderContext* pRenderContext, const Fbo::SharedPtr& pTargetFbo)
 {
-    int returnCode =
-        runTests(getDevice(), getTargetFbo().get(), mOptions.categoryFlags, mOptions.filter, mOptions.xmlReportPath, mOptions.repeat);
+    int returnCode = 0;
+    if (mOptions.runBenchmarks)
+        returnCode = runBenchmarks(mOptions.benchmarkOptions);
+    else
+        returnCode = runTests(
+            getDevice(), getTargetFbo().get(), mOptions.categoryFlags, mOptions.filter, mOptions.xmlReportPath, mOptions.repeat,
+            mOptions.jobs, mOptions.shardIndex, mOptions.shardCount
+        );
     shutdown(returnCode);
 }
 
@@ -60,6 +68,22 @@ int main(int argc, char** argv)
     args::ValueFlag<std::string> filterFlag(parser, "filter", "Regular expression for filtering tests to run.", {'f', "filter"});
     args::ValueFlag<std::string> xmlReportFlag(parser, "path", "XML report output file.", {'x', "xml-report"});
     args::ValueFlag<uint32_t> repeatFlag(parser, "N", "Number of times to repeat the test.", {'r', "repeat"});
+    args::ValueFlag<uint32_t> jobsFlag(
+        parser, "N", "Number of threads for running CPU tests (default: 1, 0 = hardware concurrency).", {'j', "jobs"}
+    );
+    args::ValueFlag<std::string> shardFlag(parser, "i/N", "Only run the i-th of N test shards (0-based).", {"shard"});
+    args::ValueFlag<std::string> benchmarkFlag(
+        parser, "filter", "Run CPU benchmarks matching the regular expression instead of tests.", {'b', "benchmark"}
+    );
+    args::ValueFlag<uint32_t> benchmarkWarmupFlag(parser, "N", "Number of warm-up runs per benchmark.", {"benchmark-warmup"});
+    args::ValueFlag<uint32_t> benchmarkRepeatFlag(parser, "N", "Number of measured runs per benchmark.", {"benchmark-repeat"});
+    args::ValueFlag<std::string> benchmarkJsonFlag(parser, "path", "JSON benchmark report output file.", {"benchmark-json"});
+    args::ValueFlag<std::string> benchmarkBaselineFlag(
+        parser, "path", "JSON benchmark report to compare against. Fails on regressions.", {"benchmark-baseline"}
+    );
+    args::ValueFlag<double> benchmarkThresholdFlag(
+        parser, "percent", "Allowed increase of the median time over the baseline (default: 10).", {"benchmark-threshold"}
+    );
     args::Flag enableDebugLayerFlag(parser, "", "Enable debug layer (enabled by default in Debug build).", {"enable-debug-layer"});
     args::CompletionFlag completionFlag(parser, {"complete"});
 
@@ -144,6 +168,47 @@ int main(int argc, char** argv)
         options.xmlReportPath = args::get(xmlReportFlag);
     if (repeatFlag)
         options.repeat = args::get(repeatFlag);
+    if (jobsFlag)
+    {
+        options.jobs = args::get(jobsFlag);
+        if (options.jobs == 0)
+            options.jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (shardFlag)
+    {
+        std::vector<std::string> tokens = splitString(args::get(shardFlag), "/");
+        try
+        {
+            if (tokens.size() != 2)
+                throw std::invalid_argument("Expected two values");
+            options.shardIndex = std::stoul(tokens[0]);
+            options.shardCount = std::stoul(tokens[1]);
+        }
+        catch (const std::exception&)
+        {
+            options.shardCount = 0;
+        }
+        if (options.shardCount == 0 || options.shardIndex >= options.shardCount)
+        {
+            std::cerr << "Invalid test shard '" << args::get(shardFlag) << "', use 'i/N' with 0 <= i < N" << std::endl;
+            return 1;
+        }
+    }
+    if (benchmarkFlag)
+    {
+        options.runBenchmarks = true;
+        options.benchmarkOptions.filter = args::get(benchmarkFlag);
+    }
+    if (benchmarkWarmupFlag)
+        options.benchmarkOptions.warmupCount = args::get(benchmarkWarmupFlag);
+    if (benchmarkRepeatFlag)
+        options.benchmarkOptions.repetitionCount = args::get(benchmarkRepeatFlag);
+    if (benchmarkJsonFlag)
+        options.benchmarkOptions.jsonReportPath = args::get(benchmarkJsonFlag);
+    if (benchmarkBaselineFlag)
+        options.benchmarkOptions.baselinePath = args::get(benchmarkBaselineFlag);
+    if (benchmarkThresholdFlag)
+        options.benchmarkOptions.regressionThreshold = args::get(benchmarkThresholdFlag) / 100.0;
 
     // Disable logging to console, we don't want to clutter the test runner output with log messages.
     Logger::setOutputs(Logger::OutputFlags::File | Logger::OutputFlags::DebugWindow);
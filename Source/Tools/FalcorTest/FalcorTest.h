@@ -41,6 +41,11 @@ public:
         std::string filter;
         std::filesystem::path xmlReportPath;
         uint32_t repeat = 1;
+        uint32_t jobs = 1;       ///< Number of threads for running thread-safe CPU tests.
+        uint32_t shardIndex = 0; ///< Index of the test shard to run.
+        uint32_t shardCount = 1; ///< Total number of test shards.
+        bool runBenchmarks = false; ///< Run benchmarks instead of tests.
+        BenchmarkOptions benchmarkOptions;
     };
 
     FalcorTest(const SampleAppConfig& config, const Options& options);
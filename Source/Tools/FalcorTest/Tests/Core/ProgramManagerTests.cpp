@@ -0,0 +1,116 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Core/Program/ComputeProgram.h"
+#include "Core/Program/ProgramManager.h"
+
+namespace Falcor
+{
+namespace
+{
+const uint32_t kVersionCount = 3;
+
+ComputeProgram::SharedPtr createProgram(std::shared_ptr<Device> pDevice)
+{
+    return ComputeProgram::createFromFile(pDevice, "Tests/Core/BufferTests.cs.slang", "clearBuffer", Program::DefineList{{"TYPE", "0"}});
+}
+
+/// Enable prewarming from a copy of the given prewarm list, as the manager overwrites the list when it is destroyed.
+std::filesystem::path enablePrewarmingFromCopy(ProgramManager& manager, const std::filesystem::path& path, uint32_t threadCount)
+{
+    auto copyPath = getTempFilePath();
+    std::filesystem::copy_file(path, copyPath);
+    manager.enablePrewarming(copyPath, threadCount);
+    return copyPath;
+}
+} // namespace
+
+GPU_TEST(ProgramManager_PrewarmShutdown)
+{
+    auto pDevice = ctx.getDevice();
+    const auto prewarmPath = getTempFilePath();
+    std::vector<std::filesystem::path> tempPaths = {prewarmPath};
+
+    // Record all versions of the program.
+    {
+        ProgramManager manager(pDevice);
+        manager.enablePrewarming(prewarmPath, 2);
+        auto pProgram = createProgram(pDevice);
+        for (uint32_t type = 0; type < kVersionCount; ++type)
+        {
+            std::string log;
+            pProgram->addDefine("TYPE", std::to_string(type));
+            EXPECT(manager.getProgramVersion(*pProgram, log) != nullptr) << log;
+        }
+    }
+    ASSERT(std::filesystem::exists(prewarmPath));
+
+    // Recorded versions are compiled in the background and picked up by the program.
+    {
+        ProgramManager manager(pDevice);
+        tempPaths.push_back(enablePrewarmingFromCopy(manager, prewarmPath, 2));
+        auto pProgram = createProgram(pDevice);
+        for (uint32_t type = 0; type < kVersionCount; ++type)
+        {
+            std::string log;
+            pProgram->addDefine("TYPE", std::to_string(type));
+            EXPECT(manager.getProgramVersion(*pProgram, log) != nullptr) << log;
+        }
+    }
+
+    // Destroy the program while its versions are queued or being compiled. The tasks must not keep the program alive.
+    {
+        ProgramManager manager(pDevice);
+        tempPaths.push_back(enablePrewarmingFromCopy(manager, prewarmPath, 1));
+        auto pProgram = createProgram(pDevice);
+        std::weak_ptr<Program> pWeakProgram = pProgram;
+        std::string log;
+        EXPECT(manager.getProgramVersion(*pProgram, log) != nullptr) << log;
+        pProgram.reset();
+        EXPECT(pWeakProgram.expired());
+    }
+
+    // Destroy the manager while versions are queued, before the program.
+    {
+        auto pProgram = createProgram(pDevice);
+        {
+            ProgramManager manager(pDevice);
+            tempPaths.push_back(enablePrewarmingFromCopy(manager, prewarmPath, 1));
+            std::string log;
+            EXPECT(manager.getProgramVersion(*pProgram, log) != nullptr) << log;
+        }
+        pProgram.reset();
+    }
+
+    for (const auto& path : tempPaths)
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+}
+} // namespace Falcor
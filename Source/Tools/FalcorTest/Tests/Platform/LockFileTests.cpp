@@ -46,9 +46,9 @@ CPU_TEST(LockFile_Closed)
     EXPECT_FALSE(file.isOpen());
 }
 
-CPU_TEST(LockFile_OpenClose)
+CPU_TEST_SERIAL(LockFile_OpenClose)
 {
-    const std::filesystem::path path = "test_lock_file";
+    const std::filesystem::path path = getTempFilePath();
 
     {
         LockFile file;
@@ -72,9 +72,9 @@ CPU_TEST(LockFile_OpenClose)
     ASSERT_FALSE(std::filesystem::exists(path));
 }
 
-CPU_TEST(LockFile_ExclusiveLock)
+CPU_TEST_SERIAL(LockFile_ExclusiveLock)
 {
-    static const std::filesystem::path path = "test_lock_file";
+    static const std::filesystem::path path = getTempFilePath();
     static std::atomic<uint32_t> lockCounter;
     static std::atomic<uint32_t> unlockCounter;
 
@@ -69,7 +69,7 @@ CPU_TEST(MemoryMappedFile_Read)
     for (size_t i = 0; i < randomData.size(); ++i)
         randomData[i] = rng() & 0xff;
 
-    const std::filesystem::path tempPath = std::filesystem::absolute("test_memory_mapped.bin");
+    const std::filesystem::path tempPath = getTempFilePath();
 
     // Write file with random data.
     std::ofstream ofs(tempPath, std::ios::binary);
@@ -0,0 +1,155 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "RenderGraph/RenderGraph.h"
+
+namespace Falcor
+{
+namespace
+{
+const uint32_t kTexDim = 16;
+
+/** Render pass that records how often it is compiled.
+ */
+class StubPass : public RenderPass
+{
+public:
+    FALCOR_PLUGIN_CLASS(StubPass, "StubPass", "Render pass for testing.");
+
+    using SharedPtr = std::shared_ptr<StubPass>;
+
+    static SharedPtr create(std::shared_ptr<Device> pDevice, bool hasInput) { return SharedPtr(new StubPass(std::move(pDevice), hasInput)); }
+
+    RenderPassReflection reflect(const CompileData& compileData) override
+    {
+        RenderPassReflection r;
+        if (mHasInput)
+            r.addInput("in", "Input").texture2D(kTexDim, kTexDim);
+        r.addOutput("out", "Output").texture2D(kTexDim, kTexDim).format(mOutputFormat);
+        return r;
+    }
+
+    void compile(RenderContext* pRenderContext, const CompileData& compileData) override { mCompileCount++; }
+    void execute(RenderContext* pRenderContext, const RenderData& renderData) override {}
+
+    void setOutputFormat(ResourceFormat format)
+    {
+        mOutputFormat = format;
+        requestRecompile();
+    }
+
+    void requestRecompileWithoutChanges() { requestRecompile(); }
+
+    uint32_t getCompileCount() const { return mCompileCount; }
+
+private:
+    StubPass(std::shared_ptr<Device> pDevice, bool hasInput) : RenderPass(std::move(pDevice)), mHasInput(hasInput) {}
+
+    bool mHasInput;
+    ResourceFormat mOutputFormat = ResourceFormat::RGBA32Float;
+    uint32_t mCompileCount = 0;
+};
+
+struct CompileCounts
+{
+    uint32_t a, b, c;
+};
+
+CompileCounts getCompileCounts(const StubPass::SharedPtr& pA, const StubPass::SharedPtr& pB, const StubPass::SharedPtr& pC)
+{
+    return {pA->getCompileCount(), pB->getCompileCount(), pC->getCompileCount()};
+}
+} // namespace
+
+GPU_TEST(RenderGraphIncrementalCompile)
+{
+    auto pA = StubPass::create(ctx.getDevice(), false);
+    auto pB = StubPass::create(ctx.getDevice(), true);
+    auto pC = StubPass::create(ctx.getDevice(), true);
+
+    // Graph: A -> B -> C
+    auto pGraph = RenderGraph::create(ctx.getDevice(), "IncrementalCompile");
+    pGraph->addPass(pA, "A");
+    pGraph->addPass(pB, "B");
+    pGraph->addPass(pC, "C");
+    pGraph->addEdge("A.out", "B.in");
+    pGraph->addEdge("B.out", "C.in");
+    pGraph->markOutput("A.out");
+    pGraph->markOutput("C.out");
+
+    // First compilation compiles all passes.
+    ASSERT(pGraph->compile(ctx.getRenderContext()));
+    auto counts = getCompileCounts(pA, pB, pC);
+    EXPECT_EQ(counts.a, 1u);
+    EXPECT_EQ(counts.b, 1u);
+    EXPECT_EQ(counts.c, 1u);
+    auto pOutA = pGraph->getOutput("A.out");
+    auto pOutC = pGraph->getOutput("C.out");
+    ASSERT(pOutA != nullptr);
+    ASSERT(pOutC != nullptr);
+
+    // Recompiling without changes to the passes does not compile any pass and reuses all resources.
+    pGraph->setResourceAliasingEnabled(!pGraph->isResourceAliasingEnabled());
+    ASSERT(pGraph->compile(ctx.getRenderContext()));
+    counts = getCompileCounts(pA, pB, pC);
+    EXPECT_EQ(counts.a, 1u);
+    EXPECT_EQ(counts.b, 1u);
+    EXPECT_EQ(counts.c, 1u);
+    EXPECT(pGraph->getOutput("A.out") == pOutA);
+    EXPECT(pGraph->getOutput("C.out") == pOutC);
+
+    // A pass requesting a recompile is compiled even if its compilation data did not change.
+    pB->requestRecompileWithoutChanges();
+    ASSERT(pGraph->compile(ctx.getRenderContext()));
+    counts = getCompileCounts(pA, pB, pC);
+    EXPECT_EQ(counts.a, 1u);
+    EXPECT_EQ(counts.b, 2u);
+    EXPECT_EQ(counts.c, 1u);
+
+    // Changing the output of B recompiles B and the pass consuming it, A and its resources are untouched.
+    pB->setOutputFormat(ResourceFormat::RGBA16Float);
+    ASSERT(pGraph->compile(ctx.getRenderContext()));
+    counts = getCompileCounts(pA, pB, pC);
+    EXPECT_EQ(counts.a, 1u);
+    EXPECT_EQ(counts.b, 3u);
+    EXPECT_EQ(counts.c, 2u);
+    EXPECT(pGraph->getOutput("A.out") == pOutA);
+    EXPECT(pGraph->getOutput("C.out") == pOutC);
+
+    // Rewiring C to read from A recompiles C only. B no longer participates in the graph.
+    pGraph->removeEdge("B.out", "C.in");
+    pGraph->addEdge("A.out", "C.in");
+    ASSERT(pGraph->compile(ctx.getRenderContext()));
+    counts = getCompileCounts(pA, pB, pC);
+    EXPECT_EQ(counts.a, 1u);
+    EXPECT_EQ(counts.b, 3u);
+    EXPECT_EQ(counts.c, 3u);
+    EXPECT(pGraph->getOutput("A.out") == pOutA);
+    EXPECT(pGraph->getOutput("C.out") == pOutC);
+}
+} // namespace Falcor
@@ -0,0 +1,162 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "RenderGraph/ResourceAliasingPlanner.h"
+
+namespace Falcor
+{
+namespace
+{
+using Planner = ResourceAliasingPlanner;
+
+Planner::ResourceDesc createTexture2D(uint32_t width, uint32_t height, ResourceFormat format)
+{
+    Planner::ResourceDesc desc;
+    desc.type = RenderPassReflection::Field::Type::Texture2D;
+    desc.width = width;
+    desc.height = height;
+    desc.format = format;
+    desc.bindFlags = ResourceBindFlags::ShaderResource | ResourceBindFlags::UnorderedAccess;
+    return desc;
+}
+} // namespace
+
+CPU_TEST(ResourceAliasingPlanner_Size)
+{
+    EXPECT_EQ(createTexture2D(16, 8, ResourceFormat::RGBA32Float).getSizeInBytes(), 16 * 8 * 16);
+    EXPECT_EQ(createTexture2D(16, 8, ResourceFormat::R8Unorm).getSizeInBytes(), 16 * 8);
+
+    // Full mip chain: 8x8 + 4x4 + 2x2 + 1x1.
+    auto desc = createTexture2D(8, 8, ResourceFormat::R8Unorm);
+    desc.mipLevels = Resource::kMaxPossible;
+    EXPECT_EQ(desc.getSizeInBytes(), 64 + 16 + 4 + 1);
+
+    // Block compressed formats are sized in 4x4 blocks.
+    EXPECT_EQ(createTexture2D(8, 8, ResourceFormat::BC1Unorm).getSizeInBytes(), 4 * 8);
+
+    Planner::ResourceDesc buffer;
+    buffer.type = RenderPassReflection::Field::Type::RawBuffer;
+    buffer.width = 1000;
+    EXPECT_EQ(buffer.getSizeInBytes(), 1000);
+}
+
+CPU_TEST(ResourceAliasingPlanner_DisjointLifetimes)
+{
+    const auto desc = createTexture2D(64, 64, ResourceFormat::RGBA16Float);
+    const uint64_t size = desc.getSizeInBytes();
+
+    // A chain of resources where each is consumed by the next pass.
+    std::vector<Planner::Request> requests = {
+        {desc, {0, 1}},
+        {desc, {1, 2}},
+        {desc, {2, 3}},
+        {desc, {3, 4}},
+        {desc, {4, 4}},
+    };
+
+    auto plan = Planner::plan(requests);
+    ASSERT_EQ(plan.allocationIndices.size(), requests.size());
+
+    // Resources 0, 2, 4 and 1, 3 can share allocations.
+    EXPECT_EQ(plan.stats.allocationCount, 2u);
+    EXPECT_EQ(plan.allocationRequests.size(), 2u);
+    EXPECT_EQ(plan.allocationIndices[0], plan.allocationIndices[2]);
+    EXPECT_EQ(plan.allocationIndices[0], plan.allocationIndices[4]);
+    EXPECT_EQ(plan.allocationIndices[1], plan.allocationIndices[3]);
+    EXPECT_NE(plan.allocationIndices[0], plan.allocationIndices[1]);
+
+    EXPECT_EQ(plan.stats.resourceCount, 5u);
+    EXPECT_EQ(plan.stats.requestedBytes, 5 * size);
+    EXPECT_EQ(plan.stats.allocatedBytes, 2 * size);
+    EXPECT_EQ(plan.stats.getSavedBytes(), 3 * size);
+}
+
+CPU_TEST(ResourceAliasingPlanner_Compatibility)
+{
+    const auto descA = createTexture2D(64, 64, ResourceFormat::RGBA16Float);
+    const auto descB = createTexture2D(64, 64, ResourceFormat::RGBA32Float);
+    auto descC = descA;
+    descC.bindFlags = ResourceBindFlags::ShaderResource | ResourceBindFlags::RenderTarget;
+
+    std::vector<Planner::Request> requests = {
+        {descA, {0, 0}},
+        {descB, {1, 1}},        // Different format.
+        {descC, {2, 2}},        // Different bind flags.
+        {descA, {3, 3}, false}, // Not aliasable.
+        {descA, {4, 4}},
+    };
+
+    auto plan = Planner::plan(requests);
+    EXPECT_EQ(plan.stats.allocationCount, 4u);
+    EXPECT_EQ(plan.allocationIndices[0], plan.allocationIndices[4]);
+    EXPECT_NE(plan.allocationIndices[0], plan.allocationIndices[1]);
+    EXPECT_NE(plan.allocationIndices[0], plan.allocationIndices[2]);
+    EXPECT_NE(plan.allocationIndices[0], plan.allocationIndices[3]);
+}
+
+CPU_TEST(ResourceAliasingPlanner_RandomIntervals)
+{
+    const auto desc = createTexture2D(32, 32, ResourceFormat::RGBA8Unorm);
+    const uint32_t kPassCount = 40;
+
+    std::vector<Planner::Request> requests;
+    uint32_t seed = 1;
+    auto rand = [&]() { return (seed = seed * 1664525u + 1013904223u) >> 8; };
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        uint32_t start = rand() % kPassCount;
+        uint32_t end = std::min(kPassCount - 1, start + rand() % 6);
+        requests.push_back({desc, {start, end}});
+    }
+
+    auto plan = Planner::plan(requests);
+
+    // No two resources sharing an allocation may have overlapping lifetimes.
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+        for (size_t j = i + 1; j < requests.size(); j++)
+        {
+            if (plan.allocationIndices[i] != plan.allocationIndices[j])
+                continue;
+            bool overlap = requests[i].lifetime.first <= requests[j].lifetime.second && requests[j].lifetime.first <= requests[i].lifetime.second;
+            EXPECT(!overlap) << "i = " << i << " j = " << j;
+        }
+    }
+
+    // The greedy sweep is optimal: the allocation count equals the maximum number of simultaneously live resources.
+    uint32_t maxLive = 0;
+    for (uint32_t t = 0; t < kPassCount; t++)
+    {
+        uint32_t live = 0;
+        for (const auto& r : requests)
+            live += (r.lifetime.first <= t && t <= r.lifetime.second) ? 1 : 0;
+        maxLive = std::max(maxLive, live);
+    }
+    EXPECT_EQ(plan.stats.allocationCount, maxLive);
+}
+} // namespace Falcor
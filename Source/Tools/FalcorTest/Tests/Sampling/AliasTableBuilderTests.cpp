@@ -0,0 +1,241 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Sampling/AliasTableBuilder.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace Falcor
+{
+namespace
+{
+enum class WeightPattern
+{
+    Uniform,
+    Constant,
+    Dominant,
+    SparseZeros,
+    Skewed,
+};
+
+std::vector<float> generateWeights(size_t N, WeightPattern pattern, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> uniform;
+    std::vector<float> weights(N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        float u = uniform(rng);
+        switch (pattern)
+        {
+        case WeightPattern::Uniform:
+            weights[i] = u;
+            break;
+        case WeightPattern::Constant:
+            weights[i] = 1.f;
+            break;
+        case WeightPattern::Dominant:
+            weights[i] = i == N / 2 ? 1000.f : 1e-3f;
+            break;
+        case WeightPattern::SparseZeros:
+            weights[i] = u < 0.5f ? 0.f : 100.f * u * u * u;
+            break;
+        case WeightPattern::Skewed:
+            weights[i] = std::pow(u, 20.f);
+            break;
+        }
+    }
+    return weights;
+}
+
+/** Check that the table is well-formed and that the probabilities it implies match the weights.
+    The probability of item i is (thresholds[i] + sum of (1 - thresholds[j]) over entries j aliased to i) / N.
+*/
+void checkAliasTable(CPUUnitTestContext& ctx, const std::vector<float>& weights, const AliasTableData& table)
+{
+    const size_t N = weights.size();
+    ASSERT_EQ(table.thresholds.size(), N);
+    ASSERT_EQ(table.aliases.size(), N);
+
+    double weightSum = 0.0;
+    for (float w : weights)
+        weightSum += w;
+    EXPECT(std::abs(table.weightSum - weightSum) <= 1e-9 * weightSum);
+
+    std::vector<double> probabilities(N, 0.0);
+    for (size_t i = 0; i < N; ++i)
+    {
+        EXPECT(table.thresholds[i] >= 0.f && table.thresholds[i] <= 1.f);
+        ASSERT(table.aliases[i] < N);
+        probabilities[i] += table.thresholds[i];
+        probabilities[table.aliases[i]] += 1.0 - table.thresholds[i];
+    }
+
+    size_t errorCount = 0;
+    for (size_t i = 0; i < N; ++i)
+    {
+        double expected = weightSum > 0.0 ? weights[i] / weightSum : 1.0 / N;
+        double actual = probabilities[i] / N;
+        // Allow a small relative error due to float thresholds, and an absolute error for tiny weights.
+        if (std::abs(actual - expected) > 1e-4 * expected + 1e-6 / N)
+            errorCount++;
+    }
+    EXPECT_EQ(errorCount, 0);
+}
+
+/** Reference sequential alias table construction (Vose 1991), used as the baseline in the benchmarks.
+*/
+AliasTableData buildAliasTableSequential(std::vector<float> weights)
+{
+    const size_t N = weights.size();
+    AliasTableData table;
+    table.thresholds.resize(N, 1.f);
+    table.aliases.resize(N);
+    std::iota(table.aliases.begin(), table.aliases.end(), 0u);
+
+    for (float w : weights)
+        table.weightSum += w;
+
+    std::vector<uint32_t> light;
+    std::vector<uint32_t> heavy;
+    const float scale = float(N / table.weightSum);
+    for (uint32_t i = 0; i < N; ++i)
+    {
+        weights[i] *= scale;
+        (weights[i] < 1.f ? light : heavy).push_back(i);
+    }
+
+    while (!light.empty() && !heavy.empty())
+    {
+        uint32_t l = light.back();
+        uint32_t h = heavy.back();
+        light.pop_back();
+        table.thresholds[l] = weights[l];
+        table.aliases[l] = h;
+        weights[h] -= 1.f - weights[l];
+        if (weights[h] < 1.f)
+        {
+            heavy.pop_back();
+            light.push_back(h);
+        }
+    }
+
+    return table;
+}
+} // namespace
+
+CPU_TEST(AliasTableBuilder_Distribution)
+{
+    std::mt19937 rng;
+    const WeightPattern patterns[] = {
+        WeightPattern::Uniform, WeightPattern::Constant, WeightPattern::Dominant, WeightPattern::SparseZeros, WeightPattern::Skewed,
+    };
+
+    for (size_t N : {1, 2, 3, 7, 100, 1000, 100000, 300000})
+    {
+        for (WeightPattern pattern : patterns)
+        {
+            std::vector<float> weights = generateWeights(N, pattern, rng);
+
+            // Test with the default task size and with small task sizes to exercise splitting the sweep.
+            for (size_t itemsPerTask : {size_t(1), size_t(64), size_t(1) << 16})
+            {
+                checkAliasTable(ctx, weights, buildAliasTable(weights, itemsPerTask));
+            }
+        }
+    }
+}
+
+CPU_TEST(AliasTableBuilder_Degenerate)
+{
+    // Empty table.
+    {
+        AliasTableData table = buildAliasTable({});
+        EXPECT(table.thresholds.empty());
+        EXPECT(table.aliases.empty());
+        EXPECT_EQ(table.weightSum, 0.0);
+    }
+
+    // All zero weights sample uniformly.
+    {
+        std::vector<float> weights(1000, 0.f);
+        AliasTableData table = buildAliasTable(weights, 16);
+        EXPECT_EQ(table.weightSum, 0.0);
+        checkAliasTable(ctx, weights, table);
+    }
+
+    // Single non-zero weight.
+    {
+        std::vector<float> weights(1000, 0.f);
+        weights[123] = 5.f;
+        AliasTableData table = buildAliasTable(weights, 16);
+        for (size_t i = 0; i < weights.size(); ++i)
+        {
+            if (i != 123)
+            {
+                EXPECT_EQ(table.thresholds[i], 0.f);
+                EXPECT_EQ(table.aliases[i], 123);
+            }
+        }
+        checkAliasTable(ctx, weights, table);
+    }
+}
+
+CPU_TEST(AliasTableBuilder_Deterministic)
+{
+    // The table must not depend on how the work is scheduled.
+    std::mt19937 rng;
+    std::vector<float> weights = generateWeights(200000, WeightPattern::Uniform, rng);
+    AliasTableData a = buildAliasTable(weights, 1000);
+    AliasTableData b = buildAliasTable(weights, 1000);
+    EXPECT(a.thresholds == b.thresholds);
+    EXPECT(a.aliases == b.aliases);
+    EXPECT_EQ(a.weightSum, b.weightSum);
+}
+
+CPU_BENCHMARK(AliasTableBuilder_Build)
+{
+    std::mt19937 rng;
+    std::vector<float> weights = generateWeights(size_t(1) << 22, WeightPattern::Uniform, rng);
+
+    AliasTableData table;
+    ctx.run([&]() { table = buildAliasTable(weights); });
+    EXPECT_EQ(table.thresholds.size(), weights.size());
+}
+
+CPU_BENCHMARK(AliasTableBuilder_BuildSequential)
+{
+    std::mt19937 rng;
+    std::vector<float> weights = generateWeights(size_t(1) << 22, WeightPattern::Uniform, rng);
+
+    AliasTableData table;
+    ctx.run([&]() { table = buildAliasTableSequential(weights); });
+    EXPECT_EQ(table.thresholds.size(), weights.size());
+}
+} // namespace Falcor
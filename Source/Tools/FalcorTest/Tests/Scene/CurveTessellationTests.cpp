@@ -0,0 +1,517 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/Curves/CurveTessellation.h"
+#include "Core/Assert.h"
+#include "Utils/Math/Common.h"
+#include "Utils/Math/MathHelpers.h"
+#include "Utils/Math/CubicSpline.h"
+#include <glm/gtx/quaternion.hpp>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace Falcor
+{
+namespace
+{
+struct HairSet
+{
+    std::vector<uint32_t> vertexCounts;
+    std::vector<float3> points;
+    std::vector<float> widths;
+    std::vector<float2> UVs;
+};
+
+HairSet createHairSet(uint32_t strandCount)
+{
+    std::mt19937 rng;
+    auto dist = std::uniform_real_distribution<float>();
+    auto u = [&]() { return dist(rng); };
+
+    HairSet hair;
+    for (uint32_t i = 0; i < strandCount; i++)
+    {
+        uint32_t vertexCount = 4 + rng() % 12;
+        hair.vertexCounts.push_back(vertexCount);
+
+        float3 p = float3(u(), u(), u()) * 10.f;
+        for (uint32_t j = 0; j < vertexCount; j++)
+        {
+            // Repeat some interior control points to exercise the duplicate removal.
+            if (j < 2 || j == vertexCount - 1 || rng() % 8 != 0)
+                p += float3(u() * 0.1f, 0.1f + u() * 0.1f, u() * 0.1f);
+            hair.points.push_back(p);
+            hair.widths.push_back(0.01f + u() * 0.01f);
+            hair.UVs.push_back(float2(u(), u()));
+        }
+    }
+    return hair;
+}
+
+// Copy of the serial tessellation code that was replaced by the parallel implementation.
+// It is kept unchanged as a reference: the parallel code must produce bit-identical results.
+
+struct StrandArrays {
+    std::vector<float3> controlPoints;
+    std::vector<float>  widths;
+    std::vector<float2> UVs;
+    uint32_t vertexCount { 0 };
+};
+
+struct CurveArrays {
+    const float3* controlPoints;
+    const float* widths;
+    const float2* UVs;
+
+    // Initializer
+    CurveArrays(const float3* paramControlPoints, const float* paramWidths, const float2* paramUVs)
+    {
+        controlPoints = paramControlPoints;
+        widths = paramWidths;
+        UVs = paramUVs;
+    }
+};
+
+struct CubicSplineCache
+{
+    CubicSpline<float3> optSplinePoints;
+    CubicSpline<float>  optSplineWidths;
+    CubicSpline<float2> optSplineUVs;
+
+    CubicSpline<float3> splinePoints;
+    CubicSpline<float>  splineWidths;
+    CubicSpline<float2> splineUVs;
+};
+
+// Curves tessellated to quad-tubes have the width somewhere between curveWidth and (curveWidth / sqrt(2)), depending on the viewing angle.
+// To achieve curveWidth on average, however, we need to scale the initial curveWidth by 1.11 (the number was deducted numerically).
+const float kMeshCompensationScale = 1.11f;
+
+float4 transformSphere(const rmcv::mat4& xform, const float4& sphere)
+{
+    // Spheres are represented as (center.x, center.y, center.z, radius).
+    // Assume the scaling is isotropic, i.e., the end points are still spheres after transformation.
+    float  scale = std::sqrt(xform[0][0] * xform[0][0] + xform[0][1] * xform[0][1] + xform[0][2] * xform[0][2]);
+    float3 xyz = xform * float4(sphere.xyz, 1.f);
+    return float4(xyz, sphere.w * scale);
+}
+
+void optimizeStrandGeometry(CubicSplineCache& splineCache, const CurveArrays& curveArrays, StrandArrays& strandArrays, StrandArrays& optimizedStrandArrays, uint32_t pointOffset, uint32_t subdivPerSegment, uint32_t keepOneEveryXVerticesPerStrand, float widthScale)
+{
+    strandArrays.controlPoints.clear();
+    strandArrays.UVs.clear();
+    strandArrays.widths.clear();
+
+    // Optimize geometry by removing duplicates.
+    for (uint32_t j = 0; j < strandArrays.vertexCount - 1; j++)
+    {
+        if (curveArrays.controlPoints[pointOffset + j] != curveArrays.controlPoints[pointOffset + j + 1])
+        {
+            strandArrays.controlPoints.push_back(curveArrays.controlPoints[pointOffset + j]);
+            strandArrays.widths.push_back(curveArrays.widths[pointOffset + j]);
+            if (curveArrays.UVs) strandArrays.UVs.push_back(curveArrays.UVs[pointOffset + j]);
+        }
+    }
+
+    // Add the last control point.
+    strandArrays.controlPoints.push_back(curveArrays.controlPoints[pointOffset + strandArrays.vertexCount - 1]);
+    strandArrays.widths.push_back(curveArrays.widths[pointOffset + strandArrays.vertexCount - 1]);
+    if (curveArrays.UVs) strandArrays.UVs.push_back(curveArrays.UVs[pointOffset + strandArrays.vertexCount - 1]);
+
+    optimizedStrandArrays.vertexCount = static_cast<uint32_t>(strandArrays.controlPoints.size());
+
+    const CubicSpline<float3>& splinePoints = splineCache.optSplinePoints.setup(strandArrays.controlPoints.data(), optimizedStrandArrays.vertexCount);
+    const CubicSpline<float>& splineWidths = splineCache.optSplineWidths.setup(strandArrays.widths.data(), optimizedStrandArrays.vertexCount);
+
+    uint32_t tmpCount = 0;
+    for (uint32_t j = 0; j < optimizedStrandArrays.vertexCount - 1; j++)
+    {
+        for (uint32_t k = 0; k < subdivPerSegment; k++)
+        {
+            if (tmpCount % keepOneEveryXVerticesPerStrand == 0)
+            {
+                float t = (float)k / (float)subdivPerSegment;
+                optimizedStrandArrays.controlPoints.push_back(splinePoints.interpolate(j, t));
+                optimizedStrandArrays.widths.push_back(kMeshCompensationScale * widthScale * splineWidths.interpolate(j, t));
+            }
+            tmpCount++;
+        }
+    }
+
+    // Always keep the last vertex.
+    optimizedStrandArrays.controlPoints.push_back(splinePoints.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f));
+    optimizedStrandArrays.widths.push_back(kMeshCompensationScale * widthScale * splineWidths.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f));
+
+    // Texture coordinates.
+    if (curveArrays.UVs)
+    {
+        const CubicSpline<float2>& splineUVs = splineCache.optSplineUVs.setup(strandArrays.UVs.data(), optimizedStrandArrays.vertexCount);
+        tmpCount = 0;
+        for (uint32_t j = 0; j < optimizedStrandArrays.vertexCount - 1; j++)
+        {
+            for (uint32_t k = 0; k < subdivPerSegment; k++)
+            {
+                if (tmpCount % keepOneEveryXVerticesPerStrand == 0)
+                {
+                    float t = (float)k / (float)subdivPerSegment;
+                    optimizedStrandArrays.UVs.push_back(splineUVs.interpolate(j, t));
+                }
+                tmpCount++;
+            }
+        }
+
+        // Always keep the last vertex.
+        optimizedStrandArrays.UVs.push_back(splineUVs.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f));
+    }
+}
+
+void updateCurveFrame(const StrandArrays& strandArrays, float3& fwd, float3& s, float3& t, uint32_t j)
+{
+    float3 prevFwd;
+
+    if (j <= 0 || j >= strandArrays.controlPoints.size())
+    {
+        // The forward tangents should be the same, meaning s & t are also the same
+        prevFwd = fwd;
+    }
+    else if (j == 1)
+    {
+        prevFwd = normalize(strandArrays.controlPoints[j] - strandArrays.controlPoints[j - 1]);
+        fwd = normalize(strandArrays.controlPoints[j + 1] - strandArrays.controlPoints[j - 1]);
+    }
+    else if (j < strandArrays.controlPoints.size() - 2)
+    {
+        prevFwd = normalize(strandArrays.controlPoints[j] - strandArrays.controlPoints[j - 2]);
+        fwd = normalize(strandArrays.controlPoints[j + 1] - strandArrays.controlPoints[j - 1]);
+    }
+    else if (j == strandArrays.controlPoints.size() - 1)
+    {
+        prevFwd = normalize(strandArrays.controlPoints[j] - strandArrays.controlPoints[j - 2]);
+        fwd = normalize(strandArrays.controlPoints[j] - strandArrays.controlPoints[j - 1]);
+    }
+
+    // Use quaternions to smoothly rotate the other vectors and update s & t vectors.
+    glm::quat rotQuat = glm::rotation(prevFwd, fwd);
+    s = glm::rotate(rotQuat, s);
+    t = glm::rotate(rotQuat, t);
+}
+
+void updateMeshResultBuffers(CurveTessellation::MeshResult& result, const CurveArrays& curveArrays, StrandArrays& optimizedStrandArrays, const float3& fwd, const float3& s, const float3& t, uint32_t pointCountPerCrossSection, const float& widthScale, uint32_t j)
+{
+    // Mesh vertices, normals, tangents, and texCrds (if any).
+    for (uint32_t k = 0; k < pointCountPerCrossSection; k++)
+    {
+        float phi = (float)k / (float)pointCountPerCrossSection * (float)M_PI * 2.f;
+        float3 vNormal = std::cos(phi) * s + std::sin(phi) * t;
+
+        float curveRadius = 0.5f * optimizedStrandArrays.widths[j];
+        result.vertices.push_back(optimizedStrandArrays.controlPoints[j] + curveRadius * vNormal);
+        result.normals.push_back(vNormal);
+        result.tangents.push_back(float4(fwd.x, fwd.y, fwd.z, 1));
+        result.radii.push_back(curveRadius);
+
+        if (curveArrays.UVs)
+        {
+            result.texCrds.push_back(optimizedStrandArrays.UVs[j]);
+        }
+    }
+}
+
+void connectFaceVertices(CurveTessellation::MeshResult& result, uint32_t meshVertexOffset, uint32_t pointCountPerCrossSection, uint32_t quadCountLimit, uint32_t nextCrossSectionVertexOffset, uint32_t multiplier, uint32_t j)
+{
+    for (uint32_t k = 0; k < quadCountLimit; k++)
+    {
+        result.faceVertexCounts.push_back(3);
+        result.faceVertexIndices.push_back(meshVertexOffset + multiplier * j * pointCountPerCrossSection + k);
+        result.faceVertexIndices.push_back(meshVertexOffset + multiplier * j * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection);
+        result.faceVertexIndices.push_back(meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection);
+
+        result.faceVertexCounts.push_back(3);
+        result.faceVertexIndices.push_back(meshVertexOffset + multiplier * j * pointCountPerCrossSection + k);
+        result.faceVertexIndices.push_back(meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection);
+        result.faceVertexIndices.push_back(meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + k);
+    }
+}
+
+CurveTessellation::SweptSphereResult referenceLinearSweptSphere(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t degree, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, const rmcv::mat4& xform)
+{
+    CurveTessellation::SweptSphereResult result;
+
+    // Only support linear tube segments now.
+    // TODO: Add quadratic or cubic tube segments if necessary.
+    FALCOR_ASSERT(degree == 1);
+    result.degree = degree;
+
+    uint32_t pointCounts = 0;
+    uint32_t segCounts = 0;
+    uint32_t maxVertexCountsPerStrand = 0;
+    for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
+    {
+        uint32_t tmpPointCount = div_round_up(subdivPerSegment * (vertexCountsPerStrand[i] - 1), keepOneEveryXVerticesPerStrand) + 1;
+        pointCounts += tmpPointCount;
+        segCounts += tmpPointCount - 1;
+        maxVertexCountsPerStrand = std::max(maxVertexCountsPerStrand, vertexCountsPerStrand[i]);
+    }
+    result.indices.reserve(segCounts);
+    result.points.reserve(pointCounts);
+    result.radius.reserve(pointCounts);
+    result.texCrds.reserve(pointCounts);
+
+    uint32_t pointOffset = 0;
+
+    StrandArrays strandArrays;
+    strandArrays.controlPoints.reserve(maxVertexCountsPerStrand);
+    strandArrays.widths.reserve(maxVertexCountsPerStrand);
+    strandArrays.UVs.reserve(maxVertexCountsPerStrand);
+    CurveArrays curveArrays(controlPoints, widths, UVs);
+
+    StrandArrays optimizedStrandArrays;
+    CubicSplineCache splineCache;
+    for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
+    {
+        optimizedStrandArrays.controlPoints.clear();
+        optimizedStrandArrays.UVs.clear();
+        optimizedStrandArrays.widths.clear();
+        optimizedStrandArrays.vertexCount = 0;
+        strandArrays.vertexCount = vertexCountsPerStrand[i];
+
+        optimizeStrandGeometry(splineCache, curveArrays, strandArrays, optimizedStrandArrays, pointOffset, subdivPerSegment, keepOneEveryXVerticesPerStrand, widthScale);
+
+        const CubicSpline<float3>& splinePoints = splineCache.splinePoints.setup(strandArrays.controlPoints.data(), optimizedStrandArrays.vertexCount);
+        const CubicSpline<float>& splineWidths = splineCache.splineWidths.setup(strandArrays.widths.data(), optimizedStrandArrays.vertexCount);
+
+        uint32_t tmpCount = 0;
+        for (uint32_t j = 0; j < optimizedStrandArrays.vertexCount - 1; j++)
+        {
+            for (uint32_t k = 0; k < subdivPerSegment; k++)
+            {
+                if (tmpCount % keepOneEveryXVerticesPerStrand == 0)
+                {
+                    float t = (float)k / (float)subdivPerSegment;
+                    result.indices.push_back((uint32_t)result.points.size());
+
+                    // Pre-transform curve points.
+                    float4 sph = transformSphere(xform, float4(splinePoints.interpolate(j, t), splineWidths.interpolate(j, t) * 0.5f * widthScale));
+
+                    result.points.push_back(sph.xyz);
+                    result.radius.push_back(sph.w);
+                }
+                tmpCount++;
+            }
+        }
+
+        // Always keep the last vertex.
+        float4 sph = transformSphere(xform, float4(splinePoints.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f), splineWidths.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f) * 0.5f * widthScale));
+        result.points.push_back(sph.xyz);
+        result.radius.push_back(sph.w);
+
+        // Texture coordinates.
+        if (UVs)
+        {
+            const CubicSpline<float2>& splineUVs = splineCache.splineUVs.setup(strandArrays.UVs.data(), optimizedStrandArrays.vertexCount);
+            tmpCount = 0;
+            for (uint32_t j = 0; j < optimizedStrandArrays.vertexCount - 1; j++)
+            {
+                for (uint32_t k = 0; k < subdivPerSegment; k++)
+                {
+                    if (tmpCount % keepOneEveryXVerticesPerStrand == 0)
+                    {
+                        float t = (float)k / (float)subdivPerSegment;
+                        result.texCrds.push_back(splineUVs.interpolate(j, t));
+                    }
+                    tmpCount++;
+                }
+            }
+
+            // Always keep the last vertex.
+            result.texCrds.push_back(splineUVs.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f));
+        }
+
+        for (uint32_t j = i; j < std::min(strandCount, i + keepOneEveryXStrands); j++) pointOffset += vertexCountsPerStrand[j];
+    }
+
+    return result;
+}
+
+CurveTessellation::MeshResult referencePolytube(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, uint32_t pointCountPerCrossSection)
+{
+    CurveTessellation::MeshResult result;
+    uint32_t vertexCounts = 0;
+    uint32_t faceCounts = 0;
+    uint32_t maxVertexCountsPerStrand = 0;
+    for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
+    {
+        uint32_t tmpPointCount = div_round_up(subdivPerSegment * (vertexCountsPerStrand[i] - 1), keepOneEveryXVerticesPerStrand) + 1;
+        vertexCounts += pointCountPerCrossSection * tmpPointCount;
+        faceCounts += 2 * pointCountPerCrossSection * (tmpPointCount - 1);
+        maxVertexCountsPerStrand = std::max(maxVertexCountsPerStrand, vertexCountsPerStrand[i]);
+    }
+    result.vertices.reserve(vertexCounts);
+    result.normals.reserve(vertexCounts);
+    result.tangents.reserve(vertexCounts);
+    result.texCrds.reserve(vertexCounts);
+    result.radii.reserve(vertexCounts);
+    result.faceVertexCounts.reserve(faceCounts);
+    result.faceVertexIndices.reserve(faceCounts * 3);
+
+    uint32_t pointOffset = 0;
+    uint32_t meshVertexOffset = 0;
+
+    StrandArrays strandArrays;
+    strandArrays.controlPoints.reserve(maxVertexCountsPerStrand);
+    strandArrays.widths.reserve(maxVertexCountsPerStrand);
+    strandArrays.UVs.reserve(maxVertexCountsPerStrand);
+    CurveArrays curveArrays(controlPoints, widths, UVs);
+
+    StrandArrays optimizedStrandArrays;
+    CubicSplineCache splineCache;
+    for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
+    {
+        optimizedStrandArrays.controlPoints.clear();
+        optimizedStrandArrays.UVs.clear();
+        optimizedStrandArrays.widths.clear();
+        optimizedStrandArrays.vertexCount = 0;
+
+        strandArrays.vertexCount = vertexCountsPerStrand[i];
+
+        optimizeStrandGeometry(splineCache, curveArrays, strandArrays, optimizedStrandArrays, pointOffset, subdivPerSegment, keepOneEveryXVerticesPerStrand, widthScale);
+
+        for (uint32_t j = i; j < std::min(strandCount, i + keepOneEveryXStrands); j++) pointOffset += vertexCountsPerStrand[j];
+
+        // Build the initial frame.
+        float3 fwd, s, t;
+        fwd = normalize(optimizedStrandArrays.controlPoints[1] - optimizedStrandArrays.controlPoints[0]);
+        buildFrame(fwd, s, t);
+
+        // Create mesh.
+        for (uint32_t j = 0; j < optimizedStrandArrays.controlPoints.size(); j++)
+        {
+            // Update the curve's frame vectors: [fwd, s, t]
+            updateCurveFrame(optimizedStrandArrays, fwd, s, t, j);
+
+            // Mesh vertices, normals, tangents, and texCrds (if any).
+            updateMeshResultBuffers(result, curveArrays, optimizedStrandArrays, fwd, s, t, pointCountPerCrossSection, widthScale, j);
+
+            // Mesh faces.
+            if (j < optimizedStrandArrays.controlPoints.size() - 1)
+            {
+                uint32_t quadCountLimit = pointCountPerCrossSection;
+                connectFaceVertices(result, meshVertexOffset, pointCountPerCrossSection, quadCountLimit, 1, 1, j);
+            }
+        }
+
+        meshVertexOffset += pointCountPerCrossSection * (uint32_t)optimizedStrandArrays.controlPoints.size();
+    }
+    return result;
+}
+
+template<typename T>
+void expectIdentical(CPUUnitTestContext& ctx, const std::vector<T>& result, const std::vector<T>& ref, const char* name)
+{
+    ASSERT_EQ(result.size(), ref.size()) << name;
+    EXPECT(std::memcmp(result.data(), ref.data(), ref.size() * sizeof(T)) == 0) << name;
+}
+} // namespace
+
+CPU_TEST(CurveTessellation_MatchesSerial)
+{
+    const uint32_t strandCount = 3000;
+    HairSet hair = createHairSet(strandCount);
+    rmcv::mat4 xform = rmcv::translate(float3(1.f, 2.f, 3.f)) * rmcv::scale(float3(2.f));
+
+    for (uint32_t keepStrands : {1u, 3u})
+    {
+        for (uint32_t keepVertices : {1u, 2u})
+        {
+            const float2* pUVs = keepVertices == 1 ? hair.UVs.data() : nullptr;
+
+            auto lss = CurveTessellation::convertToLinearSweptSphere(
+                strandCount, hair.vertexCounts.data(), hair.points.data(), hair.widths.data(), pUVs, 1, 4, keepStrands, keepVertices, 1.f, xform
+            );
+            auto refLss = referenceLinearSweptSphere(
+                strandCount, hair.vertexCounts.data(), hair.points.data(), hair.widths.data(), pUVs, 1, 4, keepStrands, keepVertices, 1.f, xform
+            );
+            EXPECT_EQ(lss.degree, refLss.degree);
+            expectIdentical(ctx, lss.indices, refLss.indices, "indices");
+            expectIdentical(ctx, lss.points, refLss.points, "points");
+            expectIdentical(ctx, lss.radius, refLss.radius, "radius");
+            expectIdentical(ctx, lss.texCrds, refLss.texCrds, "texCrds");
+
+            auto mesh = CurveTessellation::convertToPolytube(
+                strandCount, hair.vertexCounts.data(), hair.points.data(), hair.widths.data(), pUVs, 4, keepStrands, keepVertices, 1.f, 4
+            );
+            auto refMesh = referencePolytube(
+                strandCount, hair.vertexCounts.data(), hair.points.data(), hair.widths.data(), pUVs, 4, keepStrands, keepVertices, 1.f, 4
+            );
+            expectIdentical(ctx, mesh.vertices, refMesh.vertices, "vertices");
+            expectIdentical(ctx, mesh.normals, refMesh.normals, "normals");
+            expectIdentical(ctx, mesh.tangents, refMesh.tangents, "tangents");
+            expectIdentical(ctx, mesh.texCrds, refMesh.texCrds, "texCrds");
+            expectIdentical(ctx, mesh.radii, refMesh.radii, "radii");
+            expectIdentical(ctx, mesh.faceVertexCounts, refMesh.faceVertexCounts, "faceVertexCounts");
+            expectIdentical(ctx, mesh.faceVertexIndices, refMesh.faceVertexIndices, "faceVertexIndices");
+        }
+    }
+}
+
+CPU_BENCHMARK(CurveTessellation_LinearSweptSphere)
+{
+    const uint32_t strandCount = 100'000;
+    HairSet hair = createHairSet(strandCount);
+
+    CurveTessellation::SweptSphereResult lss;
+    ctx.run(
+        [&]()
+        {
+            lss = CurveTessellation::convertToLinearSweptSphere(
+                strandCount, hair.vertexCounts.data(), hair.points.data(), hair.widths.data(), hair.UVs.data(), 1, 4, 1, 1, 1.f,
+                rmcv::identity<rmcv::mat4>()
+            );
+        }
+    );
+    EXPECT_GT(lss.indices.size(), 0u);
+}
+
+CPU_BENCHMARK(CurveTessellation_Polytube)
+{
+    const uint32_t strandCount = 100'000;
+    HairSet hair = createHairSet(strandCount);
+
+    CurveTessellation::MeshResult mesh;
+    ctx.run(
+        [&]()
+        {
+            mesh = CurveTessellation::convertToPolytube(
+                strandCount, hair.vertexCounts.data(), hair.points.data(), hair.widths.data(), hair.UVs.data(), 4, 1, 1, 1.f, 4
+            );
+        }
+    );
+    EXPECT_GT(mesh.faceVertexCounts.size(), 0u);
+}
+} // namespace Falcor
@@ -0,0 +1,295 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/DrawCuller.h"
+#include "Utils/Math/Matrix.h"
+#include <cmath>
+#include <random>
+#include <set>
+#include <utility>
+
+namespace Falcor
+{
+namespace
+{
+const float2 kViewportSize = float2(1920.f, 1080.f);
+
+struct TestScene
+{
+    std::vector<MeshDesc> meshes;
+    std::vector<GeometryInstanceData> instances;
+    std::vector<AABB> bounds; // Per draw ID.
+};
+
+/** Create instances with random world-space bounds around the camera.
+    The instances come in runs of the same mesh and a few have invalid bounds.
+*/
+TestScene createScene(uint32_t instanceCount, std::mt19937& rng)
+{
+    TestScene scene;
+    const uint32_t meshCount = 8;
+    scene.meshes.resize(meshCount);
+    for (uint32_t i = 0; i < meshCount; ++i)
+    {
+        scene.meshes[i] = {};
+        scene.meshes[i].vbOffset = i * 100;
+        scene.meshes[i].ibOffset = i * 300;
+        scene.meshes[i].vertexCount = 100;
+        scene.meshes[i].indexCount = 300;
+    }
+
+    std::uniform_int_distribution<uint32_t> meshDist(0, meshCount - 1);
+    std::uniform_int_distribution<uint32_t> runDist(1, 16);
+    std::uniform_real_distribution<float> posDist(-100.f, 100.f);
+    std::uniform_real_distribution<float> logSizeDist(std::log(0.01f), std::log(20.f));
+    std::uniform_real_distribution<float> u(0.f, 1.f);
+
+    while (scene.instances.size() < instanceCount)
+    {
+        uint32_t meshID = meshDist(rng);
+        uint32_t runLength = runDist(rng);
+        for (uint32_t i = 0; i < runLength; ++i)
+        {
+            GeometryInstanceData instance(GeometryType::TriangleMesh);
+            instance.geometryID = meshID;
+            if (u(rng) < 0.3f)
+                instance.flags |= (uint32_t)GeometryInstanceFlags::IsWorldFrontFaceCW;
+            scene.instances.push_back(instance);
+
+            float3 center = float3(posDist(rng), posDist(rng), posDist(rng));
+            float3 halfExtent = float3(std::exp(logSizeDist(rng)), std::exp(logSizeDist(rng)), std::exp(logSizeDist(rng)));
+            scene.bounds.push_back(u(rng) < 0.01f ? AABB() : AABB(center - halfExtent, center + halfExtent));
+        }
+    }
+    return scene;
+}
+
+DrawCuller::View createView(float3 eye, float3 target)
+{
+    rmcv::mat4 view = rmcv::lookAt(eye, target, float3(0.f, 1.f, 0.f));
+    rmcv::mat4 proj = rmcv::perspective(1.f, kViewportSize.x / kViewportSize.y, 0.1f, 1000.f);
+    return DrawCuller::View(proj * view, kViewportSize);
+}
+
+/** Reference culling test by brute force.
+    The box is outside the frustum if all of its corners are outside the same clip plane. The projected size is the
+    bounding rectangle of a dense grid of points on the box.
+*/
+DrawCuller::Result cullReference(const DrawCuller::View& view, const DrawCuller::Settings& settings, const AABB& bounds)
+{
+    if (!bounds.valid())
+        return DrawCuller::Result::Visible;
+
+    const rmcv::mat4& viewProj = view.getViewProjMatrix();
+
+    if (settings.frustumCulling)
+    {
+        uint32_t outside[6] = {};
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            float3 corner = float3(
+                i & 1 ? bounds.maxPoint.x : bounds.minPoint.x,
+                i & 2 ? bounds.maxPoint.y : bounds.minPoint.y,
+                i & 4 ? bounds.maxPoint.z : bounds.minPoint.z
+            );
+            float4 clip = viewProj * float4(corner, 1.f);
+            outside[0] += clip.x < -clip.w;
+            outside[1] += clip.x > clip.w;
+            outside[2] += clip.y < -clip.w;
+            outside[3] += clip.y > clip.w;
+            outside[4] += clip.z < 0.f;
+            outside[5] += clip.z > clip.w;
+        }
+        for (uint32_t count : outside)
+            if (count == 8)
+                return DrawCuller::Result::FrustumCulled;
+    }
+
+    if (settings.minPixelSize > 0.f)
+    {
+        const uint32_t n = 6;
+        float2 pixelMin = float2(std::numeric_limits<float>::infinity());
+        float2 pixelMax = float2(-std::numeric_limits<float>::infinity());
+        for (uint32_t z = 0; z <= n; ++z)
+        {
+            for (uint32_t y = 0; y <= n; ++y)
+            {
+                for (uint32_t x = 0; x <= n; ++x)
+                {
+                    float3 t = float3(float(x), float(y), float(z)) / float(n);
+                    float3 p = bounds.minPoint + t * (bounds.maxPoint - bounds.minPoint);
+                    float4 clip = viewProj * float4(p, 1.f);
+                    if (clip.w <= 0.f)
+                        return DrawCuller::Result::Visible;
+                    float2 pixel = 0.5f * float2(clip.x / clip.w, clip.y / clip.w) * view.getViewportSize();
+                    pixelMin = glm::min(pixelMin, pixel);
+                    pixelMax = glm::max(pixelMax, pixel);
+                }
+            }
+        }
+        float2 size = pixelMax - pixelMin;
+        if (size.x < settings.minPixelSize && size.y < settings.minPixelSize)
+            return DrawCuller::Result::SizeCulled;
+    }
+
+    return DrawCuller::Result::Visible;
+}
+
+void testCulling(CPUUnitTestContext& ctx, const DrawCuller::Settings& settings, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    TestScene scene = createScene(20000, rng);
+
+    DrawListBuilder drawList;
+    drawList.build(scene.instances, scene.meshes, true);
+
+    DrawCuller culler;
+    culler.setSettings(settings);
+    DrawCuller::View view = createView(float3(0.f, 5.f, 30.f), float3(10.f, 0.f, -20.f));
+    culler.cull(view, scene.bounds, drawList);
+
+    // Compare the results to the reference.
+    const auto& results = culler.getResults();
+    ASSERT_EQ(results.size(), scene.bounds.size());
+
+    DrawCuller::Stats expectedStats;
+    expectedStats.instanceCount = (uint32_t)scene.bounds.size();
+    std::set<uint32_t> expectedVisible;
+    uint32_t mismatchCount = 0;
+    for (uint32_t i = 0; i < (uint32_t)scene.bounds.size(); ++i)
+    {
+        DrawCuller::Result expected = cullReference(view, settings, scene.bounds[i]);
+        mismatchCount += results[i] != expected;
+        switch (expected)
+        {
+        case DrawCuller::Result::Visible:
+            expectedStats.visibleCount++;
+            expectedVisible.insert(i);
+            break;
+        case DrawCuller::Result::FrustumCulled:
+            expectedStats.frustumCulledCount++;
+            break;
+        case DrawCuller::Result::SizeCulled:
+            expectedStats.sizeCulledCount++;
+            break;
+        }
+    }
+    EXPECT_EQ(mismatchCount, 0u);
+
+    const auto& stats = culler.getStats();
+    EXPECT_EQ(stats.instanceCount, expectedStats.instanceCount);
+    EXPECT_EQ(stats.frustumCulledCount, expectedStats.frustumCulledCount);
+    EXPECT_EQ(stats.sizeCulledCount, expectedStats.sizeCulledCount);
+    EXPECT_EQ(stats.visibleCount, expectedStats.visibleCount);
+
+    // Make sure the test exercises all cases that are enabled.
+    EXPECT_GT(stats.visibleCount, 0u);
+    if (settings.frustumCulling)
+        EXPECT_GT(stats.frustumCulledCount, 0u);
+    if (settings.minPixelSize > 0.f)
+        EXPECT_GT(stats.sizeCulledCount, 0u);
+
+    // The compacted draws should cover exactly the visible instances, each with its own mesh.
+    std::set<uint32_t> drawn;
+    uint32_t drawCount = 0;
+    for (const auto& group : culler.getGroups())
+    {
+        drawCount += group.getDrawCount();
+        for (const auto& draw : group.indexedDraws)
+        {
+            for (uint32_t drawID = draw.StartInstanceLocation; drawID < draw.StartInstanceLocation + draw.InstanceCount; ++drawID)
+            {
+                EXPECT(drawn.insert(drawID).second);
+                ASSERT_LT(drawID, (uint32_t)scene.instances.size());
+                EXPECT_EQ(draw.BaseVertexLocation, (int32_t)scene.meshes[scene.instances[drawID].geometryID].vbOffset);
+            }
+        }
+    }
+    EXPECT(drawn == expectedVisible);
+    EXPECT_EQ(stats.drawCount, drawCount);
+    EXPECT_LT(drawCount, stats.visibleCount);
+}
+} // namespace
+
+CPU_TEST(DrawCuller_Frustum)
+{
+    DrawCuller::Settings settings;
+    testCulling(ctx, settings, 1);
+}
+
+CPU_TEST(DrawCuller_FrustumAndSize)
+{
+    DrawCuller::Settings settings;
+    settings.minPixelSize = 4.f;
+    testCulling(ctx, settings, 2);
+}
+
+CPU_TEST(DrawCuller_Size)
+{
+    DrawCuller::Settings settings;
+    settings.frustumCulling = false;
+    settings.minPixelSize = 2.f;
+    testCulling(ctx, settings, 3);
+}
+
+CPU_TEST(DrawCuller_NoCulling)
+{
+    DrawCuller::Settings settings;
+    settings.frustumCulling = false;
+
+    std::mt19937 rng(4);
+    TestScene scene = createScene(1000, rng);
+    DrawListBuilder drawList;
+    drawList.build(scene.instances, scene.meshes, true);
+
+    DrawCuller culler;
+    culler.setSettings(settings);
+    culler.cull(createView(float3(0.f), float3(0.f, 0.f, -1.f)), scene.bounds, drawList);
+
+    // Without culling the compacted draw lists are the full draw lists.
+    EXPECT_EQ(culler.getStats().visibleCount, (uint32_t)scene.instances.size());
+    for (uint32_t i = 0; i < DrawListBuilder::kGroupCount; ++i)
+        EXPECT_EQ(culler.getGroups()[i].getDrawCount(), drawList.getGroups()[i].getDrawCount());
+}
+
+CPU_BENCHMARK(DrawCuller_Cull)
+{
+    std::mt19937 rng(5);
+    TestScene scene = createScene(100000, rng);
+    DrawListBuilder drawList;
+    drawList.build(scene.instances, scene.meshes, true);
+
+    DrawCuller culler;
+    DrawCuller::Settings settings;
+    settings.minPixelSize = 1.f;
+    culler.setSettings(settings);
+    DrawCuller::View view = createView(float3(0.f, 5.f, 30.f), float3(10.f, 0.f, -20.f));
+
+    ctx.run([&]() { culler.cull(view, scene.bounds, drawList); });
+}
+} // namespace Falcor
@@ -0,0 +1,283 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/DrawListBuilder.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <set>
+#include <utility>
+
+namespace Falcor
+{
+namespace
+{
+using DrawPair = std::pair<uint32_t, uint32_t>; // (draw ID, mesh ID)
+
+std::vector<MeshDesc> createMeshes(uint32_t count, bool isIndexed)
+{
+    std::vector<MeshDesc> meshes(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        MeshDesc& mesh = meshes[i];
+        mesh = {};
+        mesh.vbOffset = i * 1000;
+        mesh.vertexCount = 100 + i;
+        if (isIndexed)
+        {
+            mesh.ibOffset = i * 2000;
+            mesh.indexCount = 3 * (50 + i);
+            if (i % 2 == 0) mesh.flags |= (uint32_t)MeshFlags::Use16BitIndices;
+        }
+    }
+    return meshes;
+}
+
+GeometryInstanceData createInstance(uint32_t meshID, bool isWorldFrontFaceCW)
+{
+    GeometryInstanceData instance(GeometryType::TriangleMesh);
+    instance.geometryID = meshID;
+    if (isWorldFrontFaceCW) instance.flags |= (uint32_t)GeometryInstanceFlags::IsWorldFrontFaceCW;
+    return instance;
+}
+
+/** Create instances with long runs of the same mesh, as produced by heavy instancing, mixed with random meshes.
+    A few non-triangle instances are added at the end.
+*/
+std::vector<GeometryInstanceData> createInstances(uint32_t meshCount, std::mt19937& rng)
+{
+    std::vector<GeometryInstanceData> instances;
+    std::uniform_int_distribution<uint32_t> meshDist(0, meshCount - 1);
+    std::uniform_int_distribution<uint32_t> runDist(1, 64);
+    std::bernoulli_distribution cwDist(0.1);
+
+    while (instances.size() < 2000)
+    {
+        uint32_t meshID = meshDist(rng);
+        uint32_t runLength = instances.size() % 3 == 0 ? runDist(rng) : 1;
+        for (uint32_t i = 0; i < runLength; ++i) instances.push_back(createInstance(meshID, cwDist(rng)));
+    }
+
+    GeometryInstanceData curve(GeometryType::Curve);
+    instances.push_back(curve);
+    return instances;
+}
+
+/** Expand the merged draws of all groups into (draw ID, mesh ID) pairs.
+    Each draw is matched to its mesh by the draw arguments, and the group is checked against the instance flags.
+*/
+std::multiset<DrawPair> expandDraws(
+    CPUUnitTestContext& ctx,
+    const DrawListBuilder& builder,
+    const std::vector<GeometryInstanceData>& instances,
+    const std::vector<MeshDesc>& meshes
+)
+{
+    // Triangle mesh instances indexed by draw ID.
+    std::vector<GeometryInstanceData> drawInstances;
+    for (const auto& instance : instances)
+        if (instance.getType() == GeometryType::TriangleMesh)
+            drawInstances.push_back(instance);
+
+    auto findMesh = [&](auto isMatch)
+    {
+        for (uint32_t meshID = 0; meshID < (uint32_t)meshes.size(); ++meshID)
+            if (isMatch(meshes[meshID]))
+                return meshID;
+        return std::numeric_limits<uint32_t>::max();
+    };
+
+    auto addInstances = [&](std::multiset<DrawPair>& pairs, const DrawListBuilder::Group& group, uint32_t meshID, uint32_t start, uint32_t count)
+    {
+        EXPECT_GE(count, 1u);
+        for (uint32_t drawID = start; drawID < start + count; ++drawID)
+        {
+            pairs.insert({drawID, meshID});
+            if (drawID >= drawInstances.size())
+                continue;
+            EXPECT_EQ(drawInstances[drawID].isWorldFrontFaceCW(), !group.ccw);
+            if (group.ibFormat != ResourceFormat::Unknown)
+                EXPECT_EQ(meshes[meshID].use16BitIndices(), group.ibFormat == ResourceFormat::R16Uint);
+        }
+    };
+
+    std::multiset<DrawPair> pairs;
+    for (const auto& group : builder.getGroups())
+    {
+        for (const auto& draw : group.indexedDraws)
+        {
+            uint32_t meshID = findMesh(
+                [&](const MeshDesc& mesh)
+                {
+                    return mesh.indexCount == draw.IndexCountPerInstance && (int32_t)mesh.vbOffset == draw.BaseVertexLocation &&
+                           mesh.ibOffset * (mesh.use16BitIndices() ? 2 : 1) == draw.StartIndexLocation;
+                }
+            );
+            addInstances(pairs, group, meshID, draw.StartInstanceLocation, draw.InstanceCount);
+        }
+        for (const auto& draw : group.draws)
+        {
+            uint32_t meshID = findMesh([&](const MeshDesc& mesh)
+                                       { return mesh.vertexCount == draw.VertexCountPerInstance && mesh.vbOffset == draw.StartVertexLocation; });
+            addInstances(pairs, group, meshID, draw.StartInstanceLocation, draw.InstanceCount);
+        }
+    }
+    return pairs;
+}
+
+/** Get the (draw ID, mesh ID) pairs that the unmerged draw list would contain: one draw per triangle mesh instance.
+*/
+std::multiset<DrawPair> getExpectedDraws(const std::vector<GeometryInstanceData>& instances)
+{
+    std::multiset<DrawPair> pairs;
+    uint32_t drawID = 0;
+    for (const auto& instance : instances)
+        if (instance.getType() == GeometryType::TriangleMesh)
+            pairs.insert({drawID++, instance.geometryID});
+    return pairs;
+}
+
+uint32_t getTotalDrawCount(const DrawListBuilder& builder)
+{
+    uint32_t count = 0;
+    for (const auto& group : builder.getGroups())
+        count += group.getDrawCount();
+    return count;
+}
+
+void testDrawList(CPUUnitTestContext& ctx, bool isIndexed)
+{
+    std::mt19937 rng(isIndexed ? 1 : 2);
+    const uint32_t meshCount = 16;
+    auto meshes = createMeshes(meshCount, isIndexed);
+    auto instances = createInstances(meshCount, rng);
+
+    DrawListBuilder builder;
+    builder.build(instances, meshes, isIndexed);
+    EXPECT_EQ(builder.getInstanceCount(), (uint32_t)instances.size() - 1);
+    EXPECT(expandDraws(ctx, builder, instances, meshes) == getExpectedDraws(instances));
+
+    // The runs of instances of the same mesh should have been merged.
+    EXPECT_LT(getTotalDrawCount(builder), builder.getInstanceCount() / 2);
+
+    if (!isIndexed)
+    {
+        EXPECT_EQ(builder.getGroups()[1].getDrawCount(), 0u);
+        EXPECT_EQ(builder.getGroups()[3].getDrawCount(), 0u);
+    }
+
+    // Updating without changes should not rebuild any groups.
+    EXPECT_EQ(builder.update(instances), 0u);
+
+    // Flip the winding of some instances. Only the groups they move between should be rebuilt.
+    auto prevGroups = builder.getGroups();
+    std::uniform_int_distribution<size_t> instanceDist(0, instances.size() - 2);
+    uint32_t expectedChangedGroups = 0;
+    for (uint32_t i = 0; i < 50; ++i)
+    {
+        auto& instance = instances[instanceDist(rng)];
+        if (isIndexed && meshes[instance.geometryID].use16BitIndices())
+            continue;
+        instance.flags ^= (uint32_t)GeometryInstanceFlags::IsWorldFrontFaceCW;
+        expectedChangedGroups = isIndexed ? 0xa : 0x5; // 32-bit groups for indexed meshes.
+    }
+
+    uint32_t changedGroups = builder.update(instances);
+    EXPECT_EQ(changedGroups, expectedChangedGroups);
+    EXPECT(expandDraws(ctx, builder, instances, meshes) == getExpectedDraws(instances));
+
+    for (uint32_t i = 0; i < DrawListBuilder::kGroupCount; ++i)
+    {
+        if (changedGroups & (1u << i))
+            continue;
+        const auto& group = builder.getGroups()[i];
+        EXPECT_EQ(group.getDrawCount(), prevGroups[i].getDrawCount());
+        EXPECT(std::equal(
+            group.indexedDraws.begin(),
+            group.indexedDraws.end(),
+            prevGroups[i].indexedDraws.begin(),
+            prevGroups[i].indexedDraws.end(),
+            [](const auto& a, const auto& b) { return std::memcmp(&a, &b, sizeof(a)) == 0; }
+        ));
+    }
+
+    // The incrementally updated draw list should match a full rebuild.
+    DrawListBuilder rebuilt;
+    rebuilt.build(instances, meshes, isIndexed);
+    for (uint32_t i = 0; i < DrawListBuilder::kGroupCount; ++i)
+        EXPECT_EQ(builder.getGroups()[i].getDrawCount(), rebuilt.getGroups()[i].getDrawCount());
+}
+} // namespace
+
+CPU_TEST(DrawListBuilder_Indexed)
+{
+    testDrawList(ctx, true);
+}
+
+CPU_TEST(DrawListBuilder_NonIndexed)
+{
+    testDrawList(ctx, false);
+}
+
+CPU_TEST(DrawListBuilder_MergeContiguous)
+{
+    auto meshes = createMeshes(2, true);
+
+    // Instances 0-99 are mesh 0 with the same winding and merge into a single draw.
+    // Instance 100 is mesh 0 with flipped winding, and instances 101-102 are mesh 1 interleaved with mesh 0.
+    std::vector<GeometryInstanceData> instances;
+    for (uint32_t i = 0; i < 100; ++i)
+        instances.push_back(createInstance(0, false));
+    instances.push_back(createInstance(0, true));
+    instances.push_back(createInstance(1, false));
+    instances.push_back(createInstance(0, false));
+    instances.push_back(createInstance(1, false));
+
+    DrawListBuilder builder;
+    builder.build(instances, meshes, true);
+
+    const auto& groups = builder.getGroups();
+    ASSERT_EQ(groups[2].indexedDraws.size(), 2u); // CCW 16-bit: mesh 0
+    EXPECT_EQ(groups[2].indexedDraws[0].StartInstanceLocation, 0u);
+    EXPECT_EQ(groups[2].indexedDraws[0].InstanceCount, 100u);
+    EXPECT_EQ(groups[2].indexedDraws[1].StartInstanceLocation, 102u);
+    EXPECT_EQ(groups[2].indexedDraws[1].InstanceCount, 1u);
+    ASSERT_EQ(groups[0].indexedDraws.size(), 1u); // CW 16-bit: mesh 0
+    EXPECT_EQ(groups[0].indexedDraws[0].StartInstanceLocation, 100u);
+    ASSERT_EQ(groups[3].indexedDraws.size(), 2u); // CCW 32-bit: mesh 1
+    EXPECT_EQ(groups[1].getDrawCount(), 0u);
+
+    // Flipping the winding of instance 100 merges all 101 instances of mesh 0 into one draw.
+    instances[100].flags &= ~(uint32_t)GeometryInstanceFlags::IsWorldFrontFaceCW;
+    EXPECT_EQ(builder.update(instances), 0x5u);
+    ASSERT_EQ(groups[2].indexedDraws.size(), 2u);
+    EXPECT_EQ(groups[2].indexedDraws[0].InstanceCount, 101u);
+    EXPECT_EQ(groups[0].getDrawCount(), 0u);
+}
+} // namespace Falcor
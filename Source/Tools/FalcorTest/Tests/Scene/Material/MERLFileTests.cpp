@@ -28,9 +28,48 @@
 #include "Testing/UnitTest.h"
 #include "Scene/Material/MERLFile.h"
 #include "Scene/Material/MERLMaterialData.slang"
+#include "Scene/Material/MeasuredBRDFCache.h"
+#include <chrono>
+#include <fstream>
 
 namespace Falcor
 {
+namespace
+{
+void writeSyntheticMERLFile(const std::filesystem::path& path, double scale)
+{
+    const int dims[3] = { 90, 90, 180 };
+    const size_t n = (size_t)dims[0] * dims[1] * dims[2];
+
+    // Include a few negative samples to exercise the clamping in the processing.
+    std::vector<double> data(3 * n);
+    for (size_t i = 0; i < data.size(); i++) data[i] = i % 997 == 0 ? -1.0 : scale * (double)(i % 1000);
+
+    std::ofstream ofs(path, std::ios_base::out | std::ios_base::binary);
+    ofs.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+    ofs.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(double));
+}
+
+/// Redirects the measured BRDF cache to a unique temporary directory for the lifetime of the object.
+struct ScopedCacheDirectory
+{
+    std::filesystem::path directory;
+
+    ScopedCacheDirectory() : directory(getTempFilePath())
+    {
+        std::filesystem::create_directories(directory);
+        MeasuredBRDFCache::setDirectory(directory);
+    }
+
+    ~ScopedCacheDirectory()
+    {
+        MeasuredBRDFCache::setDirectory({});
+        std::error_code ec;
+        std::filesystem::remove_all(directory, ec);
+    }
+};
+} // namespace
+
 GPU_TEST(MERLFile)
 {
     const std::filesystem::path path = "TestScenes/Materials/Data/gray-lambert.binary";
@@ -58,4 +97,79 @@ GPU_TEST(MERLFile)
         EXPECT_EQ(v.z, expected.z);
     }
 }
+
+CPU_TEST_SERIAL(MERLFile_Cache)
+{
+    ScopedCacheDirectory scopedCache;
+    const auto path = scopedCache.directory / "MERLFile_Cache.binary";
+    writeSyntheticMERLFile(path, 1.0);
+
+    const auto key = MERLFile::computeCacheKey(path);
+    ASSERT(key.has_value());
+    const auto cachePath = MeasuredBRDFCache::getCachePath(*key);
+    EXPECT_EQ(cachePath.parent_path(), scopedCache.directory);
+
+    MERLFile fresh;
+    ASSERT(fresh.loadBRDF(path, false));
+    EXPECT(!std::filesystem::exists(cachePath));
+
+    // First load populates the cache, second load reads from it.
+    MERLFile first;
+    ASSERT(first.loadBRDF(path));
+    EXPECT(std::filesystem::exists(cachePath));
+
+    MERLFile cached;
+    ASSERT(cached.loadBRDF(path));
+    EXPECT(cached.getData() == fresh.getData());
+
+    // Changing the source file invalidates the cache. The file size is unchanged, so make sure the modification time differs.
+    const auto modifiedTime = std::filesystem::last_write_time(path);
+    writeSyntheticMERLFile(path, 2.0);
+    std::filesystem::last_write_time(path, modifiedTime + std::chrono::seconds(1));
+
+    const auto newKey = MERLFile::computeCacheKey(path);
+    ASSERT(newKey.has_value());
+    EXPECT(*newKey != *key);
+
+    MERLFile modifiedFresh;
+    ASSERT(modifiedFresh.loadBRDF(path, false));
+    MERLFile modified;
+    ASSERT(modified.loadBRDF(path));
+    EXPECT(modified.getData() == modifiedFresh.getData());
+    EXPECT(modified.getData() != fresh.getData());
+}
+
+CPU_TEST_SERIAL(MeasuredBRDFCache_CorruptBlobSize)
+{
+    ScopedCacheDirectory scopedCache;
+    const auto path = scopedCache.directory / "source.bin";
+    {
+        std::ofstream ofs(path, std::ios_base::out | std::ios_base::binary);
+        ofs << "source";
+    }
+
+    const auto key = MeasuredBRDFCache::computeKey(path, "MeasuredBRDFCache_CorruptBlobSize");
+    ASSERT(key.has_value());
+
+    const std::vector<uint32_t> values = {1, 2, 3, 4};
+    ASSERT(MeasuredBRDFCache::write(*key, {MeasuredBRDFCache::toBlob(values.data(), values.size())}));
+    auto blobs = MeasuredBRDFCache::read(*key);
+    ASSERT(blobs.has_value());
+    ASSERT_EQ(blobs->size(), 1);
+    std::vector<uint32_t> readValues;
+    EXPECT(MeasuredBRDFCache::fromBlob((*blobs)[0], readValues));
+    EXPECT(readValues == values);
+
+    // Overwrite the blob size, which directly precedes the blob data at the end of the file, with a huge value.
+    const auto cachePath = MeasuredBRDFCache::getCachePath(*key);
+    const uint64_t fileSize = std::filesystem::file_size(cachePath);
+    const uint64_t corruptSize = ~0ull >> 1;
+    {
+        std::fstream fs(cachePath, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+        fs.seekp(fileSize - values.size() * sizeof(uint32_t) - sizeof(uint64_t));
+        fs.write(reinterpret_cast<const char*>(&corruptSize), sizeof(corruptSize));
+    }
+
+    EXPECT(!MeasuredBRDFCache::read(*key).has_value());
+}
 } // namespace Falcor
@@ -0,0 +1,110 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/Material/RGLCommon.h"
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace Falcor
+{
+namespace
+{
+const uint4 kSize = uint4(4, 3, 16, 16);
+
+std::vector<float> createTable(uint4 size)
+{
+    const size_t sliceStride = (size_t)size.z * size.w;
+    std::vector<float> pdf(sliceStride * size.x * size.y);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> u;
+    for (size_t i = 0; i < pdf.size(); i++) pdf[i] = u(rng) * (1.f + 3.f * std::sin(i * 0.1f) * std::sin(i * 0.1f));
+
+    // Include an all-zero slice to exercise the fallback to a uniform distribution.
+    std::fill_n(pdf.begin() + 5 * sliceStride, sliceStride, 0.f);
+
+    return pdf;
+}
+
+/** Build the reference distribution one slice at a time on a single thread.
+*/
+SamplableDistribution4D buildSerial(const std::vector<float>& pdf, uint4 size)
+{
+    const size_t sliceStride = (size_t)size.z * size.w;
+    std::vector<float> refPDF(pdf.size()), refMarginal(pdf.size() / size.z), refConditional(pdf.size());
+
+    for (uint32_t slice = 0; slice < size.x * size.y; slice++)
+    {
+        SamplableDistribution4D dist(pdf.data() + slice * sliceStride, uint4(1, 1, size.z, size.w));
+        std::memcpy(refPDF.data() + slice * sliceStride, dist.getPDF(), sliceStride * sizeof(float));
+        std::memcpy(refMarginal.data() + slice * size.w, dist.getMarginal(), size.w * sizeof(float));
+        std::memcpy(refConditional.data() + slice * sliceStride, dist.getConditional(), sliceStride * sizeof(float));
+    }
+
+    return SamplableDistribution4D(size, refPDF.data(), refMarginal.data(), refConditional.data());
+}
+}
+
+CPU_TEST(SamplableDistribution4D_MatchesSerial)
+{
+    const auto pdf = createTable(kSize);
+    SamplableDistribution4D dist(pdf.data(), kSize);
+    SamplableDistribution4D ref = buildSerial(pdf, kSize);
+
+    EXPECT(std::memcmp(dist.getPDF(), ref.getPDF(), dist.getElementCount() * sizeof(float)) == 0);
+    EXPECT(std::memcmp(dist.getMarginal(), ref.getMarginal(), dist.getMarginalCount() * sizeof(float)) == 0);
+    EXPECT(std::memcmp(dist.getConditional(), ref.getConditional(), dist.getElementCount() * sizeof(float)) == 0);
+}
+
+CPU_TEST(SamplableDistribution4D_HalfCDFs)
+{
+    const auto pdf = createTable(kSize);
+    SamplableDistribution4D dist(pdf.data(), kSize);
+
+    // Tables with an odd count are padded to a multiple of 4 bytes.
+    const float oddCDF[] = { 0.f, 0.5f, 1.f };
+    const auto odd = SamplableDistribution4D::packCDFToHalf(oddCDF, 3);
+    EXPECT_EQ(odd.size(), 4);
+    EXPECT(odd[2] == float16_t(1.f));
+    EXPECT(odd[3] == float16_t(0.f));
+
+    const size_t count = dist.getElementCount();
+    const auto conditional = SamplableDistribution4D::packCDFToHalf(dist.getConditional(), count);
+    EXPECT_EQ(conditional.size(), count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        float ref = dist.getConditional()[i];
+        EXPECT_LE(std::abs(float(conditional[i]) - ref), std::abs(ref) * 1e-3f + 1e-7f);
+
+        // Each row of kSize.z entries must stay non-decreasing after rounding.
+        if (i % kSize.z != 0) EXPECT(conditional[i - 1] <= conditional[i]);
+    }
+}
+} // namespace Falcor
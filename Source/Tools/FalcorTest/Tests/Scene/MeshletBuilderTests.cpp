@@ -0,0 +1,202 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/MeshletBuilder.h"
+#include "Scene/TriangleMesh.h"
+#include <algorithm>
+#include <array>
+#include <set>
+
+namespace Falcor
+{
+namespace
+{
+struct TestMesh
+{
+    std::vector<uint32_t> indices;
+    std::vector<float3> positions;
+};
+
+TestMesh createGrid(uint32_t size)
+{
+    TestMesh mesh;
+    for (uint32_t y = 0; y <= size; ++y)
+        for (uint32_t x = 0; x <= size; ++x)
+            mesh.positions.push_back(float3(float(x), float(y), 0.f));
+
+    for (uint32_t y = 0; y < size; ++y)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            uint32_t i = y * (size + 1) + x;
+            uint32_t j = i + size + 1;
+            mesh.indices.insert(mesh.indices.end(), {i, i + 1, j, i + 1, j + 1, j});
+        }
+    }
+    return mesh;
+}
+
+TestMesh createSphere()
+{
+    auto pMesh = TriangleMesh::createSphere(1.f, 128, 64);
+    TestMesh mesh;
+    mesh.indices = pMesh->getIndices();
+    for (const auto& v : pMesh->getVertices())
+        mesh.positions.push_back(v.position);
+    return mesh;
+}
+
+std::multiset<std::array<uint32_t, 3>> getTriangles(const std::vector<uint32_t>& indices)
+{
+    std::multiset<std::array<uint32_t, 3>> triangles;
+    for (size_t i = 0; i < indices.size(); i += 3)
+        triangles.insert({indices[i], indices[i + 1], indices[i + 2]});
+    return triangles;
+}
+
+void testMeshlets(CPUUnitTestContext& ctx, const TestMesh& mesh, const MeshletLimits& limits)
+{
+    std::vector<uint32_t> indices = mesh.indices;
+    auto meshlets = buildMeshlets(indices, mesh.positions, limits);
+
+    // The triangles are only reordered.
+    EXPECT(getTriangles(indices) == getTriangles(mesh.indices));
+
+    uint32_t triangleOffset = 0;
+    for (const auto& meshlet : meshlets)
+    {
+        // Meshlets are contiguous triangle ranges within the limits.
+        EXPECT_EQ(meshlet.meshID, 0);
+        EXPECT_EQ(meshlet.triangleOffset, triangleOffset);
+        EXPECT_GT(meshlet.triangleCount, 0);
+        EXPECT_LE(meshlet.triangleCount, limits.maxTriangles);
+        EXPECT_LE(meshlet.vertexCount, limits.maxVertices);
+        triangleOffset += meshlet.triangleCount;
+
+        std::set<uint32_t> vertices;
+        for (uint32_t t = meshlet.triangleOffset; t < meshlet.triangleOffset + meshlet.triangleCount; ++t)
+        {
+            const float3& p0 = mesh.positions[indices[3 * t]];
+            const float3& p1 = mesh.positions[indices[3 * t + 1]];
+            const float3& p2 = mesh.positions[indices[3 * t + 2]];
+
+            for (uint32_t k = 0; k < 3; ++k)
+            {
+                vertices.insert(indices[3 * t + k]);
+                float3 p = mesh.positions[indices[3 * t + k]];
+                EXPECT_LE(length(p - meshlet.sphereCenter), meshlet.sphereRadius * 1.0001f + 1e-6f);
+            }
+
+            float3 n = cross(p1 - p0, p2 - p0);
+            if (length(n) > 0.f)
+                EXPECT_GE(dot(normalize(n), meshlet.coneAxis), meshlet.coneCutoff - 1e-5f);
+        }
+        EXPECT_EQ(meshlet.vertexCount, vertices.size());
+    }
+    EXPECT_EQ(triangleOffset, indices.size() / 3);
+}
+} // namespace
+
+CPU_TEST(MeshletBuilder_Grid)
+{
+    TestMesh mesh = createGrid(100);
+    testMeshlets(ctx, mesh, MeshletLimits());
+
+    // A flat grid has a degenerate normal cone and meshlets close to the vertex limit.
+    std::vector<uint32_t> indices = mesh.indices;
+    auto meshlets = buildMeshlets(indices, mesh.positions);
+    size_t fullMeshlets = std::count_if(meshlets.begin(), meshlets.end(), [](const auto& m) { return m.vertexCount >= 56; });
+    EXPECT_GE(fullMeshlets, meshlets.size() * 9 / 10);
+    for (const auto& meshlet : meshlets)
+    {
+        EXPECT_GE(meshlet.coneCutoff, 0.9999f);
+        EXPECT_GE(meshlet.coneAxis.z, 0.9999f);
+    }
+}
+
+CPU_TEST(MeshletBuilder_Sphere)
+{
+    TestMesh mesh = createSphere();
+    testMeshlets(ctx, mesh, MeshletLimits());
+    testMeshlets(ctx, mesh, MeshletLimits{128, 256});
+    testMeshlets(ctx, mesh, MeshletLimits{3, 1});
+}
+
+CPU_TEST(MeshletBuilder_Disconnected)
+{
+    // Separate triangles are merged into meshlets instead of getting one meshlet each.
+    TestMesh mesh;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        float x = float(i);
+        mesh.positions.insert(mesh.positions.end(), {float3(x, 0.f, 0.f), float3(x + 1.f, 0.f, 0.f), float3(x, 1.f, 0.f)});
+        mesh.indices.insert(mesh.indices.end(), {3 * i, 3 * i + 1, 3 * i + 2});
+    }
+    testMeshlets(ctx, mesh, MeshletLimits());
+
+    std::vector<uint32_t> indices = mesh.indices;
+    auto meshlets = buildMeshlets(indices, mesh.positions);
+    EXPECT_LE(meshlets.size(), 1000 / 21 + 1);
+}
+
+CPU_TEST(MeshletBuilder_InvalidInput)
+{
+    std::vector<float3> positions(3);
+    auto throwsArgumentError = [&](std::vector<uint32_t> indices)
+    {
+        try
+        {
+            buildMeshlets(indices, positions);
+        }
+        catch (const ArgumentError&)
+        {
+            return true;
+        }
+        return false;
+    };
+
+    EXPECT(throwsArgumentError({0, 1}));
+    EXPECT(throwsArgumentError({0, 1, 3}));
+    EXPECT(!throwsArgumentError({}));
+}
+
+CPU_BENCHMARK(MeshletBuilder_Build)
+{
+    TestMesh mesh = createGrid(500);
+
+    std::vector<MeshletDesc> meshlets;
+    ctx.run(
+        [&]()
+        {
+            std::vector<uint32_t> indices = mesh.indices;
+            meshlets = buildMeshlets(indices, mesh.positions);
+        }
+    );
+    EXPECT_GT(meshlets.size(), 0u);
+}
+} // namespace Falcor
@@ -0,0 +1,118 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/SDFs/SDFGridSparseFile.h"
+#include <cmath>
+#include <fstream>
+
+namespace Falcor
+{
+namespace
+{
+std::vector<float> createSphereValues(uint32_t gridWidth, float radius)
+{
+    const uint32_t valueWidth = gridWidth + 1;
+    std::vector<float> values(valueWidth * valueWidth * valueWidth);
+    for (uint32_t z = 0; z < valueWidth; z++)
+    {
+        for (uint32_t y = 0; y < valueWidth; y++)
+        {
+            for (uint32_t x = 0; x < valueWidth; x++)
+            {
+                float3 p = float3(x, y, z) / float(gridWidth) - float3(0.5f);
+                values[x + valueWidth * (y + valueWidth * z)] = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z) - radius;
+            }
+        }
+    }
+    return values;
+}
+
+void testSparseFile(CPUUnitTestContext& ctx, uint32_t gridWidth, uint32_t brickWidth)
+{
+    const std::filesystem::path densePath = getRuntimeDirectory() / "test_sdf_grid.sdfg";
+    const std::filesystem::path sparsePath = getRuntimeDirectory() / "test_sdf_grid.sdfgs";
+    const std::filesystem::path convertedPath = getRuntimeDirectory() / "test_sdf_grid_converted.sdfgs";
+
+    std::vector<float> values = createSphereValues(gridWidth, 0.3f);
+
+    // Write sparse file directly.
+    SDFGridSparseFile::write(sparsePath, values, gridWidth, brickWidth);
+
+    // Write dense file and convert it.
+    {
+        std::ofstream file(densePath, std::ios::out | std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&gridWidth), sizeof(uint32_t));
+        file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+    }
+    SDFGridSparseFile::convertFromDenseFile(densePath, convertedPath, brickWidth);
+
+    SDFGridSparseFile::Header header = SDFGridSparseFile::readHeader(sparsePath);
+    EXPECT_EQ(header.gridWidth, gridWidth);
+    EXPECT_EQ(header.brickWidth, brickWidth);
+    EXPECT_GT(header.surfaceBrickCount, 0u);
+    EXPECT_LT((uint64_t)header.surfaceBrickCount, header.getBrickCount());
+
+    std::vector<int8_t> sparseValues;
+    std::vector<int8_t> convertedValues;
+    EXPECT_EQ(SDFGridSparseFile::readQuantizedValues(sparsePath, sparseValues), gridWidth);
+    EXPECT_EQ(SDFGridSparseFile::readQuantizedValues(convertedPath, convertedValues), gridWidth);
+    ASSERT_EQ(sparseValues.size(), values.size());
+    ASSERT_EQ(convertedValues.size(), values.size());
+
+    // The sparse files must reconstruct exactly the quantized values of the dense grid.
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        int8_t expected = SDFGridSparseFile::quantizeValue(values[i], gridWidth);
+        EXPECT_EQ(sparseValues[i], expected) << "i = " << i;
+        EXPECT_EQ(convertedValues[i], expected) << "i = " << i;
+    }
+
+    std::filesystem::remove(densePath);
+    std::filesystem::remove(sparsePath);
+    std::filesystem::remove(convertedPath);
+}
+} // namespace
+
+CPU_TEST_SERIAL(SDFGridSparseFile_RoundTrip)
+{
+    testSparseFile(ctx, 16, 8);
+    testSparseFile(ctx, 32, 8);
+    // Grid and brick widths that do not align with the value grid.
+    testSparseFile(ctx, 33, 4);
+}
+
+CPU_TEST_SERIAL(SDFGridSparseFile_Quantize)
+{
+    const uint32_t gridWidth = 64;
+    EXPECT_EQ(SDFGridSparseFile::quantizeValue(0.f, gridWidth), 0);
+    EXPECT_EQ(SDFGridSparseFile::quantizeValue(1.f, gridWidth), 127);
+    EXPECT_EQ(SDFGridSparseFile::quantizeValue(-1.f, gridWidth), -127);
+    EXPECT_EQ(SDFGridSparseFile::quantizeValue(SDFGridSparseFile::dequantizeValue(64, gridWidth), gridWidth), 64);
+    EXPECT_EQ(SDFGridSparseFile::quantizeValue(SDFGridSparseFile::dequantizeValue(-13, gridWidth), gridWidth), -13);
+}
+} // namespace Falcor
@@ -0,0 +1,333 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/SceneBVH.h"
+#include <algorithm>
+#include <random>
+
+namespace Falcor
+{
+namespace
+{
+SceneBVH::Mesh createTriangleSoup(std::mt19937& rng, uint32_t triangleCount, float triangleSize)
+{
+    std::uniform_real_distribution<float> u(-1.f, 1.f);
+    SceneBVH::Mesh mesh;
+    for (uint32_t i = 0; i < triangleCount; ++i)
+    {
+        float3 center(u(rng), u(rng), u(rng));
+        for (uint32_t j = 0; j < 3; ++j)
+        {
+            mesh.indices.push_back((uint32_t)mesh.positions.size());
+            mesh.positions.push_back(center + triangleSize * float3(u(rng), u(rng), u(rng)));
+        }
+    }
+    return mesh;
+}
+
+/// Grid of size x size unit cells in the z = 0 plane, two triangles per cell.
+SceneBVH::Mesh createGrid(uint32_t size)
+{
+    SceneBVH::Mesh mesh;
+    for (uint32_t y = 0; y <= size; ++y)
+        for (uint32_t x = 0; x <= size; ++x)
+            mesh.positions.push_back(float3(float(x), float(y), 0.f));
+
+    for (uint32_t y = 0; y < size; ++y)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            uint32_t i = y * (size + 1) + x;
+            uint32_t j = i + size + 1;
+            mesh.indices.insert(mesh.indices.end(), {i, i + 1, j, i + 1, j + 1, j});
+        }
+    }
+    return mesh;
+}
+
+float4x4 createTransform(std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> u(0.f, 1.f);
+    float4x4 transform = rmcv::translate(float3(u(rng), u(rng), u(rng)) * 4.f - 2.f);
+    transform = transform * rmcv::rotate(u(rng) * 6.f, normalize(float3(u(rng), u(rng), u(rng)) + 0.1f));
+    transform = transform * rmcv::scale(float3(0.5f + u(rng), 0.5f + u(rng), 0.5f + u(rng)));
+    return transform;
+}
+
+std::vector<Ray> createRays(std::mt19937& rng, uint32_t count)
+{
+    std::uniform_real_distribution<float> u(-1.f, 1.f);
+    std::vector<Ray> rays;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        float3 origin = float3(u(rng), u(rng), u(rng)) * 4.f;
+        float3 target = float3(u(rng), u(rng), u(rng)) * 2.f;
+        rays.push_back(Ray(origin, normalize(target - origin)));
+    }
+    return rays;
+}
+
+/// Reference closest hit that tests all triangles in world space.
+SceneBVH::Hit bruteForceClosestHit(const std::vector<SceneBVH::Mesh>& meshes, const std::vector<SceneBVH::Instance>& instances, const Ray& ray)
+{
+    SceneBVH::Hit hit;
+    float tMax = ray.tMax;
+    for (const auto& instance : instances)
+    {
+        const auto& mesh = meshes[instance.meshIndex];
+        for (uint32_t i = 0; i < mesh.indices.size() / 3; ++i)
+        {
+            float3 v[3];
+            for (uint32_t j = 0; j < 3; ++j)
+                v[j] = float3(instance.transform * float4(mesh.positions[mesh.indices[i * 3 + j]], 1.f));
+
+            float3 e1 = v[1] - v[0];
+            float3 e2 = v[2] - v[0];
+            float3 n = cross(e1, e2);
+            float denom = dot(n, ray.dir);
+            if (denom == 0.f)
+                continue;
+            float t = dot(n, v[0] - ray.origin) / denom;
+            if (t < ray.tMin || t > tMax)
+                continue;
+
+            // Barycentrics from the sub-triangle areas.
+            float3 p = ray.origin + t * ray.dir;
+            float b1 = dot(n, cross(p - v[0], e2)) / dot(n, n);
+            float b2 = dot(n, cross(e1, p - v[0])) / dot(n, n);
+            if (b1 < 0.f || b2 < 0.f || b1 + b2 > 1.f)
+                continue;
+
+            tMax = t;
+            hit = {instance.instanceID, i, t, float2(b1, b2)};
+        }
+    }
+    return hit;
+}
+
+void testClosestHits(
+    CPUUnitTestContext& ctx,
+    const SceneBVH& bvh,
+    const std::vector<SceneBVH::Mesh>& meshes,
+    const std::vector<SceneBVH::Instance>& instances,
+    const std::vector<Ray>& rays
+)
+{
+    const auto hits = bvh.closestHit(rays);
+    EXPECT_EQ(hits.size(), rays.size());
+
+    uint32_t hitCount = 0;
+    for (size_t i = 0; i < rays.size(); ++i)
+    {
+        const SceneBVH::Hit expected = bruteForceClosestHit(meshes, instances, rays[i]);
+        const SceneBVH::Hit hit = bvh.closestHit(rays[i]);
+        EXPECT_EQ(hit.isValid(), expected.isValid()) << "ray " << i;
+        if (!hit.isValid() || !expected.isValid())
+            continue;
+
+        hitCount++;
+        const float scale = std::max(expected.t, 1.f);
+        EXPECT_LE(std::abs(hit.t - expected.t), 1e-4f * scale) << "ray " << i;
+        // Nearly coincident hits may resolve differently, only compare the IDs for distinct hits.
+        if (std::abs(hit.t - expected.t) < 1e-6f * scale)
+        {
+            EXPECT_EQ(hit.instanceID, expected.instanceID) << "ray " << i;
+            EXPECT_EQ(hit.primitiveIndex, expected.primitiveIndex) << "ray " << i;
+            EXPECT_LE(std::abs(hit.barycentrics.x - expected.barycentrics.x), 1e-3f) << "ray " << i;
+            EXPECT_LE(std::abs(hit.barycentrics.y - expected.barycentrics.y), 1e-3f) << "ray " << i;
+        }
+
+        // The batched query must return exactly the same hits.
+        EXPECT_EQ(hits[i].instanceID, hit.instanceID);
+        EXPECT_EQ(hits[i].primitiveIndex, hit.primitiveIndex);
+        EXPECT_EQ(hits[i].t, hit.t);
+    }
+    EXPECT_GT(hitCount, rays.size() / 10);
+}
+
+struct TestScene
+{
+    std::vector<SceneBVH::Mesh> meshes;
+    std::vector<SceneBVH::Instance> instances;
+};
+
+TestScene createTestScene(std::mt19937& rng)
+{
+    TestScene scene;
+    scene.meshes.push_back(createTriangleSoup(rng, 200, 0.2f));
+    scene.meshes.push_back(createTriangleSoup(rng, 50, 0.5f));
+    scene.meshes.push_back(createTriangleSoup(rng, 3, 0.5f));
+    scene.meshes.push_back({}); // Empty mesh.
+    for (uint32_t i = 0; i < 10; ++i)
+        scene.instances.push_back({i % 4, 100 + i, createTransform(rng)});
+    return scene;
+}
+} // namespace
+
+CPU_TEST(SceneBVH_ClosestHit)
+{
+    std::mt19937 rng(1);
+    TestScene scene = createTestScene(rng);
+    auto pBVH = SceneBVH::create(scene.meshes, scene.instances);
+    EXPECT_EQ(pBVH->getMeshCount(), 4u);
+    EXPECT_EQ(pBVH->getInstanceCount(), 10u);
+
+    testClosestHits(ctx, *pBVH, scene.meshes, scene.instances, createRays(rng, 2000));
+
+    // Limited ray extents.
+    std::vector<Ray> rays = createRays(rng, 500);
+    for (auto& ray : rays)
+    {
+        ray.tMin = 1.f;
+        ray.tMax = 3.f;
+    }
+    testClosestHits(ctx, *pBVH, scene.meshes, scene.instances, rays);
+}
+
+CPU_TEST(SceneBVH_AnyHit)
+{
+    std::mt19937 rng(2);
+    TestScene scene = createTestScene(rng);
+    auto pBVH = SceneBVH::create(scene.meshes, scene.instances);
+
+    std::vector<Ray> rays = createRays(rng, 2000);
+    for (size_t i = 0; i < rays.size(); i += 2)
+        rays[i].tMax = 1.f;
+
+    const auto anyHits = pBVH->anyHit(rays);
+    EXPECT_EQ(anyHits.size(), rays.size());
+    for (size_t i = 0; i < rays.size(); ++i)
+    {
+        // Skip rays with a hit close to the end of the ray.
+        const SceneBVH::Hit expected = bruteForceClosestHit(scene.meshes, scene.instances, rays[i]);
+        Ray shortened = rays[i];
+        Ray extended = rays[i];
+        shortened.tMax *= 0.999f;
+        extended.tMax *= 1.001f;
+        if (bruteForceClosestHit(scene.meshes, scene.instances, shortened).isValid() !=
+            bruteForceClosestHit(scene.meshes, scene.instances, extended).isValid())
+            continue;
+
+        EXPECT_EQ(pBVH->anyHit(rays[i]), expected.isValid()) << "ray " << i;
+        EXPECT_EQ(anyHits[i] != 0, expected.isValid()) << "ray " << i;
+    }
+}
+
+CPU_TEST(SceneBVH_Overlap)
+{
+    // Two instances of a 16x16 grid, the second one is offset by 20 units along x.
+    std::vector<SceneBVH::Mesh> meshes = {createGrid(16)};
+    std::vector<SceneBVH::Instance> instances = {{0, 0, float4x4()}, {0, 1, rmcv::translate(float3(20.f, 0.f, 0.f))}};
+    auto pBVH = SceneBVH::create(meshes, instances);
+
+    // Box inside the lower-left triangle of cell (2, 3).
+    auto overlaps = pBVH->overlap(AABB(float3(2.1f, 3.1f, -1.f), float3(2.3f, 3.3f, 1.f)));
+    EXPECT_EQ(overlaps.size(), 1u);
+    if (overlaps.size() == 1)
+    {
+        EXPECT_EQ(overlaps[0].instanceID, 0u);
+        EXPECT_EQ(overlaps[0].primitiveIndex, (3u * 16 + 2) * 2);
+    }
+
+    // Box overlapping both triangles of cells [1, 2] x [1, 2] of the second instance.
+    overlaps = pBVH->overlap(AABB(float3(21.4f, 1.4f, -1.f), float3(22.6f, 2.6f, 1.f)));
+    EXPECT_EQ(overlaps.size(), 8u);
+    for (const auto& overlap : overlaps)
+    {
+        EXPECT_EQ(overlap.instanceID, 1u);
+        uint32_t cell = overlap.primitiveIndex / 2;
+        EXPECT(cell % 16 >= 1 && cell % 16 <= 2 && cell / 16 >= 1 && cell / 16 <= 2) << "cell " << cell;
+    }
+
+    // Box above the grid.
+    overlaps = pBVH->overlap(AABB(float3(1.f, 1.f, 0.1f), float3(10.f, 10.f, 1.f)));
+    EXPECT_EQ(overlaps.size(), 0u);
+
+    // Box that contains the first grid and touches no other geometry.
+    overlaps = pBVH->overlap(AABB(float3(-1.f), float3(17.f)));
+    EXPECT_EQ(overlaps.size(), 16u * 16 * 2);
+}
+
+CPU_TEST(SceneBVH_Refit)
+{
+    std::mt19937 rng(3);
+    TestScene scene = createTestScene(rng);
+    auto pBVH = SceneBVH::create(scene.meshes, scene.instances);
+
+    // Move all instances.
+    std::vector<float4x4> transforms;
+    for (auto& instance : scene.instances)
+    {
+        instance.transform = createTransform(rng);
+        transforms.push_back(instance.transform);
+    }
+    pBVH->setInstanceTransforms(transforms);
+    testClosestHits(ctx, *pBVH, scene.meshes, scene.instances, createRays(rng, 1000));
+
+    // Deform a mesh.
+    std::uniform_real_distribution<float> u(-0.2f, 0.2f);
+    for (auto& p : scene.meshes[1].positions)
+        p += float3(u(rng), u(rng), u(rng));
+    pBVH->setMeshPositions(1, scene.meshes[1].positions);
+    testClosestHits(ctx, *pBVH, scene.meshes, scene.instances, createRays(rng, 1000));
+}
+
+CPU_BENCHMARK(SceneBVH_Build)
+{
+    std::mt19937 rng(4);
+    std::vector<SceneBVH::Mesh> meshes;
+    std::vector<SceneBVH::Instance> instances;
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        meshes.push_back(createTriangleSoup(rng, 20000, 0.02f));
+        instances.push_back({i, i, createTransform(rng)});
+    }
+
+    SceneBVH::SharedPtr pBVH;
+    ctx.run([&]() { pBVH = SceneBVH::create(meshes, instances); });
+    EXPECT(pBVH != nullptr);
+}
+
+CPU_BENCHMARK(SceneBVH_ClosestHit)
+{
+    std::mt19937 rng(5);
+    std::vector<SceneBVH::Mesh> meshes;
+    std::vector<SceneBVH::Instance> instances;
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        meshes.push_back(createTriangleSoup(rng, 20000, 0.02f));
+        instances.push_back({i, i, createTransform(rng)});
+    }
+    auto pBVH = SceneBVH::create(meshes, instances);
+    std::vector<Ray> rays = createRays(rng, 20000);
+
+    std::vector<SceneBVH::Hit> hits;
+    ctx.run([&]() { hits = pBVH->closestHit(rays); });
+    EXPECT_EQ(hits.size(), rays.size());
+}
+} // namespace Falcor
@@ -0,0 +1,116 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/SceneBuilder.h"
+#include "Scene/Material/StandardMaterial.h"
+
+namespace Falcor
+{
+namespace
+{
+// Number of instances in the synthetic scene used for the node memory test.
+const uint32_t kInstanceCount = 100'000;
+
+// Upper bound on the scene graph memory per instance node. Storing the node names and bind matrices
+// in every node, as the builder used to do, takes about 400 bytes per node.
+const double kMaxBytesPerNode = 320.0;
+} // namespace
+
+GPU_TEST(SceneBuilder_NodeMemory)
+{
+    // Measure the builder memory used per instance node on a synthetic scene with a large number of
+    // named instances of a single mesh, similar to the node layout produced by the pbrt importer.
+    auto pDevice = ctx.getDevice();
+    auto pBuilder = SceneBuilder::create(pDevice, Settings(), SceneBuilder::Flags::DontOptimizeGraph);
+
+    auto pMaterial = StandardMaterial::create(pDevice, "Material");
+    MeshID meshID = pBuilder->addTriangleMesh(TriangleMesh::createQuad(), pMaterial);
+
+    for (uint32_t i = 0; i < kInstanceCount; ++i)
+    {
+        SceneBuilder::Node node;
+        node.name = "instance";
+        node.transform[0][3] = float(i);
+        NodeID nodeID = pBuilder->addNode(node);
+        pBuilder->addMeshInstance(nodeID, meshID);
+    }
+
+    EXPECT_EQ(pBuilder->getNodeCount(), kInstanceCount);
+
+    double bytesPerNode = double(pBuilder->getSceneGraphByteSize()) / kInstanceCount;
+    EXPECT_LE(bytesPerNode, kMaxBytesPerNode);
+}
+
+GPU_TEST(SceneBuilder_AddInstances)
+{
+    auto pDevice = ctx.getDevice();
+    auto pBuilder = SceneBuilder::create(pDevice, Settings(), SceneBuilder::Flags::DontOptimizeGraph);
+
+    auto pMaterial = StandardMaterial::create(pDevice, "Material");
+    MeshID quadID = pBuilder->addTriangleMesh(TriangleMesh::createQuad(), pMaterial);
+    MeshID cubeID = pBuilder->addTriangleMesh(TriangleMesh::createCube(), pMaterial);
+
+    // Prototype with all meshes at the origin uses a single node per instance.
+    SceneBuilder::Prototype prototype;
+    prototype.name = "prototype";
+    prototype.meshes.emplace_back(quadID, rmcv::mat4());
+    prototype.meshes.emplace_back(cubeID, rmcv::mat4());
+    PrototypeID prototypeID = pBuilder->addPrototype(prototype);
+    EXPECT_EQ(pBuilder->getPrototypeCount(), 1);
+
+    std::vector<rmcv::mat4> transforms(3);
+    for (size_t i = 0; i < transforms.size(); ++i)
+        transforms[i][0][3] = float(i);
+
+    auto nodeIDs = pBuilder->addInstances(prototypeID, transforms);
+    ASSERT_EQ(nodeIDs.size(), 3);
+    EXPECT_EQ(pBuilder->getNodeCount(), 3);
+    for (size_t i = 0; i < nodeIDs.size(); ++i)
+        EXPECT_EQ(nodeIDs[i].get(), i);
+
+    // Meshes with distinct transforms get one child node per transform.
+    rmcv::mat4 offset;
+    offset[1][3] = 1.f;
+    SceneBuilder::Prototype offsetPrototype;
+    offsetPrototype.meshes.emplace_back(quadID, rmcv::mat4());
+    offsetPrototype.meshes.emplace_back(cubeID, offset);
+    PrototypeID offsetPrototypeID = pBuilder->addPrototype(offsetPrototype);
+
+    NodeID parentID = pBuilder->addNode(SceneBuilder::Node{ "parent" });
+    nodeIDs = pBuilder->addInstances(offsetPrototypeID, transforms, parentID);
+    ASSERT_EQ(nodeIDs.size(), 3);
+    EXPECT_EQ(pBuilder->getNodeCount(), 4 + 3 * 2);
+    EXPECT_EQ(nodeIDs[0].get(), 4);
+    EXPECT_EQ(nodeIDs[1].get(), 6);
+    EXPECT_EQ(nodeIDs[2].get(), 8);
+
+    // Empty batches are allowed.
+    nodeIDs = pBuilder->addInstances(prototypeID, nullptr, 0);
+    EXPECT(nodeIDs.empty());
+}
+} // namespace Falcor
@@ -0,0 +1,140 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/VertexCompression.h"
+#include <random>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+std::vector<StaticVertexData> createRandomVertices(size_t count, const AABB& bounds, float texCrdScale)
+{
+    std::mt19937 rng;
+    auto dist = std::uniform_real_distribution<float>();
+    auto u = [&]() { return dist(rng); };
+
+    std::vector<StaticVertexData> vertices(count);
+    for (auto& v : vertices)
+    {
+        v.position = bounds.minPoint + float3(u(), u(), u()) * bounds.extent();
+        v.normal = normalize(float3(u(), u(), u()) * 2.f - 1.f);
+        v.tangent = float4(normalize(float3(u(), u(), u()) * 2.f - 1.f), u() < 0.5f ? 1.f : -1.f);
+        v.texCrd = float2(u(), u()) * texCrdScale;
+        v.curveRadius = 0.f;
+    }
+    return vertices;
+}
+} // namespace
+
+CPU_TEST(VertexCompression_RoundTrip)
+{
+    AABB bounds(float3(-10.f, 0.f, 5.f), float3(10.f, 1.f, 5.5f));
+    auto vertices = createRandomVertices(10000, bounds, 1.f);
+
+    for (const auto& v : vertices)
+    {
+        StaticVertexData q = decompressVertex(compressVertex(v, bounds), bounds);
+
+        // Positions are quantized to 16-bit unorms over the bounds.
+        float3 maxPositionError = bounds.extent() / 65535.f * 0.5f + 1e-6f;
+        EXPECT(all(lessThanEqual(abs(q.position - v.position), maxPositionError)));
+
+        EXPECT_GE(dot(q.normal, v.normal), 0.99999f);
+        EXPECT_GE(dot(float3(q.tangent), float3(v.tangent)), 0.99999f);
+        EXPECT_EQ(q.tangent.w, v.tangent.w);
+
+        // fp16 has 11 bits of precision, the texture coordinates are in [0,1).
+        EXPECT(all(lessThanEqual(abs(q.texCrd - v.texCrd), float2(1.f / 4096.f))));
+        EXPECT_EQ(q.curveRadius, 0.f);
+    }
+
+    // Compressing a decompressed vertex gives the same encoding.
+    for (const auto& v : vertices)
+    {
+        CompressedStaticVertexData c = compressVertex(v, bounds);
+        CompressedStaticVertexData c2 = compressVertex(decompressVertex(c, bounds), bounds);
+        EXPECT_EQ(c.position[0], c2.position[0]);
+        EXPECT_EQ(c.position[1], c2.position[1]);
+        EXPECT_EQ(c.position[2], c2.position[2]);
+        EXPECT_EQ(c.texCrd, c2.texCrd);
+        EXPECT_EQ(c.tangentSign, c2.tangentSign);
+    }
+}
+
+CPU_TEST(VertexCompression_InvalidTangent)
+{
+    StaticVertexData v = {};
+    v.position = float3(1.f, 2.f, 3.f);
+    v.normal = float3(0.f, 0.f, -1.f);
+    v.tangent = float4(0.f);
+
+    AABB bounds(v.position);
+    CompressedStaticVertexData c = compressVertex(v, bounds);
+    EXPECT_EQ(c.tangentSign, 0);
+
+    // Degenerate bounds reproduce the position exactly.
+    StaticVertexData q = decompressVertex(c, bounds);
+    EXPECT(q.position == v.position);
+    EXPECT(q.normal == v.normal);
+    EXPECT_EQ(q.tangent.w, 0.f);
+}
+
+CPU_TEST(VertexCompression_Budget)
+{
+    // A 100 unit wide mesh has a position error below 1e-3 units.
+    AABB smallBounds(float3(0.f), float3(100.f));
+    auto smallVertices = createRandomVertices(1000, smallBounds, 1.f);
+    auto smallError = computeQuantizationError(smallVertices, smallBounds);
+    EXPECT_LE(smallError.position, 100.f / 65535.f);
+    EXPECT_LE(smallError.normal, 0.01f);
+    EXPECT_LE(smallError.texCrd, 1.f / 4096.f);
+    EXPECT(smallError.isWithin(VertexQuantizationBudget()));
+
+    // A 10k unit wide mesh does not.
+    AABB largeBounds(float3(0.f), float3(10000.f));
+    auto largeVertices = createRandomVertices(1000, largeBounds, 1.f);
+    auto largeError = computeQuantizationError(largeVertices, largeBounds);
+    EXPECT_GT(largeError.position, VertexQuantizationBudget().maxPositionError);
+    EXPECT(!largeError.isWithin(VertexQuantizationBudget()));
+
+    VertexQuantizationBudget relaxedBudget;
+    relaxedBudget.maxPositionError = 1.f;
+    EXPECT(largeError.isWithin(relaxedBudget));
+
+    // Large texture coordinates lose precision in fp16.
+    auto tiledVertices = createRandomVertices(1000, smallBounds, 1000.f);
+    auto tiledError = computeQuantizationError(tiledVertices, smallBounds);
+    EXPECT_GT(tiledError.texCrd, VertexQuantizationBudget().maxTexCrdError);
+
+    // Texture coordinates outside the fp16 range can't be represented.
+    tiledVertices[0].texCrd = float2(1e6f);
+    EXPECT(std::isinf(computeQuantizationError(tiledVertices, smallBounds).texCrd));
+}
+} // namespace Falcor
@@ -0,0 +1,201 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/Volume/Grid.h"
+#include "Scene/Volume/GridCache.h"
+#include "Scene/Volume/GridConverter.h"
+#include <chrono>
+#include <fstream>
+
+namespace Falcor
+{
+namespace
+{
+/// Redirects the grid cache to a unique temporary directory for the lifetime of the object.
+struct ScopedCacheDirectory
+{
+    std::filesystem::path directory;
+    uint64_t maxSize;
+
+    ScopedCacheDirectory() : directory(getTempFilePath()), maxSize(GridCache::getMaxSize())
+    {
+        std::filesystem::create_directories(directory);
+        GridCache::setDirectory(directory);
+    }
+
+    ~ScopedCacheDirectory()
+    {
+        GridCache::setDirectory({});
+        GridCache::setMaxSize(maxSize);
+        std::error_code ec;
+        std::filesystem::remove_all(directory, ec);
+    }
+};
+
+void writeFile(const std::filesystem::path& path, size_t size, char value)
+{
+    std::ofstream ofs(path, std::ios_base::out | std::ios_base::binary);
+    std::vector<char> data(size, value);
+    ofs.write(data.data(), data.size());
+}
+} // namespace
+
+CPU_TEST(GridCache_Key)
+{
+    const auto path = getTempFilePath();
+    writeFile(path, 1000, 'a');
+
+    const auto key = GridCache::computeKey(path, "density");
+    EXPECT(key == GridCache::computeKey(path, "density"));
+    EXPECT(key != GridCache::computeKey(path, "temperature"));
+
+    // Entries are invalidated when the content of the source file changes, even if the size stays the same.
+    writeFile(path, 1000, 'b');
+    EXPECT(key != GridCache::computeKey(path, "density"));
+
+    std::filesystem::remove(path);
+}
+
+CPU_TEST_SERIAL(GridCache_CorruptFile)
+{
+    ScopedCacheDirectory cacheDirectory;
+    const auto key = Hasher::compute(HashAlgorithm::XXH3_128, "corrupt", 7);
+    const auto cachePath = GridCache::getCachePath(key);
+    EXPECT_EQ(cachePath.parent_path(), cacheDirectory.directory);
+
+    // Missing, empty, truncated and garbage files are rejected before the device is used.
+    EXPECT(GridCache::readCache(nullptr, key) == nullptr);
+    writeFile(cachePath, 0, 0);
+    EXPECT(GridCache::readCache(nullptr, key) == nullptr);
+    writeFile(cachePath, 16, 'x');
+    EXPECT(GridCache::readCache(nullptr, key) == nullptr);
+    writeFile(cachePath, 4096, 'x');
+    EXPECT(GridCache::readCache(nullptr, key) == nullptr);
+}
+
+CPU_TEST_SERIAL(GridCache_Evict)
+{
+    ScopedCacheDirectory cacheDirectory;
+    const auto& dir = cacheDirectory.directory;
+
+    // Create entries with increasing modification times.
+    const auto now = std::filesystem::file_time_type::clock::now();
+    for (int i = 0; i < 4; i++)
+    {
+        const auto path = dir / fmt::format("entry{}", i);
+        writeFile(path, 1000, 'a');
+        std::filesystem::last_write_time(path, now - std::chrono::hours(4 - i));
+    }
+    // Temporary files of concurrent writers are never evicted.
+    writeFile(dir / "entry4.123.tmp", 1000, 'a');
+    std::filesystem::last_write_time(dir / "entry4.123.tmp", now - std::chrono::hours(10));
+
+    GridCache::evict(4000);
+    for (int i = 0; i < 4; i++)
+        EXPECT(std::filesystem::exists(dir / fmt::format("entry{}", i)));
+
+    // The least recently used entries are removed first.
+    GridCache::evict(2500);
+    EXPECT(!std::filesystem::exists(dir / "entry0"));
+    EXPECT(!std::filesystem::exists(dir / "entry1"));
+    EXPECT(std::filesystem::exists(dir / "entry2"));
+    EXPECT(std::filesystem::exists(dir / "entry3"));
+    EXPECT(std::filesystem::exists(dir / "entry4.123.tmp"));
+
+    GridCache::evict(0);
+    EXPECT(!std::filesystem::exists(dir / "entry2"));
+    EXPECT(!std::filesystem::exists(dir / "entry3"));
+}
+
+GPU_TEST(GridCache_RoundTrip)
+{
+    ScopedCacheDirectory cacheDirectory;
+    const auto key = Hasher::compute(HashAlgorithm::XXH3_128, "sphere", 6);
+
+    Grid::SharedPtr pGrid = Grid::createSphere(ctx.getDevice(), 1.f, 0.05f);
+    const auto& handle = pGrid->getGridHandle();
+    NanoVDBConverterBC4 converter(handle.grid<float>());
+    converter.convertToHost();
+    GridCache::writeCache(key, handle, converter.getHostData());
+    ASSERT(std::filesystem::exists(GridCache::getCachePath(key)));
+
+    Grid::SharedPtr pCached = GridCache::readCache(ctx.getDevice(), key);
+    ASSERT(pCached != nullptr);
+    EXPECT_EQ(pCached->getMinValue(), pGrid->getMinValue());
+    EXPECT_EQ(pCached->getMaxValue(), pGrid->getMaxValue());
+    EXPECT_EQ(pCached->getVoxelCount(), pGrid->getVoxelCount());
+    for (int i = -24; i <= 24; i += 3)
+    {
+        const int3 ijk(i, i / 2, -i);
+        EXPECT_EQ(pCached->getValue(ijk), pGrid->getValue(ijk)) << "i = " << i;
+    }
+
+    // An entry whose sections do not match the brick texture sizes is rejected, even if the sections are inside the file.
+    const auto cachePath = GridCache::getCachePath(key);
+    {
+        std::fstream fs(cachePath, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+        const std::streamoff kLeafDimOffset = 16; // After the magic, version and atlas format.
+        uint32_t leafDimX = 0;
+        fs.seekg(kLeafDimOffset);
+        fs.read(reinterpret_cast<char*>(&leafDimX), sizeof(leafDimX));
+        EXPECT_EQ(leafDimX, converter.getHostData().leafDim.x);
+        leafDimX *= 2;
+        fs.seekp(kLeafDimOffset);
+        fs.write(reinterpret_cast<const char*>(&leafDimX), sizeof(leafDimX));
+    }
+    EXPECT(GridCache::readCache(ctx.getDevice(), key) == nullptr);
+
+    // Brick data that does not match the brick texture sizes is not written.
+    BrickedGridData truncatedData = converter.getHostData();
+    truncatedData.atlasSize /= 2;
+    bool thrown = false;
+    try
+    {
+        GridCache::writeCache(key, handle, truncatedData);
+    }
+    catch (const RuntimeError&)
+    {
+        thrown = true;
+    }
+    EXPECT(thrown);
+
+    // A truncated entry is rejected.
+    GridCache::writeCache(key, handle, converter.getHostData());
+    const uint64_t entrySize = std::filesystem::file_size(cachePath);
+    std::filesystem::resize_file(cachePath, std::filesystem::file_size(cachePath) / 2);
+    EXPECT(GridCache::readCache(ctx.getDevice(), key) == nullptr);
+
+    // Writing an entry evicts old entries beyond the size limit, but keeps the new entry.
+    writeFile(cacheDirectory.directory / "old", 1000, 'a');
+    std::filesystem::last_write_time(cacheDirectory.directory / "old", std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+    GridCache::setMaxSize(entrySize);
+    GridCache::writeCache(key, handle, converter.getHostData());
+    EXPECT(!std::filesystem::exists(cacheDirectory.directory / "old"));
+    EXPECT(GridCache::readCache(ctx.getDevice(), key) != nullptr);
+}
+} // namespace Falcor
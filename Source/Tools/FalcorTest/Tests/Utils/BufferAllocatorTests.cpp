@@ -27,9 +27,25 @@
  **************************************************************************/
 #include "Testing/UnitTest.h"
 #include "Utils/BufferAllocator.h"
+#include <vector>
 
 namespace Falcor
 {
+namespace
+{
+/// Mock upload sink recording the uploaded ranges.
+struct UploadRecorder
+{
+    std::vector<BufferAllocator::Range> uploads;
+
+    BufferAllocator::UploadFunc getFunc()
+    {
+        return [this](size_t byteOffset, const uint8_t* pData, size_t byteSize)
+        { uploads.push_back(BufferAllocator::Range(byteOffset, byteOffset + byteSize)); };
+    }
+};
+} // namespace
+
 struct S
 {
     float a;
@@ -317,4 +333,213 @@ GPU_TEST(BufferAllocatorStructAlign)
     }
 }
 
+CPU_TEST(BufferAllocatorDirtyRanges)
+{
+    BufferAllocator buf(0, 0, 0);
+    buf.setDirtyMergeDistance(16);
+    buf.allocate(1024);
+    EXPECT(buf.getDirtyRanges().empty());
+
+    // Edits at opposite ends of the buffer are tracked separately.
+    buf.modified(0, 4);
+    buf.modified(1000, 8);
+    ASSERT_EQ(buf.getDirtyRanges().size(), 2);
+
+    // Ranges within the merge distance are coalesced, including ranges bridged by a new edit.
+    buf.modified(12, 4);
+    buf.modified(500, 4);
+    buf.modified(530, 4);
+    buf.modified(984, 4);
+    {
+        const auto& ranges = buf.getDirtyRanges();
+        ASSERT_EQ(ranges.size(), 4);
+        EXPECT(ranges[0] == BufferAllocator::Range(0, 16));
+        EXPECT(ranges[1] == BufferAllocator::Range(500, 504));
+        EXPECT(ranges[2] == BufferAllocator::Range(530, 534));
+        EXPECT(ranges[3] == BufferAllocator::Range(984, 1008));
+    }
+    buf.modified(510, 10);
+    buf.modified(8, 2);
+    EXPECT_EQ(buf.getDirtyRanges().size(), 3);
+
+    // One upload per range, after which nothing is dirty.
+    UploadRecorder recorder;
+    buf.uploadDirtyRanges(recorder.getFunc());
+    ASSERT_EQ(recorder.uploads.size(), 3);
+    EXPECT(recorder.uploads[0] == BufferAllocator::Range(0, 16));
+    EXPECT(recorder.uploads[1] == BufferAllocator::Range(500, 534));
+    EXPECT(recorder.uploads[2] == BufferAllocator::Range(984, 1008));
+    EXPECT(buf.getDirtyRanges().empty());
+
+    // A large merge distance gives a single range covering all edits.
+    buf.setDirtyMergeDistance(1024);
+    buf.modified(0, 4);
+    buf.modified(1000, 8);
+    ASSERT_EQ(buf.getDirtyRanges().size(), 1);
+    EXPECT(buf.getDirtyRanges()[0] == BufferAllocator::Range(0, 1008));
+}
+
+CPU_TEST(BufferAllocatorFreeReuse)
+{
+    BufferAllocator buf(16, 0, 128);
+    buf.setDirtyMergeDistance(0);
+
+    size_t a = buf.allocate(20);
+    size_t b = buf.allocate(100);
+    size_t c = buf.allocate(4);
+    EXPECT_EQ(a, 0);
+    EXPECT_EQ(b, 128);
+    EXPECT_EQ(c, 240);
+    EXPECT_EQ(buf.getAllocationCount(), 3);
+
+    // Freeing merges the block with the surrounding padding.
+    buf.free(b);
+    EXPECT_EQ(buf.getFreeSize(), 220);
+    EXPECT_EQ(buf.getSize(), 244);
+
+    // Reused blocks follow the alignment and cache line rules.
+    size_t d = buf.allocate(8);
+    EXPECT_EQ(d, 32);
+    size_t e = buf.allocate(100);
+    EXPECT_EQ(e, 128);
+    EXPECT_EQ(buf.getFreeSize(), 212 - 100);
+    EXPECT_EQ(buf.getSize(), 244);
+
+    // Reused memory is cleared and marked dirty.
+    buf.uploadDirtyRanges([](size_t, const uint8_t*, size_t) {});
+    buf.set<uint32_t>(e, 0xdeadbeef);
+    buf.free(e);
+    size_t f = buf.allocate(4);
+    EXPECT_EQ(f, 48);
+    buf.uploadDirtyRanges([](size_t, const uint8_t*, size_t) {});
+    size_t g = buf.allocate(4);
+    EXPECT_EQ(g, 64);
+    g = buf.allocate(64);
+    EXPECT_EQ(g, 128);
+    EXPECT_EQ(*reinterpret_cast<const uint32_t*>(buf.getStartPointer() + g), 0);
+    ASSERT_EQ(buf.getDirtyRanges().size(), 2);
+    EXPECT(buf.getDirtyRanges()[0] == BufferAllocator::Range(64, 68));
+    EXPECT(buf.getDirtyRanges()[1] == BufferAllocator::Range(128, 192));
+
+    // Too large allocations are appended.
+    size_t h = buf.allocate(200);
+    EXPECT_EQ(h, 256);
+    EXPECT_EQ(buf.getSize(), 456);
+
+    // Freeing the last allocation shrinks the buffer, including the freed blocks before it.
+    buf.free(h);
+    EXPECT_EQ(buf.getSize(), 244);
+    buf.free(c);
+    EXPECT_EQ(buf.getSize(), 192);
+    EXPECT_EQ(buf.getFreeSize(), 92);
+
+    buf.clear();
+    EXPECT_EQ(buf.getSize(), 0);
+    EXPECT_EQ(buf.getAllocationCount(), 0);
+    EXPECT_EQ(buf.getFreeSize(), 0);
+}
+
+CPU_TEST(BufferAllocatorAppendAfterShrink)
+{
+    BufferAllocator buf(16, 0, 0);
+    buf.setDirtyMergeDistance(0);
+
+    size_t a = buf.allocate(64);
+    size_t b = buf.allocate(64);
+    EXPECT_EQ(a, 0);
+    EXPECT_EQ(b, 64);
+    buf.set<uint32_t>(b, 0xdeadbeef);
+
+    UploadRecorder recorder;
+    buf.uploadDirtyRanges(recorder.getFunc());
+    ASSERT_EQ(recorder.uploads.size(), 1);
+    EXPECT(recorder.uploads[0] == BufferAllocator::Range(64, 68));
+
+    // Freeing the last allocation shrinks the buffer but the uploaded data is still there.
+    buf.free(b);
+    EXPECT_EQ(buf.getSize(), 64);
+    EXPECT(buf.getDirtyRanges().empty());
+
+    // Appended memory is dirty up to the end of the previously uploaded data.
+    size_t c = buf.allocate(100);
+    EXPECT_EQ(c, 64);
+    EXPECT_EQ(*reinterpret_cast<const uint32_t*>(buf.getStartPointer() + c), 0);
+    ASSERT_EQ(buf.getDirtyRanges().size(), 1);
+    EXPECT(buf.getDirtyRanges()[0] == BufferAllocator::Range(64, 128));
+
+    recorder.uploads.clear();
+    buf.uploadDirtyRanges(recorder.getFunc());
+    ASSERT_EQ(recorder.uploads.size(), 1);
+    EXPECT(recorder.uploads[0] == BufferAllocator::Range(64, 128));
+
+    // Memory beyond the uploaded data is not dirty until modified.
+    buf.allocate(16);
+    EXPECT(buf.getDirtyRanges().empty());
+
+    // The same applies after clearing the buffer.
+    buf.clear();
+    size_t d = buf.allocate(32);
+    EXPECT_EQ(d, 0);
+    ASSERT_EQ(buf.getDirtyRanges().size(), 1);
+    EXPECT(buf.getDirtyRanges()[0] == BufferAllocator::Range(0, 32));
+}
+
+CPU_TEST(BufferAllocatorCompact)
+{
+    BufferAllocator buf(16, 0, 128);
+    buf.setDirtyMergeDistance(0);
+
+    std::vector<size_t> offsets;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        offsets.push_back(buf.allocate(4 + 12 * i));
+        buf.set<uint32_t>(offsets.back(), i);
+    }
+    buf.uploadDirtyRanges([](size_t, const uint8_t*, size_t) {});
+
+    // Free every other allocation.
+    for (uint32_t i = 0; i < 8; i += 2)
+        buf.free(offsets[i]);
+    const size_t sizeBefore = buf.getSize();
+    EXPECT_GT(buf.getFreeSize(), 0);
+
+    auto relocations = buf.compact();
+    ASSERT_EQ(relocations.size(), 4);
+    EXPECT_EQ(buf.getFreeSize(), 0);
+    EXPECT_LT(buf.getSize(), sizeBefore);
+
+    for (size_t j = 0; j < relocations.size(); j++)
+    {
+        const auto& r = relocations[j];
+        const uint32_t i = 2 * (uint32_t)j + 1;
+        EXPECT_EQ(r.oldOffset, offsets[i]);
+        EXPECT_EQ(r.byteSize, 4 + 12 * i);
+        EXPECT_EQ(r.newOffset % 16, 0);
+        EXPECT(r.newOffset / 128 == (r.newOffset + r.byteSize - 1) / 128) << "Allocation spans a cache line";
+        EXPECT_EQ(*reinterpret_cast<const uint32_t*>(buf.getStartPointer() + r.newOffset), i);
+        if (j > 0)
+            EXPECT_GE(r.newOffset, relocations[j - 1].newOffset + relocations[j - 1].byteSize);
+    }
+
+    // Only moved allocations are dirty. Touching allocations are merged into one range.
+    for (const auto& range : buf.getDirtyRanges())
+    {
+        bool foundStart = false;
+        bool foundEnd = false;
+        for (const auto& r : relocations)
+        {
+            if (r.oldOffset == r.newOffset)
+                continue;
+            foundStart |= range.start == r.newOffset;
+            foundEnd |= range.end == r.newOffset + r.byteSize;
+        }
+        EXPECT(foundStart && foundEnd);
+    }
+
+    // The relocated allocations can be freed at their new offsets.
+    for (const auto& r : relocations)
+        buf.free(r.newOffset);
+    EXPECT_EQ(buf.getSize(), 0);
+    EXPECT_EQ(buf.getAllocationCount(), 0);
+}
 } // namespace Falcor
@@ -0,0 +1,225 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/FastHash.h"
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+struct TestVector
+{
+    size_t len;
+    uint64_t hash64;
+    XXH3::Hash128 hash128;
+};
+
+// Reference values computed with XXH3_64bits() and XXH3_128bits() from xxHash 0.8.
+// The lengths cover all code paths of the short, mid-size and long (multi-block) inputs.
+const TestVector kTestVectors[] = {
+    // clang-format off
+    {0, 0x2d06800538d394c2ull, {0x6001c324468d497full, 0x99aa06d3014798d8ull}},
+    {1, 0xc44bdff4074eecdbull, {0xc44bdff4074eecdbull, 0xa6cd5e9392000f6aull}},
+    {3, 0xe14090f554a5ea90ull, {0xe14090f554a5ea90ull, 0x977fcbc0448b49f6ull}},
+    {4, 0x2e8d078a566e9749ull, {0x4ee6926f0426173eull, 0x4e82b36688c5328full}},
+    {8, 0xcd1c7f88482fcaefull, {0x79d85adaeefd615eull, 0x7b4966a681f18d57ull}},
+    {9, 0xbfe43def699fa9e3ull, {0xee5940d4df4715aeull, 0x200d098a7113e15full}},
+    {16, 0x81e9eb8634460bb9ull, {0x37286a19cf622308ull, 0x78e8ab538d3acaabull}},
+    {17, 0x9998430fd0a655beull, {0x33bed349ec1c0ce7ull, 0x1ea709ada2b9c32eull}},
+    {64, 0x22a06b30c4c72936ull, {0xa6e3ffeedc6985ddull, 0x5834551911de3391ull}},
+    {128, 0x75eca5c5d5594884ull, {0xe1f0636051ccd2beull, 0x5ac741c59c95d36aull}},
+    {129, 0xa05da42e7a4e4667ull, {0xcfb3fed667226458ull, 0x1240f4d960139642ull}},
+    {200, 0xe07bfbc15015bf69ull, {0x3572cb319f206ea7ull, 0xddc90e87387183a2ull}},
+    {240, 0x5eb2467c8c9e3969ull, {0xb2e6947c477a4ab0ull, 0x640a6149838a7599ull}},
+    {241, 0x2d431e984c441f15ull, {0x2d431e984c441f15ull, 0xe817e20e53e42a8cull}},
+    {1024, 0xe99def1145f12936ull, {0xe99def1145f12936ull, 0xdf4c8b9ff9715101ull}},
+    {1025, 0x83cba9b371e4e7f4ull, {0x83cba9b371e4e7f4ull, 0x63e845aab7eb695full}},
+    {2500, 0xbb908da56c5e2f4full, {0xbb908da56c5e2f4full, 0x5cff36f04f1008c5ull}},
+    {4999, 0xf977accf80157982ull, {0xf977accf80157982ull, 0xf28a94a3ba04fb2full}},
+    // clang-format on
+};
+
+std::vector<uint8_t> createTestData(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (uint32_t i = 0; i < size; i++)
+        data[i] = (uint8_t)((i * 2654435761u) >> 24);
+    return data;
+}
+
+std::vector<uint8_t> createRandomData(size_t size)
+{
+    std::mt19937 rng(0);
+    std::vector<uint8_t> data(size);
+    for (auto& v : data)
+        v = (uint8_t)rng();
+    return data;
+}
+
+const size_t kBenchmarkSize = 64 << 20;
+} // namespace
+
+CPU_TEST(XXH3_KnownValues)
+{
+    const auto data = createTestData(5000);
+
+    for (const auto& v : kTestVectors)
+    {
+        EXPECT_EQ(XXH3::compute64(data.data(), v.len), v.hash64) << "len = " << v.len;
+        EXPECT(XXH3::compute128(data.data(), v.len) == v.hash128) << "len = " << v.len;
+    }
+
+    EXPECT_EQ(XXH3::toString(XXH3::compute128("abc", 3)), "06b05ab6733a618578af5f94892f3950");
+}
+
+CPU_TEST(XXH3_Streaming)
+{
+    const auto data = createTestData(5000);
+    std::mt19937 rng(1);
+
+    for (const auto& v : kTestVectors)
+    {
+        // Feed the data in random sized chunks, including empty ones.
+        XXH3 xxh3;
+        size_t offset = 0;
+        while (offset < v.len)
+        {
+            size_t size = std::min<size_t>(v.len - offset, rng() % 600);
+            xxh3.update(data.data() + offset, size);
+            offset += size;
+        }
+        EXPECT_EQ(xxh3.finalize64(), v.hash64) << "len = " << v.len;
+        EXPECT(xxh3.finalize128() == v.hash128) << "len = " << v.len;
+    }
+
+    // Byte-wise updates across several blocks.
+    {
+        const auto randomData = createRandomData(3000);
+        XXH3 xxh3;
+        for (size_t i = 0; i < randomData.size(); i++)
+        {
+            xxh3.update(randomData[i]);
+            if (i % 97 == 0)
+                EXPECT(xxh3.finalize128() == XXH3::compute128(randomData.data(), i + 1)) << "len = " << (i + 1);
+        }
+        EXPECT_EQ(xxh3.finalize64(), XXH3::compute64(randomData.data(), randomData.size()));
+    }
+}
+
+CPU_TEST(Hasher_Digest)
+{
+    std::string str{"Hello World!"};
+
+    // SHA1 digests match the SHA1 class.
+    Hasher::Digest sha1 = Hasher::compute(HashAlgorithm::SHA1, str.data(), str.size());
+    EXPECT_EQ(sha1.getSize(), 20u);
+    EXPECT(std::equal(sha1.bytes.begin(), sha1.bytes.end(), SHA1::compute(str.data(), str.size()).begin()));
+    EXPECT_EQ(sha1.toString(), "2ef7bde608ce5404e97d5f042f95f89f1c232871");
+
+    // XXH3 digests are the canonical representation of the 128-bit hash.
+    Hasher::Digest xxh3 = Hasher::compute(HashAlgorithm::XXH3_128, str.data(), str.size());
+    EXPECT_EQ(xxh3.getSize(), 16u);
+    EXPECT_EQ(xxh3.toString(), XXH3::toString(XXH3::compute128(str.data(), str.size())));
+    EXPECT(sha1 != xxh3);
+
+    Hasher hasher(HashAlgorithm::XXH3_128);
+    hasher.update(std::string_view("Hello "));
+    hasher.update(std::string_view("World!"));
+    EXPECT(hasher.finalize() == xxh3);
+}
+
+CPU_TEST(Hasher_File)
+{
+    const auto path = std::filesystem::temp_directory_path() / "FalcorTest_Hasher_File.bin";
+    const auto data = createRandomData(100000);
+
+    for (size_t size : {size_t(0), size_t(100), data.size()})
+    {
+        {
+            std::ofstream ofs(path, std::ios_base::out | std::ios_base::binary);
+            ofs.write(reinterpret_cast<const char*>(data.data()), size);
+        }
+
+        for (auto algorithm : {HashAlgorithm::SHA1, HashAlgorithm::XXH3_128})
+        {
+            auto digest = Hasher::computeFile(algorithm, path);
+            ASSERT(digest.has_value());
+            EXPECT(*digest == Hasher::compute(algorithm, data.data(), size)) << "size = " << size;
+        }
+    }
+
+    std::filesystem::remove(path);
+    EXPECT(!Hasher::computeFile(HashAlgorithm::XXH3_128, path).has_value());
+}
+
+CPU_BENCHMARK(FastHash_SHA1_64MB)
+{
+    const auto data = createRandomData(kBenchmarkSize);
+    SHA1::MD md;
+    ctx.run([&]() { md = SHA1::compute(data.data(), data.size()); });
+    EXPECT(md != SHA1::MD{});
+}
+
+CPU_BENCHMARK(FastHash_XXH3_64_64MB)
+{
+    const auto data = createRandomData(kBenchmarkSize);
+    uint64_t hash = 0;
+    ctx.run([&]() { hash = XXH3::compute64(data.data(), data.size()); });
+    EXPECT_NE(hash, 0);
+}
+
+CPU_BENCHMARK(FastHash_XXH3_128_64MB)
+{
+    const auto data = createRandomData(kBenchmarkSize);
+    XXH3::Hash128 hash;
+    ctx.run([&]() { hash = XXH3::compute128(data.data(), data.size()); });
+    EXPECT(hash != XXH3::Hash128{});
+}
+
+CPU_BENCHMARK(FastHash_XXH3_Streaming_64MB)
+{
+    // Hash in 4 KB chunks, as done when hashing data that is produced incrementally.
+    const auto data = createRandomData(kBenchmarkSize);
+    const size_t kChunkSize = 4096;
+    XXH3::Hash128 hash;
+    ctx.run(
+        [&]()
+        {
+            XXH3 xxh3;
+            for (size_t offset = 0; offset < data.size(); offset += kChunkSize)
+                xxh3.update(data.data() + offset, std::min(kChunkSize, data.size() - offset));
+            hash = xxh3.finalize128();
+        }
+    );
+    EXPECT(hash == XXH3::compute128(data.data(), data.size()));
+}
+} // namespace Falcor
@@ -0,0 +1,254 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Image/AsyncImageWriter.h"
+#include "Utils/Math/Float16.h"
+#include <iterator>
+
+namespace Falcor
+{
+namespace
+{
+std::filesystem::path getTestPath(const std::string& name, uint32_t index, const std::string& ext)
+{
+    return getRuntimeDirectory() / fmt::format("test_async_image_writer_{}_{}.{}", name, index, ext);
+}
+} // namespace
+
+CPU_TEST(AsyncImageWriter_PNG)
+{
+    const uint32_t kImageCount = 16;
+    const uint32_t kWidth = 64;
+    const uint32_t kHeight = 8;
+
+    // Write a set of grayscale ramps through a writer with a small queue to exercise back-pressure.
+    {
+        AsyncImageWriter writer(4, 2);
+        for (uint32_t i = 0; i < kImageCount; i++)
+        {
+            std::vector<uint8_t> data(kWidth * kHeight * 4);
+            for (uint32_t p = 0; p < kWidth * kHeight; p++)
+            {
+                uint8_t v = (uint8_t)(i * 8 + (p % kWidth));
+                data[4 * p + 0] = data[4 * p + 1] = data[4 * p + 2] = v;
+                data[4 * p + 3] = 255;
+            }
+            auto pBitmap = Bitmap::create(kWidth, kHeight, ResourceFormat::RGBA8Unorm, data.data());
+            writer.write(getTestPath("png", i, "png"), std::move(pBitmap), Bitmap::FileFormat::PngFile);
+        }
+
+        writer.flush();
+        EXPECT_EQ(writer.getPendingCount(), 0);
+
+        auto stats = writer.getStats();
+        EXPECT_EQ(stats.imagesWritten, kImageCount);
+        EXPECT_EQ(stats.imagesFailed, 0);
+        EXPECT_EQ(stats.bytesWritten, (uint64_t)kImageCount * kWidth * kHeight * 4);
+    }
+
+    // Load the images and validate the content.
+    for (uint32_t i = 0; i < kImageCount; i++)
+    {
+        const auto path = getTestPath("png", i, "png");
+        auto bmp = Bitmap::createFromFile(path, true /* top-down */);
+        EXPECT(bmp != nullptr);
+
+        if (bmp)
+        {
+            EXPECT_EQ(bmp->getWidth(), kWidth);
+            EXPECT_EQ(bmp->getHeight(), kHeight);
+            EXPECT_EQ(bmp->getSize(), kWidth * kHeight * 4);
+
+            const uint8_t* data = bmp->getData();
+            if (data && bmp->getSize() == kWidth * kHeight * 4)
+            {
+                for (uint32_t p = 0; p < kWidth * kHeight; p++)
+                {
+                    uint8_t v = (uint8_t)(i * 8 + (p % kWidth));
+                    EXPECT_EQ(data[4 * p + 0], v);
+                    EXPECT_EQ(data[4 * p + 1], v);
+                    EXPECT_EQ(data[4 * p + 2], v);
+                }
+            }
+        }
+
+        std::filesystem::remove(path);
+    }
+}
+
+CPU_TEST(AsyncImageWriter_SmallFloatFormats)
+{
+    const uint32_t kWidth = 16;
+    const uint32_t kHeight = 4;
+    const uint32_t kPixelCount = kWidth * kHeight;
+
+    // Float images with one or two channels are expanded to RGBA on the worker thread.
+    // All bit depths behave the same: one channel is replicated to gray, two channels are written as red/green.
+    const ResourceFormat kFormats[] = {ResourceFormat::R32Float, ResourceFormat::R16Float, ResourceFormat::RG32Float, ResourceFormat::RG16Float};
+
+    for (uint32_t f = 0; f < std::size(kFormats); f++)
+    {
+        const ResourceFormat format = kFormats[f];
+        const uint32_t channelCount = getFormatChannelCount(format);
+        const bool isHalf = getNumChannelBits(format, 0) == 16;
+        const auto path = getTestPath("float", f, "exr");
+
+        // Values are exactly representable in fp16.
+        std::vector<float> values(kPixelCount * channelCount);
+        for (uint32_t i = 0; i < values.size(); i++)
+            values[i] = 0.25f * i;
+
+        std::vector<uint8_t> data(values.size() * (isHalf ? 2 : 4));
+        for (uint32_t i = 0; i < values.size(); i++)
+        {
+            if (isHalf)
+                reinterpret_cast<float16_t*>(data.data())[i] = float16_t(values[i]);
+            else
+                reinterpret_cast<float*>(data.data())[i] = values[i];
+        }
+
+        {
+            AsyncImageWriter writer;
+            auto pBitmap = Bitmap::create(kWidth, kHeight, format, data.data());
+            writer.write(path, std::move(pBitmap), Bitmap::FileFormat::ExrFile, Bitmap::ExportFlags::Uncompressed);
+            writer.flush();
+            EXPECT_EQ(writer.getStats().imagesWritten, 1) << to_string(format);
+            // Destructor flushes the queue.
+        }
+
+        auto bmp = Bitmap::createFromFile(path, true /* top-down */);
+        EXPECT(bmp != nullptr) << to_string(format);
+
+        if (bmp)
+        {
+            EXPECT_EQ(bmp->getWidth(), kWidth);
+            EXPECT_EQ(bmp->getHeight(), kHeight);
+
+            const uint32_t channels = getFormatChannelCount(bmp->getFormat());
+            EXPECT(channels == 3 || channels == 4);
+            EXPECT_EQ(bmp->getSize(), kPixelCount * channels * sizeof(float));
+
+            const float* pixels = reinterpret_cast<const float*>(bmp->getData());
+            if (pixels && bmp->getSize() == kPixelCount * channels * sizeof(float))
+            {
+                for (uint32_t p = 0; p < kPixelCount; p++)
+                {
+                    const float* v = &values[p * channelCount];
+                    const float expected[3] = {v[0], channelCount == 1 ? v[0] : v[1], channelCount == 1 ? v[0] : 0.f};
+                    for (uint32_t c = 0; c < 3; c++)
+                        EXPECT_EQ(pixels[channels * p + c], expected[c]) << to_string(format) << " p = " << p << " c = " << c;
+                }
+            }
+        }
+
+        std::filesystem::remove(path);
+    }
+}
+
+GPU_TEST(AsyncImageWriter_Readback)
+{
+    Device* pDevice = ctx.getDevice().get();
+
+    const uint32_t kImageCount = 8;
+    const uint32_t kWidth = 32;
+    const uint32_t kHeight = 16;
+
+    // Texture readbacks are completed and released on this thread, the workers only see the CPU data.
+    {
+        AsyncImageWriter writer(2, 4);
+        for (uint32_t i = 0; i < kImageCount; i++)
+        {
+            std::vector<uint8_t> data(kWidth * kHeight * 4);
+            for (uint32_t p = 0; p < kWidth * kHeight; p++)
+            {
+                data[4 * p + 0] = (uint8_t)(p % kWidth);
+                data[4 * p + 1] = (uint8_t)(p / kWidth);
+                data[4 * p + 2] = (uint8_t)i;
+                data[4 * p + 3] = 255;
+            }
+            auto pTex = Texture::create2D(pDevice, kWidth, kHeight, ResourceFormat::RGBA8Unorm, 1, 1, data.data(), ResourceBindFlags::ShaderResource);
+            auto pReadTask = ctx.getRenderContext()->asyncReadTextureSubresource(pTex.get(), 0);
+            writer.write(getTestPath("readback", i, "png"), pReadTask, kWidth, kHeight, pTex->getFormat(), Bitmap::FileFormat::PngFile);
+            writer.processReadbacks();
+        }
+
+        writer.flush();
+        EXPECT_EQ(writer.getPendingCount(), 0);
+        EXPECT_EQ(writer.getStats().imagesWritten, kImageCount);
+        EXPECT_EQ(writer.getStats().imagesFailed, 0);
+    }
+
+    for (uint32_t i = 0; i < kImageCount; i++)
+    {
+        const auto path = getTestPath("readback", i, "png");
+        auto bmp = Bitmap::createFromFile(path, true /* top-down */);
+        EXPECT(bmp != nullptr);
+
+        if (bmp && bmp->getSize() == kWidth * kHeight * 4)
+        {
+            const uint8_t* data = bmp->getData();
+            for (uint32_t p = 0; p < kWidth * kHeight; p++)
+            {
+                EXPECT_EQ(data[4 * p + 0], p % kWidth);
+                EXPECT_EQ(data[4 * p + 1], p / kWidth);
+                EXPECT_EQ(data[4 * p + 2], i);
+            }
+        }
+
+        std::filesystem::remove(path);
+    }
+}
+
+CPU_TEST(AsyncImageWriter_Failure)
+{
+    // Writing to a directory that doesn't exist fails on the worker thread and is counted.
+    const auto path = getRuntimeDirectory() / "test_async_image_writer_missing_dir" / "image.png";
+    std::filesystem::remove_all(path.parent_path());
+
+    AsyncImageWriter writer(1);
+    std::vector<uint8_t> data(4 * 4 * 4, 255);
+    writer.write(path, Bitmap::create(4, 4, ResourceFormat::RGBA8Unorm, data.data()), Bitmap::FileFormat::PngFile);
+
+    // PFM doesn't support alpha. This is rejected by the encoder and counted as well.
+    std::vector<float> floatData(4 * 4 * 4, 1.f);
+    const auto pfmPath = getTestPath("failure", 0, "pfm");
+    writer.write(
+        pfmPath,
+        Bitmap::create(4, 4, ResourceFormat::RGBA32Float, reinterpret_cast<const uint8_t*>(floatData.data())),
+        Bitmap::FileFormat::PfmFile,
+        Bitmap::ExportFlags::ExportAlpha
+    );
+    writer.flush();
+
+    auto stats = writer.getStats();
+    EXPECT_EQ(stats.imagesWritten, 0);
+    EXPECT_EQ(stats.imagesFailed, 2);
+    EXPECT(!std::filesystem::exists(path));
+    EXPECT(!std::filesystem::exists(pfmPath));
+}
+} // namespace Falcor
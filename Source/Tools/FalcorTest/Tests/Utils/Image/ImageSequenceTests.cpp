@@ -0,0 +1,163 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Image/ImageSequence.h"
+#include <fstream>
+
+namespace Falcor
+{
+namespace
+{
+/// Creates a unique temporary directory for the lifetime of the object.
+struct ScopedTempDirectory
+{
+    std::filesystem::path directory;
+
+    ScopedTempDirectory() : directory(getTempFilePath()) { std::filesystem::create_directories(directory); }
+
+    ~ScopedTempDirectory()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(directory, ec);
+    }
+};
+
+void touchFile(const std::filesystem::path& path)
+{
+    std::ofstream ofs(path, std::ios_base::out | std::ios_base::binary);
+    ofs << "not an image";
+}
+
+/// Write a small image whose pixels are all set to 'value'.
+void writeFrame(const std::filesystem::path& path, uint8_t value)
+{
+    const uint32_t kSize = 4;
+    std::vector<uint8_t> data(kSize * kSize * 4, value);
+    Bitmap::saveImageOrThrow(
+        path, kSize, kSize, Bitmap::FileFormat::PngFile, Bitmap::ExportFlags::None, ResourceFormat::RGBA8Unorm, true, data.data()
+    );
+}
+} // namespace
+
+CPU_TEST(ImageSequence_FindFrames)
+{
+    ScopedTempDirectory temp;
+
+    EXPECT(ImageSequence::isPattern("frame_####.png"));
+    EXPECT(!ImageSequence::isPattern("frame_0001.png"));
+    EXPECT(!ImageSequence::isPattern("##/frame.png"));
+
+    // Matching frames, including a frame number wider than the padding.
+    for (const char* name : {"frame_0010.png", "frame_0002.png", "frame_12345.png", "frame_0001.png"})
+        touchFile(temp.directory / name);
+    // Files that must be ignored: padded wider than the pattern, not a number, out of range, wrong prefix or suffix.
+    for (const char* name :
+         {"frame_01234.png", "frame_00a1.png", "frame_+001.png", "frame_99999999999999999999999.png", "other_0003.png", "frame_0003.exr",
+          "frame_001.png"})
+        touchFile(temp.directory / name);
+    std::filesystem::create_directories(temp.directory / "frame_0004.png");
+
+    auto frames = ImageSequence::findFrames(temp.directory / "frame_####.png");
+    ASSERT_EQ(frames.size(), 4);
+    EXPECT_EQ(frames[0].filename(), "frame_0001.png");
+    EXPECT_EQ(frames[1].filename(), "frame_0002.png");
+    EXPECT_EQ(frames[2].filename(), "frame_0010.png");
+    EXPECT_EQ(frames[3].filename(), "frame_12345.png");
+
+    EXPECT(ImageSequence::findFrames(temp.directory / "frame.png").empty());
+    EXPECT(ImageSequence::findFrames(temp.directory / "missing" / "frame_####.png").empty());
+}
+
+CPU_TEST(ImageSequence_Eviction)
+{
+    ScopedTempDirectory temp;
+
+    const uint32_t kFrameCount = 6;
+    std::vector<std::filesystem::path> paths;
+    for (uint32_t i = 0; i < kFrameCount; ++i)
+    {
+        paths.push_back(temp.directory / fmt::format("frame_{}.png", i));
+        writeFrame(paths.back(), (uint8_t)(i * 10));
+    }
+
+    // Determine the size of a decoded frame.
+    size_t frameSize = 0;
+    {
+        ImageSequence sequence(paths, 1, ~size_t(0), 1);
+        auto pFrame = sequence.getFrame(0, true);
+        ASSERT(pFrame != nullptr);
+        frameSize = pFrame->getSize();
+        EXPECT_EQ(pFrame->getData()[0], 0);
+    }
+
+    // Without prefetching, frames are decoded only when requested, which makes the cache content deterministic.
+    ImageSequence sequence(paths, 1, 2 * frameSize, 1);
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        auto pFrame = sequence.getFrame(i, true);
+        ASSERT(pFrame != nullptr);
+        EXPECT_EQ(pFrame->getData()[0], i * 10);
+        EXPECT_LE(sequence.getCachedBytes(), 2 * frameSize);
+    }
+
+    // Playback loops, so after frame 2 the frame needed furthest in the future is frame 1.
+    EXPECT(sequence.isFrameCached(0));
+    EXPECT(!sequence.isFrameCached(1));
+    EXPECT(sequence.isFrameCached(2));
+
+    // Shrinking the cache evicts down to the requested frame.
+    sequence.setCacheLimits(1, frameSize);
+    EXPECT_EQ(sequence.getCachedBytes(), frameSize);
+    EXPECT(!sequence.isFrameCached(0));
+    EXPECT(sequence.isFrameCached(2));
+}
+
+CPU_TEST(ImageSequence_FailedFrame)
+{
+    ScopedTempDirectory temp;
+
+    std::vector<std::filesystem::path> paths = {temp.directory / "frame_0.png", temp.directory / "frame_1.png", temp.directory / "frame_2.png"};
+    writeFrame(paths[0], 0);
+    touchFile(paths[1]);
+    writeFrame(paths[2], 20);
+
+    ImageSequence sequence(paths, 3, ~size_t(0), 2);
+
+    ImageSequence::FrameState state;
+    EXPECT(sequence.getFrame(0, true, &state) != nullptr);
+    EXPECT(state == ImageSequence::FrameState::Ready);
+
+    // A frame that fails to load is reported as failed and doesn't hold up the following frames.
+    EXPECT(sequence.getFrame(1, true, &state) == nullptr);
+    EXPECT(state == ImageSequence::FrameState::Failed);
+    EXPECT(!sequence.isFrameCached(1));
+
+    EXPECT(sequence.getFrame(2, true, &state) != nullptr);
+    EXPECT(state == ImageSequence::FrameState::Ready);
+}
+} // namespace Falcor
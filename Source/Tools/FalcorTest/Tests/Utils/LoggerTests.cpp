@@ -0,0 +1,155 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Logger.h"
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace Falcor
+{
+namespace
+{
+/// Routes log messages to the log file for the duration of a test and restores the logger state afterwards.
+/// Tests using this must be serial, as the logger state is global.
+class ScopedFileLogging
+{
+public:
+    ScopedFileLogging() : mOutputs(Logger::getOutputs()), mVerbosity(Logger::getVerbosity())
+    {
+        Logger::setOutputs(Logger::OutputFlags::File);
+        Logger::setVerbosity(Logger::Level::Info);
+    }
+
+    ~ScopedFileLogging()
+    {
+        Logger::setOutputs(mOutputs);
+        Logger::setVerbosity(mVerbosity);
+    }
+
+private:
+    Logger::OutputFlags mOutputs;
+    Logger::Level mVerbosity;
+};
+
+std::string readLogFile()
+{
+    std::ifstream ifs(Logger::getLogFilePath(), std::ios::binary);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+size_t countOccurrences(const std::string& text, const std::string& pattern)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size()))
+        count++;
+    return count;
+}
+} // namespace
+
+CPU_TEST_SERIAL(Logger_AsyncOrder)
+{
+    ScopedFileLogging scopedLogging;
+
+    const uint32_t kThreadCount = 4;
+    const uint32_t kMessageCount = 200;
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t)
+    {
+        threads.emplace_back(
+            [t]()
+            {
+                for (uint32_t i = 0; i < kMessageCount; ++i)
+                    logInfo("Logger_AsyncOrder thread {} message {}.", t, i);
+            }
+        );
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    // All messages must be written after flush(), and the messages of each thread must be in submission order.
+    Logger::flush();
+    std::string text = readLogFile();
+    for (uint32_t t = 0; t < kThreadCount; ++t)
+    {
+        size_t prevPos = 0;
+        for (uint32_t i = 0; i < kMessageCount; ++i)
+        {
+            size_t pos = text.find(fmt::format("Logger_AsyncOrder thread {} message {}.", t, i));
+            ASSERT_NE(pos, std::string::npos) << "thread " << t << " message " << i;
+            EXPECT_GE(pos, prevPos) << "thread " << t << " message " << i;
+            prevPos = pos;
+        }
+    }
+}
+
+CPU_TEST_SERIAL(Logger_RateLimit)
+{
+    ScopedFileLogging scopedLogging;
+
+    // All calls share the same format string and are therefore rate limited as one call site.
+    const uint32_t kMessageCount = 25;
+    for (uint32_t i = 0; i < kMessageCount; ++i)
+        logWarning("Logger_RateLimit message {}.", i);
+
+    Logger::flush();
+    std::string text = readLogFile();
+    EXPECT_EQ(countOccurrences(text, "(Warning) Logger_RateLimit message "), 10);
+    EXPECT_NE(text.find("Logger_RateLimit message 9."), std::string::npos);
+    EXPECT_EQ(text.find("Logger_RateLimit message 10."), std::string::npos);
+    EXPECT_EQ(countOccurrences(text, "15 similar messages suppressed: \"Logger_RateLimit message {}.\""), 1);
+
+    // flush() starts a new window.
+    logWarning("Logger_RateLimit message {}.", kMessageCount);
+    Logger::flush();
+    EXPECT_NE(readLogFile().find(fmt::format("Logger_RateLimit message {}.", kMessageCount)), std::string::npos);
+}
+
+CPU_TEST_SERIAL(Logger_FlushOnShutdown)
+{
+    ScopedFileLogging scopedLogging;
+
+    // Note: After shutdown the logger writes synchronously. This doesn't affect other tests beyond that.
+    logInfo("Logger_FlushOnShutdown before shutdown.");
+    Logger::shutdown();
+    EXPECT_NE(readLogFile().find("Logger_FlushOnShutdown before shutdown."), std::string::npos);
+
+    // Messages logged after shutdown are appended to the log file without discarding earlier messages.
+    logInfo("Logger_FlushOnShutdown after shutdown.");
+    std::string text = readLogFile();
+    EXPECT_NE(text.find("Logger_FlushOnShutdown before shutdown."), std::string::npos);
+    EXPECT_NE(text.find("Logger_FlushOnShutdown after shutdown."), std::string::npos);
+
+    // The path can't be changed once the log file has been created.
+    EXPECT(!Logger::setLogFilePath("Logger_FlushOnShutdown.log"));
+}
+} // namespace Falcor
@@ -62,7 +62,7 @@ FALCOR_SCRIPT_BINDING(Settings_UnitTestHarness)
 
 } // namespace
 
-CPU_TEST(Settings_PythonBinding)
+CPU_TEST_SERIAL(Settings_PythonBinding)
 {
     Settings_UnitTestHarness harness;
 
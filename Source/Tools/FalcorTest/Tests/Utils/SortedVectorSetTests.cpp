@@ -0,0 +1,117 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Algorithm/SortedVectorSet.h"
+
+#include <random>
+#include <set>
+#include <unordered_map>
+
+namespace Falcor
+{
+CPU_TEST(SortedVectorSet_Insert)
+{
+    SortedVectorSet<uint32_t> set;
+    EXPECT(set.empty());
+
+    EXPECT(set.insert(5));
+    EXPECT(set.insert(1));
+    EXPECT(set.insert(9));
+    EXPECT(!set.insert(5));
+    EXPECT(set.insert(3));
+
+    std::vector<uint32_t> expected = {1, 3, 5, 9};
+    EXPECT(set.getValues() == expected);
+    EXPECT_EQ(set.size(), 4);
+    EXPECT_EQ(set.front(), 1);
+    EXPECT_EQ(set.back(), 9);
+
+    EXPECT(set.contains(3));
+    EXPECT(!set.contains(4));
+    EXPECT(set.find(4) == set.end());
+    EXPECT_EQ(*set.find(9), 9);
+
+    EXPECT_EQ(set.erase(3), 1);
+    EXPECT_EQ(set.erase(3), 0);
+    EXPECT_EQ(set.size(), 3);
+
+    set.clear();
+    EXPECT(set.empty());
+}
+
+CPU_TEST(SortedVectorSet_MatchesStdSet)
+{
+    std::mt19937 rng;
+    std::uniform_int_distribution<uint32_t> dist(0, 1000);
+
+    SortedVectorSet<uint32_t> set;
+    std::set<uint32_t> ref;
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        uint32_t v = dist(rng);
+        if (i % 3 == 0)
+        {
+            EXPECT_EQ(set.erase(v), ref.erase(v));
+        }
+        else
+        {
+            EXPECT_EQ(set.insert(v), ref.insert(v).second);
+        }
+    }
+
+    ASSERT_EQ(set.size(), ref.size());
+    EXPECT(std::equal(set.begin(), set.end(), ref.begin()));
+}
+
+CPU_TEST(SortedVectorSet_Hash)
+{
+    SortedVectorSet<uint32_t> a = {1, 2, 3};
+    SortedVectorSet<uint32_t> b = {3, 1, 2};
+    SortedVectorSet<uint32_t> c = {1, 2, 4};
+
+    EXPECT(a == b);
+    EXPECT(a != c);
+    EXPECT(a < c);
+    EXPECT_EQ(a.getHash(), b.getHash());
+    EXPECT_NE(a.getHash(), c.getHash());
+
+    // The cached hash must be invalidated on modification.
+    size_t hash = a.getHash();
+    a.insert(4);
+    EXPECT_NE(a.getHash(), hash);
+    a.erase(3);
+    EXPECT(a == c);
+    EXPECT_EQ(a.getHash(), c.getHash());
+
+    std::unordered_map<SortedVectorSet<uint32_t>, int> map;
+    map[a] = 1;
+    map[b] = 2;
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map[c], 1);
+}
+} // namespace Falcor
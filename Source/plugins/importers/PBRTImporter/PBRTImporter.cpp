@@ -72,6 +72,7 @@
 #include "Utils/Timing/TimeReport.h"
 #include "Utils/Math/FalcorMath.h"
 #include "Utils/Math/FNVHash.h"
+#include "Utils/NumericRange.h"
 #include "Scene/Importer.h"
 #include "Scene/Material/Material.h"
 #include "Scene/Material/StandardMaterial.h"
@@ -85,6 +86,10 @@
 #include "Scene/Material/PBRT/PBRTDiffuseTransmissionMaterial.h"
 #include "Scene/Curves/CurveTessellation.h"
 
+#include <algorithm>
+#include <exception>
+#include <execution>
+#include <optional>
 #include <unordered_map>
 
 namespace Falcor
@@ -196,10 +201,34 @@ struct CurveAggregate
     std::vector<float> widths;     ///< Concatenated list of widths of all strands.
 };
 
+/**
+ * List of curve aggregates in order of creation.
+ */
+struct CurveAggregateList
+{
+    std::unordered_map<CurveAggregate::Key, size_t, CurveAggregate::KeyHash> indices;
+    std::vector<CurveAggregate> aggregates;
+};
+
+/**
+ * Shape to be created by createShapes().
+ */
+struct ShapeTask
+{
+    const ShapeSceneEntity* pEntity = nullptr;
+    CurveAggregateList* pCurveAggregates = nullptr; ///< Curve aggregates to append curve shapes to.
+    size_t group = 0;                               ///< Caller defined group index.
+};
+
+/**
+ * Instance definition (object) and the transforms of all its instances.
+ */
 struct InstanceDefinition
 {
-    std::vector<std::pair<MeshID, rmcv::mat4>> meshes;  // List of meshID + transform
-    std::vector<std::pair<CurveID, rmcv::mat4>> curves; // List of curveID + transfrom
+    const InstanceDefinitionSceneEntity* pEntity = nullptr;
+    SceneBuilder::Prototype prototype;
+    CurveAggregateList curveAggregates;
+    std::vector<rmcv::mat4> instanceTransforms;
 };
 
 struct BuilderContext
@@ -217,10 +246,6 @@ struct BuilderContext
 
     Falcor::Material::SharedPtr pDefaultMaterial;
 
-    std::unordered_map<CurveAggregate::Key, CurveAggregate, CurveAggregate::KeyHash> curveAggregates;
-
-    std::map<std::string, InstanceDefinition> instanceDefinitions;
-
     size_t curveCount = 0;
 
     bool usePBRTMaterials = false;
@@ -1393,7 +1418,12 @@ void createAreaLight(BuilderContext& ctx, const SceneEntity& entity, const Falco
     }
 }
 
-Shape createShape(BuilderContext& ctx, const ShapeSceneEntity& entity)
+/**
+ * Create the geometry of a shape.
+ * This does not modify the builder context and is safe to call from multiple threads.
+ * Curve shapes are aggregated separately by appendCurve().
+ */
+Shape createShapeGeometry(const BuilderContext& ctx, const ShapeSceneEntity& entity)
 {
     auto warnUnsupported = [&]() { warnUnsupportedType(entity.loc, "Shape", entity.name); };
 
@@ -1444,52 +1474,7 @@ Shape createShape(BuilderContext& ctx, const ShapeSceneEntity& entity)
     }
     else if (type == "curve")
     {
-        // Parameters:
-        // Float width, Float width0, Float width1, Int degree, String basis,
-        // Point3[] P, String type, Normal3[] N, Int splitdepth
-        warnUnsupportedParameters(params, {"degree", "N"});
-
-        auto splitdepth = params.getInt("splitdepth", 1);
-
-        auto width = params.getFloat("width", 1.f);
-        auto width0 = params.getFloat("width0", width);
-        auto width1 = params.getFloat("width1", width);
-
-        auto basis = params.getString("basis", "bezier");
-        if (basis != "bspline")
-            logWarning(entity.loc, "Basis '{}' is not supported. Using 'bspline' basis instead.", basis);
-
-        auto type = params.getString("type", "flat");
-        if (type != "cylinder")
-            logWarning(entity.loc, "Curve type '{}' is not supported. Using 'cylinder' type instead.", type);
-
-        auto P = params.getPoint3Array("P");
-
-        // Create or get existing curve aggregate.
-        auto pMaterial = ctx.getMaterial(entity.materialRef);
-        CurveAggregate::Key key{entity.transform, pMaterial.get()};
-        auto it = ctx.curveAggregates.find(key);
-        if (it == ctx.curveAggregates.end())
-        {
-            it = ctx.curveAggregates.emplace(key, CurveAggregate{}).first;
-            it->second.transform = entity.transform;
-            it->second.pMaterial = pMaterial;
-            it->second.splitDepth = splitdepth;
-        }
-        CurveAggregate& aggregate = it->second;
-
-        // Append curve to aggregate.
-        size_t pointCount = P.size();
-        size_t offset = aggregate.points.size();
-        aggregate.strands.push_back(pointCount);
-        aggregate.points.resize(aggregate.points.size() + pointCount);
-        aggregate.widths.resize(aggregate.widths.size() + pointCount);
-        for (size_t i = 0; i < pointCount; ++i)
-        {
-            float t = float(i) / pointCount;
-            aggregate.points[offset + i] = P[i];
-            aggregate.widths[offset + i] = lerp(width0, width1, t);
-        }
+        // Curves are aggregated in appendCurve().
     }
     else if (type == "trianglemesh")
     {
@@ -1617,8 +1602,72 @@ Shape createShape(BuilderContext& ctx, const ShapeSceneEntity& entity)
     if (entity.reverseOrientation && shape.pTriangleMesh)
         shape.pTriangleMesh->setFrontFaceCW(!shape.pTriangleMesh->getFrontFaceCW());
 
+    return shape;
+}
+
+/**
+ * Append a curve shape to the curve aggregate with matching transform and material.
+ */
+void appendCurve(BuilderContext& ctx, CurveAggregateList& curveAggregates, const ShapeSceneEntity& entity)
+{
+    const auto& params = entity.params;
+
+    // Parameters:
+    // Float width, Float width0, Float width1, Int degree, String basis,
+    // Point3[] P, String type, Normal3[] N, Int splitdepth
+    warnUnsupportedParameters(params, {"degree", "N"});
+
+    auto splitdepth = params.getInt("splitdepth", 1);
+
+    auto width = params.getFloat("width", 1.f);
+    auto width0 = params.getFloat("width0", width);
+    auto width1 = params.getFloat("width1", width);
+
+    auto basis = params.getString("basis", "bezier");
+    if (basis != "bspline")
+        logWarning(entity.loc, "Basis '{}' is not supported. Using 'bspline' basis instead.", basis);
+
+    auto type = params.getString("type", "flat");
+    if (type != "cylinder")
+        logWarning(entity.loc, "Curve type '{}' is not supported. Using 'cylinder' type instead.", type);
+
+    auto P = params.getPoint3Array("P");
+
+    // Create or get existing curve aggregate.
+    auto pMaterial = ctx.getMaterial(entity.materialRef);
+    CurveAggregate::Key key{entity.transform, pMaterial.get()};
+    auto it = curveAggregates.indices.find(key);
+    if (it == curveAggregates.indices.end())
+    {
+        it = curveAggregates.indices.emplace(key, curveAggregates.aggregates.size()).first;
+        auto& newAggregate = curveAggregates.aggregates.emplace_back();
+        newAggregate.transform = entity.transform;
+        newAggregate.pMaterial = pMaterial;
+        newAggregate.splitDepth = splitdepth;
+    }
+    CurveAggregate& aggregate = curveAggregates.aggregates[it->second];
+
+    // Append curve to aggregate.
+    size_t pointCount = P.size();
+    size_t offset = aggregate.points.size();
+    aggregate.strands.push_back(pointCount);
+    aggregate.points.resize(aggregate.points.size() + pointCount);
+    aggregate.widths.resize(aggregate.widths.size() + pointCount);
+    for (size_t i = 0; i < pointCount; ++i)
+    {
+        float t = float(i) / pointCount;
+        aggregate.points[offset + i] = P[i];
+        aggregate.widths[offset + i] = lerp(width0, width1, t);
+    }
+}
+
+/**
+ * Get the material of a shape and create its area light, if any.
+ */
+Falcor::Material::SharedPtr createShapeMaterial(BuilderContext& ctx, const ShapeSceneEntity& entity)
+{
     // Get the material.
-    shape.pMaterial = ctx.getMaterial(entity.materialRef);
+    auto pMaterial = ctx.getMaterial(entity.materialRef);
 
     // Create area light.
     if (entity.lightIndex != -1)
@@ -1628,21 +1677,21 @@ Shape createShape(BuilderContext& ctx, const ShapeSceneEntity& entity)
         // Create a new material as we may already use it for other shapes with no area light attached to it.
         if (!std::holds_alternative<std::monostate>(entity.materialRef))
         {
-            shape.pMaterial = createMaterial(ctx, ctx.scene.getMaterial(entity.materialRef), true);
-            shape.pMaterial->setName(shape.pMaterial->getName() + "_" + nameSuffix);
+            pMaterial = createMaterial(ctx, ctx.scene.getMaterial(entity.materialRef), true);
+            pMaterial->setName(pMaterial->getName() + "_" + nameSuffix);
         }
         else
         {
             auto pStandardMaterial = Falcor::StandardMaterial::create(ctx.builder.getDevice(), nameSuffix);
             pStandardMaterial->setBaseColor(float4(0.f, 0.f, 0.f, 1.f));
             pStandardMaterial->setRoughness(0.f);
-            shape.pMaterial = pStandardMaterial;
+            pMaterial = pStandardMaterial;
         }
         const SceneEntity& areaLightEntity = ctx.scene.getAreaLight(entity.lightIndex);
-        createAreaLight(ctx, areaLightEntity, shape.pMaterial);
+        createAreaLight(ctx, areaLightEntity, pMaterial);
     }
 
-    return shape;
+    return pMaterial;
 }
 
 /**
@@ -1715,41 +1764,110 @@ std::variant<Falcor::MeshID, Falcor::CurveID> createCurveGeometry(BuilderContext
     }
 }
 
-InstanceDefinition createInstanceDefinition(BuilderContext& ctx, const InstanceDefinitionSceneEntity& entity)
+/**
+ * Run a function for each index in [0, count) in parallel.
+ * Exceptions are rethrown on the calling thread. The exception of the lowest index is rethrown so that error reporting is deterministic.
+ */
+template<typename Func>
+void parallelFor(size_t count, Func func)
 {
-    InstanceDefinition instanceDefinition;
+    std::vector<std::exception_ptr> exceptions(count);
+    auto range = NumericRange<size_t>(0, count);
+    std::for_each(
+        std::execution::par, range.begin(), range.end(),
+        [&](size_t i)
+        {
+            try
+            {
+                func(i);
+            }
+            catch (...)
+            {
+                exceptions[i] = std::current_exception();
+            }
+        }
+    );
+    for (const auto& exception : exceptions)
+    {
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+}
 
-    for (const auto& shapeEntity : entity.shapes)
+/**
+ * Create the geometry of all curve aggregates.
+ * Depending on the tessellation mode, addMesh(meshID, transform) or addCurve(curveID, transform) is called for each aggregate.
+ */
+template<typename AddMeshFunc, typename AddCurveFunc>
+void createCurves(BuilderContext& ctx, const CurveAggregateList& curveAggregates, AddMeshFunc addMesh, AddCurveFunc addCurve)
+{
+    for (const auto& curveAggregate : curveAggregates.aggregates)
     {
-        // Process shapes and create meshes.
-        auto shape = createShape(ctx, shapeEntity);
-        if (shape.pTriangleMesh)
+        auto meshOrCurveID = createCurveGeometry(ctx, curveAggregate);
+        if (auto meshID = std::get_if<Falcor::MeshID>(&meshOrCurveID))
+        {
+            addMesh(*meshID, curveAggregate.transform);
+        }
+        else if (auto curveID = std::get_if<Falcor::CurveID>(&meshOrCurveID))
         {
-            auto meshID = ctx.builder.addTriangleMesh(shape.pTriangleMesh, shape.pMaterial);
-            instanceDefinition.meshes.emplace_back(meshID, shape.transform);
+            addCurve(*curveID, curveAggregate.transform);
         }
+        else
+        {
+            FALCOR_UNREACHABLE();
+        }
+    }
+}
 
-        // Create curves from curve aggregates assembled during the processing step above.
-        for (const auto& [_, curveAggregate] : ctx.curveAggregates)
+/**
+ * Create shapes and add their meshes to the scene builder.
+ * Shape geometry is created and processed into the runtime mesh format in parallel. Materials, area lights and curve
+ * aggregates are created serially, and the meshes are added in task order, so mesh IDs do not depend on thread scheduling.
+ * Shapes are processed in batches to bound the memory used by intermediate geometry.
+ * addMesh(task, meshID, transform) is called for each added mesh.
+ */
+template<typename AddMeshFunc>
+void createShapes(BuilderContext& ctx, const std::vector<ShapeTask>& tasks, AddMeshFunc addMesh)
+{
+    const size_t kBatchSize = 4096;
+
+    for (size_t batchStart = 0; batchStart < tasks.size(); batchStart += kBatchSize)
+    {
+        const size_t batchSize = std::min(kBatchSize, tasks.size() - batchStart);
+        std::vector<Shape> shapes(batchSize);
+        std::vector<std::optional<SceneBuilder::ProcessedMesh>> processedMeshes(batchSize);
+
+        parallelFor(batchSize, [&](size_t i) { shapes[i] = createShapeGeometry(ctx, *tasks[batchStart + i].pEntity); });
+
+        for (size_t i = 0; i < batchSize; ++i)
         {
-            auto meshOrCurveID = createCurveGeometry(ctx, curveAggregate);
-            if (auto meshID = std::get_if<Falcor::MeshID>(&meshOrCurveID))
-            {
-                instanceDefinition.meshes.emplace_back(*meshID, curveAggregate.transform);
-            }
-            else if (auto curveID = std::get_if<Falcor::CurveID>(&meshOrCurveID))
-            {
-                instanceDefinition.curves.emplace_back(*curveID, curveAggregate.transform);
-            }
-            else
+            const auto& task = tasks[batchStart + i];
+            if (task.pEntity->name == "curve")
+                appendCurve(ctx, *task.pCurveAggregates, *task.pEntity);
+            else if (shapes[i].pTriangleMesh)
+                shapes[i].pMaterial = createShapeMaterial(ctx, *task.pEntity);
+        }
+
+        parallelFor(
+            batchSize,
+            [&](size_t i)
             {
-                FALCOR_UNREACHABLE();
+                if (!shapes[i].pTriangleMesh)
+                    return;
+                processedMeshes[i] = ctx.builder.processTriangleMesh(shapes[i].pTriangleMesh, shapes[i].pMaterial);
+                shapes[i].pTriangleMesh = nullptr;
             }
+        );
+
+        for (size_t i = 0; i < batchSize; ++i)
+        {
+            if (!processedMeshes[i])
+                continue;
+            auto meshID = ctx.builder.addProcessedMesh(*processedMeshes[i]);
+            processedMeshes[i].reset();
+            addMesh(tasks[batchStart + i], meshID, shapes[i].transform);
         }
-        ctx.curveAggregates.clear();
     }
-
-    return instanceDefinition;
 }
 
 void buildScene(BuilderContext& ctx)
@@ -1804,64 +1922,74 @@ void buildScene(BuilderContext& ctx)
     }
 
     // Process shapes and create meshes.
+    CurveAggregateList curveAggregates;
+    std::vector<ShapeTask> shapeTasks;
+    shapeTasks.reserve(ctx.scene.getShapes().size());
     for (const auto& entity : ctx.scene.getShapes())
-    {
-        auto shape = createShape(ctx, entity);
-        if (shape.pTriangleMesh)
+        shapeTasks.push_back({&entity, &curveAggregates});
+
+    createShapes(
+        ctx, shapeTasks,
+        [&](const ShapeTask& task, MeshID meshID, const rmcv::mat4& transform)
         {
-            auto nodeID = ctx.builder.addNode({entity.name, shape.transform});
-            auto meshID = ctx.builder.addTriangleMesh(shape.pTriangleMesh, shape.pMaterial);
+            auto nodeID = ctx.builder.addNode({task.pEntity->name, transform});
             ctx.builder.addMeshInstance(nodeID, meshID);
         }
-    }
+    );
 
     // Create curves from curve aggregates assembled during the processing step above.
-    for (const auto& [_, curveAggregate] : ctx.curveAggregates)
-    {
-        auto nodeID = ctx.builder.addNode({"curves", curveAggregate.transform});
-        auto meshOrCurveID = createCurveGeometry(ctx, curveAggregate);
-        if (auto meshID = std::get_if<Falcor::MeshID>(&meshOrCurveID))
-        {
-            ctx.builder.addMeshInstance(nodeID, *meshID);
-        }
-        else if (auto curveID = std::get_if<Falcor::CurveID>(&meshOrCurveID))
-        {
-            ctx.builder.addCurveInstance(nodeID, *curveID);
-        }
-        else
-        {
-            FALCOR_UNREACHABLE();
-        }
-    }
-    ctx.curveAggregates.clear();
-
-    auto getInstanceDefinition = [&ctx](const InstanceSceneEntity& entity)
+    createCurves(
+        ctx, curveAggregates,
+        [&](MeshID meshID, const rmcv::mat4& transform) { ctx.builder.addMeshInstance(ctx.builder.addNode({"curves", transform}), meshID); },
+        [&](CurveID curveID, const rmcv::mat4& transform) { ctx.builder.addCurveInstance(ctx.builder.addNode({"curves", transform}), curveID); }
+    );
+
+    // Gather the instance definitions that are referenced by instances, and their instance transforms.
+    std::vector<InstanceDefinition> instanceDefinitions;
+    std::unordered_map<std::string, size_t> instanceDefinitionIndices;
+    for (const auto& entity : ctx.scene.getInstances())
     {
-        auto it = ctx.instanceDefinitions.find(entity.name);
-        if (it == ctx.instanceDefinitions.end())
+        auto [it, inserted] = instanceDefinitionIndices.try_emplace(entity.name, instanceDefinitions.size());
+        if (inserted)
         {
             auto it2 = ctx.scene.getInstanceDefinitions().find(entity.name);
             if (it2 == ctx.scene.getInstanceDefinitions().end())
             {
                 throwError(entity.loc, "Object instance '{}' not defined.", entity.name);
             }
-            it = ctx.instanceDefinitions.emplace(entity.name, createInstanceDefinition(ctx, it2->second)).first;
+            instanceDefinitions.emplace_back().pEntity = &it2->second;
         }
-        return it->second;
-    };
+        instanceDefinitions[it->second].instanceTransforms.push_back(entity.transform);
+    }
 
-    // Create instanced shapes.
-    for (const auto& entity : ctx.scene.getInstances())
+    // Create the shapes of all instance definitions together.
+    shapeTasks.clear();
+    for (size_t i = 0; i < instanceDefinitions.size(); ++i)
     {
-        const auto& instanceDefinition = getInstanceDefinition(entity);
-        auto instanceTransform = entity.transform;
+        for (const auto& shapeEntity : instanceDefinitions[i].pEntity->shapes)
+            shapeTasks.push_back({&shapeEntity, &instanceDefinitions[i].curveAggregates, i});
+    }
 
-        // Instantiate meshes.
-        for (const auto& [meshID, transform] : instanceDefinition.meshes)
-        {
-            auto nodeID = ctx.builder.addNode({"instance", instanceTransform * transform});
-            ctx.builder.addMeshInstance(nodeID, meshID);
-        }
+    createShapes(
+        ctx, shapeTasks,
+        [&](const ShapeTask& task, MeshID meshID, const rmcv::mat4& transform)
+        { instanceDefinitions[task.group].prototype.meshes.emplace_back(meshID, transform); }
+    );
+
+    // Create instanced shapes.
+    // Each instance definition becomes a prototype and all its instances are added to the scene builder in bulk.
+    for (auto& instanceDefinition : instanceDefinitions)
+    {
+        auto& prototype = instanceDefinition.prototype;
+        prototype.name = "instance";
+        createCurves(
+            ctx, instanceDefinition.curveAggregates,
+            [&](MeshID meshID, const rmcv::mat4& transform) { prototype.meshes.emplace_back(meshID, transform); },
+            [&](CurveID curveID, const rmcv::mat4& transform) { prototype.curves.emplace_back(curveID, transform); }
+        );
+
+        auto prototypeID = ctx.builder.addPrototype(prototype);
+        ctx.builder.addInstances(prototypeID, instanceDefinition.instanceTransforms);
     }
 }
 
@@ -3,18 +3,36 @@ Script for running unit tests.
 Most of the work is delegated to FalcorTest.
 '''
 
+import os
 import sys
+import time
 import argparse
+import tempfile
 import subprocess
+import xml.etree.ElementTree as ET
 
 from core import Environment, config
 
 from build_falcor import build_falcor
 
-def run_unit_tests(env, category, device_type, filter_regex, xml_report, repeat_count):
+TIMEOUT = 600
+
+def merge_xml_reports(shard_reports, xml_report):
+    '''
+    Merge the XML reports of all test shards into a single report.
+    '''
+    merged = ET.Element('testsuites')
+    testsuite = ET.SubElement(merged, 'testsuite', {'name': 'Unit Tests'})
+    for path in shard_reports:
+        if os.path.exists(path):
+            testsuite.extend(ET.parse(path).getroot().iter('testcase'))
+    ET.ElementTree(merged).write(xml_report, encoding='utf-8', xml_declaration=True)
+
+def run_unit_tests(env, category, device_type, filter_regex, xml_report, repeat_count, jobs=None, shards=None):
     '''
     Run unit tests by running FalcorTest.
     The optional filter_regex is used to select specific tests to run.
+    If shards is set, the tests are split across that many FalcorTest processes running concurrently.
     '''
     args = [str(env.falcor_test_exe)]
     if category:
@@ -23,19 +41,49 @@ def run_unit_tests(env, category, device_type, filter_regex, xml_report, repeat_
         args += ['--device-type', str(device_type)]
     if filter_regex:
         args += ['--filter', str(filter_regex)]
-    if xml_report:
-        args += ['--xml-report', str(xml_report)]
     if repeat_count:
         args += ['--repeat', str(repeat_count)]
+    if jobs is not None:
+        args += ['--jobs', str(jobs)]
 
-    p = subprocess.Popen(args)
-    try:
-        p.communicate(timeout=600)
-    except subprocess.TimeoutExpired:
-        p.kill()
-        print('\n\nProcess killed due to timeout')
+    if not shards or shards <= 1:
+        if xml_report:
+            args += ['--xml-report', str(xml_report)]
+
+        p = subprocess.Popen(args)
+        try:
+            p.communicate(timeout=TIMEOUT)
+        except subprocess.TimeoutExpired:
+            p.kill()
+            print('\n\nProcess killed due to timeout')
+
+        return p.returncode == 0
+
+    with tempfile.TemporaryDirectory() as temp_dir:
+        shard_reports = [os.path.join(temp_dir, f'shard_{i}.xml') for i in range(shards)]
+        processes = []
+        for i in range(shards):
+            shard_args = args + ['--shard', f'{i}/{shards}', '--xml-report', shard_reports[i]]
+            processes.append(subprocess.Popen(shard_args, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True))
+
+        # Print the output of the shards in order, so the log is deterministic.
+        success = True
+        deadline = time.monotonic() + TIMEOUT
+        for i, p in enumerate(processes):
+            try:
+                output, _ = p.communicate(timeout=max(0, deadline - time.monotonic()))
+            except subprocess.TimeoutExpired:
+                p.kill()
+                output, _ = p.communicate()
+                output += f'\n\nShard {i} killed due to timeout\n'
+            print(f'Shard {i}/{shards}:')
+            print(output)
+            success = success and p.returncode == 0
+
+        if xml_report:
+            merge_xml_reports(shard_reports, xml_report)
 
-    return p.returncode == 0
+    return success
 
 def main():
     parser = argparse.ArgumentParser(description='Utility for running unit tests.')
@@ -46,6 +94,8 @@ def main():
     parser.add_argument('-f', '--filter', type=str, action='store', help='Regular expression for filtering tests to run')
     parser.add_argument('-x', '--xml-report', type=str, action='store', help='XML report output file')
     parser.add_argument('-r', '--repeat', type=int, action='store', help='Number of times to repeat the test.')
+    parser.add_argument('-j', '--jobs', type=int, action='store', help='Number of threads for running CPU tests (0 = hardware concurrency).')
+    parser.add_argument('--shards', type=int, action='store', help='Split the tests across this many concurrent FalcorTest processes.')
     parser.add_argument('--skip-build', action='store_true', help='Skip building project before running tests')
     parser.add_argument('--list-configs', action='store_true', help='List available build configurations.')
     args = parser.parse_args()
@@ -69,7 +119,7 @@ def main():
             sys.exit(1)
 
     # Run tests.
-    success = run_unit_tests(env, args.category, args.device_type, args.filter, args.xml_report, args.repeat)
+    success = run_unit_tests(env, args.category, args.device_type, args.filter, args.xml_report, args.repeat, args.jobs, args.shards)
 
     sys.exit(0 if success else 1)
 